@@ -900,7 +900,8 @@ void Bundle::setTimetag( uint64_t ntp_time )
 	uint64_t a = htonll( ntp_time );
 	ByteArray<8> b;
 	memcpy( b.data(), reinterpret_cast<uint8_t*>( &a ), 8 );
-	mDataBuffer->insert( mDataBuffer->begin() + 12, b.begin(), b.end() );
+	// overwrites the immediate timetag of initializeBuffer(), inserting would leave it behind as garbage
+	std::copy( b.begin(), b.end(), mDataBuffer->begin() + 12 );
 }
 	
 void Bundle::initializeBuffer()
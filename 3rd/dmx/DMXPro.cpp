@@ -250,6 +250,19 @@ void DMXPro::setValue(int value, int channel)
 }
 
 
+void DMXPro::setValues(const int* channels, const unsigned char* values, size_t count)
+{
+	std::unique_lock<std::mutex> dataLock(mDMXDataMutex); // get DMX packet UNIQUE lock
+	for (size_t i = 0; i < count; i++)
+	{
+		if (channels[i] <= 0 || channels[i] > 512)
+			continue;
+		mDMXPacketOut[4 + channels[i]] = values[i];
+	}
+	dataLock.unlock(); // unlock mutex
+}
+
+
 size_t DMXPro::getValue(int channel)
 {
 	if (channel <= 0 || channel > 512)
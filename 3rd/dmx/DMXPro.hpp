@@ -88,6 +88,7 @@ public:
 	bool isConnected() { return mSerial != nullptr; }
 
 	void setValue(int value, int channel);
+	void setValues(const int* channels, const unsigned char* values, size_t count); // one lock for a whole batch
 	size_t getValue(int channel);
 
 	void reconnect();
@@ -95,26 +95,35 @@ class Filter : public FilterBase<T>
 	void insertValue(T value) override {
 		std::lock_guard<std::mutex> lock(mutex);
 		values.push_back(value);
+		sum += value;
 		computeCurrentValue(true);
 	};
   private:
 	std::deque<T> values;
 	T currentValue; // speedUp
+	T sum = T(0);	// running, so an insert does not touch the whole window
+	unsigned insertsSinceSum = 0;
 	unsigned windowSize;
 	unsigned currentWindowSize;
 	mutable std::mutex mutex;
 
 	void computeCurrentValue(bool force = false) {
-		if (values.size() > currentWindowSize) {
+		while (values.size() > currentWindowSize) {
+			sum -= values.front();
 			values.pop_front();
 			force = true;
 		}
 
 		if (force) {
-			T temp = T(0);
-			for (auto n : values) {
-				temp += n;
+			// rounding errors of the running sum are dropped once per window
+			if (++insertsSinceSum >= currentWindowSize) {
+				insertsSinceSum = 0;
+				sum = T(0);
+				for (auto n : values) {
+					sum += n;
+				}
 			}
+			T temp = sum;
 			temp /= values.size();
 			currentValue = temp;
 		}
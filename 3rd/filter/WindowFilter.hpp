@@ -0,0 +1,327 @@
+/*
+
+	WindowFilter - constant time per sample, templated, ease-of-use
+	Lars Engeln 2025
+	mail@lars-engeln.de
+
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+*/
+
+/*
+	every insertValue() is O(1), independent of the window size, and never allocates after construction.
+	there is no locking: one thread inserts, reading from another thread needs its own synchronisation.
+
+	RunningMean<T>		sum and mean over the last n values
+	RunningVariance<T>	mean and variance over the last n values (Welford, with removal)
+	MovingMin<T>		minimum over the last n values (monotonic deque), scalars only
+	MovingMax<T>		maximum over the last n values (monotonic deque), scalars only
+	EMA<T>				exponential moving average
+	Biquad<T>			second order IIR, low-/high-/bandpass after the RBJ audio EQ cookbook
+
+	T can be float, double, glm::vec2/3/4 and, except for the variance and min/max, glm::quat (needs _withGLM of Filter.hpp).
+	quaternions are kept in the hemisphere of the current value and normalised on output.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <memory>
+#include <functional>
+
+#include "Filter.hpp"
+
+namespace windowfilter {
+
+	template<class T> inline T		zero()											{ return T(0); }
+	template<class T> inline T		align(const T& value, const T& reference)		{ return value; }
+	template<class T> inline T		finish(const T& value)							{ return value; }
+
+#ifdef _withGLM
+	template<> inline glm::quat		zero<glm::quat>()								{ return glm::quat(0.0f, 0.0f, 0.0f, 0.0f); }
+	template<> inline glm::quat		align(const glm::quat& value, const glm::quat& reference) { return glm::dot(value, reference) < 0.0f ? -value : value; }
+	template<> inline glm::quat		finish(const glm::quat& value)					{ float len = glm::length(value); return len > 0.0f ? value / len : glm::quat(1.0f, 0.0f, 0.0f, 0.0f); }
+#endif
+
+	/**
+	* fixed size ring of the last n values
+	*/
+	template<class T>
+	class Ring {
+	public:
+		Ring(size_t capacity = 1) { setCapacity(capacity); };
+
+		void	setCapacity(size_t capacity) { values.assign(capacity < 1 ? 1 : capacity, zero<T>()); head = 0; count = 0; };
+		size_t	capacity() const	{ return values.size(); };
+		size_t	size() const		{ return count; };
+		bool	isFull() const		{ return count == values.size(); };
+		bool	hasWrapped() const	{ return head == 0; };	// right after a push, once per capacity values
+
+		const T& oldest() const		{ return values[head]; };	// the value push() will overwrite, only valid if full
+
+		void push(const T& value) {
+			values[head] = value;
+			head = head + 1 == values.size() ? 0 : head + 1;
+			if (count < values.size())
+				count++;
+		};
+
+		template<class F> void forEach(F f) const {
+			size_t start = isFull() ? head : 0;
+			for (size_t i = 0; i < count; i++) {
+				size_t index = start + i;
+				f(values[index < values.size() ? index : index - values.size()]);
+			}
+		};
+
+	private:
+		std::vector<T>	values;
+		size_t			head;
+		size_t			count;
+	};
+
+	template<class T>
+	class RunningMean : public FilterBase<T> {
+	public:
+		RunningMean(size_t windowSize = 10) : ring(windowSize), sum(zero<T>()), currentValue(zero<T>()) {};
+		static std::shared_ptr<RunningMean> create(size_t windowSize = 10) { return std::make_shared<RunningMean>(windowSize); }
+
+		void	setWindowSize(size_t windowSize) { ring.setCapacity(windowSize); sum = zero<T>(); currentValue = zero<T>(); };
+		size_t	getWindowSize() const	{ return ring.capacity(); };
+		size_t	getCount() const		{ return ring.size(); };
+		T		getSum() const			{ return sum; };
+
+		T getValue() override { return currentValue; };
+		void insertValue(T value) override {
+			if (ring.size() > 0)
+				value = align(value, currentValue);
+			if (ring.isFull())
+				sum -= ring.oldest();
+			sum += value;
+			ring.push(value);
+
+			// rounding errors of the running sum are dropped once per window, amortised O(1)
+			if (ring.hasWrapped()) {
+				sum = zero<T>();
+				ring.forEach([&](const T& v) { sum += v; });
+			}
+
+			currentValue = finish(sum / (float)ring.size());
+		};
+
+	private:
+		Ring<T>	ring;
+		T		sum;
+		T		currentValue;
+	};
+	template<class T>
+	using RunningMeanRef = std::shared_ptr<RunningMean<T>>;
+
+	template<class T>
+	class RunningVariance : public FilterBase<T> {
+	public:
+		RunningVariance(size_t windowSize = 10) : ring(windowSize), mean(zero<T>()), m2(zero<T>()) {};
+		static std::shared_ptr<RunningVariance> create(size_t windowSize = 10) { return std::make_shared<RunningVariance>(windowSize); }
+
+		void	setWindowSize(size_t windowSize) { ring.setCapacity(windowSize); mean = zero<T>(); m2 = zero<T>(); };
+		size_t	getWindowSize() const	{ return ring.capacity(); };
+
+		T		getMean() const			{ return mean; };
+		T		getVariance() const		{ return ring.size() > 1 ? m2 / (float)(ring.size() - 1) : zero<T>(); };	// sample variance
+		T		getStdDev() const		{ return glm::sqrt(getVariance()); };
+
+		T getValue() override { return getVariance(); };
+		void insertValue(T value) override {
+			if (ring.isFull()) {
+				T old		= ring.oldest();
+				float n		= (float)ring.size();
+				T oldMean	= mean;
+				mean		+= (value - old) / n;
+				m2			+= (value - old) * (value - mean + old - oldMean);
+			}
+			else {
+				float n		= (float)(ring.size() + 1);
+				T delta		= value - mean;
+				mean		+= delta / n;
+				m2			+= delta * (value - mean);
+			}
+			ring.push(value);
+			m2 = clampPositive(m2);
+		};
+
+	private:
+		Ring<T>	ring;
+		T		mean;
+		T		m2;
+
+		static T clampPositive(const T& value) { return glm::max(value, zero<T>()); }
+	};
+	template<class T>
+	using RunningVarianceRef = std::shared_ptr<RunningVariance<T>>;
+
+	/**
+	* monotonic deque: holds only values that can still become the extremum, every value enters and leaves it once
+	*/
+	template<class T, class Compare>
+	class MovingExtremum : public FilterBase<T> {
+	public:
+		MovingExtremum(size_t windowSize = 10) { setWindowSize(windowSize); };
+
+		void setWindowSize(size_t windowSize) {
+			window = windowSize < 1 ? 1 : windowSize;
+			values.assign(window + 2, T(0));	// one more than can be held at once, so full and empty differ
+			indices.assign(window + 2, 0);
+			front = back = 0;
+			counter = 0;
+		};
+		size_t	getWindowSize() const { return window; };
+
+		T getValue() override { return front == back ? T(0) : values[front]; };
+		void insertValue(T value) override {
+			size_t capacity = values.size();
+
+			// drop everything the new value dominates
+			while (front != back) {
+				size_t last = back == 0 ? capacity - 1 : back - 1;
+				if (!compare(value, values[last]) && value != values[last])
+					break;
+				back = last;
+			}
+			values[back]	= value;
+			indices[back]	= counter;
+			back			= back + 1 == capacity ? 0 : back + 1;
+
+			// and the front, once it left the window
+			if (indices[front] + window <= counter)
+				front = front + 1 == capacity ? 0 : front + 1;
+
+			counter++;
+		};
+
+	private:
+		size_t				window;
+		std::vector<T>		values;
+		std::vector<size_t>	indices;
+		size_t				front, back;
+		size_t				counter;
+		Compare				compare;
+	};
+
+	template<class T>
+	using MovingMin = MovingExtremum<T, std::less<T>>;
+	template<class T>
+	using MovingMax = MovingExtremum<T, std::greater<T>>;
+
+	template<class T>
+	class EMA : public FilterBase<T> {
+	public:
+		EMA(float alpha = 0.1f) : alpha(alpha), currentValue(zero<T>()), isInitialized(false) {};
+		static std::shared_ptr<EMA> create(float alpha = 0.1f) { return std::make_shared<EMA>(alpha); }
+
+		// alpha for a time constant tau at a sample interval dt
+		static float alphaFromTimeConstant(float tau, float dt) { return tau > 0.0f ? 1.0f - std::exp(-dt / tau) : 1.0f; }
+
+		void	setAlpha(float a)	{ alpha = a; };
+		float	getAlpha() const	{ return alpha; };
+		void	reset()				{ isInitialized = false; };
+
+		T getValue() override { return currentValue; };
+		void insertValue(T value) override {
+			if (!isInitialized) {
+				currentValue	= value;
+				isInitialized	= true;
+				return;
+			}
+			value			= align(value, currentValue);
+			currentValue	= finish(currentValue + (value - currentValue) * alpha);
+		};
+
+	private:
+		float	alpha;
+		T		currentValue;
+		bool	isInitialized;
+	};
+	template<class T>
+	using EMARef = std::shared_ptr<EMA<T>>;
+
+	template<class T>
+	class Biquad : public FilterBase<T> {
+	public:
+		enum Type {
+			LOWPASS,
+			HIGHPASS,
+			BANDPASS
+		};
+
+		Biquad(Type type = LOWPASS, float frequency = 5.0f, float sampleRate = 60.0f, float q = 0.7071f) : currentValue(zero<T>()) { setParams(type, frequency, sampleRate, q); reset(); };
+		static std::shared_ptr<Biquad> create(Type type = LOWPASS, float frequency = 5.0f, float sampleRate = 60.0f, float q = 0.7071f) { return std::make_shared<Biquad>(type, frequency, sampleRate, q); }
+
+		void setParams(Type type, float frequency, float sampleRate, float q) {
+			float w0	= 2.0f * 3.14159265f * std::fmin(frequency, sampleRate * 0.49f) / sampleRate;
+			float cosW0	= std::cos(w0);
+			float alpha	= std::sin(w0) / (2.0f * (q > 0.0f ? q : 0.7071f));
+			float a0	= 1.0f + alpha;
+
+			switch (type) {
+			case HIGHPASS:
+				b0 = (1.0f + cosW0) * 0.5f;
+				b1 = -(1.0f + cosW0);
+				b2 = b0;
+				break;
+			case BANDPASS:
+				b0 = alpha;
+				b1 = 0.0f;
+				b2 = -alpha;
+				break;
+			default:
+				b0 = (1.0f - cosW0) * 0.5f;
+				b1 = 1.0f - cosW0;
+				b2 = b0;
+				break;
+			}
+			a1 = -2.0f * cosW0;
+			a2 = 1.0f - alpha;
+
+			b0 /= a0; b1 /= a0; b2 /= a0; a1 /= a0; a2 /= a0;
+		};
+		void reset() { z1 = z2 = zero<T>(); };
+
+		T getValue() override { return currentValue; };
+		void insertValue(T value) override {
+			value = align(value, currentValue);
+
+			// transposed direct form II
+			T y	= value * b0 + z1;
+			z1	= value * b1 - y * a1 + z2;
+			z2	= value * b2 - y * a2;
+			currentValue = finish(y);
+		};
+
+	private:
+		float	b0, b1, b2, a1, a2;
+		T		z1, z2;
+		T		currentValue;
+	};
+	template<class T>
+	using BiquadRef = std::shared_ptr<Biquad<T>>;
+
+}
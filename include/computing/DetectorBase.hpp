@@ -22,6 +22,7 @@
 #include "camera/CameraManager.hpp"
 #include "marker/MarkerRoomNode.hpp"
 #include "camera/CameraRoomNode.hpp"
+#include "AssetManager.hpp"
 #if __has_include(<opencv2/aruco.hpp>)
 #define WITHARUCO
 #endif
@@ -121,12 +122,25 @@ namespace act {
 			}
 
 			bool isDetecting() { return m_detecting; }
+			bool isLoading() { return m_initialization.isLoading(); }
 
 			bool hasNewCandidates() { return m_areNewCandidatesAvailable; }
 			std::vector<C> getCandidates() { m_areNewCandidatesAvailable = false; return m_currentCandidates; }
 
 		protected:
-			bool m_isInitialized = false;
+			std::atomic<bool> m_isInitialized = false;	// set last by the initialization, detecting waits for it
+
+			/**
+			* @brief loads the network on the AssetManager instead of blocking the caller,
+			* a derived destructor has to wait for m_initialization as the init uses its members
+			*/
+			void initInBackground(std::function<void()> init) {
+				m_initialization = util::AssetManager::get().run<bool>([init]() {
+					init();
+					return std::make_shared<bool>(true);
+				});
+			}
+			util::AssetFuture<bool> m_initialization;
 
 			cv::UMat m_currentImage;
 			cv::UMat m_feedbackImage;
@@ -0,0 +1,75 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "cinder/Json.h"
+
+#include "Snapshot.hpp"
+
+namespace act {
+	namespace mod {
+
+		/**
+		* @brief the processing graph as flat tables, built from the JSON description or a binary snapshot
+		* strings are interned, links point to nodes by index and params of nodes are kept as msgpack in binary snapshots,
+		* so loading needs neither a JSON parse of the whole file nor searches by uid
+		*/
+		class GraphSnapshot
+		{
+		public:
+			struct Node {
+				uint32_t				uid, name, title;	// string indices
+				float					x = 0.0f, y = 0.0f;
+				std::vector<uint8_t>	packedParams;		// msgpack, if read from a binary snapshot
+				ci::Json				params;				// if built from JSON
+			};
+			struct Child {
+				uint32_t	container;
+				float		x = 0.0f, y = 0.0f;
+			};
+			struct Link {
+				uint32_t	from, fromPort;		// node index, nodes are followed by the containers
+				uint32_t	to, toPort;
+			};
+			struct Container {
+				uint32_t				uid, name, title, panning;
+				int32_t					level = 0;
+				std::vector<uint32_t>	nodes;
+				std::vector<Child>		children;
+				std::vector<Link>		links;
+			};
+
+			std::vector<std::string>	strings;
+			std::vector<Node>			nodes;
+			std::vector<Container>		containers;
+
+			static std::shared_ptr<GraphSnapshot> fromJson(const ci::Json& description);
+			static std::shared_ptr<GraphSnapshot> decode(const std::vector<uint8_t>& data);
+			std::vector<uint8_t> encode();
+
+			const std::string& getString(uint32_t index) { return strings[index]; };
+			ci::Json getParams(Node& node);
+			uint32_t getContainerEndpoint(uint32_t container) { return (uint32_t)nodes.size() + container; };
+
+		private:
+			std::unordered_map<std::string, uint32_t> m_stringIndices;
+			uint32_t intern(const std::string& string);
+		};
+		using GraphSnapshotRef = std::shared_ptr<GraphSnapshot>;
+
+	}
+}
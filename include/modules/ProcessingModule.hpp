@@ -29,6 +29,9 @@
 #include "ProcNodeRegistry.hpp"
 #include "ContainerProcNode.hpp"
 
+#include "GraphSnapshot.hpp"
+#include "Snapshot.hpp"
+
 using namespace ci;
 using namespace ci::app;
 
@@ -58,6 +61,7 @@ namespace act {
 			proc::ProcNodeBaseRef getNodeByUID(act::UID uid);
 			proc::ContainerProcNodeRef getContainerByContainingNode(act::UID uid);
 			proc::ProcNodeBaseRef createNodeByName(std::string nodeName);
+			std::shared_ptr<act::proc::ProcNodeRegistry> getNodeRegistry() { return m_nodeRegistry; }
 			void deleteNodeByUID(act::UID uid);
 
 			proc::ContainerProcNodeRef createContainerByName(std::string name);
@@ -84,10 +88,15 @@ namespace act {
 			
 			std::string											m_newGroupName{ "Group" };
 
+			// descriptions are taken on the main thread, encoded and written by the saver
+			util::SnapshotSaver									m_saver;
+
 			void drawNodePool();
 			void drawCreateButton(std::string nodeName);
 			void loadFromFile(fs::path path);
-			void saveToFile(fs::path path);
+			void loadSnapshot(GraphSnapshot& snapshot);
+			void saveToFile(fs::path path);	// binary unless it is a .json
+			fs::path getRecentPath();
 			void connect(int from, int to);
 			std::pair<act::UID, std::string> getNodeUIDAndPortName(std::string str);
 		};
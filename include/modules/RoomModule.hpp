@@ -32,6 +32,7 @@
 #include "MouseRawListener.hpp"
 
 #include "Stage.hpp"
+#include "Snapshot.hpp"
 
 
 using namespace ci;
@@ -110,11 +111,13 @@ namespace act {
 			void handleResize();
 
 			void loadFromFile(fs::path path);
-			void saveToFile(fs::path path);
+			void saveToFile(fs::path path);	// binary unless it is a .json
 
 		private:
 			int m_selectedCopyPos = 0;
 
+			util::SnapshotSaver		m_saver;
+
 		};
 
 		using RoomModuleRef = std::shared_ptr<RoomModule>;
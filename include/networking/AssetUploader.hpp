@@ -0,0 +1,102 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
+
+#include "cinder/Json.h"
+
+#include "UniqueIDBase.hpp"
+#include "Connection.hpp"
+
+namespace act {
+	namespace net {
+
+		/**
+		* @brief receives assets (audio, video, models, fixture profiles) in chunks and writes them in its own thread
+		* an upload is begun with its size, sent in base64 chunks with their offset and CRC-32 and committed at the end.
+		* received bytes are kept in a .part file next to the target, so a begin with the same name and size resumes at its end.
+		* uploads without a message for a while are forgotten, their .part file is kept for such a resume
+		*/
+		class AssetUploader
+		{
+		public:
+			/** @brief a reply for the sender of an upload, produced on the upload thread */
+			struct Reply {
+				act::UID				msgUID;
+				ConnectionProviderRef	sender;
+				ci::Json				data;
+				std::string				error;		// empty if successful
+			};
+
+			AssetUploader();
+			~AssetUploader();
+
+			void begin(act::UID msgUID, ConnectionProviderRef sender, act::UID uid, std::string kind, std::string fileName, uint64_t size, int64_t checksum = -1);
+			void chunk(act::UID msgUID, ConnectionProviderRef sender, act::UID uid, uint64_t offset, std::string base64Data, int64_t checksum = -1);
+			void commit(act::UID msgUID, ConnectionProviderRef sender, act::UID uid);
+			void abort(act::UID msgUID, ConnectionProviderRef sender, act::UID uid);
+
+			/** @brief a whole file in one message, as sent by older WebUIs */
+			void upload(act::UID msgUID, ConnectionProviderRef sender, std::string kind, std::string fileName, std::string base64Data);
+
+			std::vector<Reply> takeReplies();
+
+			static uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+			static std::filesystem::path getDirectory(const std::string& kind);
+
+		private:
+			struct Upload {
+				std::filesystem::path	partPath;
+				std::filesystem::path	targetPath;
+				uint64_t				size		= 0;
+				uint64_t				received	= 0;
+				int64_t					checksum	= -1;	// of the whole file, not checked if negative
+				std::chrono::steady_clock::time_point	lastActive;
+			};
+
+			std::map<act::UID, Upload>	m_uploads;	// only used on the upload thread
+			std::chrono::seconds					m_idleTimeout = std::chrono::minutes(10);
+			std::chrono::steady_clock::time_point	m_lastExpire;
+
+			std::thread							m_thread;
+			std::mutex							m_mutex;
+			std::condition_variable				m_condition;
+			bool								m_isRunning = true;
+			std::deque<std::function<void()>>	m_jobs;
+
+			std::mutex							m_replyMutex;
+			std::vector<Reply>					m_replies;
+
+			void push(std::function<void()> job);
+			void reply(const act::UID& msgUID, const ConnectionProviderRef& sender, ci::Json data);
+			void replyError(const act::UID& msgUID, const ConnectionProviderRef& sender, std::string error);
+			void loop();
+			void expireUploads();
+		};
+
+	}
+}
@@ -37,6 +37,8 @@ namespace act {
 			virtual void onMsg(ci::Json json, act::UID uid) = 0;
 			virtual void onConnect(act::UID uid) = 0;
 			virtual void onDisconnect(act::UID uid) = 0;
+			/** @brief the full state for a client that is new or fell behind */
+			virtual ci::Json onResync(act::UID uid) { return ci::Json(); }
 		}; using MsgRecieverRef = std::shared_ptr<MsgReciever>;
 
 	}
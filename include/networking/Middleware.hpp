@@ -26,6 +26,7 @@
 
 #include "Connection.hpp"
 #include "Message.hpp"
+#include "AssetUploader.hpp"
 
 using namespace ci;
 
@@ -66,6 +67,7 @@ namespace act {
 			ci::Json	disconnectProcNodes(act::UID fromUID, std::string outputName, act::UID toUID, std::string inputName);
 			ci::Json	getParameterOfProcNode(act::UID msgUID, act::UID uid);
 			void		setParameterOfProcNode(act::UID uid, ci::Json params);
+			void		watchParameterOfProcNode(act::UID uid, ConnectionProviderRef sender);
 			void		subscribeToProcNode(act::UID uid, std::string valueName, ConnectionProviderRef sender);
 			void		unsubscribeFromProcNode(act::UID uid, std::string valueName);
 			
@@ -73,7 +75,7 @@ namespace act {
 			ci::Json	updateRoomNode(act::UID msgUID, ci::Json data);
 			ci::Json	deleteRoomNode(act::UID msgUID, act::UID uid);
 
-			ci::Json	uploadAudio(act::UID msgUID, act::UID uid, std::string fileName, std::string fileData);
+			void		uploadAsset(act::UID msgUID, ci::Json data, ConnectionProviderRef sender);
 			
 
 		private:
@@ -86,12 +88,14 @@ namespace act {
 
 			std::map<act::UID, std::map<std::string, proc::PortBaseRef>> m_subscriptions; // uid -> valueName -> port
 			std::vector<proc::ProcNodeBaseRef>	m_jsonNodes; // keeping them on a warm place
+			std::map<act::UID, std::vector<ConnectionProviderRef>> m_paramWatchers; // uid -> requesters of the params, they get the changed ones on update
 
 
 			bool							checkEmpty(std::string var, std::string where, std::string what, ConnectionProviderRef sender = nullptr);
 
-			std::vector<proc::ProcNodeBaseRef>	m_nodeTypeNodes; // holds all nodes to be registered, so if the request will be come in again, the nodes don't have to be generated again
-			ci::Json						m_procNodeTypeData;
+			ci::Json						m_procNodeTypeData; // filled on the first request, the registry describes the types without keeping nodes
+
+			AssetUploader					m_uploader; // decodes and writes uploads in its own thread, replies are sent on update
 
 		}; using MiddlewareRef = std::shared_ptr<Middleware>;
 
@@ -56,6 +56,7 @@ namespace act {
 			virtual void onMsg(ci::Json json, act::UID uid) override;
 			virtual void onConnect(act::UID uid) override;
 			virtual void onDisconnect(act::UID uid) override;
+			virtual ci::Json onResync(act::UID uid) override;
 
 		private:
 
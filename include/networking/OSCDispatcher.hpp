@@ -0,0 +1,78 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#define _SILENCE_CXX17_RESULT_OF_DEPRECATION_WARNING
+#include "Osc.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace act {
+	namespace net {
+
+		/**
+		* @brief routes OSC messages to listeners registered by address pattern
+		* patterns may use the OSC wildcards *, ?, [abc], [a-z], [!a] and {foo,bar} within a part of the address.
+		* the listeners are compiled into a trie over the address parts: literal parts are looked up, only wildcard parts
+		* are matched. the listeners found for an address are cached, so repeated addresses cost one lookup
+		*/
+		class OSCDispatcher
+		{
+		public:
+			using ListenerFn = std::function<void(const ci::osc::Message& message)>;
+			using ListenerRef = std::shared_ptr<ListenerFn>;
+
+			OSCDispatcher();
+			~OSCDispatcher();
+
+			void	setListener(const std::string& pattern, ListenerFn listener);	// replaces the one of the same pattern
+			void	removeListener(const std::string& pattern);
+			bool	hasListeners() { return !m_listeners.empty(); }
+
+			/**
+			* @brief calls all listeners whose pattern matches the address, false if there was none
+			*/
+			bool	dispatch(const ci::osc::Message& message);
+
+			static bool	matchPart(std::string_view pattern, std::string_view part);
+
+		private:
+			struct Node {
+				std::unordered_map<std::string, int32_t>	literals;
+				std::vector<std::pair<std::string, int32_t>> wildcards;
+				std::vector<ListenerRef>					listeners;	// of patterns ending here
+			};
+
+			std::map<std::string, ListenerRef>	m_listeners;
+			std::vector<Node>					m_nodes;
+			bool								m_isCompiled = false;
+
+			std::unordered_map<std::string, std::vector<ListenerRef>> m_cache;	// by address
+			std::vector<std::string_view>		m_parts;
+
+			void	compile();
+			void	collect(int32_t node, size_t part, std::vector<ListenerRef>& result);
+			static void	split(std::string_view address, std::vector<std::string_view>& parts);
+			static bool	isWildcard(std::string_view part);
+		};
+
+	}
+}
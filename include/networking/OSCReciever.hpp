@@ -1,4 +1,3 @@
-
 /*
 	InACTually
 	> interactive theater for actual acts
@@ -9,7 +8,7 @@
 	Licensed under the MIT License.
 	See LICENSE file in the project root for full license information.
 
-	This file is created and substantially modified: 2021-2023
+	This file is created and substantially modified: 2021-2023, 2025
 
 	contributors:
 	Lars Engeln - mail@lars-engeln.de
@@ -20,11 +19,18 @@
 #define _SILENCE_CXX17_RESULT_OF_DEPRECATION_WARNING
 //#define _CRT_SECURE_NO_WARNINGS
 #include "Osc.h"
+#include "OSCDispatcher.hpp"
 
 #include "cinder/app/App.h"
 #include "cinder/Log.h"
 
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 using namespace ci;
 using namespace ci::app;
@@ -41,62 +47,72 @@ using protocol = asio::ip::tcp;
 namespace act {
 	namespace net {
 
+		/**
+		* @brief receives OSC on its own network thread, listeners are called on the main thread
+		* messages are parsed on the network thread into a lock-free ring, which update() drains at the start of a frame.
+		* when coalescing, only the latest message per address of a frame is dispatched, so a high-rate controller
+		* cannot flood the graph. listeners are registered by address pattern, see OSCDispatcher
+		*/
 		class OSCReciever {
 		public:
-			OSCReciever(uint16_t port)
-			{
-				m_connected = false;
-				m_receiver = std::make_shared<Receiver>(port);
-				
-#if USE_UDP
-				// UDP opens the socket and "listens" accepting any message from any endpoint. The listen
-				// function takes an error handler for the underlying socket. Any errors that would
-				// call this function are because of problems with the socket or with the remote message.
-				
-#endif
-			}
+			OSCReciever(uint16_t port);
+			~OSCReciever();
 
-			static std::shared_ptr<OSCReciever> create(uint16_t localPort) { return std::make_shared<OSCReciever>(localPort); }
+			static std::shared_ptr<OSCReciever> create(uint16_t localPort);
 
+			void setListener(std::string address, OSCDispatcher::ListenerFn callback) { m_dispatcher.setListener(address, callback); }
+			void removeListener(std::string address) { m_dispatcher.removeListener(address); }
 
-			void setListener(std::string address, osc::ReceiverBase::ListenerFn callback) {
-				m_receiver->setListener(address, callback);
-			}
-			void removeListener(std::string address) {
-				m_receiver->removeListener(address);
-			}
-
-			void listen() {
-				try{
-					// Bind the receiver to the endpoint. This function may throw.
-					m_receiver->bind();
-				}
-					catch (const osc::Exception& ex) {
-					CI_LOG_E("Error binding: " << ex.what() << " val: " << ex.value());
-				}
-				m_receiver->listen(
-					[this](asio::error_code error, protocol::endpoint endpoint) -> bool {
-						if (error) {
-							CI_LOG_E("Error Listening: " << error.message() << " val: " << error.value() << " endpoint: " << endpoint);
-							return false;
-						}
-						else {
-							m_connected = true;
-							return true;
-						}
-					});
-			}
+			void listen();
 
 			bool isConnected() {
 				return m_connected;
 			}
 
+			/**
+			* @brief dispatches the messages received since the last call, on the calling thread
+			*/
+			void update();
+
+			/**
+			* @brief updates all receivers, called by the NetworkManager before the rooms and the graph
+			*/
+			static void updateAll();
+
+			bool isCoalescing() { return m_isCoalescing; }
+			void setIsCoalescing(bool coalescing) { m_isCoalescing = coalescing; }
+
+			uint64_t getReceived() { return m_received; }
+			uint64_t getDropped() { return m_dropped; }	// the ring was full, update() was not called for too long
 
 		private:
+			asio::io_context	m_ioContext;
+			asio::executor_work_guard<asio::io_context::executor_type> m_work;
+			std::thread			m_thread;
+
 			std::shared_ptr<Receiver> m_receiver;
-			bool m_connected;
+			std::atomic<bool>	m_connected;
+
+			OSCDispatcher		m_dispatcher;
+			bool				m_isCoalescing = true;
+
+			// single producer (network thread), single consumer (update)
+			static const size_t				kRingSize = 4096;	// power of two
+			std::vector<ci::osc::Message>	m_ring;
+			std::atomic<size_t>				m_head = 0;	// written by the producer
+			std::atomic<size_t>				m_tail = 0;	// written by the consumer
+			std::atomic<uint64_t>			m_received = 0;
+			std::atomic<uint64_t>			m_dropped = 0;
+
+			std::vector<ci::osc::Message>	m_messages;
+			std::unordered_map<std::string, size_t> m_latest;	// per address, index of its last message in a frame
+			std::set<std::string>			m_disregardedAddresses;
+
+			void push(const ci::osc::Message& message);
 
+			static std::mutex								s_mutex;
+			static std::vector<std::weak_ptr<OSCReciever>>	s_recievers;
 		};
 		using OSCRecieverRef = std::shared_ptr<OSCReciever>;
 	}
-}
\ No newline at end of file
+}
@@ -1,4 +1,3 @@
-
 /*
 	InACTually
 	> interactive theater for actual acts
@@ -9,7 +8,7 @@
 	Licensed under the MIT License.
 	See LICENSE file in the project root for full license information.
 
-	This file is created and substantially modified: 2021-2023
+	This file is created and substantially modified: 2021-2023, 2025
 
 	contributors:
 	Lars Engeln - mail@lars-engeln.de
@@ -21,9 +20,18 @@
 using Sender = ci::osc::SenderUdp;
 #define _SILENCE_CXX17_RESULT_OF_DEPRECATION_WARNING
 
+#include <atomic>
+#include <map>
+#include <thread>
+
 namespace act {
 	namespace net {
 
+		/**
+		* @brief sends OSC to one destination from its own asio worker thread
+		* when bundling, messages are collected until flush() (once per tick) and sent as size-bounded #bundles,
+		* messages with a delay are sent in bundles timetagged into the future, so the receiver can schedule them
+		*/
 		class OSCServer
 		{
 		public:
@@ -35,13 +43,43 @@ namespace act {
 			inline bool isRunning() { return m_isConnected; }
 
 			void sendMsg(ci::osc::Message msg);
+			void sendMsg(ci::osc::Message msg, float delay);	// in s, always bundled
+
+			/**
+			* @brief hands the bundles collected since the last call to the worker
+			*/
+			void flush();
+
+			bool isBundling() { return m_isBundling; }
+			void setIsBundling(bool bundling);
+
+			size_t getMaxPacketSize() { return m_maxPacketSize; }
+			void setMaxPacketSize(size_t size) { m_maxPacketSize = std::max((size_t)64, size); }	// bytes, bundles stay below the MTU
+
+			uint64_t getSentMessages() { return m_sentMessages; }
+			uint64_t getSentPackets() { return m_sentPackets; }
 
 		private:
+			asio::io_context		m_ioContext;
+			asio::executor_work_guard<asio::io_context::executor_type> m_work;
+			std::thread				m_thread;
+
 			ci::osc::UdpSocketRef	m_socket;
 			Sender	m_sender;
-			bool	m_isConnected;
+			std::atomic<bool>	m_isConnected;
 			void	onSendError(asio::error_code error);
+
+			bool	m_isBundling	= false;
+			size_t	m_maxPacketSize	= 1400;
+
+			// open bundles by delay in ms, the last one of each list is being filled
+			std::map<int, std::vector<ci::osc::Bundle>>	m_bundles;
+
+			std::atomic<uint64_t>	m_sentMessages	= 0;
+			std::atomic<uint64_t>	m_sentPackets	= 0;
+
+			void	append(const ci::osc::Message& msg, int delay);
 		}; 
 		using OSCServerRef = std::shared_ptr<OSCServer>;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,267 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include <memory>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+
+#include "cinder/Json.h"
+#include "jsonHelper.hpp"
+
+namespace act {
+	namespace net {
+
+		enum QueuePolicy {
+			QP_RESYNC,		// a full queue is dropped, the client gets the full state instead
+			QP_COALESCE,	// a pending update of the same fields is replaced, resync if still full
+			QP_DISCONNECT	// a full queue closes the client, it gets the full state when it reconnects
+		};
+
+		struct ClientQueueConfig {
+			size_t		maxPending	= 256;
+			size_t		maxBytes	= 16 * 1024 * 1024;
+			QueuePolicy	policy		= QP_COALESCE;
+
+			ci::Json toJson() const {
+				auto json = ci::Json::object();
+				json["maxPending"]	= maxPending;
+				json["maxBytes"]	= maxBytes;
+				json["policy"]		= (int)policy;
+				return json;
+			}
+
+			void fromJson(const ci::Json& json) {
+				int pending		= (int)maxPending;
+				int bytes		= (int)maxBytes;
+				int queuePolicy	= (int)policy;
+				util::setValueFromJson(json, "maxPending", pending);
+				util::setValueFromJson(json, "maxBytes", bytes);
+				util::setValueFromJson(json, "policy", queuePolicy);
+
+				maxPending	= std::max(1, pending);
+				maxBytes	= std::max(1, bytes);
+				policy		= (QueuePolicy)std::clamp(queuePolicy, (int)QP_RESYNC, (int)QP_DISCONNECT);
+			}
+		};
+
+		/**
+		* @brief a bounded outbound queue per client of a SimpleWeb WebSocket server
+		* a broadcast is serialised once and shared by the clients. only one message per client is handed to its socket,
+		* the next one is sent from the completion handler on the I/O thread, so a slow client only backs up its own queue.
+		* new and lagging clients are sent the full state by resync() on the main thread
+		*/
+		template<class ServerT>
+		class WebSocketClients
+		{
+		public:
+			using Connection	= typename ServerT::Connection;
+			using ConnectionRef	= std::shared_ptr<Connection>;
+			using OutMessageRef	= std::shared_ptr<typename ServerT::OutMessage>;
+
+			void setConfig(const ClientQueueConfig& config) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_config = config;
+			}
+			ClientQueueConfig getConfig() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_config;
+			}
+
+			void add(ConnectionRef connection) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_clients[connection].needsResync = true;
+			}
+			void remove(ConnectionRef connection) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_clients.erase(connection);
+			}
+
+			size_t size() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_clients.size();
+			}
+			size_t getPendingCount() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				size_t count = 0;
+				for (auto&& client : m_clients)
+					count += client.second.queue.size();
+				return count;
+			}
+			size_t getDroppedCount() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_droppedCount;
+			}
+
+			void broadcast(const ci::Json& json) {
+				if (json.is_null())
+					return;
+
+				auto message = serialise(json);
+				auto key = coalesceKey(json);
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (auto&& [connection, client] : m_clients)
+					enqueue(connection, client, message, key);
+			}
+
+			/** @brief sends the state of describeFn to the new and the lagging clients, describeFn is only called if there are any */
+			void resync(std::function<ci::Json()> describeFn) {
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					bool needsResync = false;
+					for (auto&& client : m_clients)
+						needsResync |= client.second.needsResync;
+					if (!needsResync)
+						return;
+				}
+
+				auto message = serialise(describeFn());
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (auto&& [connection, client] : m_clients) {
+					if (!client.needsResync)
+						continue;
+
+					// the full state supersedes whatever is still pending
+					client.queue.clear();
+					client.bytes		= 0;
+					client.needsResync	= false;
+					enqueue(connection, client, message, "");
+				}
+			}
+
+		private:
+			struct Pending {
+				OutMessageRef	message;
+				std::string		key;
+			};
+
+			struct Client {
+				std::deque<Pending>	queue;
+				size_t				bytes		= 0;
+				bool				isSending	= false;
+				bool				isClosing	= false;
+				bool				needsResync	= false;
+			};
+
+			std::mutex							m_mutex;
+			std::map<ConnectionRef, Client>		m_clients;
+			ClientQueueConfig					m_config;
+			size_t								m_droppedCount = 0;
+
+			static OutMessageRef serialise(const ci::Json& json) {
+				auto message = std::make_shared<typename ServerT::OutMessage>();
+				*message << json.dump();
+				return message;
+			}
+
+			/** @brief updates of the same fields of a node replace each other, everything else is kept in order */
+			static std::string coalesceKey(const ci::Json& json) {
+				if (!json.is_object() || !json.contains("data") || !json["data"].is_object())
+					return "";
+
+				std::string method = json.value("method", "");
+				if (method != "update" && method != "subscribe")
+					return "";
+
+				const auto& data = json["data"];
+				if (!data.contains("uid"))
+					return "";
+
+				std::string key = json.value("type", "") + "|" + method;
+				for (auto it = data.begin(); it != data.end(); ++it) {
+					key += "|" + it.key();
+					if (it.key() == "uid" || it.key() == "valueName")
+						key += "=" + it.value().dump();
+					else if (it.key() == "params" && it.value().is_object())
+						for (auto param = it.value().begin(); param != it.value().end(); ++param)
+							key += "." + param.key();
+				}
+				return key;
+			}
+
+			void enqueue(const ConnectionRef& connection, Client& client, const OutMessageRef& message, const std::string& key) {
+				if (client.isClosing || client.needsResync)
+					return; // nothing to add, it gets the full state anyway
+
+				size_t size = message->size();
+				if (m_config.policy == QP_COALESCE && !key.empty()) {
+					for (auto&& pending : client.queue) {
+						if (pending.key != key)
+							continue;
+						client.bytes	+= size - pending.message->size();
+						pending.message	 = message;
+						return;
+					}
+				}
+
+				if (client.queue.size() >= m_config.maxPending || client.bytes + size > m_config.maxBytes) {
+					m_droppedCount += client.queue.size() + 1;
+					client.queue.clear();
+					client.bytes = 0;
+
+					if (m_config.policy == QP_DISCONNECT) {
+						client.isClosing = true;
+						connection->send_close(1008, "too slow");
+					}
+					else {
+						client.needsResync = true;
+					}
+					return;
+				}
+
+				client.queue.push_back({ message, key });
+				client.bytes += size;
+				if (!client.isSending)
+					sendNext(connection, client);
+			}
+
+			void sendNext(const ConnectionRef& connection, Client& client) {
+				if (client.queue.empty() || client.isClosing)
+					return;
+
+				auto message = client.queue.front().message;
+				client.bytes -= message->size();
+				client.queue.pop_front();
+				client.isSending = true;
+
+				std::weak_ptr<Connection> weakConnection = connection;
+				connection->send(message, [this, weakConnection](const SimpleWeb::error_code& ec) {
+					auto connection = weakConnection.lock();
+					if (!connection)
+						return;
+
+					std::lock_guard<std::mutex> lock(m_mutex);
+					auto it = m_clients.find(connection);
+					if (it == m_clients.end())
+						return;
+
+					it->second.isSending = false;
+					if (!ec)
+						sendNext(connection, it->second);
+				});
+			}
+		};
+
+	}
+}
@@ -21,6 +21,9 @@
 #include "ModuleRegistry.hpp"
 #include "server_wss.hpp"
 #include "Connection.hpp"
+#include "WebSocketClients.hpp"
+
+#include <mutex>
 
 using namespace ci;
 
@@ -45,10 +48,13 @@ namespace act {
 			ci::Json			toJson();
 			void				fromJson(ci::Json json);
 
-			void				sendMsg(ci::Json msg);
+			void				sendMsg(ci::Json msg) override;
+			std::string			getCurrentStatus() override;
 
 			bool				isConnected() { return m_isConnected; }
 
+			void				setQueueConfig(const ClientQueueConfig& config) { m_clients.setConfig(config); }
+
 		private:
 			MsgRecieverRef		m_reciever;
 
@@ -57,6 +63,11 @@ namespace act {
 			unsigned int		m_port;
 			bool				m_isConnected;
 
+			WebSocketClients<WssServer>	m_clients;
+
+			std::mutex				m_inboxMutex;
+			std::vector<ci::Json>	m_inbox;	// parsed on the I/O thread, handled on the main thread
+
 			std::string			m_text;
 			
 			void				recieveJson(ci::Json json);
@@ -19,15 +19,25 @@
 
 #include "ModuleBase.hpp"
 #include "ModuleRegistry.hpp"
-#include "WebSocketServer.h"
+#include "server_ws.hpp"
 #include "Connection.hpp"
+#include "WebSocketClients.hpp"
+
+#include <thread>
+#include <mutex>
 
 using namespace ci;
 
 
 namespace act {
 	namespace net {
+		using WsServer = SimpleWeb::SocketServer<SimpleWeb::WS>;
+		using WsServerRef = std::shared_ptr<WsServer>;
 
+		/**
+		* @brief plain WebSocket server for the WebUI, running on its own I/O thread
+		* incoming messages are handed to the main thread by update(), outgoing ones are queued per client
+		*/
 		class WebUIServer : public ConnectionProvider, public UniqueIDBase
 		{
 		public:
@@ -43,19 +53,30 @@ namespace act {
 			ci::Json		toJson();
 			void				fromJson(ci::Json json);
 
-			void				sendMsg(ci::Json msg);
+			void				sendMsg(ci::Json msg) override;
+			std::string			getCurrentStatus() override;
 
 			bool				isConnected() { return m_isConnected; }
 
+			void				setQueueConfig(const ClientQueueConfig& config) { m_clients.setConfig(config); }
+
 		private:
 			MsgRecieverRef		m_reciever;
 
-			WebSocketServer		m_server;
+			WsServerRef			m_server;
+			std::thread			m_serverThread;
 			unsigned int		m_port;
 			bool				m_isConnected;
 
-			std::string			m_text;
+			WebSocketClients<WsServer>	m_clients;
+
+			std::mutex				m_inboxMutex;
+			std::vector<ci::Json>	m_inbox;	// parsed on the I/O thread, handled on the main thread
+
+			std::mutex			m_textMutex;
+			std::string			m_text;		// set on the I/O thread, drawn on the main thread
 			
+			void				setText(const std::string& text);
 			void				recieveJson(ci::Json json);
 
 
@@ -0,0 +1,84 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "ProcNodeBase.hpp"
+#include "actionspace/ActionspaceRoomNode.hpp"
+#include "pointcloud/PointcloudRoomNode.hpp"
+#include "pointcloud/PointcloudOctree.hpp"
+
+using namespace ci;
+using namespace ci::app;
+
+
+namespace act {
+	namespace proc {
+
+		/**
+		* @brief enter and exit events of an actionspace room node
+		* a list of positions (e.g. bodies) is tested in one batch, their indices are sent when they enter or leave;
+		* room nodes that enter or leave are sent by name; a pointcloud is counted by an octree, pruned by the actionspace's bounds
+		*/
+		class ActionspaceTriggerProcNode : public ProcNodeBase
+		{
+		public:
+			ActionspaceTriggerProcNode();
+			~ActionspaceTriggerProcNode();
+
+			PROCNODECREATE(ActionspaceTriggerProcNode);
+
+			void setup(act::room::RoomManagers)	override;
+			void update()							override;
+			void draw()								override;
+
+			ci::Json toParams() override;
+			void fromParams(ci::Json json) override;
+
+		private:
+			OutputPortRef<bool>					m_insidePort;
+			OutputPortRef<number>				m_countPort;
+			OutputPortRef<std::vector<number>>	m_enteredPort;
+			OutputPortRef<std::vector<number>>	m_exitedPort;
+			OutputPortRef<std::string>			m_nodeEnteredPort;
+			OutputPortRef<std::string>			m_nodeExitedPort;
+			OutputPortRef<number>				m_pointsPort;
+			OutputPortRef<bool>					m_occupiedPort;
+
+			float					m_actorRadius = 0.0f;	// positions are points if 0
+			int						m_count = 0;
+
+			std::vector<uint8_t>	m_inside;				// per index of the last list
+			std::vector<uint8_t>	m_result;
+			std::vector<float>		m_radii;
+			std::vector<number>		m_entered;
+			std::vector<number>		m_exited;
+
+			room::PointcloudOctree	m_octree;
+			int						m_points = 0;
+			int						m_minPoints = 50;		// inside to count as occupied
+			bool					m_isOccupied = false;
+
+			room::ActionspaceRoomNodeRef	m_actionspaceRoomNode;
+			room::ActionspaceManagerRef		m_actionspaceMgr;
+
+			void test(const std::vector<vec3>& positions);
+			void testPointcloud(const room::Pointcloud& pointcloud);
+
+		}; using ActionspaceTriggerProcNodeRef = std::shared_ptr<ActionspaceTriggerProcNode>;
+
+	}
+}
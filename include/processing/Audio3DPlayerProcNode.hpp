@@ -85,8 +85,10 @@ namespace act {
 			void setPlaySpeed(float speed);
 
 			void loadSound(std::filesystem::path path);
+			void onSoundLoaded();
 			bool m_isOpenDialog;
 			bool m_isPlaying;
+			bool m_isPlayPending = false;	// play() while the sound is decoded
 			bool m_isCollapsed  = false;
 			bool m_showWaveform = false;
 		};
@@ -19,6 +19,8 @@
 
 #include "ProcNodeBase.hpp"
 
+#include <array>
+
 using namespace ci;
 using namespace ci::app;
 
@@ -49,9 +51,11 @@ namespace act {
 			OutputPortRef<float>	m_globalMovementPort;
 			OutputPortRef<audio::NodeRef>	m_audioOutPort;
 			
-			float calcLocalMovement(room::BodyRef body);
-			float calcGlobalMovement(room::BodyRef body);
-			float calcHandDistance(room::BodyRef body);
+			using Joints = std::array<vec3, room::BJT_COUNT>;
+
+			float calcLocalMovement(const Joints& joints);
+			float calcGlobalMovement(const Joints& joints);
+			float calcHandDistance(const Joints& joints);
 			float calcVelocity(vec3 last, vec3 current);
 
 			float m_localMovement;
@@ -76,7 +80,9 @@ namespace act {
 			int m_modStrength = 500;
 			float m_volume = 0.0f;
 
-			room::BodyRef m_oldBody;
+			Joints	m_joints;
+			Joints	m_oldJoints;
+			bool	m_hasOldJoints;
 			float   m_scaleValue;
 
 			audio::GenTriangleNodeRef m_osc;
@@ -18,6 +18,8 @@
 #pragma once
 
 #include "ProcNodeBase.hpp"
+#include "AssetManager.hpp"
+#include <opencv2/objdetect/face.hpp>
 
 using namespace ci;
 using namespace ci::app;
@@ -26,6 +28,24 @@ using namespace ci::app;
 namespace act {
 	namespace proc {
 
+		/**
+		* @brief sent as context of the face rects, they are sent right before the face image of the same frame,
+		* so a receiver can pair them with that image or with the frame itself and map the rects into it
+		*/
+		class FaceRectsContext : public PortContext {
+		public:
+			FaceRectsContext(cv::UMat frame, cv::Rect imageRect, cv::Size imageSize)
+				: frame(frame), imageRect(imageRect), imageSize(imageSize) {};
+
+			cv::UMat	frame;		// the rects are in pixels of this frame, its buffer identifies it
+			cv::Rect	imageRect;	// area of the frame sent as face image, empty if none is sent
+			cv::Size	imageSize;	// size of the sent face image
+		}; using FaceRectsContextRef = std::shared_ptr<FaceRectsContext>;
+
+		/**
+		* @brief detect-then-track: a full detection runs every n frames or when a face got lost,
+		* in between every face is followed by template matching inside the ROI predicted from its motion
+		*/
 		class FaceDetectionProcNode : public ProcNodeBase
 		{
 		public:
@@ -34,6 +54,7 @@ namespace act {
 
 			PROCNODECREATE(FaceDetectionProcNode);
 
+			void setup(act::room::RoomManagers)	override;
 			void update()			override;
 			void draw()				override;
 
@@ -56,13 +77,33 @@ namespace act {
 			int		m_faceAvailHistoryThreshold;
 			std::deque<int> m_faceAvailHistory;
 
-			cv::CascadeClassifier					mFaceCascade;
+			util::AssetFuture<cv::CascadeClassifier>	m_faceCascade;	// shared by all FaceDetection nodes
 			std::vector<ci::Rectf>					mFaces;
 			std::deque<std::vector<ci::Rectf>>		mFacesHistory;
 			int										mFaceHistorySize;
 
+			struct FaceTrack {
+				cv::Rect2f	rect;		// in resized pixels
+				cv::Point2f	velocity;	// in resized pixels per frame
+				cv::UMat	templ;		// grey patch of the last match
+			};
+			std::vector<FaceTrack>					m_tracks;
+			int										m_detectionInterval;	// in frames
+			int										m_framesSinceDetection;
+			bool									m_hasLostTrack;
+			float									m_trackThreshold;		// min. normalized correlation to keep a track
+
+			bool									m_isUsingDNN;
+			util::AssetFuture<cv::FaceDetectorYN>	m_dnnDetector;	// one per node, it keeps the input size
+
+			std::vector<cv::Rect>	detectFaces(cv::UMat mat, cv::UMat gray);
+			void					trackFaces(cv::UMat gray);
+			void					resetTracks(const std::vector<cv::Rect>& faces, cv::UMat gray);
+			void					loadDNN();
+
 			ImageOutputPortRef	m_faceImagePort;
 			OutputPortRef<bool>		m_faceAvailablePort;
+			OutputPortRef<numberList>	m_faceRectsPort;
 
 		}; using FaceDetectionProcNodeRef = std::shared_ptr<FaceDetectionProcNode>;
 
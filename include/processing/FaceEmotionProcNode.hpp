@@ -19,6 +19,8 @@
 #pragma once
 
 #include "ProcNodeBase.hpp"
+#include "AssetManager.hpp"
+#include "FaceDetectionProcNode.hpp"
 #include <opencv2/dnn/dnn.hpp>
 
 using namespace ci;
@@ -36,10 +38,12 @@ namespace act {
 
 			PROCNODECREATE(FaceEmotionProcNode);
 
+			void setup(act::room::RoomManagers)	override;
 			void update()			override;
 			void draw()				override;
 
 			void onMat(cv::UMat event);
+			void onFaceRects(numberList rects, PortContextRef context);
 
 		private:
 			ci::gl::Texture2dRef												m_texture;
@@ -48,20 +52,33 @@ namespace act {
 
 			ImageOutputPortRef												m_imagePort;
 			OutputPortRef<std::pair<std::string, float>>						m_emotionPort;
+			OutputPortRef<featureList>											m_emotionsPort;
+
+			bool																m_hasFaceRects = false;	// while connected, faces are taken from the rects
+			bool																m_isFaceRectsPending = false;	// rects not yet paired with an image
+			std::vector<cv::Rect>												m_faceRects;		// in pixels of the frame of the context
+			FaceRectsContextRef													m_faceRectsContext;	// nullptr if the rects are in image pixels
+			cv::UMat															m_waitingImage;		// came before the rects of its frame
+			bool																m_isBatching = true;	// false if the network only takes single images
 
 			static bool															m_registered;
 
 			bool																m_show = false;
 
 			std::vector<std::string>											m_emotions;
-			cv::dnn::Net														m_network;
+			cv::dnn::Net														m_network;		// empty until the shared one is loaded
+			util::AssetFuture<cv::dnn::Net>										m_networkAsset;
 
 			std::pair<std::string, float>										m_currentEmotion;
 		
 			cv::Mat																detectCurrentEmotions(cv::UMat frame);
+			bool																mapFaceRects(cv::UMat image, std::vector<cv::Rect>& faces); // false if the image is neither the frame nor the face image of the rects
+			void																sendEmotion(cv::UMat image);
+			bool																sendEmotionsPerFace(cv::UMat image); // false if the pending rects do not belong to the image
+			cv::Mat																detectCurrentEmotions(cv::UMat frame, const std::vector<cv::Rect>& faces, std::vector<size_t>& faceOfRow); // one row per face inside the frame, single forward pass
 			std::pair<std::string, float>										getCurrentEmotion(std::vector<float> result);
 
-			std::vector<float>													softmax(cv::Mat* mat);
+			std::vector<float>													softmax(cv::Mat* mat, int row = 0);
 
 		}; using FaceEmotionProcNodeRef = std::shared_ptr<FaceEmotionProcNode>;
 
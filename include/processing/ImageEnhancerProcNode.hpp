@@ -28,6 +28,10 @@ using namespace ci::app;
 namespace act {
 	namespace proc {
 
+		/**
+		* @brief resize, crop, tilt and flip are planned into one remap, luminance work is done on the L channel only,
+		* all intermediate images are kept, so a steady stream does not allocate
+		*/
 		class ImageEnhancerProcNode : public ProcNodeBase
 		{
 		public:
@@ -71,6 +75,28 @@ namespace act {
 			cv::Ptr<cv::CLAHE> m_clahe;
 			int m_claheClip;
 
+			cv::UMat&	enhance(cv::UMat image);
+			void		planGeometry(cv::Size inputSize);
+			void		prepare(cv::UMat& buffer, cv::Size size, int type);
+			void		benchmark(int frames = 300);
+
+			// planned geometry, rebuilt if the input size or a geometric parameter changes
+			cv::Size	m_plannedInputSize;
+			std::tuple<float, float, float, float, float, bool, bool, bool, bool> m_plannedGeometry;
+			cv::Size	m_outputSize;
+			cv::UMat	m_map1, m_map2;
+
+			// persistent scratch buffers
+			cv::UMat	m_geometry;
+			cv::UMat	m_gray;
+			cv::UMat	m_lab;
+			cv::UMat	m_luma;
+			cv::UMat	m_lumaEqualized;
+			cv::UMat	m_blurred;
+			cv::UMat	m_outputs[2];	// sent, so never scratch
+			int			m_outputIndex = 0;
+			int			m_allocations = 0;
+
 		}; using ImageEnhancerProcNodeRef = std::shared_ptr<ImageEnhancerProcNode>;
 
 	}
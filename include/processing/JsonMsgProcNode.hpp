@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ProcNodeBase.hpp"
+#include "PreviewStream.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -36,12 +37,12 @@ namespace act {
 
 			void update()			override;
 			void draw()				override;
-
-			ci::Json toParams() override;
-			void fromParams(ci::Json json) override;
 			
 		private:
 			std::string m_msgName;
+			PreviewSettings	m_previewSettings;
+			PreviewStream	m_preview;		// images are sent from update(), once they are encoded
+			std::string		m_previewBase64;
 			OutputPortRef<ci::Json>	m_jsonPort;
 			std::vector<PortBaseRef> m_allInputPorts;
 
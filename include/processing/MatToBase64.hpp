@@ -27,6 +27,12 @@ typedef unsigned char BYTE;
 
 std::string base64_encode(BYTE const* buf, unsigned int bufLen);
 std::vector<BYTE> base64_decode(std::string const&);
+/** @brief into out, its capacity is reused */
+void base64_encode(BYTE const* buf, size_t bufLen, std::string& out);
+void base64_decode(std::string const&, std::vector<BYTE>& out);
+
+/** @brief .jpg and .webp are encoded with quality, buf is reused */
+bool encodeImage(const cv::Mat& imgMat, cv::String ext, int quality, std::vector<uchar>& buf);
 
 std::string  surface8uToBase64(ci::Surface8u imgSurface8u, cv::String ext);
 std::string  matToBase64(cv::Mat imgMat, cv::String ext, int quality = 70, bool scale = false, int newWidth = 1280);
@@ -19,6 +19,7 @@
 
 #include "ProcNodeBase.hpp"
 #include "cinder/Rand.h"
+#include "filter/WindowFilter.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -46,6 +47,10 @@ namespace act {
 			std::deque<float> m_history;
 			std::deque<float> m_rawHistory;
 
+			windowfilter::RunningMean<float>	m_mean;
+			windowfilter::MovingMin<float>		m_rawMin;
+			windowfilter::MovingMax<float>		m_rawMax;
+
 			int m_historySize;
 			float m_meanNumber;
 
@@ -61,6 +66,8 @@ namespace act {
 			bool  m_doMap;
 
 			void onNumber(float number);
+			void setHistorySize(int size);
+			void benchmark(int samples = 1000000);
 
 		}; using NumberEnhancerProcNodeRef = std::shared_ptr<NumberEnhancerProcNode>;
 
@@ -54,6 +54,10 @@ namespace act {
 			std::string					m_text;
 			bool						m_isRunning;
 
+			bool						m_isBundling	= true;		// messages of one update are sent as bundles
+			int							m_maxPacketSize	= 1400;
+			float						m_delay			= 0.0f;		// in s, received messages are timetagged into the future
+
 			void						initialize();
 
 		}; 
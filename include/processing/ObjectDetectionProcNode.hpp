@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ProcNodeBase.hpp"
+#include "AssetManager.hpp"
 #include <opencv2/dnn/dnn.hpp>
 
 using namespace ci;
@@ -35,6 +36,7 @@ namespace act {
 
 			PROCNODECREATE(ObjectDetectionProcNode);
 
+			void setup(act::room::RoomManagers)	override;
 			void update()			override;
 			void draw()				override;
 
@@ -54,7 +56,13 @@ namespace act {
 
 			bool								m_show;
 
-			void								initNetwork();
+			struct Model {
+				cv::dnn::Net				network;
+				std::vector<std::string>	classes;
+				std::string					outputLayer;
+			};
+			util::AssetFuture<Model>			m_model;	// one per node, it is run on the node's own thread
+			static std::shared_ptr<Model>		loadModel(std::string classesFile, std::string cfgFile, std::string weightsFile);
 			featureList							m_currentObjects;
 
 			cv::dnn::Net						m_network;
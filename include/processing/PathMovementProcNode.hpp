@@ -9,7 +9,7 @@
 	Licensed under the MIT License.
 	See LICENSE file in the project root for full license information.
 
-	This file is created and substantially modified: 2024
+	This file is created and substantially modified: 2024-2025
 
 	contributors:
 	Lars Engeln - mail@lars-engeln.de
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ProcNodeBase.hpp"
+#include "position/PositionRoomNode.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -26,6 +27,10 @@ using namespace ci::app;
 namespace act {
 	namespace proc {
 
+		/**
+		* @brief moves along a path room node at constant speed, the path is looked up by arc length
+		* a list of positions on the path is evaluated in one go, e.g. for many followers
+		*/
 		class PathMovementProcNode : public ProcNodeBase
 		{
 		public:
@@ -34,8 +39,9 @@ namespace act {
 
 			PROCNODECREATE(PathMovementProcNode);
 
-			void update()			override;
-			void draw()				override;
+			void setup(act::room::RoomManagers)	override;
+			void update()							override;
+			void draw()								override;
 
 			ci::Json toParams() override;
 			void fromParams(ci::Json json) override;
@@ -43,14 +49,28 @@ namespace act {
 			vec3 getPosition() { return m_position; };
 
 		private:
-			OutputPortRef<vec3>	m_positionPort;
+			OutputPortRef<vec3>					m_positionPort;
+			OutputPortRef<std::vector<vec3>>	m_positionsPort;
+			OutputPortRef<vec3>					m_snappedPort;
+			OutputPortRef<number>				m_snappedAtPort;
 			vec3 m_position;
 
-			std::vector<ci::vec3> m_points;
+			float	m_distance	= 0.0f;	// along the path
+			float	m_speed		= 0.0f;	// m/s, travels on its own if not 0
+			double	m_lastTime	= 0.0;
+
+			std::vector<float>	m_distances;
+			std::vector<vec3>	m_positions;
+
+			room::PositionRoomNodeRef	m_pathRoomNode;
+			room::PositionManagerRef	m_posMgr;
 
 			void evaluate(float t);
+			void evaluateAtDistance(float distance);
+			void evaluateList(std::vector<number> ts);
+			void snap(vec3 position);
 
 		}; using PathMovementProcNodeRef = std::shared_ptr<PathMovementProcNode>;
 
 	}
-}
\ No newline at end of file
+}
@@ -27,6 +27,9 @@ using namespace ci::app;
 #include <opencv2/opencv.hpp>
 
 #include "pointcloud/PointcloudRoomNode.hpp"
+#include "pointcloud/PointcloudFilter.hpp"
+#include "pointcloud/PointcloudOctree.hpp"
+#include "kinect/KinectRecording.hpp"
 
 namespace act {
 	namespace proc {
@@ -56,15 +59,24 @@ namespace act {
 
 			cv::UMat m_colorImageCache;
 			cv::UMat m_depthImageCache;
-			ci::vec2 m_fov;
+			ci::vec2 m_fov = ci::vec2(90.0f, 74.3f);	// in degree
 			act::room::Pointcloud m_pointcloud = nullptr;
+			std::vector<glm::vec3> m_unprojected;
+			std::vector<glm::vec3> m_downsampled;
 
 			act::room::PointcloudRoomNodeRef m_pointcloudRoomNode;
 
-			int m_threshold = 50;
-			float m_boxSize = 0.35;
+			int m_threshold = 50;		// neighbors of the outlier removal, 0 disables it
+			float m_boxSize = 0.05f;	// voxel size in meter, 0 disables downsampling
+			float m_depthRange = 5.0f;	// meter at 255 of 8 bit depth images, 16 bit ones are in millimeter
 
 			void createPointcloud(cv::UMat depthImage, cv::UMat colorImage);
+			void filterDepth(const cv::Mat& depth, std::vector<glm::vec3>& result);	// unprojects, downsamples and removes outliers
+
+			/**
+			* @brief times the filtering of the last depth image and pointcloud of an .iarec recording, nothing is sent
+			*/
+			void benchmark(const fs::path& path, int frames = 100);
 		};
 
 		using PointcloudProcNodeRef = std::shared_ptr<PointcloudProcNode>;
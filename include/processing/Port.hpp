@@ -35,7 +35,7 @@ namespace act {
 		class PortContext {
 		public:
 			PortContext() {};
-			~PortContext() {};
+			virtual ~PortContext() {};
 		};
 		using PortContextRef = std::shared_ptr<PortContext>; // std::shared_ptr<void>;
 
@@ -114,6 +114,18 @@ namespace act {
 				return disconnected;
 			}
 
+			// called on the listening side, the callbacks of an input fire with its first and last source
+			void onSourceConnected() {
+				m_sourceCount++;
+				if (m_sourceCount == 1)
+					m_onConnectionCB();
+			}
+			void onSourceDisconnected() {
+				m_sourceCount--;
+				if (m_sourceCount == 0)
+					m_onDisconnectionCB();
+			}
+
 			virtual void send(T data, K context = nullptr) {
 				if (!isEnabled())
 					return;
@@ -138,6 +150,7 @@ namespace act {
 			std::function<void()> m_onConnectionCB = []() {};
 			std::function<void()> m_onDisconnectionCB = []() {};
 
+			int		m_sourceCount = 0;
 			bool	m_hasCachedData = false;
 			T		m_cachedData;
 			K		m_cachedDataContext;
@@ -157,6 +170,7 @@ namespace act {
 					if(m_hasCachedData)
 						p->recieve(m_cachedData, m_cachedDataContext);
 					m_ports.push_back(p);
+					p->onSourceConnected();
 
 					return true;
 				}
@@ -173,6 +187,7 @@ namespace act {
 						return false;
 
 					m_ports.erase(std::remove(m_ports.begin(), m_ports.end(), p), m_ports.end());
+					p->onSourceDisconnected();
 					return true;
 				}
 				return false;
@@ -0,0 +1,60 @@
+
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "CinderOpenCV.h"
+
+namespace act {
+	namespace proc {
+
+		struct PreviewSettings {
+			int		maxWidth	= 1280;		// wider images are scaled down
+			float	maxRate		= 0.0f;		// frames per second, further frames are dropped; not limited if 0
+			int		quality		= 85;
+			bool	isWebP		= false;	// jpg otherwise
+		};
+
+		struct PreviewState;
+
+		/**
+		* @brief encodes images to base64 for a live preview, off the main thread
+		* submit() only drops frames above the rate and scales the image down into a reused buffer, the encoding is done on the shared preview thread.
+		* a frame still waiting for the encoder is replaced by the newer one, take() hands out the latest encoded frame once
+		*/
+		class PreviewStream
+		{
+		public:
+			PreviewStream();
+
+			/** @brief returns false if the frame is dropped */
+			bool submit(const cv::UMat& image);
+			/** @brief swaps the latest encoded frame into base64, returns false if there is no new one */
+			bool take(std::string& base64);
+
+			void			setSettings(const PreviewSettings& settings);
+			PreviewSettings	getSettings();
+
+		private:
+			std::shared_ptr<PreviewState> m_state;
+		};
+
+	}
+}
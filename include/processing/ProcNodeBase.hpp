@@ -21,6 +21,7 @@
 #include "procpch.hpp"
 
 #include "PortMsg.hpp"
+#include "ParamSet.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -34,7 +35,8 @@ namespace act {
 			NDS_ERROR = -1,
 			NDS_UNKNOWN = 0,
 			NDS_ACTIVE,
-			NDS_INACTIVE
+			NDS_INACTIVE,
+			NDS_LOADING		// resources are still loaded in the background
 		};
 
 		enum ProcNodeType {
@@ -198,10 +200,13 @@ namespace act {
 			virtual void setIsHovered(bool isHovered) { m_isHovered = isHovered; }
 			virtual void setIsSelected(bool isSelected) { m_isSelected = isSelected; }
 
-			virtual ci::Json toParams() { return ci::Json::object(); };
-			virtual void fromParams(ci::Json json) {};
+			virtual ci::Json toParams() { return m_params.toJson(); };
+			virtual void fromParams(ci::Json json) { m_params.fromJson(json); };
 			ci::Json getJsonTypeDefinition();
 
+			/** @brief the declared params changed since the last call, by the GUI or by fromParams */
+			ci::Json takeParamChanges() { return m_params.takeChanges(); };
+
 			void preventDrag(bool prevent) {
 				ImNodes::SetNodeDraggable(m_id, !prevent);
 			}
@@ -219,6 +224,7 @@ namespace act {
 
 			unsigned int m_errorNodeColor			= IM_COL32(util::Design::errorColor().r * 255, util::Design::errorColor().g * 255, util::Design::errorColor().b * 255, 255);
 			unsigned int m_darkErrorNodeColor		= IM_COL32(util::Design::darkErrorColor().r * 255, util::Design::darkErrorColor().g * 255, util::Design::darkErrorColor().b * 255, 255);
+			unsigned int m_loadingNodeColor			= IM_COL32(util::Design::grayColor().r * 255, util::Design::grayColor().g * 255, util::Design::grayColor().b * 255, 255);
 			unsigned int m_darkprocessingNodeColor	= IM_COL32(util::Design::darkPrimaryColor().r * 255, util::Design::darkPrimaryColor().g * 255, util::Design::darkPrimaryColor().b * 255, 255);
 			unsigned int m_processingNodeColor		= IM_COL32(util::Design::primaryColor().r * 255, util::Design::primaryColor().g * 255, util::Design::primaryColor().b * 255, 255);
 			unsigned int m_inputNodeColor			= IM_COL32(util::Design::primaryColor().g * 255, util::Design::primaryColor().r * 255, util::Design::primaryColor().b * 255, 255);
@@ -228,6 +234,12 @@ namespace act {
 			std::vector<PortBaseRef> m_inputPorts;
 			std::vector<PortBaseRef> m_outputPorts;
 
+			util::ParamSet			m_params; // declared in the constructor, toParams and fromParams are derived from it
+
+			void drawParams(float width = 0.0f) {
+				preventDrag(m_params.draw(width));
+			}
+
 
 			InputPortRef<ci::Json>					createJsonInput			(std::string label, std::function<void(ci::Json)> cb, bool display = true)				{ auto port = InputPort<ci::Json>::create(PT_JSON, label, cb);						if (display) m_inputPorts.push_back(port); return port; }
 			InputPortRef<bool>						createBoolInput			(std::string label, std::function<void(bool)> cb, bool display = true)					{ auto port = InputPort<bool>::create(PT_BOOL, label, cb);							if (display) m_inputPorts.push_back(port); return port; }
@@ -28,13 +28,33 @@ namespace act {
 		public:
 			using nodeCreateFunc = std::shared_ptr<act::proc::ProcNodeBase>(*)();
 
+			/**
+			* @brief everything known about a node type without keeping a node of it,
+			* the definition (inputs, outputs, rpcs, params, group) is filled once on request by a prototype that is never set up
+			*/
+			struct NodeType {
+				std::string		group;
+				std::string		name;
+				nodeCreateFunc	create;
+				ci::Json		definition;
+				bool			isDescribed = false;
+			};
+
 		public:
 			ProcNodeRegistry();
 
+			template<typename T>
+			bool add(std::string group, const std::string name) {
+				static_assert(std::is_base_of_v<act::proc::ProcNodeBase, T>, "only ProcNodes can be registered");
+				return add(group, name, &T::create);
+			}
 			bool add(std::string group, const std::string name, act::proc::ProcNodeRegistry::nodeCreateFunc createFunc);
 
 			std::shared_ptr<act::proc::ProcNodeBase> create(const std::string& name);
 
+			ci::Json getTypeDefinition(const std::string& name);
+			ci::Json getTypeDefinitions(); // nodeName -> definition of all registered types
+
 			std::map<std::string, act::proc::ProcNodeRegistry::nodeCreateFunc>& getMap() {
 				return m_nodeCreateMap;
 			}
@@ -45,6 +65,9 @@ namespace act {
 		private:
 			std::map<std::string, act::proc::ProcNodeRegistry::nodeCreateFunc> m_nodeCreateMap; // nodeName -> ::create()
 			std::map<std::string, std::vector<std::string>> m_groupMap; // groupName -> [nodeName]s
+			std::map<std::string, NodeType> m_types; // nodeName -> NodeType
+
+			void describe(NodeType& type);
 		};
 
 	}
@@ -19,122 +19,593 @@
 
 #include "stddef.hpp"
 #include "cinder/gl/gl.h"
+#include "MeshBVH.hpp"
+
+#include <algorithm>
 
 namespace act {
 	namespace room {
+
+		enum BoundingType {
+			BT_SPHERE,
+			BT_BOX,			// axis-aligned
+			BT_ORIENTED_BOX,
+			BT_CYLINDER,
+			BT_CAPSULE,
+			BT_CONVEX,
+			BT_MESH
+		};
 		
+		/**
+		* @brief volume placed by a rigid transform (position and orientation, no scale)
+		* the batched tests take SoA inputs and write 1 or 0 per entry to result
+		*/
 		class BoundingBase {
 		public:
-			BoundingBase(ci::vec3 position, ci::quat orientation) {
-				setPosition(position);
-				setOrientation(orientation);
+			BoundingBase(BoundingType type, ci::vec3 position, ci::quat orientation) 
+			: m_type(type) {
+				m_position		= position;
+				m_orientation	= glm::normalize(orientation);
+				updateTransform();
 			}
-			~BoundingBase() {}
+			virtual ~BoundingBase() {}
+
+			BoundingType	getType()								{ return m_type; }
 
 			ci::vec3		getPosition()							{ return m_position; }
 			virtual void	setPosition(ci::vec3 position)			{ m_position = position; updateTransform(); };
 			ci::quat		getOrientation()						{ return m_orientation; }
-			virtual void	setOrientation(ci::quat orientation)	{ m_orientation = orientation; updateTransform(); };
+			virtual void	setOrientation(ci::quat orientation)	{ m_orientation = glm::normalize(orientation); updateTransform(); };
 
 			virtual bool	contains(ci::vec3 pt) = 0;
 			virtual bool	intersects(ci::Ray ray) = 0;
+			virtual bool	intersectsSphere(ci::vec3 center, float radius) = 0;
+			virtual ci::AxisAlignedBox getWorldBounds() = 0;
 			virtual void	draw() = 0;
 
+			virtual void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) {
+								for (size_t i = 0; i < count; i++)
+									result[i] = contains(points[i]) ? 1 : 0;
+							}
+			virtual void	intersectsSpheres(const ci::vec3* centers, const float* radii, size_t count, uint8_t* result) {
+								for (size_t i = 0; i < count; i++)
+									result[i] = intersectsSphere(centers[i], radii[i]) ? 1 : 0;
+							}
+
 		protected:
+			BoundingType	m_type;
 			ci::vec3		m_position;
 			ci::quat		m_orientation;
 			ci::vec3		m_scalation;
 
 			ci::mat4		m_transform;
+			ci::mat3		m_rotation;		// columns are the local axes in world space
 			void updateTransform() {
 				m_transform = ci::translate(m_position) * glm::toMat4(m_orientation) * ci::scale(ci::vec3(1.0f));
+				m_rotation	= glm::toMat3(m_orientation);
 			}
+
+			// the transform is rigid, so the inverse is the transposed rotation and distances stay the same
+			ci::vec3	toLocal(ci::vec3 pt)	{ return (pt - m_position) * m_rotation; }
+			ci::vec3	toLocalDir(ci::vec3 dir){ return dir * m_rotation; }
+			ci::Ray		toLocal(ci::Ray ray)	{ return ci::Ray(toLocal(ray.getOrigin()), toLocalDir(ray.getDirection())); }
+			// a world length in local space, conservative (by the smallest axis) if the transform ever gets a non-uniform scale
+			float		toLocalLength(float length) {
+							float scale = std::min({ glm::length(ci::vec3(m_transform[0])), glm::length(ci::vec3(m_transform[1])), glm::length(ci::vec3(m_transform[2])) });
+							return scale > 0.0f ? length / scale : length;
+						}
+
 		}; using BoundingRef = std::shared_ptr<BoundingBase>;
 
 		class BoundingSphere : public BoundingBase {
 		public:
 			BoundingSphere(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 1.0f)
-			: BoundingBase(position, ci::quat(1.0f, 0.0f, 0.0f, 1.0f)) {
+			: BoundingBase(BT_SPHERE, position, ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
 				setRadius(radius);
 			};
 
 			static std::shared_ptr<BoundingSphere> create(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 1.0f) { return std::make_shared<BoundingSphere>(position, radius); };
 
 			float	getRadius() { return m_radius; }
-			void	setRadius(float radius) { m_radius = radius; m_radiusSq	= radius + radius; }
+			void	setRadius(float radius) { m_radius = radius; m_radiusSq	= radius * radius; }
 
 			bool	contains(ci::vec3 pt) override {
-						return glm::length(m_position - pt) <= m_radius;
+						return glm::distance2(m_position, pt) <= m_radiusSq;
 					}
 			bool	intersects(ci::Ray ray) override {
 						vec3 m = ray.getOrigin() - m_position;
+						float a = glm::dot(ray.getDirection(), ray.getDirection());
 						float b = glm::dot(m, ray.getDirection());
 						float c = glm::dot(m, m) - m_radiusSq;
 
 						// origin outside and r pointing away from s (b > 0) 
 						if (c > 0.0f && b > 0.0f) 
 							return false;
-						float discr = b * b - c;
+						float discr = b * b - a * c;
 						
 						// negative discriminant -> ray missing sphere 
 						if (discr < 0.0f) 
 							return false;
 
-						//float t = 0.0f;
-						// compute smallest t value of intersection
-						// t = -b - sqrt(discr);
-						// if t is negative, ray started inside sphere so clamp t to zero 
-						//if (t < 0.0f) t = 0.0f;
-						// vec3 intersection = ray.calcPosition(t);
 						return true;
 					};
+			bool	intersectsSphere(ci::vec3 center, float radius) override {
+						float r = m_radius + radius;
+						return glm::distance2(m_position, center) <= r * r;
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						return ci::AxisAlignedBox(m_position - vec3(m_radius), m_position + vec3(m_radius));
+					}
 			void	draw() override {
 						ci::gl::drawSphere(m_position, m_radius);
 					};
+
+			void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) override {
+						const vec3 c = m_position;
+						const float r2 = m_radiusSq;
+						for (size_t i = 0; i < count; i++) {
+							vec3 d = points[i] - c;
+							result[i] = d.x * d.x + d.y * d.y + d.z * d.z <= r2;
+						}
+					}
+			void	intersectsSpheres(const ci::vec3* centers, const float* radii, size_t count, uint8_t* result) override {
+						const vec3 c = m_position;
+						for (size_t i = 0; i < count; i++) {
+							vec3 d = centers[i] - c;
+							float r = m_radius + radii[i];
+							result[i] = d.x * d.x + d.y * d.y + d.z * d.z <= r * r;
+						}
+					}
 		private:
 			float	m_radius;
 			float	m_radiusSq;
 		};
 
+		/**
+		* @brief axis-aligned box around its position, the orientation is ignored
+		*/
+		class BoundingBox : public BoundingBase {
+		public:
+			BoundingBox(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), ci::vec3 size = vec3(1.0f, 1.0f, 1.0f))
+				: BoundingBase(BT_BOX, position, ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
+				setSize(size);
+			};
+
+			static std::shared_ptr<BoundingBox> create(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), ci::vec3 size = vec3(1.0f, 1.0f, 1.0f)) { return std::make_shared<BoundingBox>(position, size); };
+
+			ci::vec3	getSize() { return m_halfSize * 2.0f; }
+			ci::vec3	getHalfSize() { return m_halfSize; }
+			void		setSize(ci::vec3 size) { m_halfSize = glm::abs(size) * 0.5f; }
+
+			bool	contains(ci::vec3 pt) override {
+						return glm::all(glm::lessThanEqual(glm::abs(pt - m_position), m_halfSize));
+					}
+			bool	intersects(ci::Ray ray) override {
+						return intersectsSlabs(ray.getOrigin() - m_position, ray.getDirection(), m_halfSize);
+					}
+			bool	intersectsSphere(ci::vec3 center, float radius) override {
+						vec3 closest = glm::clamp(center, m_position - m_halfSize, m_position + m_halfSize);
+						return glm::distance2(closest, center) <= radius * radius;
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						return ci::AxisAlignedBox(m_position - m_halfSize, m_position + m_halfSize);
+					}
+			void	draw() override {
+						ci::gl::drawStrokedCube(m_position, m_halfSize * 2.0f);
+					};
+
+			void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) override {
+						const vec3 lo = m_position - m_halfSize;
+						const vec3 hi = m_position + m_halfSize;
+						for (size_t i = 0; i < count; i++) {
+							const vec3& p = points[i];
+							result[i] = (p.x >= lo.x) & (p.x <= hi.x) & (p.y >= lo.y) & (p.y <= hi.y) & (p.z >= lo.z) & (p.z <= hi.z);
+						}
+					}
+
+			/**
+			* @brief ray against a box of halfSize around the origin, the ray is relative to the box' center
+			*/
+			static bool intersectsSlabs(ci::vec3 origin, ci::vec3 direction, ci::vec3 halfSize) {
+						float tNear = 0.0f;
+						float tFar	= FLT_MAX;
+						for (int axis = 0; axis < 3; axis++) {
+							if (fabsf(direction[axis]) < FLT_EPSILON) {
+								if (fabsf(origin[axis]) > halfSize[axis])
+									return false;
+								continue;
+							}
+							float t0 = (-halfSize[axis] - origin[axis]) / direction[axis];
+							float t1 = ( halfSize[axis] - origin[axis]) / direction[axis];
+							if (t0 > t1)
+								std::swap(t0, t1);
+							tNear	= std::max(tNear, t0);
+							tFar	= std::min(tFar, t1);
+							if (tNear > tFar)
+								return false;
+						}
+						return true;
+					}
+		private:
+			ci::vec3	m_halfSize;
+		};
+
+		class BoundingOrientedBox : public BoundingBase {
+		public:
+			BoundingOrientedBox(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), ci::vec3 size = vec3(1.0f, 1.0f, 1.0f), ci::quat orientation = ci::quat(1.0f, 0.0f, 0.0f, 0.0f))
+				: BoundingBase(BT_ORIENTED_BOX, position, orientation) {
+				setSize(size);
+			};
+
+			static std::shared_ptr<BoundingOrientedBox> create(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), ci::vec3 size = vec3(1.0f, 1.0f, 1.0f), ci::quat orientation = ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) { return std::make_shared<BoundingOrientedBox>(position, size, orientation); };
+
+			ci::vec3	getSize() { return m_halfSize * 2.0f; }
+			ci::vec3	getHalfSize() { return m_halfSize; }
+			ci::mat3	getAxes() { return m_rotation; }
+			void		setSize(ci::vec3 size) { m_halfSize = glm::abs(size) * 0.5f; }
+
+			bool	contains(ci::vec3 pt) override {
+						return glm::all(glm::lessThanEqual(glm::abs(toLocal(pt)), m_halfSize));
+					}
+			bool	intersects(ci::Ray ray) override {
+						return BoundingBox::intersectsSlabs(toLocal(ray.getOrigin()), toLocalDir(ray.getDirection()), m_halfSize);
+					}
+			bool	intersectsSphere(ci::vec3 center, float radius) override {
+						vec3 local = toLocal(center);
+						vec3 closest = glm::clamp(local, -m_halfSize, m_halfSize);
+						return glm::distance2(closest, local) <= radius * radius;
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						return ci::AxisAlignedBox(-m_halfSize, m_halfSize).transformed(m_transform);
+					}
+			void	draw() override {
+						gl::pushMatrices();
+						gl::multModelMatrix(m_transform);
+						ci::gl::drawStrokedCube(vec3(0.0f), m_halfSize * 2.0f);
+						gl::popMatrices();
+					};
+
+			void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) override {
+						const vec3 c = m_position;
+						const vec3 ax = m_rotation[0], ay = m_rotation[1], az = m_rotation[2];
+						const vec3 h = m_halfSize;
+						for (size_t i = 0; i < count; i++) {
+							vec3 d = points[i] - c;
+							float x = d.x * ax.x + d.y * ax.y + d.z * ax.z;
+							float y = d.x * ay.x + d.y * ay.y + d.z * ay.z;
+							float z = d.x * az.x + d.y * az.y + d.z * az.z;
+							result[i] = (fabsf(x) <= h.x) & (fabsf(y) <= h.y) & (fabsf(z) <= h.z);
+						}
+					}
+		private:
+			ci::vec3	m_halfSize;
+		};
+
+		/**
+		* @brief upright cylinder standing on its position, the axis is the local y axis
+		*/
 		class BoundingCylinder : public BoundingBase {
 		public:
-			BoundingCylinder(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 1.0f)
-				: BoundingBase(position, ci::quat(1.0f, 0.0f, 0.0f, 1.0f)) {
+			BoundingCylinder(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 1.0f, float height = 1.0f)
+				: BoundingBase(BT_CYLINDER, position, ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
+				m_radius = radius;
+				m_height = height;
 				setRadius(radius);
-				m_triMesh = ci::TriMesh::create(ci::geom::Cylinder());
 			};
 
-			static std::shared_ptr<BoundingCylinder> create(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 1.0f) { return std::make_shared<BoundingCylinder>(position, radius); };
+			static std::shared_ptr<BoundingCylinder> create(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 1.0f, float height = 1.0f) { return std::make_shared<BoundingCylinder>(position, radius, height); };
 
 			float	getRadius() { return m_radius; }
-			void	setRadius(float radius) { m_radius = radius; m_radiusSq = radius + radius; }
+			void	setRadius(float radius) { m_radius = radius; m_radiusSq = radius * radius; updateMesh(); }
+			float	getHeight() { return m_height; }
+			void	setHeight(float height) { m_height = height; updateMesh(); }
 
 			bool	contains(ci::vec3 pt)	override {
-						return false;
+						vec3 local = toLocal(pt);
+						return local.y >= 0.0f && local.y <= m_height && local.x * local.x + local.z * local.z <= m_radiusSq;
 					}
 			bool	intersects(ci::Ray ray) override {
-						return false;
+						vec3 o = toLocal(ray.getOrigin());
+						vec3 d = toLocalDir(ray.getDirection());
+
+						// mantle, x^2 + z^2 = r^2 between the caps
+						float a = d.x * d.x + d.z * d.z;
+						float b = o.x * d.x + o.z * d.z;
+						float c = o.x * o.x + o.z * o.z - m_radiusSq;
+						if (a > FLT_EPSILON) {
+							float discr = b * b - a * c;
+							if (discr < 0.0f)
+								return false;
+							float root = sqrtf(discr);
+							for (float t : { (-b - root) / a, (-b + root) / a }) {
+								float y = o.y + t * d.y;
+								if (t >= 0.0f && y >= 0.0f && y <= m_height)
+									return true;
+							}
+						}
+						else if (c > 0.0f) { // parallel to the axis and outside
+							return false;
+						}
+
+						// caps
+						if (fabsf(d.y) > FLT_EPSILON) {
+							for (float capY : { 0.0f, m_height }) {
+								float t = (capY - o.y) / d.y;
+								vec3 p = o + t * d;
+								if (t >= 0.0f && p.x * p.x + p.z * p.z <= m_radiusSq)
+									return true;
+							}
+						}
+						return o.y >= 0.0f && o.y <= m_height && c <= 0.0f; // starts inside
 					};
+			bool	intersectsSphere(ci::vec3 center, float radius) override {
+						vec3 local = toLocal(center);
+						vec3 closest(local.x, glm::clamp(local.y, 0.0f, m_height), local.z);
+						float radial = local.x * local.x + local.z * local.z;
+						if (radial > m_radiusSq) {
+							float s = m_radius / sqrtf(radial);
+							closest.x *= s;
+							closest.z *= s;
+						}
+						return glm::distance2(closest, local) <= radius * radius;
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						return ci::AxisAlignedBox(vec3(-m_radius, 0.0f, -m_radius), vec3(m_radius, m_height, m_radius)).transformed(m_transform);
+					}
 			void	draw() override {
 						gl::pushMatrices();
-						gl::translate(m_position);
-						gl::multModelMatrix(glm::toMat4(m_orientation));
-						//gl::scale(m_scalation);
+						gl::multModelMatrix(m_transform);
 						ci::gl::draw(*m_triMesh);
 						gl::popMatrices();
 					};
+
+			void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) override {
+						const vec3 c = m_position;
+						const vec3 ax = m_rotation[0], ay = m_rotation[1], az = m_rotation[2];
+						const float r2 = m_radiusSq;
+						const float h = m_height;
+						for (size_t i = 0; i < count; i++) {
+							vec3 d = points[i] - c;
+							float x = d.x * ax.x + d.y * ax.y + d.z * ax.z;
+							float y = d.x * ay.x + d.y * ay.y + d.z * ay.z;
+							float z = d.x * az.x + d.y * az.y + d.z * az.z;
+							result[i] = (y >= 0.0f) & (y <= h) & (x * x + z * z <= r2);
+						}
+					}
 		private:
 			float	m_radius;
 			float	m_radiusSq;
+			float	m_height;
 			ci::TriMeshRef		m_triMesh;
+
+			void	updateMesh() { m_triMesh = ci::TriMesh::create(ci::geom::Cylinder().radius(m_radius).height(m_height)); }
+		};
+
+		/**
+		* @brief all points within radius of the segment from the position along the local y axis
+		*/
+		class BoundingCapsule : public BoundingBase {
+		public:
+			BoundingCapsule(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 0.5f, float length = 1.0f, ci::quat orientation = ci::quat(1.0f, 0.0f, 0.0f, 0.0f))
+				: BoundingBase(BT_CAPSULE, position, orientation) {
+				m_radius = radius;
+				m_length = length;
+			};
+
+			static std::shared_ptr<BoundingCapsule> create(ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), float radius = 0.5f, float length = 1.0f, ci::quat orientation = ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) { return std::make_shared<BoundingCapsule>(position, radius, length, orientation); };
+
+			float		getRadius() { return m_radius; }
+			void		setRadius(float radius) { m_radius = radius; }
+			float		getLength() { return m_length; }
+			void		setLength(float length) { m_length = length; }
+			ci::vec3	getStart() { return m_position; }
+			ci::vec3	getEnd() { return m_position + m_rotation[1] * m_length; }
+
+			bool	contains(ci::vec3 pt) override {
+						return distanceSqToSegment(pt) <= m_radius * m_radius;
+					}
+			bool	intersects(ci::Ray ray) override {
+						return closestSegmentSegmentSq(getStart(), getEnd(), ray.getOrigin(), ray.getOrigin() + ray.getDirection(), FLT_MAX) <= m_radius * m_radius;
+					}
+			bool	intersectsSphere(ci::vec3 center, float radius) override {
+						float r = m_radius + radius;
+						return distanceSqToSegment(center) <= r * r;
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						vec3 start = getStart(), end = getEnd();
+						return ci::AxisAlignedBox(glm::min(start, end) - vec3(m_radius), glm::max(start, end) + vec3(m_radius));
+					}
+			void	draw() override {
+						vec3 start = getStart(), end = getEnd();
+						ci::gl::draw(ci::geom::Capsule().center((start + end) * 0.5f).direction(m_rotation[1]).length(m_length).radius(m_radius));
+					};
+
+			void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) override {
+						const vec3 a = getStart();
+						const vec3 ab = getEnd() - a;
+						const float abab = glm::dot(ab, ab);
+						const float inv = abab > 0.0f ? 1.0f / abab : 0.0f;
+						const float r2 = m_radius * m_radius;
+						for (size_t i = 0; i < count; i++) {
+							vec3 ap = points[i] - a;
+							float t = glm::clamp((ap.x * ab.x + ap.y * ab.y + ap.z * ab.z) * inv, 0.0f, 1.0f);
+							vec3 d = ap - ab * t;
+							result[i] = d.x * d.x + d.y * d.y + d.z * d.z <= r2;
+						}
+					}
+
+			float	distanceSqToSegment(ci::vec3 pt) {
+						vec3 a = getStart();
+						vec3 ab = getEnd() - a;
+						float abab = glm::dot(ab, ab);
+						float t = abab > 0.0f ? glm::clamp(glm::dot(pt - a, ab) / abab, 0.0f, 1.0f) : 0.0f;
+						return glm::distance2(a + ab * t, pt);
+					}
+
+			/**
+			* @brief squared distance between p1 + s * (q1 - p1), s in [0, 1] and p2 + t * (q2 - p2), t in [0, maxT]
+			* see Ericson, Real-Time Collision Detection, 5.1.9, a maxT of FLT_MAX makes the second one a ray
+			*/
+			static float closestSegmentSegmentSq(ci::vec3 p1, ci::vec3 q1, ci::vec3 p2, ci::vec3 q2, float maxT = 1.0f) {
+						vec3 d1 = q1 - p1;
+						vec3 d2 = q2 - p2;
+						vec3 r	= p1 - p2;
+						float a = glm::dot(d1, d1);
+						float e = glm::dot(d2, d2);
+						float f = glm::dot(d2, r);
+						float s = 0.0f, t = 0.0f;
+
+						if (a <= FLT_EPSILON && e <= FLT_EPSILON)
+							return glm::dot(r, r);
+						if (a <= FLT_EPSILON) {
+							t = glm::clamp(f / e, 0.0f, maxT);
+						}
+						else {
+							float c = glm::dot(d1, r);
+							if (e <= FLT_EPSILON) {
+								s = glm::clamp(-c / a, 0.0f, 1.0f);
+							}
+							else {
+								float b		= glm::dot(d1, d2);
+								float denom = a * e - b * b;
+								s = denom != 0.0f ? glm::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+								t = (b * s + f) / e;
+								if (t < 0.0f) {
+									t = 0.0f;
+									s = glm::clamp(-c / a, 0.0f, 1.0f);
+								}
+								else if (t > maxT) {
+									t = maxT;
+									s = glm::clamp((b * maxT - c) / a, 0.0f, 1.0f);
+								}
+							}
+						}
+						return glm::distance2(p1 + d1 * s, p2 + d2 * t);
+					}
+		private:
+			float	m_radius;
+			float	m_length;
+		};
+
+		/**
+		* @brief convex hull given as closed TriMesh, point tests run against the face planes
+		*/
+		class BoundingConvex : public BoundingBase {
+		public:
+			BoundingConvex(ci::TriMeshRef hull = ci::TriMesh::create(ci::geom::Cube()), ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), ci::quat orientation = ci::quat(1.0f, 0.0f, 0.0f, 0.0f))
+				: BoundingBase(BT_CONVEX, position, orientation) {
+				setHull(hull);
+			};
+
+			static std::shared_ptr<BoundingConvex> create(ci::TriMeshRef hull = ci::TriMesh::create(ci::geom::Cube()), ci::vec3 position = vec3(0.0f, 0.0f, 0.0f), ci::quat orientation = ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) { return std::make_shared<BoundingConvex>(hull, position, orientation); };
+
+			ci::TriMeshRef	getHull() { return m_hull; }
+			void			setHull(ci::TriMeshRef hull) {
+								m_hull	= hull;
+								m_bvh	= MeshBVH::get(m_hull);
+								m_bounds = m_bvh->getBounds();
+
+								// one plane per face, the normals are made to point away from the centroid
+								m_normals.clear();
+								m_distances.clear();
+								vec3 centroid(0.0f); // the mean of the vertices lies inside a convex hull, the center of its bounds not necessarily
+								const vec3* positions = m_hull->getPositions<3>();
+								for (size_t i = 0; i < m_hull->getNumVertices(); i++)
+									centroid += positions[i];
+								centroid /= (float)std::max((size_t)1, m_hull->getNumVertices());
+								for (size_t i = 0; i < m_hull->getNumTriangles(); i++) {
+									vec3 v0, v1, v2;
+									m_hull->getTriangleVertices(i, &v0, &v1, &v2);
+									vec3 n = glm::cross(v1 - v0, v2 - v0);
+									if (glm::length2(n) < FLT_EPSILON * FLT_EPSILON)
+										continue;
+									n = glm::normalize(n);
+									float d = glm::dot(n, v0);
+									if (glm::dot(n, centroid) > d) {
+										n = -n;
+										d = -d;
+									}
+
+									bool known = false;
+									for (size_t j = 0; j < m_normals.size() && !known; j++)
+										known = glm::dot(m_normals[j], n) > 0.9999f && fabsf(m_distances[j] - d) < 0.0001f;
+									if (!known) {
+										m_normals.push_back(n);
+										m_distances.push_back(d);
+									}
+								}
+							}
+
+			bool	contains(ci::vec3 pt) override {
+						vec3 local = toLocal(pt);
+						for (size_t j = 0; j < m_normals.size(); j++) {
+							if (glm::dot(m_normals[j], local) > m_distances[j])
+								return false;
+						}
+						return true;
+					}
+			bool	intersects(ci::Ray ray) override {
+						// clip the ray by every plane, see Cyrus-Beck
+						vec3 o = toLocal(ray.getOrigin());
+						vec3 d = toLocalDir(ray.getDirection());
+						float tEnter = 0.0f;
+						float tExit	 = FLT_MAX;
+						for (size_t j = 0; j < m_normals.size(); j++) {
+							float denom = glm::dot(m_normals[j], d);
+							float dist	= m_distances[j] - glm::dot(m_normals[j], o);
+							if (fabsf(denom) < FLT_EPSILON) {
+								if (dist < 0.0f)
+									return false;
+								continue;
+							}
+							float t = dist / denom;
+							if (denom < 0.0f)
+								tEnter = std::max(tEnter, t);
+							else
+								tExit = std::min(tExit, t);
+							if (tEnter > tExit)
+								return false;
+						}
+						return true;
+					}
+			bool	intersectsSphere(ci::vec3 center, float radius) override {
+						return contains(center) || m_bvh->intersectsSphere(toLocal(center), toLocalLength(radius));
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						return m_bounds.transformed(m_transform);
+					}
+			void	draw() override {
+						gl::pushMatrices();
+						gl::multModelMatrix(m_transform);
+						gl::draw(*m_hull);
+						gl::popMatrices();
+					};
+
+			void	containsPoints(const ci::vec3* points, size_t count, uint8_t* result) override {
+						std::fill(result, result + count, (uint8_t)1);
+						// plane by plane, in world space, so the inner loop runs straight over the points
+						for (size_t j = 0; j < m_normals.size(); j++) {
+							const vec3 n = m_rotation * m_normals[j];
+							const float d = m_distances[j] + glm::dot(n, m_position);
+							for (size_t i = 0; i < count; i++) {
+								const vec3& p = points[i];
+								result[i] &= (n.x * p.x + n.y * p.y + n.z * p.z <= d);
+							}
+						}
+					}
+		private:
+			ci::TriMeshRef		m_hull;
+			MeshBVHRef			m_bvh;
+			ci::AxisAlignedBox	m_bounds;
+			std::vector<ci::vec3>	m_normals;
+			std::vector<float>		m_distances;
 		};
 
 		class BoundingMesh : public BoundingBase {
 		public:
 			BoundingMesh(ci::TriMeshRef triMesh = ci::TriMesh::create(ci::geom::Cube()), ci::vec3 position = vec3(0.0f, 0.0f, 0.0f))
-				: BoundingBase(position, ci::quat(1.0f, 0.0f, 0.0f, 1.0f)) {
+				: BoundingBase(BT_MESH, position, ci::quat(1.0f, 0.0f, 0.0f, 0.0f)) {
 				setTriMesh(triMesh);
-				updateTransform();
 			};
 
 			static std::shared_ptr<BoundingMesh> create(ci::TriMeshRef triMesh = ci::TriMesh::create(ci::geom::Cube()), ci::vec3 position = vec3(0.0f, 0.0f, 0.0f)) { return std::make_shared<BoundingMesh>(triMesh, position); };
@@ -142,19 +613,15 @@ namespace act {
 			ci::TriMeshRef	getTriMesh() { return m_triMesh; }
 			void			setTriMesh(ci::TriMeshRef triMesh) { 
 								m_triMesh = triMesh; 
-								m_bounds = m_triMesh->calcBoundingBox();
+								m_bvh = MeshBVH::get(m_triMesh);
+								m_bounds = m_bvh->getBounds();
 							}
 
 			bool	contains(ci::vec3 pt)		override {
 						ci::AxisAlignedBox worldBoundsApprox = m_bounds.transformed(m_transform); // fast
 						if (!worldBoundsApprox.contains(pt))
 							return false;
-						vec3 point;
-						if (intersection(ci::Ray(m_position, pt - m_position), pt)) {
-							if (glm::length(point - m_position) > glm::length(pt - m_position))
-								return true;
-						}
-						return false;
+						return m_bvh->contains(toLocal(pt));
 					}
 			bool	intersects(ci::Ray ray)		override {
 						ci::AxisAlignedBox worldBoundsApprox = m_bounds.transformed(m_transform); // fast
@@ -162,57 +629,24 @@ namespace act {
 						if (!worldBoundsApprox.intersects(ray))
 							return false;
 
-						vec3 pt;
-						// Did we have a hit?
-						if (intersection(ray, pt)) {
-							// Calculate the exact position of the hit.
-							//*pickedPoint = ray.calcPosition(result);
-
-							return true;
-						}
-						else
-							return false;
+						return m_bvh->intersect(toLocal(ray));
 					};
 
 			bool	intersection(ci::Ray ray, vec3 &point) {
-						// Set initial distance to something far, far away.
-						float result = FLT_MAX;
-
-						// Traverse triangle list and find the closest intersecting triangle.
-						const size_t polycount = m_triMesh->getNumTriangles();
-
 						float distance = 0.0f;
-						for (size_t i = 0; i < polycount; ++i) {
-							// Get a single triangle from the mesh.
-							ci::vec3 v0, v1, v2;
-							m_triMesh->getTriangleVertices(i, &v0, &v1, &v2);
-
-							// Transform triangle to world space.
-							v0 = ci::vec3(m_transform * ci::vec4(v0, 1.0));
-							v1 = ci::vec3(m_transform * ci::vec4(v1, 1.0));
-							v2 = ci::vec3(m_transform * ci::vec4(v2, 1.0));
-
-							// Test to see if the ray intersects this triangle.
-							if (ray.calcTriangleIntersection(v0, v1, v2, &distance)) {
-								// Keep the result if it's closer than any intersection we've had so far.
-								if (distance < result) {
-									result = distance;
-
-									// Assuming this is the closest triangle, we'll calculate our normal
-									// while we've got all the points handy.
-									// *pickedNormal = normalize(cross(v1 - v0, v2 - v0));
-								}
-							}
-						}
+						if (!m_bvh->intersect(toLocal(ray), &distance))
+							return false;
 
-						if (distance > 0) {
-							// Calculate the exact position of the hit.
-							point = ray.calcPosition(result);
+						// the local ray keeps the parametrization of the world ray
+						point = ray.calcPosition(distance);
+						return true;
+					}
 
-							return true;
-						}
-						else
-							return false;
+			bool	intersectsSphere(ci::vec3 center, float radius) override { // inside or touching the surface
+						return contains(center) || m_bvh->intersectsSphere(toLocal(center), toLocalLength(radius));
+					}
+			ci::AxisAlignedBox getWorldBounds() override {
+						return m_bounds.transformed(m_transform);
 					}
 
 			void	draw() override {
@@ -223,7 +657,78 @@ namespace act {
 					};
 		private:
 			ci::TriMeshRef		m_triMesh;
+			MeshBVHRef			m_bvh;
 			ci::AxisAlignedBox	m_bounds;
 		};
+
+		/**
+		* @brief separating axis test of two oriented boxes, see Ericson, Real-Time Collision Detection, 4.4.1
+		*/
+		inline bool overlapsBoxes(ci::vec3 centerA, const ci::mat3& axesA, ci::vec3 halfA, ci::vec3 centerB, const ci::mat3& axesB, ci::vec3 halfB) {
+			float ra, rb;
+			ci::mat3 R, absR;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					R[i][j]		= glm::dot(axesA[i], axesB[j]);
+					absR[i][j]	= fabsf(R[i][j]) + FLT_EPSILON; // parallel edges
+				}
+			}
+			ci::vec3 d = centerB - centerA;
+			ci::vec3 t(glm::dot(d, axesA[0]), glm::dot(d, axesA[1]), glm::dot(d, axesA[2]));
+
+			for (int i = 0; i < 3; i++) {
+				ra = halfA[i];
+				rb = halfB[0] * absR[i][0] + halfB[1] * absR[i][1] + halfB[2] * absR[i][2];
+				if (fabsf(t[i]) > ra + rb) return false;
+			}
+			for (int j = 0; j < 3; j++) {
+				ra = halfA[0] * absR[0][j] + halfA[1] * absR[1][j] + halfA[2] * absR[2][j];
+				rb = halfB[j];
+				if (fabsf(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + rb) return false;
+			}
+			for (int i = 0; i < 3; i++) {
+				int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+				for (int j = 0; j < 3; j++) {
+					int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+					ra = halfA[i1] * absR[i2][j] + halfA[i2] * absR[i1][j];
+					rb = halfB[j1] * absR[i][j2] + halfB[j2] * absR[i][j1];
+					if (fabsf(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb) return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		* @brief overlap of two volumes, exact for every pair with a sphere, box/box and capsule/capsule,
+		* the remaining pairs are conservative and only compare the world bounds
+		*/
+		inline bool overlaps(BoundingBase& a, BoundingBase& b) {
+			if (!a.getWorldBounds().intersects(b.getWorldBounds()))
+				return false;
+
+			if (a.getType() == BT_SPHERE) {
+				auto& sphere = static_cast<BoundingSphere&>(a);
+				return b.intersectsSphere(sphere.getPosition(), sphere.getRadius());
+			}
+			if (b.getType() == BT_SPHERE) {
+				auto& sphere = static_cast<BoundingSphere&>(b);
+				return a.intersectsSphere(sphere.getPosition(), sphere.getRadius());
+			}
+
+			auto isBox = [](BoundingBase& v) { return v.getType() == BT_BOX || v.getType() == BT_ORIENTED_BOX; };
+			auto boxAxes = [](BoundingBase& v) { return v.getType() == BT_BOX ? ci::mat3(1.0f) : static_cast<BoundingOrientedBox&>(v).getAxes(); };
+			auto boxHalf = [](BoundingBase& v) { return v.getType() == BT_BOX ? static_cast<BoundingBox&>(v).getHalfSize() : static_cast<BoundingOrientedBox&>(v).getHalfSize(); };
+			if (isBox(a) && isBox(b))
+				return overlapsBoxes(a.getPosition(), boxAxes(a), boxHalf(a), b.getPosition(), boxAxes(b), boxHalf(b));
+
+			if (a.getType() == BT_CAPSULE && b.getType() == BT_CAPSULE) {
+				auto& ca = static_cast<BoundingCapsule&>(a);
+				auto& cb = static_cast<BoundingCapsule&>(b);
+				float r = ca.getRadius() + cb.getRadius();
+				return BoundingCapsule::closestSegmentSegmentSq(ca.getStart(), ca.getEnd(), cb.getStart(), cb.getEnd()) <= r * r;
+			}
+
+			return true;
+		}
 	}
 }
\ No newline at end of file
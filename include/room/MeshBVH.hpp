@@ -0,0 +1,75 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "stddef.hpp"
+#include "cinder/TriMesh.h"
+#include "cinder/Ray.h"
+#include "cinder/AxisAlignedBox.h"
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief bounding-volume hierarchy over the triangles of a TriMesh in model space
+		* queries take model-space rays and points, transform them with the inverse model matrix instead of the triangles.
+		* the distances of rays are in units of the given ray direction, so they stay comparable after the transformation
+		*/
+		class MeshBVH
+		{
+		public:
+			MeshBVH(ci::TriMeshRef triMesh);
+			~MeshBVH();
+
+			static std::shared_ptr<MeshBVH> create(ci::TriMeshRef triMesh) { return std::make_shared<MeshBVH>(triMesh); };
+
+			/**
+			* @brief the hierarchy of that TriMesh, built once and shared as long as anyone holds it
+			*/
+			static std::shared_ptr<MeshBVH> get(ci::TriMeshRef triMesh);
+
+			const ci::AxisAlignedBox& getBounds() const { return m_bounds; };
+			size_t	getNumTriangles() const { return m_vertices.size() / 3; };
+
+			bool	intersect(const ci::Ray& ray, float* distance = nullptr) const;	// closest hit in front of the origin
+			int		countIntersections(const ci::Ray& ray) const;
+			bool	intersectsSphere(const ci::vec3& center, float radius) const;
+			bool	contains(const ci::vec3& point) const;	// for closed meshes
+
+		private:
+			struct Node {
+				ci::vec3	min;
+				ci::vec3	max;
+				uint32_t	first;	// leaf: first triangle, inner: right child (left child follows the node)
+				uint32_t	count;	// triangles, 0 for inner nodes
+			};
+
+			std::vector<Node>		m_nodes;
+			std::vector<ci::vec3>	m_vertices;		// 3 per triangle, ordered by leaf
+			ci::AxisAlignedBox		m_bounds;
+
+			static const uint32_t	kLeafSize = 4;
+
+			uint32_t	build(std::vector<uint32_t>& triangles, std::vector<ci::vec3>& centroids, const std::vector<ci::vec3>& vertices, uint32_t begin, uint32_t end);
+			static ci::vec3 inverseDirection(const ci::vec3& direction);	// +-infinity for axes the ray is parallel to
+			static bool	intersectBox(const Node& node, const ci::vec3& origin, const ci::vec3& invDir, float maxDistance, float& entry);
+			static ci::vec3 closestPointOnTriangle(const ci::vec3& p, const ci::vec3& a, const ci::vec3& b, const ci::vec3& c);
+
+		}; using MeshBVHRef = std::shared_ptr<MeshBVH>;
+
+	}
+}
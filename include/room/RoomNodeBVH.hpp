@@ -0,0 +1,75 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "RoomNodeBase.hpp"
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief bounding-volume hierarchy over the world bounds of room nodes
+		* update() rebuilds the tree only if the set of nodes has changed, otherwise moved nodes are refitted bottom-up
+		*/
+		class RoomNodeBVH
+		{
+		public:
+			RoomNodeBVH();
+			~RoomNodeBVH();
+
+			void	update(const std::vector<RoomNodeBaseRef>& nodes);
+			void	clear();
+
+			bool							hitRay(const ci::Ray& ray);
+			RoomNodeBaseRef					getNodeOnRay(const ci::Ray& ray);	// nearest by the node's position, as before
+			void							getNodesInBox(const ci::AxisAlignedBox& box, std::vector<RoomNodeBaseRef>& result);	// whose bounds overlap the box
+
+			const std::vector<RoomNodeBaseRef>&	getItems() const { return m_items; };	// the nodes of the last update(), in the order of the tree
+			size_t	size() const { return m_items.size(); };
+
+		private:
+			struct Node {
+				ci::vec3	min;
+				ci::vec3	max;
+				uint32_t	first;	// leaf: first item, inner: right child (left child follows the node)
+				uint32_t	count;	// items, 0 for inner nodes
+			};
+
+			std::vector<Node>				m_nodes;
+			std::vector<RoomNodeBaseRef>	m_items;		// ordered by leaf
+			std::vector<ci::vec3>			m_itemMin;
+			std::vector<ci::vec3>			m_itemMax;
+			std::vector<RoomNodeBase*>		m_order;		// the nodes given to the last update(), to detect changes
+			float							m_buildArea = 0.0f;
+
+			static const uint32_t			kLeafSize = 2;
+
+			void		rebuild(const std::vector<RoomNodeBaseRef>& nodes);
+			bool		refit();
+			void		fit();
+			uint32_t	build(std::vector<uint32_t>& items, const std::vector<ci::vec3>& centers, uint32_t begin, uint32_t end);
+
+			template<typename Visit>
+			void		traverseRay(const ci::Ray& ray, Visit visit);
+
+			static float	area(const ci::vec3& min, const ci::vec3& max);
+			static ci::vec3	inverseDirection(const ci::vec3& direction);	// +-infinity for axes the ray is parallel to
+			static bool		intersectBox(const ci::vec3& min, const ci::vec3& max, const ci::vec3& origin, const ci::vec3& invDir);
+		};
+
+	}
+}
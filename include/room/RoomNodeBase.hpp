@@ -18,6 +18,8 @@
 #pragma once
 
 #include "roompch.hpp"
+#include "MeshBVH.hpp"
+#include "ParamSet.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -77,6 +79,7 @@ namespace act {
 			bool			isConnected() { return m_isConnected; };
 
 			virtual ci::AxisAlignedBox getBounds() { return m_bounds; }
+			virtual ci::AxisAlignedBox getWorldBounds();	// approximation of the transformed mesh, as used by hitRay
 
 			virtual bool	hit(ci::vec3 pos);
 			virtual bool	hitRay(ci::Ray ray);
@@ -98,8 +101,8 @@ namespace act {
 			virtual ci::Json toJson();
 			virtual void fromJson(ci::Json json, act::UID msgUID = "");
 
-			virtual ci::Json toParams() { return ci::Json::object(); };
-			virtual void fromParams(ci::Json json) {};
+			virtual ci::Json toParams() { return m_params.toJson(); };
+			virtual void fromParams(ci::Json json) { m_params.fromJson(json); };
 
 			//void connectPositionPort(std::shared_ptr<RoomNodeBase> node);
 			//void disconnectPositionOutPort(act::proc::InputPortRef<vec3> inputPort);
@@ -142,6 +145,9 @@ namespace act {
 			ci::TriMeshRef			m_triMesh;
 			ci::gl::BatchRef		m_mesh;
 			ci::AxisAlignedBox		m_bounds;
+			MeshBVHRef				m_bvh;
+
+			util::ParamSet			m_params;			// declared in the constructor, toParams and fromParams are derived from it
 
 			
 			void					publishChanges();
@@ -20,6 +20,7 @@
 #include "RoomNodeBase.hpp"
 #include "ModuleBase.hpp"
 #include "RoomManagers.hpp"
+#include "RoomNodeBVH.hpp"
 
 namespace act {
 	namespace room {
@@ -62,6 +63,10 @@ namespace act {
 
 			act::room::RoomNodeBaseRef		m_selectedNode;
 
+			act::room::RoomNodeBVH			m_nodeTree;	// of all nodes, refitted every update() and on demand by the queries
+
+			void	updateActionspaces();
+
 			ci::gl::BatchRef				m_wireRoom;
 			ci::gl::BatchRef				m_wirePlane;
 			ci::vec3						m_size;
@@ -34,9 +34,13 @@ namespace act {
 			AST_CYLINDER,
 			AST_CUBOID,
 			AST_CONE,
-			AST_FREE
+			AST_FREE,
+			AST_CAPSULE
 		};
 
+		/**
+		* @brief zone in the room, the Stage tells it which room nodes are inside it
+		*/
 		class ActionspaceRoomNode : public RoomNodeBase
 		{
 		public:
@@ -54,14 +58,39 @@ namespace act {
 			virtual ci::Json toParams() override;
 			virtual void fromParams(ci::Json json) override;
 
+			virtual ci::AxisAlignedBox	getWorldBounds() override;
+			virtual bool				hitRay(ci::Ray ray) override;
+
+			ASType		getType() { return m_type; };
+			void		setType(ASType type);
+			vec3		getSize() { return m_size; };
+			void		setSize(vec3 size);
+			BoundingRef	getBounding() { return m_bounding; };
+
+			/**
+			* @brief the room nodes inside since the last call, entered and exited are the changes to the call before
+			*/
+			void								setOccupants(const std::vector<RoomNodeBaseRef>& occupants);
+			const std::vector<RoomNodeBaseRef>&	getOccupants()	{ return m_occupants; };
+			const std::vector<RoomNodeBaseRef>&	getEntered()	{ return m_entered; };
+			const std::vector<RoomNodeBaseRef>&	getExited()		{ return m_exited; };
+
 		protected:
 			ASType	m_type = AST_SPHERE;
 			vec3	m_size = vec3(1.f, 1.f, 1.f);
 			
 			BoundingRef m_bounding;
 
+			std::vector<RoomNodeBaseRef>	m_occupants;
+			std::vector<RoomNodeBaseRef>	m_entered;
+			std::vector<RoomNodeBaseRef>	m_exited;
+
+			void	updateTransform() override;
+			void	updateBounding();
+
 		private:			
-			ASType	fromTypeString(std::string typestring);
+			ASType		fromTypeString(std::string typestring);
+			std::string	toTypeString(ASType type);
 
 		}; using ActionspaceRoomNodeRef = std::shared_ptr<ActionspaceRoomNode>;
 
@@ -51,6 +51,7 @@ namespace act {
 
 			virtual bool		hit(ci::vec3 pos) override;
 			virtual bool		hitRay(ci::Ray ray) override; 
+			ci::AxisAlignedBox	getWorldBounds() override;
 
 			virtual	void		setIsHovered(bool hovered)   override;
 			virtual	void		setIsSelected(bool selected) override;
@@ -21,6 +21,7 @@
 #include "cinder/audio/GenNode.h"
 #include "cinder/audio/audio.h"
 #include "TimeStretchingNode.hpp"
+#include "AssetManager.hpp"
 
 #include <memory>
 
@@ -49,7 +50,8 @@ namespace act {
 			std::function<void()> finishedLoadingFn = []() {};
 			std::function<void()> finishedPlayingFn = []() {};
 
-			void loadFile(fs::path path);
+			void loadFile(fs::path path);	// decodes in the background, finishedLoadingFn is called from update() when it is done
+			bool isLoading() { return m_isBufferPending; };
 
 			float getPlayPosition() { return  (float)(m_bufferPlayerNode->getReadPositionTime() / m_bufferPlayerNode->getNumSeconds()); };
 			float getSeconds()		{ return  (float)(m_bufferPlayerNode->getNumSeconds()); };
@@ -78,6 +80,11 @@ namespace act {
 			bool m_isPlaying = false;
 			bool m_isLooping = false;
 			bool m_isLoadingFile = false;
+
+			fs::path							m_path;
+			util::AssetFuture<ci::audio::Buffer>	m_bufferAsset;	// shared by all nodes playing the same file
+			bool								m_isBufferPending = false;
+			void applyBuffer();
 			bool m_isStretching = false;
 
 			float m_fadeInPosition = 0.0f;
@@ -0,0 +1,65 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "body/BodyStore.hpp"
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief one-euro filter (see 3rd/filter/OneEuroFilter.hpp) over every component of every joint of a BodyStore
+		* the state is kept in flat arrays parallel to the slots of the store, so all bodies are filtered in one plain loop.
+		* a slot that is new in the store is reset to its measurement
+		*/
+		class BodyFilterBank
+		{
+		public:
+			BodyFilterBank(float minCutoff = 1.0f, float beta = 0.007f, float dCutoff = 1.0f);
+			~BodyFilterBank();
+
+			void	apply(BodyStore& store, float dt);
+			void	reset() { m_count = 0; };
+
+			void	setParams(float minCutoff, float beta, float dCutoff);
+			float	getMinCutoff()	{ return m_minCutoff; };
+			float	getBeta()		{ return m_beta; };
+			float	getDCutoff()	{ return m_dCutoff; };
+
+		private:
+			float	m_minCutoff;
+			float	m_beta;
+			float	m_dCutoff;
+
+			size_t	m_count = 0; // bodies with a valid state
+
+			struct Channel {
+				std::vector<float> value;
+				std::vector<float> raw;
+				std::vector<float> deriv;
+			};
+			Channel	m_positions;
+			Channel	m_orientations;
+
+			void	resize(Channel& channel, size_t total);
+			void	reset(Channel& channel, const float* data, size_t begin, size_t count);
+			void	filter(Channel& channel, float* data, size_t filtered, size_t total, float dt);
+
+		}; using BodyFilterBankRef = std::shared_ptr<BodyFilterBank>;
+
+	}
+}
@@ -0,0 +1,91 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "body/Body.hpp"
+
+#include <map>
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief all joints of all bodies as structure of arrays, body b's joint j is at [b * BJT_COUNT + j]
+		* a tracked id keeps its slot (and the UID of the slot) as long as it is seen; a slot is only freed when its id disappears,
+		* so slots below size() may be inactive. slots keep their memory, only new slots are allocated
+		*/
+		class BodyStore
+		{
+		public:
+			BodyStore();
+			~BodyStore();
+
+			/** @brief marks all slots as unseen, call acquire() for every body of the frame and endFrame() afterwards */
+			void	beginFrame();
+			/** @brief the slot of the tracked id, a new id gets a free slot with a new UID */
+			size_t	acquire(uint32_t id);
+			/** @brief frees the slots whose id was not acquired since beginFrame() */
+			void	endFrame();
+
+			size_t	size() const					{ return m_count; };	// slots up to the last active one
+			bool	isActive(size_t body) const		{ return m_slots[body].isActive; };
+			/** @brief got its id in the current frame, so there is no history of it */
+			bool	isNew(size_t body) const		{ return m_slots[body].isNew; };
+			size_t	jointCount() const	{ return m_count * BJT_COUNT; };
+
+			glm::vec3*				getPositions(size_t body)					{ return &m_positions[body * BJT_COUNT]; };
+			const glm::vec3*		getPositions(size_t body) const				{ return &m_positions[body * BJT_COUNT]; };
+			glm::quat*				getOrientations(size_t body)				{ return &m_orientations[body * BJT_COUNT]; };
+			const glm::quat*		getOrientations(size_t body) const			{ return &m_orientations[body * BJT_COUNT]; };
+			BodyJointConfidence*	getConfidences(size_t body)					{ return &m_confidences[body * BJT_COUNT]; };
+			const BodyJointConfidence* getConfidences(size_t body) const		{ return &m_confidences[body * BJT_COUNT]; };
+			const UID&				getUID(size_t body) const					{ return m_uids[body]; };
+
+			// flat component access for batched filtering, 3 resp. 4 floats per joint
+			float*	getPositionData()		{ return m_positions.empty() ? nullptr : &m_positions[0].x; };
+			float*	getOrientationData()	{ return m_orientations.empty() ? nullptr : &m_orientations[0].x; };
+
+			/**
+			* @brief orientations pointing from each joint to its next joint, see kh::setOrientationFromBodyPose()
+			*/
+			void	setOrientationsFromPose(size_t body);
+
+			/**
+			* @brief copies a body into a Body for the BodyRef based ports
+			*/
+			void	toBody(size_t body, BodyRef target) const;
+
+		private:
+			struct Slot {
+				uint32_t	id			= 0;
+				bool		isActive	= false;
+				bool		isNew		= false;
+				bool		isSeen		= false;
+			};
+
+			size_t					m_count = 0;
+			std::vector<Slot>		m_slots;
+			std::map<uint32_t, size_t> m_idToSlot;
+			std::vector<glm::vec3>	m_positions;
+			std::vector<glm::quat>	m_orientations;
+			std::vector<BodyJointConfidence> m_confidences;
+			std::vector<UID>		m_uids;
+
+		}; using BodyStoreRef = std::shared_ptr<BodyStore>;
+
+	}
+}
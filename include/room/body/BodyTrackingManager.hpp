@@ -21,6 +21,8 @@
 #include "kinect/KinectManager.hpp"
 
 #include "Body.hpp"
+#include "BodyStore.hpp"
+#include "BodyFilterBank.hpp"
 #include "BodyRoomNode.hpp"
 
 namespace act {
@@ -47,6 +49,11 @@ namespace act {
 		private:
 			KinectManagerRef m_kinectMgr;
 
+			BodyStore		m_store;	// filtered joints of the current frame
+			BodyFilterBank	m_filterBank;
+			bool			m_isFiltering = true;
+			double			m_lastTime = 0.0;
+
 			std::vector<act::room::BodyRef> m_bodies;
 			act::proc::OutputPortRef<std::vector<act::room::BodyRef>> m_bodiesOutPort;
 			bool m_wereZeroBodiesBefore = true;
@@ -21,32 +21,61 @@
 
 #include "cinder/Capture.h"
 
+#include <atomic>
+
 using namespace ci;
 using namespace ci::app;
 
 namespace act {
 	namespace room {
 
+		/**
+		* @brief a single frame of a camera, stamped when it was grabbed
+		*/
+		struct CameraFrame {
+			cv::UMat	image;
+			double		timestamp	= 0.0;	// seconds, monotonic
+			uint64_t	sequence	= 0;
+		};
+
+		/**
+		* @brief grabs and converts frames in its own thread, update() takes over the newest one without locking
+		* besides a capture device, a video file or a synthetic test pattern can be used as source
+		*/
 		class CameraDevice {
 
 		public:
+			enum SourceType {
+				ST_CAPTURE,
+				ST_FILE,
+				ST_SYNTHETIC
+			};
+
 			CameraDevice();
 			CameraDevice(ci::Capture::DeviceRef deviceReference);
+			CameraDevice(fs::path videoPath);
+			CameraDevice(ci::ivec2 size, float fps);
 			~CameraDevice();
 
 			static std::shared_ptr<CameraDevice> create(ci::Capture::DeviceRef deviceRef) { return std::make_shared<CameraDevice>(deviceRef); };
-			
-			bool update();
+			static std::shared_ptr<CameraDevice> createFromFile(fs::path videoPath) { return std::make_shared<CameraDevice>(videoPath); };
+			static std::shared_ptr<CameraDevice> createSynthetic(ci::ivec2 size = ci::ivec2(1280, 720), float fps = 30.0f) { return std::make_shared<CameraDevice>(size, fps); };
+
+			bool update(); // true if a new frame has arrived since the last call
 			cv::UMat getCurrentImage();
 			cv::UMat getUndistortedImage();
+			double getTimestamp() { return m_timestamp; }
+			uint64_t getSequence() { return m_sequence; }
+			uint64_t getDroppedFrames() { return m_droppedFrames; }
 
 			std::string getName() { return m_name; }
-			bool hasCapture() { return !!m_capture; }
-			bool isCapturing() { return m_capture->isCapturing(); }
+			SourceType getSourceType() { return m_sourceType; }
+			bool hasCapture() { return !!m_capture || (m_sourceType != ST_CAPTURE && !m_error); }
+			bool isCapturing() { return m_capture ? m_capture->isCapturing() : m_isRunning.load(); }
 
 			bool isFlipped() { return m_flipped; }
 			void setIsFlipped(bool flipped) { m_flipped = flipped; }
-			
+
 			std::vector<cv::UMat> m_calibImages;
 			std::vector<std::vector<cv::Point2i>> m_calibAreas;
 			gl::Texture2dRef m_textureUndist;
@@ -61,16 +90,19 @@ namespace act {
 
 		private:
 			std::string				m_name;
+			SourceType				m_sourceType = ST_CAPTURE;
 
 			ci::CaptureRef			m_capture;
+			cv::VideoCapture		m_video;
+			float					m_fps = 30.0f;
 			ci::ivec2				m_captureSize = ci::ivec2(1280, 720);
 			cv::Size				m_cvSize = cv::Size(1280, 720);
 
 			bool	m_isCalibrated = false;
-			bool	m_flipped = false;
+			std::atomic<bool>	m_flipped = false;
 
 			cv::UMat remap(cv::UMat image);
-			
+
 			cv::Mat m_intrinsic;
 			cv::Mat m_distCoeffs;
 			cv::Mat m_map1, m_map2;
@@ -81,10 +113,40 @@ namespace act {
 
 			cv::UMat m_currentImage;
 			cv::UMat m_undistoretedImage;
+			double	 m_timestamp = 0.0;
+			uint64_t m_sequence = 0;
 
 			char* m_description;
-			
+
+			// capture thread, frames are handed over as triple buffer
+			std::thread				m_thread;
+			std::atomic<bool>		m_isRunning = false;
+
+			static const int		kFresh = 4;	// flag on m_ready, the frame has not been taken yet
+			static const int		kIndex = 3;
+			CameraFrame				m_frames[3];
+			std::atomic<int>		m_ready = 1;	// index of the latest complete frame, owned by neither side
+			int						m_write = 0;	// owned by the capture thread
+			int						m_read	= 2;	// owned by update()
+			uint64_t				m_written = 0;
+
+			// recycled images, a buffer is written again once neither the frames nor a port hold it
+			static const int		kPoolSize = 4;
+			cv::UMat				m_pool[kPoolSize];
+			int						m_poolNext = 0;
+			cv::UMat&				acquireBuffer();
+			std::atomic<uint64_t>	m_droppedFrames = 0;
+
+			void start();
+			void stop();
+			ci::Surface8uRef		m_surface;	// the captured surface frame of grab() refers to
+
+			/** @brief colorConversion is the cv::ColorConversionCodes to BGR, or -1 if frame is BGR already */
+			bool grab(cv::Mat& frame, int& colorConversion);
+			void publish(const cv::Mat& frame, int colorConversion, double timestamp);
+			void drawTestPattern(cv::Mat& frame);
+			static double now();
 
 		}; using CameraDeviceRef = std::shared_ptr<CameraDevice>;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,82 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+
+#include <array>
+
+using namespace ci;
+using namespace ci::app;
+
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief precompiled colour-to-fixture conversion of a single fixture description
+		* the RGB(A)W split (see RGBAWHelper), the colour-wheel quantisation and the gamma/dimmer curves
+		* are baked into lookup tables once, so convert() only does table lookups for a whole group of fixtures
+		*/
+		class DMXColorProfile
+		{
+		public:
+			DMXColorProfile(ci::Json description);
+			~DMXColorProfile();
+
+			static std::shared_ptr<DMXColorProfile> create(ci::Json description) { return std::make_shared<DMXColorProfile>(description); };
+
+			bool	hasColor()		{ return m_red >= 0 || m_green >= 0 || m_blue >= 0 || m_colorWheel >= 0; };
+			bool	hasColorWheel() { return m_colorWheel >= 0; };
+
+			/**
+			* @brief appends the absolute channels and values of count fixtures to channels/values, ready for DMXPro::setValues()
+			* dimmers are the final intensities [0..1], startAddresses the fixtures' DMX start addresses
+			*/
+			void	convert(const ci::Color* colors, const float* dimmers, const int* startAddresses, size_t count, std::vector<int>& channels, std::vector<unsigned char>& values) const;
+
+		private:
+			// channel offsets relative to the start address, -1 if not mapped
+			int m_red			= -1;
+			int m_green			= -1;
+			int m_blue			= -1;
+			int m_amber			= -1;
+			int m_white			= -1;
+			int m_colorWheel	= -1;
+			int m_dimmer		= -1;
+
+			// chroma of each channel per hue degree for a chroma of 1
+			std::array<float, 360>			m_hueRed;
+			std::array<float, 360>			m_hueGreen;
+			std::array<float, 360>			m_hueBlue;
+			std::array<float, 360>			m_hueAmber;
+			std::array<float, 360>			m_hueGreenOffset;	// RGBAWHelper adds a constant green in the yellow segment
+
+			std::array<unsigned char, 256>	m_colorCurve;		// gamma
+			std::array<unsigned char, 256>	m_dimmerCurve;
+
+			std::array<int, 256>			m_colorWheelLookUp;	// hue * 255 to chnVal
+			int								m_whiteColorWheelValue = -1;
+
+			void createHueLookUp(bool hasAmber);
+			void createColorWheelLookUp(ci::Json colorMap);
+			static void createCurve(std::array<unsigned char, 256>& curve, float gamma);
+
+		}; using DMXColorProfileRef = std::shared_ptr<DMXColorProfile>;
+
+	}
+}
@@ -21,6 +21,9 @@
 #include "dmx/DMXRoomNodeBase.hpp"
 #include "dmx/MovingHeadRoomNode.hpp"
 #include "dmx/DimmerRoomNode.hpp"
+#include "dmx/MovingHeadSolver.hpp"
+#include "dmx/MovingHeadPlanner.hpp"
+#include "dmx/DMXColorProfile.hpp"
 
 #include "dmx/DMXPro.hpp"
 
@@ -35,7 +38,7 @@ namespace act {
 			static	std::shared_ptr<DMXManager> create() { return std::make_shared<DMXManager>(); };
 
 			void	setup() override;
-			// void	update() override;
+			void	update() override;
 			// void	draw() override;
 			void	cleanUp() override;
 
@@ -66,6 +69,7 @@ namespace act {
 			void saveFixtures();
 			int getFixtureIndexByName(std::string fixtureName);
 			std::vector<ci::Json>				m_fixtureDescriptions;
+			std::vector<DMXColorProfileRef>		m_colorProfiles;	// one per fixture description, shared by all its devices
 			std::vector<std::string>			m_fixtureNames;
 			int									m_selectedFixture;
 
@@ -73,6 +77,19 @@ namespace act {
 			std::vector<std::string>			m_availableDeviceNames;
 			int									m_currentAddress;
 
+			void updateMovingHeads();
+			std::vector<MovingHeadRoomNodeRef>	m_movingHeads;
+			MovingHeadSolverRef					m_movingHeadSolver;
+			MovingHeadPlannerRef				m_movingHeadPlanner;
+
+			void updateColors();
+			std::vector<std::pair<DMXColorProfileRef, std::vector<DMXRoomNodeBase*>>> m_colorGroups;
+			std::vector<ci::Color>				m_colorIn;
+			std::vector<float>					m_dimmerIn;
+			std::vector<int>					m_addressIn;
+			std::vector<int>					m_colorOutChannels;
+			std::vector<unsigned char>			m_colorOutValues;
+
 		
 		};
 		using DMXManagerRef = std::shared_ptr<DMXManager>;
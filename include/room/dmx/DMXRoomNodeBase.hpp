@@ -19,6 +19,7 @@
 
 #include "roompch.hpp"
 #include "dmx/DMXPro.hpp"
+#include "dmx/DMXColorProfile.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -36,10 +37,19 @@ namespace act {
 			void setDMXInterface(DMXProRef dmxInterface);
 
 			int getStartAddress() { return m_startAddress; };
-			void setStartAddress(int address) { m_startAddress = address; };
+			virtual void setStartAddress(int address) { m_startAddress = address; m_isColorDirty = true; };
 			std::string getFixtureName() { return m_fixtureName; };
 			int getNumberOfChannels() { return m_numberOfChannels; }
 
+			int getChannelAddress(const std::string& channel); // absolute DMX address, -1 if not mapped
+
+			// colour and dimmer are converted by the fixture's DMXColorProfile and written in groups, see DMXManager::update()
+			void				setColorProfile(DMXColorProfileRef profile) { m_colorProfile = profile; m_isColorDirty = true; };
+			DMXColorProfileRef	getColorProfile()	{ return m_colorProfile; };
+			bool				isColorDirty()		{ return m_isColorDirty; };
+			void				clearColorDirty()	{ m_isColorDirty = false; };
+			ci::Color			getColorOutput()	{ return m_colorOutput; };
+			float				getDimmerOutput()	{ return m_dimmerOutput; };
 
 		protected:
 			DMXProRef				m_dmxInterface;
@@ -48,6 +58,12 @@ namespace act {
 			int						m_numberOfChannels;
 
 			bool					setValue(std::string channel, int value);
+			void					setColorOutput(ci::Color color, float dimmer);
+
+			DMXColorProfileRef		m_colorProfile;
+			ci::Color				m_colorOutput	= ci::Color::black();
+			float					m_dimmerOutput	= 0.0f;
+			bool					m_isColorDirty	= false;
 
 			std::map<std::string, int> m_channelMapping;
 			std::map<std::string, util::MinMaxValue<int>> m_channelValues;
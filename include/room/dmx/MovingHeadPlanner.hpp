@@ -0,0 +1,119 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+#include "dmx/DMXPro.hpp"
+#include "dmx/MovingHeadSolver.hpp"
+
+#include <atomic>
+
+using namespace ci;
+using namespace ci::app;
+
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief moves all moving heads from their current pan/tilt to their goals within the fixture's mechanical limits
+		* runs in its own thread at the DMX output rate, so the motion is independent of the main loop.
+		* pan and tilt are time-synchronised (both axes arrive together) and the goal is extrapolated
+		* by its own velocity to compensate tracking latency
+		*/
+		class MovingHeadPlanner
+		{
+		public:
+			MovingHeadPlanner();
+			~MovingHeadPlanner();
+
+			static std::shared_ptr<MovingHeadPlanner> create() { return std::make_shared<MovingHeadPlanner>(); };
+
+			void	start(int rate = DMXPRO_FRAME_RATE);
+			void	stop();
+			bool	isRunning() { return m_isRunning; };
+
+			void	setDMXInterface(DMXProRef dmxInterface);
+
+			void	resize(size_t count);
+			void	setFixture(size_t index, const MovingHeadCalibration& calibration);
+			void	setGoal(size_t index, float pan, float tilt);		// degree
+			void	setCurrent(size_t index, float pan, float tilt);	// jumps there without moving, i.e. after a manual setPanTilt
+			bool	isGoal(size_t index, float pan, float tilt);
+
+			void	setLead(float seconds)	{ m_lead = std::max(0.0f, seconds); };
+			float	getLead()				{ return m_lead; };
+
+			float	getPan(size_t index);
+			float	getTilt(size_t index);
+
+			void	step(float dt);	// advances all heads by dt seconds and writes the universe
+
+		private:
+			struct Axis {
+				float	pos			= 0.0f;
+				float	vel			= 0.0f;
+				float	goal		= 0.0f;
+				float	goalVel		= 0.0f;	// estimated from successive goals, used for the lead
+				float	min			= 0.0f;
+				float	max			= 360.0f;
+				float	maxVel		= 0.0f;
+				float	maxAcc		= 0.0f;
+				float	scale		= 1.0f;	// time-synchronisation with the other axis
+				bool	isMoving	= false;
+
+				void	setGoal(float value, float dt);
+				float	minTime(float distance);
+				bool	step(float target, float dt);
+			};
+
+			struct Head {
+				Axis	pan;
+				Axis	tilt;
+				double	goalTime		= 0.0;
+
+				float	tiltOffset		= 0.0f;
+				bool	isPanFlipped	= false;
+				bool	isTiltFlipped	= false;
+
+				int		panChannel		= -1;
+				int		finePanChannel	= -1;
+				int		tiltChannel		= -1;
+				int		fineTiltChannel	= -1;
+			};
+
+			std::vector<Head>			m_heads;
+			std::mutex					m_mutex;
+			DMXProRef					m_dmxInterface;
+
+			std::thread					m_thread;
+			std::atomic<bool>			m_isRunning = false;
+
+			std::atomic<float>			m_lead = 0.0f;	// seconds
+			float						m_maxExtrapolation = 0.25f;	// seconds, stop predicting if tracking is gone
+
+			std::vector<int>			m_outChannels;
+			std::vector<unsigned char>	m_outValues;
+
+			double now();
+			void emit(const Head& head);
+			void emitChannel(int channel, int value);
+
+		}; using MovingHeadPlannerRef = std::shared_ptr<MovingHeadPlanner>;
+
+	}
+}
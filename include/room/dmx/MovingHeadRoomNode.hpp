@@ -20,6 +20,7 @@
 
 #include "RoomNodeBase.hpp"
 #include "dmx/DMXRoomNodeBase.hpp"
+#include "dmx/MovingHeadSolver.hpp"
 
 #include "dmx/DMXPro.hpp"
 
@@ -62,6 +63,16 @@ namespace act {
 
 			void home();
 
+			virtual void setStartAddress(int address) override;
+
+			// batched pan/tilt, see DMXManager::update()
+			MovingHeadCalibration	syncCalibration();	// returns the current calibration and clears the dirty flag
+			bool					isCalibrationDirty()	{ return m_isCalibrationDirty; };
+			bool					hasPendingLookAt()		{ return m_hasPendingLookAt; };
+			void					applySolvedPanTilt(float pan, float tilt);
+			float					getPan()				{ return m_pan.getValue(); };
+			float					getTilt()				{ return m_tilt.getValue(); };
+
 			inline bool hasZoom()	{ return m_hasZoom; };
 			inline bool hasUV()		{ return m_hasUV; };
 			inline bool hasAmber()	{ return m_hasAmber; };
@@ -91,10 +102,12 @@ namespace act {
 			int m_beamAngleMax		= 10;
 			int m_strobeSpeed		= 25;
 
-			FilterBaseRef<glm::vec3>	m_lookAtFlt;
+			float m_maxPanSpeed			= 0.0f; // degree per second, 0 is unlimited
+			float m_maxTiltSpeed		= 0.0f;
+			float m_maxPanAcceleration	= 0.0f; // degree per second^2, 0 is unlimited
+			float m_maxTiltAcceleration	= 0.0f;
 
-			ci::quat					m_gaze;
-			ci::quat					m_previousGaze;
+			FilterBaseRef<glm::vec3>	m_lookAtFlt;
 
 			float						m_yaw;		// radians
 			float						m_pitch;	// radians
@@ -118,18 +131,16 @@ namespace act {
 			bool						m_isPanFlipped	= false;
 			bool						m_isTiltFlipped = false;
 
-			std::map<int, int>			m_colorWheelLookUp; // hue to chnVal
-			void createColorWheelLookUp(ci::Json colorMap);
-			bool						m_hasWhiteColorWheel;
-			int							m_whiteColorWheelValue;
+			bool						m_isCalibrationDirty	= true;
+			bool						m_hasPendingLookAt		= false;
 
-			bool polarToPanTilt();
 			void panTiltToPolar();
 
 			void panTo(float pan);
 			void tiltTo(float tilt);
 
 			virtual void onPosition(act::UID replyUID = "", bool publish = true) override;
+			virtual void onOrientation(act::UID replyUID = "", bool publish = true) override;
 
 		}; using MovingHeadRoomNodeRef = std::shared_ptr<MovingHeadRoomNode>;
 		
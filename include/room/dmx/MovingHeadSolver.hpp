@@ -0,0 +1,110 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+
+using namespace ci;
+using namespace ci::app;
+
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief everything the solver needs to know about a single moving head, precomputed once per mount change
+		*/
+		struct MovingHeadCalibration {
+			ci::vec3	position			= ci::vec3(0.0f);
+			ci::quat	orientation			= ci::quat();	// mount orientation, the solver keeps the inverse
+
+			float		panRange			= 360.0f;		// degree
+			float		tiltRange			= 180.0f;		// degree
+			float		tiltOffset			= 0.0f;			// degree
+			float		panCenterOffset		= 0.0f;			// degree
+			float		tiltCenterOffset	= 0.0f;			// degree
+
+			bool		isPanFlipped		= false;
+			bool		isTiltFlipped		= false;
+
+			int			panChannel			= -1;			// absolute DMX address, -1 if not mapped
+			int			finePanChannel		= -1;
+			int			tiltChannel			= -1;
+			int			fineTiltChannel		= -1;
+
+			float		maxPanSpeed			= 0.0f;			// degree per second, 0 is unlimited
+			float		maxTiltSpeed		= 0.0f;			// degree per second, 0 is unlimited
+			float		maxPanAcceleration	= 0.0f;			// degree per second^2, 0 is unlimited
+			float		maxTiltAcceleration	= 0.0f;			// degree per second^2, 0 is unlimited
+		};
+
+		/**
+		* @brief batched pan/tilt inverse kinematics for all moving heads of a universe
+		* fixtures are stored as structure of arrays, so solve() runs all targets in one flat loop,
+		* the resulting pan/tilt goals are handed to the MovingHeadPlanner
+		*/
+		class MovingHeadSolver
+		{
+		public:
+			MovingHeadSolver();
+			~MovingHeadSolver();
+
+			static std::shared_ptr<MovingHeadSolver> create() { return std::make_shared<MovingHeadSolver>(); };
+
+			void	resize(size_t count);
+			size_t	size() const { return m_count; };
+
+			void	setFixture(size_t index, const MovingHeadCalibration& calibration);
+			void	setTarget(size_t index, ci::vec3 target);
+			void	setCurrent(size_t index, float pan, float tilt);	// seed for shortest-path selection
+
+			void	solve();
+
+			bool	isSolved(size_t index) const	{ return m_isSolved[index] != 0; };
+			bool	isReachable(size_t index) const { return m_isReachable[index] != 0; };
+			float	getPan(size_t index) const		{ return m_pan[index]; };		// degree
+			float	getTilt(size_t index) const		{ return m_tilt[index]; };		// degree
+
+			/**
+			* @brief maps a normalized [0..1] position to a 16-bit coarse/fine pair
+			*/
+			static void encode16(double normalized, int& coarse, int& fine);
+			static double panToNormalized(float pan, float panRange, bool isFlipped);
+			static double tiltToNormalized(float tilt, float tiltOffset, float tiltRange, bool isFlipped);
+
+		private:
+			size_t				m_count = 0;
+
+			// fixtures (SoA)
+			std::vector<float>	m_posX, m_posY, m_posZ;
+			std::vector<float>	m_inv00, m_inv01, m_inv02;	// inverse mount rotation, row major
+			std::vector<float>	m_inv10, m_inv11, m_inv12;
+			std::vector<float>	m_inv20, m_inv21, m_inv22;
+			std::vector<float>	m_panRange, m_tiltRange, m_tiltOffset;
+			std::vector<float>	m_panCenter, m_tiltCenter;	// pan/tilt in degree at phi = 0 / theta = 0
+
+			// targets and results (SoA)
+			std::vector<float>	m_tgtX, m_tgtY, m_tgtZ;
+			std::vector<char>	m_hasTarget;
+			std::vector<float>	m_pan, m_tilt;
+			std::vector<char>	m_isSolved;
+			std::vector<char>	m_isReachable;
+
+		}; using MovingHeadSolverRef = std::shared_ptr<MovingHeadSolver>;
+
+	}
+}
@@ -0,0 +1,120 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+#include "kinect/KinectDevice.hpp"
+
+#include <array>
+#include <unordered_map>
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief fuses the bodies of several sensors into bodies with stable global ids
+		* every sensor's bodies (already in room space) are associated to the tracks near them, candidates come from a spatial hash of the tracks.
+		* bodies and tracks that share candidates form a connected component, each one gets its own small assignment,
+		* so the cost grows with the size of the groups instead of the number of bodies.
+		* joints are averaged weighted by their confidence and moved to the common time by the track's velocity
+		*/
+		class BodyFusion
+		{
+		public:
+			BodyFusion();
+			~BodyFusion();
+
+			void	begin(double time);
+			void	addBodies(size_t sensor, double time, const std::map<uint32_t, k4abt_skeleton_t>& bodies);
+			void	end();
+
+			const std::map<uint32_t, k4abt_skeleton_t>& getBodies() const { return m_bodies; };	// by global id
+
+			float	getGateDistance()			{ return m_gateDistance; };
+			void	setGateDistance(float gate)	{ m_gateDistance = std::max(0.01f, gate); };
+			float	getMaxMissingTime()			{ return m_maxMissingTime; };
+			void	setMaxMissingTime(float t)	{ m_maxMissingTime = std::max(0.0f, t); };
+
+			/**
+			* @brief optimal assignment of rows to columns of a square cost matrix (Hungarian method), O(n^3)
+			*/
+			static void solveAssignment(const std::vector<float>& cost, int n, std::vector<int>& rowToCol);
+
+		private:
+			static const int kJoints = 32;
+
+			struct Track {
+				uint32_t	id;
+				ci::vec3	center;
+				ci::vec3	velocity	= ci::vec3(0.0f);
+				double		time;
+				k4abt_skeleton_t skeleton;
+
+				// accumulated over the sensors of the current frame
+				int								observations = 0;
+				std::array<ci::vec3, kJoints>	positionSum;
+				std::array<float, kJoints>		weightSum;
+				std::array<ci::quat, kJoints>	orientationSum;
+				std::array<int, kJoints>		confidence;
+				std::array<ci::vec3, kJoints>	fallbackSum;	// of joints without any confidence
+			};
+
+			std::vector<Track>		m_tracks;
+			std::map<std::pair<size_t, uint32_t>, uint32_t>	m_associations;	// sensor and its body id to global id of the last frame
+			std::map<uint32_t, k4abt_skeleton_t>			m_bodies;
+			uint32_t				m_nextID = 1;
+			double					m_time = 0.0;
+
+			float					m_gateDistance		= 0.5f;	// m, between the chests
+			float					m_maxMissingTime	= 0.5f;	// s
+
+			// spatial hash over the track centers on the floor, the cells are as large as the gate
+			std::unordered_map<int64_t, std::vector<uint32_t>>	m_grid;
+			std::vector<uint32_t>	m_candidates;
+
+			// bipartite graph of the bodies (rows) and the tracks within the gate (columns)
+			struct Edge {
+				int		row;
+				int		col;
+				int		component;
+				float	cost;
+			};
+			std::vector<Edge>		m_edges;
+			std::vector<int>		m_trackColumn;	// of each track, -1 if it is not a candidate
+			std::vector<int>		m_parent;		// union-find over the rows followed by the columns
+			std::vector<int>		m_rowColumn;	// assigned column of each row, -1 for a new track
+			std::vector<int>		m_localRow;
+			std::vector<int>		m_localCol;
+			std::vector<int>		m_componentRows;
+			std::vector<int>		m_componentCols;
+			std::vector<float>		m_cost;
+			std::vector<int>		m_assignment;
+
+			int64_t		cellKey(int x, int z) const { return ((int64_t)x << 32) ^ (uint32_t)z; };
+			ci::ivec2	cell(const ci::vec3& position) const { return ci::ivec2((int)floorf(position.x / m_gateDistance), (int)floorf(position.z / m_gateDistance)); };
+			void		insert(uint32_t track);
+			int			findComponent(int node);
+			void		assignComponent(size_t begin, size_t end);	// edges [begin, end) of one component
+			void		accumulate(Track& track, double time, const k4abt_skeleton_t& skeleton);
+			uint32_t	createTrack(double time, const k4abt_skeleton_t& skeleton);
+
+			static ci::vec3	getCenter(const k4abt_skeleton_t& skeleton);
+			static float	confidenceWeight(int confidence);
+		};
+
+	}
+}
@@ -19,6 +19,10 @@
 
 #include "roompch.hpp"
 #include "KinectHelper.hpp"
+#include "kinect/KinectPipeline.hpp"
+
+#include <atomic>
+#include <thread>
 
 #if __has_include(<k4a/k4a.h>)
 #define WITHKINECT
@@ -33,7 +37,7 @@ using k4a_float3_t = struct {
 	struct xyz {
 		float x;
 		float y;
-		float Z;
+		float z;
 	} xyz;
 };
 using k4a_quaternion_t = struct {
@@ -41,7 +45,7 @@ using k4a_quaternion_t = struct {
 		float w;
 		float x;
 		float y;
-		float Z;
+		float z;
 	} wxyz;
 };
 using k4abt_joint_confidence_level_t = int;
@@ -75,6 +79,22 @@ namespace act {
 			KS_CAPTURING,
 		};
 
+		/**
+		* @brief tracker result of a single capture, stamped with the time of the capture
+		*/
+		struct KinectBodies {
+			double		timestamp	= 0.0;
+			uint64_t	sequence	= 0;
+
+			std::map<uint32_t, k4abt_skeleton_t>	bodies;
+			cv::UMat								bodyIndex;
+		}; using KinectBodiesRef = std::shared_ptr<const KinectBodies>;
+
+		/**
+		* @brief runs capture, body tracking and pointcloud generation in a thread each,
+		* connected by bounded latest-wins queues. every stage publishes immutable snapshots,
+		* update() only takes over the newest ones on the main thread
+		*/
 		class KinectDevice {
 		public:
 
@@ -88,7 +108,7 @@ namespace act {
 			virtual void startDevice(bool mode);
 			virtual void stopDevice();
 			
-			virtual void update();
+			void update();
 
 			k4a::device& getDevice() { return m_device; };
 			std::string getName() { return m_name; };
@@ -102,6 +122,7 @@ namespace act {
 			void setIsCapturingBodies(bool isCapturing) { m_isCapturingBodies = isCapturing; };
 
 			void setIsProvidingPointCloud(bool isProviding) { m_isProvidingPointCloud = isProviding; };
+			void setPointCloudVoxelSize(float voxelSize) { m_pointCloudVoxelSize = std::max(0.0f, voxelSize); }; // m, 0 keeps every pixel
 
 
 			void setIsDrawing2dJoints(bool isDrawing2dJoints) { m_isDrawing2dJoints = isDrawing2dJoints; };
@@ -116,15 +137,25 @@ namespace act {
 			cv::UMat getDepthFrame() { return m_depthFrame; };
 			cv::UMat getInfraRedFrame() { return m_infraRedFrame; };
 			cv::UMat getBIMFrame() { return m_bodyIndexFrame; };
-			//Pointcloud getPointCloud() { return m_pointcloud; };
+			std::shared_ptr<std::vector<glm::vec3>> getPointCloud() { return m_currentPoints ? m_currentPoints->points : nullptr; };
 
 			float getTemperatureSample() { return m_temperatureSample; };
 			vec3 getAccelerometerSample() { return m_accelerometerSample; };
 			vec3 getGyroscopeSample() { return m_gyroscopeSample; };
 
 
-			std::map<uint32_t, k4abt_skeleton_t> getBodyMap() { return m_bodyMap; };
+			const std::map<uint32_t, k4abt_skeleton_t>& getBodyMap() { return m_currentBodies->bodies; };
 			std::map<uint32_t, k4abt_skeleton_t> getRepositionedBodies() { return m_repositionedBodyMap; };
+			double getBodyTime() { return m_currentBodies->timestamp; }; // s on the steady clock, when the capture of the current bodies arrived
+
+			// newest snapshots of the stages, independent of update()
+			KinectFrameRef	getLatestFrame()	{ return m_frame.load(); };
+			KinectBodiesRef	getLatestBodies()	{ return m_bodies.load(); };
+			KinectPointsRef	getLatestPoints()	{ return m_points.load(); };
+
+			// captures the tracker and the pointcloud generation could not keep up with
+			uint64_t getDroppedTrackerCaptures()	{ return m_trackerQueue.getDropped(); };
+			uint64_t getDroppedPointCloudCaptures()	{ return m_pointcloudQueue.getDropped(); };
 
 			cv::Mat getColorMap() { return m_colorMap; };
 
@@ -149,7 +180,6 @@ namespace act {
 			act::UID m_nodeUID;
 
 			k4a::device m_device = nullptr;
-			k4a::capture m_capture;
 			k4a_device_configuration_t m_deviceConfiguration;
 
 			k4a::calibration m_sensorCalibration;
@@ -158,17 +188,20 @@ namespace act {
 
 			const uint32_t m_deviceIndex;
 
+			// taken over from the snapshots by update()
 			cv::UMat m_colorFrame;
 			cv::UMat m_depthFrame;
 			cv::UMat m_infraRedFrame;
 			cv::UMat m_bodyIndexFrame;
-			// Pointcloud m_pointcloud;
 
 			float m_temperatureSample;
 			vec3 m_accelerometerSample;
 			vec3 m_gyroscopeSample;
 
-			std::map<uint32_t, k4abt_skeleton_t> m_bodyMap;
+			KinectFrameRef	m_currentFrame;
+			KinectBodiesRef	m_currentBodies = std::make_shared<KinectBodies>();
+			KinectPointsRef	m_currentPoints;
+
 			std::map<uint32_t, k4abt_skeleton_t> m_repositionedBodyMap;
 			int m_numOfBodies = -1;
 
@@ -176,44 +209,63 @@ namespace act {
 
 			cv::Mat m_colorMap;
 
-			//Pointcloud toPointCloud(k4a::image depth, k4a::image color = nullptr);
-
-			KinectState m_state = KinectState::KS_CLOSED;
+			std::atomic<KinectState> m_state = KinectState::KS_CLOSED;
 
-			bool m_isCapturingBodies = true;
-			bool m_isCapturingImage = false;
-			bool m_isCapturingDepth = false;
-			bool m_isCapturingIR = false;
-			bool m_isCapturingIMU = false;
+			// read by the pipeline threads
+			std::atomic<bool> m_isCapturingBodies = true;
+			std::atomic<bool> m_isCapturingImage = false;
+			std::atomic<bool> m_isCapturingDepth = false;
+			std::atomic<bool> m_isCapturingIR = false;
+			std::atomic<bool> m_isCapturingIMU = false;
 
-			bool m_isProvidingPointCloud = true;
+			std::atomic<bool> m_isProvidingPointCloud = true;
+			std::atomic<float> m_pointCloudVoxelSize = 0.0f;
 
 			bool m_isDrawing2dJoints = false;
 
 			bool m_isDummy = false;
 
+			/**
+			* @brief waits for the next capture of the source with a timeout, stamped on the steady clock
+			*/
+			virtual bool grab(k4a::capture& capture, double& timestamp);
 
-			void updateColor(k4a::image colorImage);
-			void updateDepth(k4a::image depthImage);
-			void updatePointCloud(k4a::image depth, k4a::image color = nullptr);
-			void updateIR(k4a::capture capture);
-
-			void updateIMU();
+			void startPipeline();
+			void stopPipeline();
+			void bodyTrackingInit(bool cpuMode);
 
+			static double now();
 
 		private:
+			struct CaptureItem {
+				k4a::capture	capture;
+				double			timestamp	= 0.0;
+				uint64_t		sequence	= 0;
+			};
+
+			std::atomic<bool>			m_isRunning = false;
+			std::thread					m_captureThread;
+			std::thread					m_trackerThread;
+			std::thread					m_pointcloudThread;
+
+			LatestQueue<CaptureItem>	m_trackerQueue;
+			LatestQueue<CaptureItem>	m_pointcloudQueue;
 
+			std::atomic<KinectFrameRef>		m_frame;
+			std::atomic<KinectBodiesRef>	m_bodies;
+			std::atomic<KinectPointsRef>	m_points;
 
 			void initialize();
-			void bodyTrackingInit(bool cpuMode);
 
 			void getSerialNumber();
 
 			void update2dJoints();
 
-			void updateBodyTracker();
-			void updateSkeletons(k4abt::frame bodyFrame);
-			void updateBodyIndexMap(k4abt::frame bodyFrame);
+			void captureLoop();
+			void trackerLoop();
+			void pointcloudLoop();
+
+			static cv::UMat toFlippedUMat(k4a::image image);
 
 			void generateSkeleton2dCoordinates(k4abt_skeleton_t skeleton, int id);
 		};
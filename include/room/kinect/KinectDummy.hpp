@@ -28,6 +28,9 @@
 namespace act {
 	namespace room {
 
+		/**
+		* @brief plays back a recording through the same capture, tracker and pointcloud pipeline as a device
+		*/
 		class KinectDummy : public KinectDevice {
 		public:
 
@@ -40,8 +43,6 @@ namespace act {
 			void startDevice(bool mode) override;
 			void stopDevice() override;
 
-			void update() override;
-
 			k4a::device& getDevice()				{ return m_device; };
 			std::string getName()				{ return m_name; };
 			uint32_t getDeviceIndex()				{ return m_deviceIndex; };
@@ -49,9 +50,16 @@ namespace act {
  
 			bool isTracking() override { return true; };
 
+		protected:
+			/**
+			* @brief next capture of the recording, paced by its device timestamps and looped at the end
+			*/
+			bool grab(k4a::capture& capture, double& timestamp) override;
+
 		private:
 			k4a_playback_t					m_playback;
 			std::string						m_path;
+			double							m_playbackStart = -1.0;	// steady clock time of the recording's time 0
 
 			//int							m_currentBodyMapIndex;
 			//std::vector<std::map<uint32_t, k4abt_skeleton_t>> m_bodyMaps;
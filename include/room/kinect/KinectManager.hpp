@@ -23,6 +23,8 @@
 
 #include <k4a/k4a.hpp>
 #include "kinect/KinectDevice.hpp"
+#include "kinect/BodyFusion.hpp"
+#include "kinect/KinectRecording.hpp"
 
 #include "KinectHelper.hpp"
 #include "body/Body.hpp"
@@ -81,6 +83,7 @@ namespace act {
 			PointcloudRoomNodeRef createPointcloudRoomNode();
 
 			room::BodyRefList getBodies();
+			void getBodies(room::BodyStore& store);
 			std::map < uint32_t, k4abt_skeleton_t> getBodiesMerged() { return m_bodiesMerged; };
 
 			std::map<std::string, kinectConnectionState> getDevicesAndStates() { return m_devicesAndStates;};
@@ -93,15 +96,22 @@ namespace act {
 			std::string m_dummyPath = "";
 			act::room::RoomNodeBaseRef m_dummyDevice;
 
+			// the fused bodies, depth images and pointclouds can be recorded, a playing recording replaces the live bodies
+			KinectRecorder			m_recorder;
+			KinectRecordingPlayer	m_player;
+			bool					m_isRecordDialog	= false;
+			bool					m_isPlaybackDialog	= false;
+			std::vector<uint64_t>	m_recordedFrames;	// per device, sequence of the last recorded snapshot
+			std::vector<uint64_t>	m_recordedPoints;
+			PointcloudRoomNodeRef	m_playbackPointcloud;
+			bool					m_isPlaybackPointcloudNew = false;
+
 			int m_devicesInstalledCount = 0;
 
 			bool cpu_mode = false;
 
-			bool simpleMergeMode = true;
-			//When 2 bodies' distances (in meter) are under the threshold, they get merged to one body
-			float m_bodyClippingThreshold = 0.3f;
-
-			std::thread	m_updateThread;
+			//bodies of all sensors in room space are associated and merged to bodies with stable ids
+			BodyFusion m_fusion;
 
 			//Parent joints regarding to joint index --> https://docs.microsoft.com/en-us/azure/kinect-dk/body-joints
 			const int jointParentLookUp[32] = { 0, 0, 1, 2, 2, 4, 5, 6, 7, 8, 7, 2, 11, 12, 13, 14, 15, 14, 0, 18, 19, 20, 0, 22, 23, 24, 3, 26, 26, 26, 26, 26 };
@@ -110,7 +120,6 @@ namespace act {
 			const float COLOROFFSET = 0.56f;
 
 			std::map<uint32_t, k4abt_skeleton_t> m_bodiesMerged;
-			std::map<uint32_t, std::pair< k4abt_skeleton_t, int>> m_bodiesWithDuplicates;
 
 			std::map<std::string, kinectConnectionState> m_devicesAndStates;
 
@@ -127,7 +136,9 @@ namespace act {
 			std::vector<act::room::KinectDeviceRef>	getDevices();
 			void addDummyDevice(std::string path);
 
-			void checkRedundantBodies(std::map<uint32_t, k4abt_skeleton_t> currBodies);
+			void startRecording(std::string path);
+			void startPlayback(std::string path);
+			void record();
 
 			bool checkConnectionState(std::string kinectName);
 
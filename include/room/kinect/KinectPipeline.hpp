@@ -0,0 +1,124 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief images and IMU of a single capture, immutable once published
+		*/
+		struct KinectFrame {
+			double		timestamp	= 0.0;	// s on the steady clock, when the capture arrived
+			uint64_t	sequence	= 0;
+
+			cv::UMat	color;
+			cv::UMat	depth;
+			cv::UMat	infraRed;
+
+			float		temperature		= 0.0f;
+			ci::vec3	accelerometer	= ci::vec3(0.0f);
+			ci::vec3	gyroscope		= ci::vec3(0.0f);
+		}; using KinectFrameRef = std::shared_ptr<const KinectFrame>;
+
+		/**
+		* @brief points of a single depth image in the sensor's space, in m
+		*/
+		struct KinectPoints {
+			double		timestamp	= 0.0;
+			uint64_t	sequence	= 0;
+
+			std::shared_ptr<std::vector<glm::vec3>>	points;	// not to be modified after publishing
+		}; using KinectPointsRef = std::shared_ptr<const KinectPoints>;
+
+		/**
+		* @brief bounded queue between two pipeline stages, a full queue drops its oldest item
+		* so a slow consumer always continues with the latest data instead of falling behind
+		*/
+		template<typename T>
+		class LatestQueue
+		{
+		public:
+			LatestQueue(size_t capacity = 1) : m_capacity(std::max<size_t>(1, capacity)) {};
+
+			// false if an older item had to be dropped
+			bool push(T item) {
+				bool dropped = false;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_isClosed)
+						return false;
+					if (m_items.size() >= m_capacity) {
+						m_items.pop_front();
+						m_dropped++;
+						dropped = true;
+					}
+					m_items.push_back(std::move(item));
+				}
+				m_condition.notify_one();
+				return !dropped;
+			};
+
+			// waits for the next item, false once the queue is closed
+			bool pop(T& item) {
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [&]() { return !m_items.empty() || m_isClosed; });
+				if (m_isClosed)
+					return false;
+				item = std::move(m_items.front());
+				m_items.pop_front();
+				return true;
+			};
+
+			void open() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_items.clear();
+				m_isClosed = false;
+			};
+
+			// wakes up and releases all waiting consumers
+			void close() {
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_items.clear();
+					m_isClosed = true;
+				}
+				m_condition.notify_all();
+			};
+
+			uint64_t getDropped() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_dropped;
+			};
+
+		private:
+			std::mutex				m_mutex;
+			std::condition_variable	m_condition;
+			std::deque<T>			m_items;
+			size_t					m_capacity;
+			uint64_t				m_dropped	= 0;
+			bool					m_isClosed	= false;
+		};
+
+	}
+}
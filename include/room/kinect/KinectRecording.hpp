@@ -0,0 +1,188 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+#include "kinect/KinectDevice.hpp"
+
+#include <fstream>
+
+namespace act {
+	namespace room {
+
+		/*
+			.iarec recording, independent of the Kinect SDK
+
+			header		"IAKREC01", uint32 version, uint32 reserved
+			chunks		ChunkHeader followed by its payload, padded to 8 bytes
+						CT_BODIES	uint32 count, per body uint32 id and 32 joints of float position[3], float orientation wxyz[4], int32 confidence
+						CT_DEPTH	int32 width, int32 height, uint16 depth[width * height] in mm
+						CT_POINTS	uint32 count, float xyz[count * 3] in m
+			index		IndexEntry per chunk
+			footer		uint64 index offset, uint64 index count, "IAKRIDX1"
+
+			a recording without footer (e.g. after a crash) is indexed by scanning its chunks
+		*/
+		namespace recording {
+			enum ChunkType : uint32_t {
+				CT_BODIES	= 1,
+				CT_DEPTH	= 2,
+				CT_POINTS	= 3
+			};
+
+			struct ChunkHeader {
+				uint32_t	type;
+				uint32_t	stream;		// sensor index, the fused bodies are stream 0
+				double		timestamp;	// s since the start of the recording
+				uint64_t	size;		// of the payload
+			};
+
+			struct IndexEntry {
+				uint32_t	type;
+				uint32_t	stream;
+				double		timestamp;
+				uint64_t	offset;		// of the chunk header
+			};
+
+			static const char		kMagic[8]		= { 'I', 'A', 'K', 'R', 'E', 'C', '0', '1' };
+			static const char		kIndexMagic[8]	= { 'I', 'A', 'K', 'R', 'I', 'D', 'X', '1' };
+			static const uint32_t	kVersion		= 1;
+		}
+
+		/**
+		* @brief writes bodies, depth images and pointclouds to an .iarec recording
+		*/
+		class KinectRecorder
+		{
+		public:
+			KinectRecorder();
+			~KinectRecorder();
+
+			bool	open(const fs::path& path);
+			void	close();	// writes the index
+			bool	isOpen() { return m_file.is_open(); };
+
+			void	addBodies(double time, const std::map<uint32_t, k4abt_skeleton_t>& bodies, uint32_t stream = 0);
+			void	addDepth(double time, const cv::Mat& depth, uint32_t stream);
+			void	addPoints(double time, const std::vector<glm::vec3>& points, uint32_t stream);
+
+			double	getDuration()	{ return m_duration; };
+			size_t	getChunkCount()	{ return m_index.size(); };
+
+		private:
+			std::ofstream						m_file;
+			uint64_t							m_offset	= 0;
+			double								m_start		= -1.0;
+			double								m_duration	= 0.0;
+			std::vector<recording::IndexEntry>	m_index;
+			std::vector<char>					m_buffer;
+
+			void	writeChunk(recording::ChunkType type, uint32_t stream, double time);
+			template<typename T>
+			void	append(const T& value) { const char* data = (const char*)&value; m_buffer.insert(m_buffer.end(), data, data + sizeof(T)); };
+		};
+
+		/**
+		* @brief plays an .iarec recording from a memory mapping, either in time or as fast as possible
+		* as fast as possible advances by exactly one bodies chunk per update(), so runs are reproducible
+		*/
+		class KinectRecordingPlayer
+		{
+		public:
+			KinectRecordingPlayer();
+			~KinectRecordingPlayer();
+
+			bool	open(const fs::path& path);
+			void	close();
+			bool	isOpen() { return m_data != nullptr; };
+
+			void	play();
+			void	pause()		{ m_isPlaying = false; };
+			bool	isPlaying() { return m_isPlaying; };
+			void	seek(double time);
+
+			bool	isRealtime()					{ return m_isRealtime; };
+			void	setIsRealtime(bool isRealtime)	{ m_isRealtime = isRealtime; m_playStart = -1.0; };
+			bool	isLooping()						{ return m_isLooping; };
+			void	setIsLooping(bool isLooping)	{ m_isLooping = isLooping; };
+			float	getSpeed()						{ return m_speed; };
+			void	setSpeed(float speed)			{ m_speed = std::max(0.01f, speed); m_playStart = -1.0; };
+
+			/**
+			* @brief advances the playback, true if new chunks have been read
+			*/
+			bool	update();
+
+			double	getTime()		{ return m_time; };
+			double	getDuration()	{ return m_duration; };
+
+			const std::map<uint32_t, k4abt_skeleton_t>& getBodies() { return m_bodies; };	// fused, stream 0
+			double	getBodyTime()	{ return m_bodyTime; };
+			bool	hasPoints()		{ return m_hasPoints; };
+
+			/**
+			* @brief latest depth image of a stream, a view into the mapping that stays valid while the recording is open
+			*/
+			cv::Mat	getDepth(uint32_t stream = 0);
+			std::shared_ptr<std::vector<glm::vec3>> getPoints(uint32_t stream = 0);
+
+		private:
+			const uint8_t*	m_data	= nullptr;
+			size_t			m_size	= 0;
+#ifdef _WIN32
+			HANDLE			m_fileHandle	= INVALID_HANDLE_VALUE;
+			HANDLE			m_mapping		= NULL;
+#endif
+
+			std::vector<recording::IndexEntry>	m_index;
+			size_t			m_cursor		= 0;
+			double			m_duration		= 0.0;
+			double			m_time			= 0.0;
+			double			m_playStart		= -1.0;	// steady clock time of recording time 0
+			bool			m_isPlaying		= false;
+			bool			m_isRealtime	= true;
+			bool			m_isLooping		= true;
+			float			m_speed			= 1.0f;
+			bool			m_hasPoints		= false;
+
+			std::map<uint32_t, k4abt_skeleton_t>	m_bodies;
+			double									m_bodyTime = 0.0;
+			std::map<uint32_t, uint64_t>			m_depthChunks;	// stream to offset of its latest chunk
+			std::map<uint32_t, uint64_t>			m_pointChunks;
+			std::map<uint32_t, std::pair<uint64_t, std::shared_ptr<std::vector<glm::vec3>>>> m_pointCache;
+
+			bool	map(const fs::path& path);
+			void	unmap();
+			bool	readIndex();
+			void	scanIndex();
+			/** @brief header and payload of the chunk lie within the file and fit its type */
+			bool	isValidChunk(const recording::IndexEntry& entry);
+			void	readUntil(double time);
+			void	readChunk(const recording::IndexEntry& entry);
+			void	readBodies(uint64_t offset);
+
+			template<typename T>
+			T		read(uint64_t offset) {
+				T value{};
+				if (offset <= m_size && m_size - offset >= sizeof(T))
+					memcpy(&value, m_data + offset, sizeof(T));
+				return value;
+			};
+		};
+
+	}
+}
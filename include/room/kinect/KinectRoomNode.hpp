@@ -47,13 +47,18 @@ namespace act {
 			virtual void update()	override;
 			virtual void draw()		override;
 
-			virtual void drawSpecificSettings() override;
-
-			virtual ci::Json toParams() override;
-			virtual void fromParams(ci::Json json) override;
-
 			Pointcloud getWorldSpacePointCloud();
 
+			/**
+			* @brief sensor to room transform, derived from the pose of the node
+			*/
+			ci::mat4	getExtrinsics();
+			/**
+			* @brief time of the current bodies on the common steady clock, corrected by the sensor's latency
+			*/
+			double		getBodyTime() { return m_kinect ? m_kinect->getBodyTime() - m_latency : 0.0; };
+			const std::map<uint32_t, k4abt_skeleton_t>& getRepositionedBodies() { return m_repositionedBodies; };
+
 			act::proc::ImageOutputPortRef getKinectImagePort() { return m_kinectImageOutPort; }
 			act::proc::ImageOutputPortRef getKinectDepthPort() { return m_kinectDepthOutPort; }
 			act::proc::ImageOutputPortRef getKinectIRPort() { return m_kinectIROutPort; }
@@ -123,6 +128,8 @@ namespace act {
 			ci::vec3				m_offsetRotation = ci::vec3(0.0f);
 
 			bool					m_isProvidingPointCloud;
+			float					m_pointCloudVoxelSize = 0.02f;	// m, downsampled in the device's pointcloud thread
+			float					m_latency = 0.0f;	// s, from capture to the skeletons being available
 
 			ci::CameraPersp			m_cameraPersp;
 
@@ -135,7 +142,7 @@ namespace act {
 
 			void initCameraPersp(int width, int height);
 			std::map<uint32_t, k4abt_skeleton_t> repositionBodies(std::map<uint32_t, k4abt_skeleton_t> bodyMap);
-			vec3 calcRoomPos(vec3 pos);			
+			vec3 calcRoomPos(vec3 pos, const ci::mat4& extrinsics);
 
 		}; using KinectRoomNodeRef = std::shared_ptr<KinectRoomNode>;
 	}
@@ -0,0 +1,79 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "stddef.hpp"
+
+#ifdef _WIN32
+#include <ppl.h>
+#endif
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief downsampling and outlier removal of pointclouds, both deterministic and spread over all cores
+		*/
+		class PointcloudFilter
+		{
+		public:
+			/**
+			* @brief replaces the points of each voxel by their centroid, the result is ordered by voxel
+			*/
+			static void voxelDownsample(const std::vector<glm::vec3>& points, float voxelSize, std::vector<glm::vec3>& result);
+
+			/**
+			* @brief statistical outlier removal: drops points whose mean distance to their nearest neighbors
+			* is more than stddevMultiplier standard deviations above the mean of all points,
+			* neighbors are searched within searchRadius, missing ones count as searchRadius away
+			*/
+			static void removeOutliers(const std::vector<glm::vec3>& points, int neighbors, float stddevMultiplier, float searchRadius, std::vector<glm::vec3>& result);
+
+			/**
+			* @brief calls fn(i) for i in [0, count) in chunks on all cores (ppl on Windows, serial elsewhere)
+			*/
+			template<typename F>
+			static void parallelFor(size_t count, F&& fn, size_t grain = 4096) {
+				size_t chunks = (count + grain - 1) / grain;
+				auto chunk = [&](size_t c) {
+					size_t end = std::min(count, (c + 1) * grain);
+					for (size_t i = c * grain; i < end; i++)
+						fn(i);
+				};
+#ifdef _WIN32
+				if (chunks > 1) {
+					concurrency::parallel_for(size_t(0), chunks, chunk);
+					return;
+				}
+#endif
+				for (size_t c = 0; c < chunks; c++)
+					chunk(c);
+			};
+
+		private:
+			// 21 bits per axis, cells within +-2^20 around the origin
+			static uint64_t cellKey(const glm::ivec3& cell) {
+				return  ((uint64_t)(cell.x + (1 << 20)) & 0x1FFFFF)
+					| (((uint64_t)(cell.y + (1 << 20)) & 0x1FFFFF) << 21)
+					| (((uint64_t)(cell.z + (1 << 20)) & 0x1FFFFF) << 42);
+			};
+
+			static void sortByCell(const std::vector<glm::vec3>& points, float cellSize, std::vector<std::pair<uint64_t, uint32_t>>& sorted);
+		};
+
+	}
+}
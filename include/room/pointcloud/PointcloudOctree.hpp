@@ -0,0 +1,93 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "stddef.hpp"
+#include "Bounding.hpp"
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief incremental octree over points, for region and occupancy queries (e.g. points inside an actionspace)
+		* leaves keep their points as SoA so they can be tested four at a time, nodes fully inside a box
+		* are counted without touching their points. the root grows when points fall outside of it
+		*/
+		class PointcloudOctree
+		{
+		public:
+			PointcloudOctree(ci::vec3 center = ci::vec3(0.0f, 1.0f, 0.0f), float halfSize = 4.0f, float minCellSize = 0.05f, uint32_t leafCapacity = 64);
+			~PointcloudOctree();
+
+			void	clear();
+			void	insert(const ci::vec3& point);
+			void	insert(const std::vector<ci::vec3>& points);
+			void	build(const std::vector<ci::vec3>& points) { clear(); insert(points); };
+
+			size_t	size() { return m_nodes[0].count; };
+			ci::AxisAlignedBox getBounds();
+
+			size_t	countInBox(const ci::AxisAlignedBox& box);
+			void	getPointsInBox(const ci::AxisAlignedBox& box, std::vector<ci::vec3>& result);
+			size_t	countInSphere(ci::vec3 center, float radius);
+			/**
+			* @brief points inside any bounding volume, leaves are pruned by its world bounds and tested in batches
+			*/
+			size_t	countInVolume(BoundingBase& volume);
+
+			/**
+			* @brief true as soon as minPoints are found inside the box
+			*/
+			bool	isOccupied(const ci::AxisAlignedBox& box, size_t minPoints = 1);
+
+		private:
+			struct Node {
+				ci::vec3			center;
+				float				halfSize;
+				int32_t				children	= -1;	// first of 8 consecutive nodes
+				uint32_t			count		= 0;	// of the whole subtree
+				std::vector<float>	x, y, z;			// leaves only
+			};
+
+			std::vector<Node>	m_nodes;	// root is 0
+			float				m_minCellSize;
+			uint32_t			m_leafCapacity;
+			ci::vec3			m_initialCenter;
+			float				m_initialHalfSize;
+
+			std::vector<int32_t>	m_stack;
+			std::vector<int32_t>	m_subtree;
+			std::vector<ci::vec3>	m_batch;
+			std::vector<uint8_t>	m_batchResult;
+
+			void	grow(const ci::vec3& towards);
+			void	split(int32_t node);
+			int32_t	allocateChildren(const Node& parent);
+			static int octant(const Node& node, const ci::vec3& point);
+
+			// 0 outside, 1 overlapping, 2 inside
+			static int	classify(const Node& node, const ci::vec3& min, const ci::vec3& max);
+			static size_t countLeafInBox(const Node& node, const ci::vec3& min, const ci::vec3& max);
+
+			void	collect(int32_t node, std::vector<ci::vec3>& result);	// all points of a subtree
+
+			template<typename F>
+			bool	visit(const ci::vec3& min, const ci::vec3& max, F&& fn);
+		};
+
+	}
+}
@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "RoomNodeBase.hpp"
+#include "pointcloud/PointcloudFilter.hpp"
 
 namespace act {
 	namespace room {
@@ -42,18 +43,22 @@ namespace act {
 
 			void setPointcloud(Pointcloud pointcloud);
 
-			
+			float getVoxelSize() { return m_voxelSize; };
+			void  setVoxelSize(float voxelSize) { m_voxelSize = std::max(0.0f, voxelSize); };
+
+			ci::Json toParams() override;
+			void fromParams(ci::Json json) override;
 
 		private:
 
 			Pointcloud m_pointcloud;
 			int m_numPoints;
+			int m_capacity = 0;		// of the vbo, it is only recreated if a pointcloud does not fit
+			float m_voxelSize = 0.0f;	// display only, 0 draws all points
 
-			void createPointCloud();
-			void updatePointCloud();
-			std::vector<vec3>		m_positions;
-			std::vector<ci::Colorf> m_colors;
-			std::vector<float>		m_sizes;
+			void createPointCloud(int capacity);
+			void updatePointCloud(const std::vector<vec3>& positions);
+			std::vector<vec3>		m_downsampled;
 			ci::gl::BatchRef		m_geometry;
 			ci::gl::GlslProgRef		m_shader;
 
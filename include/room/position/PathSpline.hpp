@@ -0,0 +1,88 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include "roompch.hpp"
+#include "cinder/BSpline.h"
+
+using namespace ci;
+using namespace ci::app;
+
+
+namespace act {
+	namespace room {
+
+		/**
+		* @brief a path through control points with a precomputed arc-length table
+		* Catmull-Rom passes through every point, Bezier takes the points as p0 c0 c1 p1 c2 c3 p2 ..., B-spline uses ci::BSpline.
+		* distances are looked up by binary search in the table, so followers travel at constant speed in O(log n)
+		*/
+		class PathSpline
+		{
+		public:
+			enum PathType {
+				PT_BSPLINE,
+				PT_CATMULLROM,
+				PT_BEZIER
+			};
+
+			PathSpline();
+			~PathSpline();
+
+			void		set(const std::vector<ci::vec3>& points, PathType type, bool isLooping, int degree = 3);
+
+			bool		isValid()		{ return !m_lengths.empty(); };
+			float		getLength()		{ return m_lengths.empty() ? 0.0f : m_lengths.back(); };
+			PathType	getType()		{ return m_type; };
+			const std::vector<ci::vec3>& getSamples() { return m_samples; };
+
+			ci::vec3	evaluate(float u) const;					// curve parameter [0..1], not constant speed
+			float		getParameterAtDistance(float distance) const;
+			ci::vec3	evaluateAtDistance(float distance) const;	// wraps around on looping paths, clamps otherwise
+			void		evaluateAtDistances(const float* distances, size_t count, ci::vec3* positions) const;
+
+			/**
+			* @brief the nearest position on the path, distance is set to the arc length at that position
+			*/
+			ci::vec3	getClosestPosition(const ci::vec3& position, float* distance = nullptr) const;
+
+			static std::string	typeToString(PathType type);
+			static PathType		stringToType(std::string type);
+
+		private:
+			PathType				m_type		= PT_CATMULLROM;
+			bool					m_isLooping = false;
+			std::vector<ci::vec3>	m_points;
+			int						m_segments	= 0;
+			ci::BSpline3f			m_bSpline;
+
+			// arc-length table, m_lengths[i] is the length up to m_params[i]
+			std::vector<float>		m_params;
+			std::vector<float>		m_lengths;
+			std::vector<ci::vec3>	m_samples;
+
+			static const int		kSamplesPerSegment = 32;
+
+			ci::vec3	evaluateSegment(int segment, float u) const;
+			const ci::vec3& point(int index) const;
+			float		wrapDistance(float distance) const;
+			void		createTable();
+
+		}; using PathSplineRef = std::shared_ptr<PathSpline>;
+
+	}
+}
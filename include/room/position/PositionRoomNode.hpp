@@ -18,7 +18,7 @@
 #pragma once
 
 #include "RoomNodeBase.hpp"
-#include "cinder/BSpline.h"
+#include "position/PathSpline.hpp"
 
 using namespace ci;
 using namespace ci::app;
@@ -57,13 +57,20 @@ namespace act {
 			bool		getIsLooping() { return m_isLooping; };
 			int			setDegree(int degree);
 			int			getDegree() { return m_degree; };
+			void		setPathType(PathSpline::PathType type);
+			PathSpline::PathType getPathType() { return m_pathType; };
 
 			ci::vec3	evaluatePosition(float t = 0.0f);
+			float		getLength() { return m_path.getLength(); };
+			ci::vec3	evaluatePositionAtDistance(float distance); // constant speed along the path
+			void		evaluatePositionsAtDistances(const std::vector<float>& distances, std::vector<ci::vec3>& positions);
+			ci::vec3	getClosestPosition(ci::vec3 position, float* distance = nullptr);
 
 		private:
 			std::vector<ci::vec3>	m_controlPoints;
 			float					m_t;
-			ci::BSpline3f			m_spline;
+			PathSpline				m_path;
+			PathSpline::PathType	m_pathType = PathSpline::PT_BSPLINE;
 			std::vector<ci::vec3>	m_points;
 			int						m_degree;
 			void					updateSpline();
@@ -0,0 +1,183 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+namespace act {
+	namespace util {
+
+		/**
+		* @brief an asset that is loaded in the background, polled by its owner (e.g. in update())
+		* get() is nullptr while it is loading and if loading failed
+		*/
+		template<typename T>
+		class AssetFuture
+		{
+		public:
+			AssetFuture() {};
+			AssetFuture(std::shared_future<std::shared_ptr<T>> future) : m_future(future) {};
+
+			static AssetFuture ready(std::shared_ptr<T> asset) {
+				std::promise<std::shared_ptr<T>> promise;
+				promise.set_value(asset);
+				return AssetFuture(promise.get_future().share());
+			};
+
+			bool isValid()		const { return m_future.valid(); };
+			bool isReady()		const { return isValid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+			bool isLoading()	const { return isValid() && !isReady(); };
+			bool hasFailed()	const { return isReady() && !get(); };
+
+			std::shared_ptr<T> get() const {
+				if (!isReady())
+					return nullptr;
+				try {
+					return m_future.get();
+				}
+				catch (...) { // dropped at shutdown
+					return nullptr;
+				}
+			};
+			void wait() const { if (isValid()) m_future.wait(); };
+
+		private:
+			std::shared_future<std::shared_ptr<T>> m_future;
+		};
+
+		/**
+		* @brief loads models, sounds and other files on a small pool of threads
+		* load() caches by type, path and a fingerprint of the file (size and modification time), so nodes share what they load.
+		* a loaded asset is only referenced weakly by the cache, it is freed with its last owner. a failed load is evicted, the next load() tries again.
+		* run() is for assets that must not be shared, e.g. a network that is run on a node's own thread
+		*/
+		class AssetManager
+		{
+		public:
+			AssetManager(unsigned int numThreads = 0);
+			~AssetManager();
+
+			static AssetManager& get();
+
+			template<typename T>
+			AssetFuture<T> load(const std::filesystem::path& path, std::function<std::shared_ptr<T>(const std::filesystem::path&)> loader, const std::string& variant = "") {
+				std::string key = std::string(typeid(T).name()) + "|" + variant + "|" + path.string();
+				uint64_t hash = fingerprint(path);
+
+				std::lock_guard<std::mutex> lock(m_cacheMutex);
+				auto it = m_cache.find(key);
+				if (it != m_cache.end() && it->second.hash == hash) {
+					if (it->second.loading)
+						return *std::static_pointer_cast<AssetFuture<T>>(it->second.loading);
+					if (auto asset = std::static_pointer_cast<T>(it->second.asset.lock()))
+						return AssetFuture<T>::ready(asset);
+				}
+
+				uint64_t generation = ++m_generation;
+				auto future = run<T>([this, key, generation, loader, path]() {
+					std::shared_ptr<T> asset;
+					try {
+						asset = loader(path);
+					}
+					catch (...) {
+						evict(key, generation);
+						throw;	// reported by run()
+					}
+					if (!asset) {
+						evict(key, generation);
+						return asset;
+					}
+
+					// from now on the owners keep it, the cache only finds it while it is in use
+					std::lock_guard<std::mutex> lock(m_cacheMutex);
+					auto it = m_cache.find(key);
+					if (it != m_cache.end() && it->second.generation == generation) {
+						it->second.loading.reset();
+						it->second.asset = asset;
+					}
+					return asset;
+				});
+				m_cache[key] = { hash, generation, std::make_shared<AssetFuture<T>>(future), {} };
+				return future;
+			};
+
+			template<typename T>
+			AssetFuture<T> run(std::function<std::shared_ptr<T>()> loader) {
+				auto promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+				AssetFuture<T> future(promise->get_future().share());
+
+				enqueue([promise, loader]() {
+					std::shared_ptr<T> asset;
+					try {
+						asset = loader();
+					}
+					catch (const std::exception& exc) {
+						reportFailure(exc.what());
+					}
+					catch (...) {
+						reportFailure("unknown error");
+					}
+					promise->set_value(asset);
+				});
+				return future;
+			};
+
+			void	clear();	// the cache, assets in use are kept by their owners
+			size_t	getPendingCount() { return m_numPending; };
+
+		private:
+			struct CacheEntry {
+				uint64_t				hash;
+				uint64_t				generation;
+				std::shared_ptr<void>	loading;	// AssetFuture<T> while loading
+				std::weak_ptr<void>		asset;		// T once loaded
+			};
+
+			std::vector<std::thread>			m_threads;
+			std::mutex							m_jobMutex;
+			std::condition_variable				m_condition;
+			std::deque<std::function<void()>>	m_jobs;
+			bool								m_isRunning = true;
+			std::atomic<size_t>					m_numPending = 0;
+
+			std::mutex							m_cacheMutex;
+			std::map<std::string, CacheEntry>	m_cache;	// type|variant|path -> asset
+			uint64_t							m_generation = 0;
+
+			void enqueue(std::function<void()> job);
+			void evict(const std::string& key, uint64_t generation);	// unless a newer load replaced it
+			void loop();
+
+			static uint64_t	fingerprint(const std::filesystem::path& path);
+			static void		reportFailure(const std::string& what);
+		};
+
+	}
+}
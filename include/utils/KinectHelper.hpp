@@ -24,6 +24,7 @@
 
 #include <k4abt.hpp>
 #include "body/Body.hpp"
+#include "body/BodyStore.hpp"
 
 namespace kh
 {
@@ -195,5 +196,44 @@ namespace kh
 		return setOrientationFromBodyPose(bodies);
 	}
 
+	static const k4abt_joint_id_t kinectJointLookUp[act::room::BJT_COUNT] = {
+		K4ABT_JOINT_PELVIS,
+		K4ABT_JOINT_SPINE_CHEST,
+		K4ABT_JOINT_NECK,
+		K4ABT_JOINT_SHOULDER_LEFT,
+		K4ABT_JOINT_ELBOW_LEFT,
+		K4ABT_JOINT_HAND_LEFT,
+		K4ABT_JOINT_SHOULDER_RIGHT,
+		K4ABT_JOINT_ELBOW_RIGHT,
+		K4ABT_JOINT_HAND_RIGHT,
+		K4ABT_JOINT_KNEE_LEFT,
+		K4ABT_JOINT_FOOT_LEFT,
+		K4ABT_JOINT_KNEE_RIGHT,
+		K4ABT_JOINT_FOOT_RIGHT,
+		K4ABT_JOINT_HEAD
+	};
+
+	// same as toGenericBody(), but written into the slots of a store instead of new Bodys; a body id keeps its slot
+	static void toBodyStore(const std::map<uint32_t, k4abt_skeleton_t>& kinectbodies, act::room::BodyStore& store)
+	{
+		store.beginFrame();
+
+		for (auto&& kinectBody : kinectbodies) {
+			size_t index = store.acquire(kinectBody.first);
+			const k4abt_skeleton_t& kinectSkeleton = kinectBody.second;
+			glm::vec3* positions = store.getPositions(index);
+			act::room::BodyJointConfidence* confidences = store.getConfidences(index);
+
+			for (int i = 0; i < (int)act::room::BJT_COUNT; i++) {
+				const k4abt_joint_t& k4aJoint = kinectSkeleton.joints[kinectJointLookUp[i]];
+				positions[i]	= glm::vec3(k4aJoint.position.xyz.x, k4aJoint.position.xyz.y, k4aJoint.position.xyz.z);
+				confidences[i]	= static_cast<act::room::BodyJointConfidence>(k4aJoint.confidence_level);
+			}
+			store.setOrientationsFromPose(index);
+		}
+
+		store.endFrame();
+	}
+
 	
 }
\ No newline at end of file
@@ -18,20 +18,103 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <variant>
+#include <cstdint>
+#include <type_traits>
+#include <initializer_list>
+
 #include "cinder/Log.h"
 
 namespace act {
 	namespace util {
 
+		/** @brief a key/value of a structured log record, the key has to be a literal; the value is formatted on the log thread */
+		struct LogField
+		{
+			using Value = std::variant<bool, int64_t, double, std::string>;
+
+			const char*	key = "";
+			Value		value;
+
+			LogField() = default;
+			template<typename T>
+			LogField(const char* key, const T& value) : key(key) {
+				if constexpr (std::is_same_v<T, bool>)
+					this->value = value;
+				else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+					this->value = (int64_t)value;
+				else if constexpr (std::is_floating_point_v<T>)
+					this->value = (double)value;
+				else
+					this->value = std::string(value);
+			}
+		};
+
+		/** @brief lets a log site through at most once per interval, counting what it held back */
+		class LogRateLimit
+		{
+		public:
+			explicit LogRateLimit(double seconds)
+				: m_interval((int64_t)(seconds * 1e9)), m_last(now() - m_interval) {}
+
+			/** @brief suppressed is set to the number of records held back since the last one let through */
+			bool allow(size_t& suppressed) {
+				int64_t time = now();
+				int64_t last = m_last.load(std::memory_order_relaxed);
+				if (time - last < m_interval || !m_last.compare_exchange_strong(last, time)) {
+					m_suppressed.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+				return true;
+			}
+
+		private:
+			int64_t					m_interval;
+			std::atomic<int64_t>	m_last;
+			std::atomic<size_t>		m_suppressed = 0;
+
+			static int64_t now() {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+		};
+
+		/**
+		* @brief asynchronous logging backend behind CI_LOG_* and ACT_LOG_*
+		* a record is pushed into a lock-free ring buffer of the logging thread and written to the console, the system log
+		* and the rotating files by a background thread. a full ring drops the record instead of waiting, the drops are reported
+		*/
 		class Logger
 		{
 		public:
 
 			void static initialize();
+			/** @brief writes what is left and stops the log thread, later records are written synchronously */
+			void static shutdown();
 			bool static m_isInitialized;
+
+			static void write(ci::log::Level level, const char* function, const char* file, int line, std::string text, std::initializer_list<LogField> fields = {}, size_t suppressed = 0);
+			static size_t getDroppedCount();
 			
 		private:
 			
 		};
 	}
-}
\ No newline at end of file
+}
+
+/** @brief structured logging, e.g. ACT_LOG_W("oscSendError", { "port", port }, { "error", error.message() }) */
+#define ACT_LOG(level, event, ...)	::act::util::Logger::write(level, __FUNCTION__, __FILE__, __LINE__, event, { __VA_ARGS__ })
+#define ACT_LOG_I(event, ...)		ACT_LOG(::ci::log::LEVEL_INFO, event, __VA_ARGS__)
+#define ACT_LOG_W(event, ...)		ACT_LOG(::ci::log::LEVEL_WARNING, event, __VA_ARGS__)
+#define ACT_LOG_E(event, ...)		ACT_LOG(::ci::log::LEVEL_ERROR, event, __VA_ARGS__)
+
+/** @brief like ACT_LOG, but at most once per seconds at this site; the number of held back records is added as "suppressed" */
+#define ACT_LOG_EVERY(seconds, level, event, ...) do {															\
+		static ::act::util::LogRateLimit actLogLimit(seconds);													\
+		size_t actLogSuppressed = 0;																			\
+		if (actLogLimit.allow(actLogSuppressed))																\
+			::act::util::Logger::write(level, __FUNCTION__, __FILE__, __LINE__, event, { __VA_ARGS__ }, actLogSuppressed);	\
+	} while (false)
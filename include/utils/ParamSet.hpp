@@ -0,0 +1,278 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <variant>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
+
+#include "cinder/Vector.h"
+#include "cinder/Color.h"
+#include "cinder/Json.h"
+#include "cinder/CinderImGui.h"
+#include "imgui/imgui_stdlib.h"
+
+#include "jsonHelper.hpp"
+
+namespace act {
+	namespace util {
+
+		using ParamID = int;
+
+		/**
+		* @brief typed, ranged parameters of a node, declared once and bound to its members
+		* a parameter is indexed by the order of its declaration; serialisation, the JSON schema and the ImGui widgets are derived from it.
+		* changes are flagged per parameter, so updates only touch the given fields and takeChanges() only returns the changed ones.
+		* the onChange of a parameter is only called for a value that differs, what it applies has to be applied once by the owner as well.
+		* not every node declares its params yet, the ones that override toParams/fromParams serialise as before, without a schema or change updates
+		*/
+		class ParamSet
+		{
+		public:
+			using OnChangeFn = std::function<void()>;
+
+			ParamID add(const std::string& key, bool& value, OnChangeFn onChange = nullptr) {
+				return insert({ key, &value }, onChange);
+			}
+			ParamID add(const std::string& key, int& value, int min, int max, OnChangeFn onChange = nullptr) {
+				return insert({ key, &value, (float)min, (float)max, 1.0f }, onChange);
+			}
+			ParamID add(const std::string& key, float& value, float min, float max, float speed = 0.01f, OnChangeFn onChange = nullptr, const std::string& format = "%.3f") {
+				return insert({ key, &value, min, max, speed, format }, onChange);
+			}
+			ParamID add(const std::string& key, ci::vec2& value, float min, float max, float speed = 0.01f, OnChangeFn onChange = nullptr) {
+				return insert({ key, &value, min, max, speed }, onChange);
+			}
+			ParamID add(const std::string& key, ci::vec3& value, float min, float max, float speed = 0.01f, OnChangeFn onChange = nullptr) {
+				return insert({ key, &value, min, max, speed }, onChange);
+			}
+			ParamID add(const std::string& key, ci::Color& value, OnChangeFn onChange = nullptr) {
+				return insert({ key, &value, 0.0f, 1.0f }, onChange);
+			}
+			ParamID add(const std::string& key, std::string& value, OnChangeFn onChange = nullptr) {
+				return insert({ key, &value }, onChange);
+			}
+
+			bool		empty() const { return m_params.empty(); }
+			size_t		size() const { return m_params.size(); }
+			ParamID		getID(const std::string& key) const {
+				auto it = m_ids.find(key);
+				return it != m_ids.end() ? it->second : -1;
+			}
+			const std::string& getKey(ParamID id) const { return m_params[id].key; }
+
+			ci::Json toJson() const {
+				ci::Json json = ci::Json::object();
+				for (auto&& param : m_params)
+					json[param.key] = valueToJson(param);
+				return json;
+			}
+
+			/** @brief applies the known fields of json, only changed values are flagged and notified; returns true if any changed */
+			bool fromJson(const ci::Json& json) {
+				if (!json.is_object())
+					return false;
+
+				bool isChanged = false;
+				for (auto it = json.begin(); it != json.end(); ++it) {
+					ParamID id = getID(it.key());
+					if (id >= 0 && apply(id, json, it.key()))
+						isChanged = true;
+				}
+				return isChanged;
+			}
+
+			/** @brief the changed fields since the last call, keyed like toJson() */
+			ci::Json takeChanges() {
+				ci::Json json = ci::Json::object();
+				if (!m_isChanged)
+					return json;
+
+				for (ParamID id = 0; id < (ParamID)m_params.size(); id++) {
+					if (!m_changed[id])
+						continue;
+					json[m_params[id].key] = valueToJson(m_params[id]);
+					m_changed[id] = false;
+				}
+				m_isChanged = false;
+				return json;
+			}
+			bool hasChanges() const { return m_isChanged; }
+
+			/** @brief flags a parameter whose member was set directly */
+			void markChanged(ParamID id) {
+				m_changed[id] = true;
+				m_isChanged = true;
+			}
+
+			/** @brief JSON schema of an object holding the parameters, "x-id" is the index of a parameter */
+			ci::Json getSchema() const {
+				ci::Json properties = ci::Json::object();
+				for (ParamID id = 0; id < (ParamID)m_params.size(); id++) {
+					auto&& param = m_params[id];
+					ci::Json property = ci::Json::object();
+					property["x-id"]	= id;
+					property["default"]	= param.defaultValue;
+
+					std::visit([&](auto* value) {
+						using T = std::remove_pointer_t<decltype(value)>;
+						if constexpr (std::is_same_v<T, bool>) {
+							property["type"] = "boolean";
+						}
+						else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+							property["type"] = std::is_same_v<T, int> ? "integer" : "number";
+							if (param.isRanged()) {
+								property["minimum"] = param.min;
+								property["maximum"] = param.max;
+							}
+						}
+						else if constexpr (std::is_same_v<T, std::string>) {
+							property["type"] = "string";
+						}
+						else {
+							ci::Json component = { { "type", "number" } };
+							if (param.isRanged()) {
+								component["minimum"] = param.min;
+								component["maximum"] = param.max;
+							}
+							property["type"] = "object";
+							for (auto&& name : param.defaultValue.items())
+								property["properties"][name.key()] = component;
+						}
+					}, param.value);
+
+					properties[param.key] = property;
+				}
+
+				ci::Json schema = ci::Json::object();
+				schema["type"]		 = "object";
+				schema["properties"] = properties;
+				return schema;
+			}
+
+			/** @brief a widget per parameter, edited ones are flagged and notified; returns true if any was edited */
+			bool draw(float width = 0.0f) {
+				bool isEdited = false;
+				for (ParamID id = 0; id < (ParamID)m_params.size(); id++) {
+					auto&& param = m_params[id];
+					if (width > 0.0f)
+						ImGui::SetNextItemWidth(width);
+
+					bool isParamEdited = std::visit([&](auto* value) {
+						using T = std::remove_pointer_t<decltype(value)>;
+						const char* label = param.key.c_str();
+						if constexpr (std::is_same_v<T, bool>)
+							return ImGui::Checkbox(label, value);
+						else if constexpr (std::is_same_v<T, int>)
+							return ImGui::DragInt(label, value, param.speed, (int)param.min, (int)param.max);
+						else if constexpr (std::is_same_v<T, float>)
+							return ImGui::DragFloat(label, value, param.speed, param.min, param.max, param.format.c_str());
+						else if constexpr (std::is_same_v<T, ci::vec2>)
+							return ImGui::DragFloat2(label, &value->x, param.speed, param.min, param.max);
+						else if constexpr (std::is_same_v<T, ci::vec3>)
+							return ImGui::DragFloat3(label, &value->x, param.speed, param.min, param.max);
+						else if constexpr (std::is_same_v<T, ci::Color>)
+							return ImGui::ColorEdit3(label, &value->r);
+						else
+							return ImGui::InputText(label, value);
+					}, param.value);
+
+					if (isParamEdited) {
+						notify(id);
+						isEdited = true;
+					}
+				}
+				return isEdited;
+			}
+
+		private:
+			using Value = std::variant<bool*, int*, float*, ci::vec2*, ci::vec3*, ci::Color*, std::string*>;
+
+			struct Param {
+				std::string	key;
+				Value		value;
+				float		min		= 0.0f;
+				float		max		= 0.0f;		// not ranged if equal
+				float		speed	= 1.0f;
+				std::string	format	= "%.3f";
+				ci::Json	defaultValue;
+				OnChangeFn	onChange;
+
+				bool isRanged() const { return min < max; }
+			};
+
+			std::vector<Param>						m_params;
+			std::vector<bool>						m_changed;
+			std::unordered_map<std::string, ParamID> m_ids;
+			bool									m_isChanged = false;
+
+			ParamID insert(Param param, OnChangeFn onChange) {
+				ParamID id = (ParamID)m_params.size();
+				param.onChange		= onChange;
+				param.defaultValue	= valueToJson(param);
+				m_ids[param.key]	= id;
+				m_params.push_back(param);
+				m_changed.push_back(false);
+				return id;
+			}
+
+			static ci::Json valueToJson(const Param& param) {
+				return std::visit([](auto* value) -> ci::Json {
+					using T = std::remove_pointer_t<decltype(value)>;
+					if constexpr (std::is_same_v<T, ci::vec2> || std::is_same_v<T, ci::vec3> || std::is_same_v<T, ci::Color>)
+						return util::valueToJson(*value);
+					else
+						return *value;
+				}, param.value);
+			}
+
+			bool apply(ParamID id, const ci::Json& json, const std::string& key) {
+				auto&& param = m_params[id];
+				bool isChanged = std::visit([&](auto* value) {
+					using T = std::remove_pointer_t<decltype(value)>;
+					T parsed = *value;
+					if (!setValueFromJson(json, key, parsed))
+						return false;
+
+					if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+						if (param.isRanged())
+							parsed = std::clamp(parsed, (T)param.min, (T)param.max);
+					}
+					if (parsed == *value)
+						return false;
+
+					*value = parsed;
+					return true;
+				}, param.value);
+
+				if (isChanged)
+					notify(id);
+				return isChanged;
+			}
+
+			void notify(ParamID id) {
+				markChanged(id);
+				if (m_params[id].onChange)
+					m_params[id].onChange();
+			}
+		};
+
+	}
+}
@@ -0,0 +1,137 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace act {
+	namespace util {
+
+		enum SnapshotKind : uint32_t {
+			SK_GRAPH	= 1,
+			SK_ROOM		= 2
+		};
+
+		/**
+		* @brief binary snapshot: "IASNAP", version, kind, a string table and the body, all little endian
+		* the body refers to strings by their index in the table
+		*/
+		class SnapshotWriter
+		{
+		public:
+			static const uint16_t kVersion = 1;
+
+			SnapshotWriter(SnapshotKind kind) : m_kind(kind) {};
+
+			void setStrings(const std::vector<std::string>& strings) { m_strings = &strings; };
+
+			template<typename T>
+			void write(const T& value) {
+				static_assert(std::is_trivially_copyable<T>::value, "only plain values are written directly");
+				const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+				m_body.insert(m_body.end(), bytes, bytes + sizeof(T));
+			};
+			void writeBlob(const std::vector<uint8_t>& blob);
+
+			std::vector<uint8_t> finish();
+
+		private:
+			SnapshotKind						m_kind;
+			const std::vector<std::string>*		m_strings = nullptr;
+			std::vector<uint8_t>				m_body;
+		};
+
+		class SnapshotReader
+		{
+		public:
+			/**
+			* @brief checks the header and reads the string table, false if the data is no snapshot of that kind
+			*/
+			bool open(const std::vector<uint8_t>& data, SnapshotKind kind);
+
+			template<typename T>
+			bool read(T& value) {
+				static_assert(std::is_trivially_copyable<T>::value, "only plain values are read directly");
+				if (!m_data || m_position + sizeof(T) > m_data->size()) {
+					m_isValid = false;
+					return false;
+				}
+				std::memcpy(&value, m_data->data() + m_position, sizeof(T));
+				m_position += sizeof(T);
+				return true;
+			};
+			bool readBlob(std::vector<uint8_t>& blob);
+
+			bool isValid() { return m_isValid; };
+			uint16_t getVersion() { return m_version; };
+			std::vector<std::string>& getStrings() { return m_strings; };
+
+		private:
+			const std::vector<uint8_t>*	m_data = nullptr;
+			size_t						m_position = 0;
+			bool						m_isValid = false;
+			uint16_t					m_version = 0;
+			std::vector<std::string>	m_strings;
+		};
+
+		bool isSnapshotFile(const std::filesystem::path& path);
+		bool readSnapshotFile(const std::filesystem::path& path, std::vector<uint8_t>& data);
+		/**
+		* @brief writes next to the file and renames it, so an interrupted save never leaves a broken file
+		*/
+		bool writeSnapshotFile(const std::filesystem::path& path, const std::vector<uint8_t>& data);
+
+		/**
+		* @brief encodes and writes files in its own thread
+		* the encode function must only use what it captured (a copy of the description), it is called on the saving thread;
+		* a save that is still pending for the same path is replaced
+		*/
+		class SnapshotSaver
+		{
+		public:
+			SnapshotSaver();
+			~SnapshotSaver();
+
+			void save(const std::filesystem::path& path, std::function<std::vector<uint8_t>()> encode);
+			void flush();	// blocks until everything is written
+
+			bool isSaving() { return m_isSaving; };
+
+		private:
+			std::thread					m_thread;
+			std::mutex					m_mutex;
+			std::condition_variable		m_condition;
+			bool						m_isRunning = true;
+			std::atomic<bool>			m_isSaving = false;
+
+			std::map<std::filesystem::path, std::function<std::vector<uint8_t>()>> m_pending;
+
+			void loop();
+		};
+
+	}
+}
@@ -41,7 +41,7 @@ namespace act {
             return out.str();
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, int& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, int& value) {
             if (json.contains(key)) {
                 try {
                     value = json[key];
@@ -54,7 +54,7 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, float& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, float& value) {
             if (json.contains(key)) {
                 try {
                     if (json[key].type() == ci::Json::value_t::string)
@@ -70,7 +70,7 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, double& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, double& value) {
             if (json.contains(key)) {
                 try {
                     value = json[key];
@@ -83,7 +83,7 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, std::string& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, std::string& value) {
             if (json.contains(key)) {
                 try {
                     value = json[key];
@@ -96,7 +96,7 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, bool& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, bool& value) {
             if (json.contains(key)) {
                 try {
                     value = (bool)(json[key]);
@@ -109,10 +109,10 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, vec2& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, vec2& value) {
             if (json.contains(key)) {
                 try {
-                    auto vec = json[key];
+                    const auto& vec = json[key];
                     return setValueFromJson(vec, "x", value.x) && setValueFromJson(vec, "y", value.y);
                 }
                 catch (...) {
@@ -123,10 +123,10 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, ivec2& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, ivec2& value) {
             if (json.contains(key)) {
                 try {
-                    auto vec = json[key];
+                    const auto& vec = json[key];
                     return setValueFromJson(vec, "x", value.x) && setValueFromJson(vec, "y", value.y);
                 }
                 catch (...) {
@@ -137,10 +137,10 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, vec3& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, vec3& value) {
             if (json.contains(key)) {
                 try {
-                    auto vec = json[key];
+                    const auto& vec = json[key];
                     return setValueFromJson(vec, "x", value.x) && setValueFromJson(vec, "y", value.y) && setValueFromJson(vec, "z", value.z);
                 }
                 catch (...) {
@@ -151,10 +151,10 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, Color& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, Color& value) {
             if (json.contains(key)) {
                 try {
-                    auto vec = json[key];
+                    const auto& vec = json[key];
                     return setValueFromJson(vec, "r", value.r) && setValueFromJson(vec, "g", value.g) && setValueFromJson(vec, "b", value.b);
                 }
                 catch (...) {
@@ -165,10 +165,10 @@ namespace act {
             return false;
         }
 
-        static bool setValueFromJson(ci::Json json, std::string key, quat& value) {
+        static bool setValueFromJson(const ci::Json& json, const std::string& key, quat& value) {
             if (json.contains(key)) {
                 try {
-                    auto vec = json[key];
+                    const auto& vec = json[key];
                     return setValueFromJson(vec, "x", value.x) && setValueFromJson(vec, "y", value.y) && setValueFromJson(vec, "z", value.z) && setValueFromJson(vec, "w", value.w);
                 }
                 catch (...) {
@@ -16,6 +16,7 @@
 */
 
 #include "mixer/Mixer3d.hpp"
+#include "Logger.hpp"
 #define CONVHULL_3D_ENABLE
 #include "convhull_3d/convhull_3d.h"
 #include <vector>
@@ -450,7 +451,7 @@ void act::aio::Mixer3d::updateColliders()
 		collider.speakers.push_back(m_speakers[i2]);
 		m_colliders.push_back(collider);
 	}
-	std::cout << "okay";
+	ACT_LOG_I("collidersBuilt", { "colliders", m_colliders.size() });
 }
 
 act::aio::Mixer3d::Collider act::aio::Mixer3d::findCollider(ci::vec3 soundPos)
@@ -17,6 +17,7 @@
 
 #include "roompch.hpp"
 #include "DepthDetector.hpp"
+#include "Logger.hpp"
 #include "kinect/KinectDevice.hpp"
 
 #include <chrono>
@@ -29,7 +30,7 @@ act::comp::DepthDetector::DepthDetector()
 	, m_inputTensor(nullptr)
 	, m_outputTensor(nullptr)
 {
-	initNetwork();
+	initInBackground([&]() { initNetwork(); });
 }
 
 act::comp::DepthDetector::DepthDetector(room::CameraRoomNodeRef camera) 
@@ -39,12 +40,14 @@ act::comp::DepthDetector::DepthDetector(room::CameraRoomNodeRef camera)
 	, m_inputTensor(nullptr)
 	, m_outputTensor(nullptr)
 {
-	initNetwork();
+	initInBackground([&]() { initNetwork(); });
 }
 
 
 act::comp::DepthDetector::~DepthDetector()
 {
+	m_initialization.wait();
+
 	try {
 		const auto& api = Ort::GetApi();
 		// Finally, don't forget to release the provider options
@@ -222,7 +225,7 @@ void  act::comp::DepthDetector::detect() {
 		m_session.Run(opts, m_inputNames.data(), &m_inputTensor, 1, m_outputNames.data(), &m_outputTensor, 1);
 	}
 	catch (Ort::Exception exc) {
-		CI_LOG_E("Failed to predict depth: " << exc.what());
+		ACT_LOG_EVERY(1.0, ci::log::LEVEL_ERROR, "depthPredictionFailed", { "what", exc.what() });
 	}
 	
 	try {
@@ -17,6 +17,7 @@
 
 #include "roompch.hpp"
 #include "MarkerDetector.hpp"
+#include "Logger.hpp"
 
 #include <chrono>
 using namespace std::chrono_literals;
@@ -125,7 +126,7 @@ void  act::comp::MarkerDetector::detect() {
 			solvePnP(m_objPoints, markerCorners.at(i), camera->getIntrinsic(), camera->getDistCoeffs(), candidates[i].rvec, candidates[i].tvec);
 		}
 		catch (cv::Exception exc) {
-			CI_LOG_E(exc.what());
+			ACT_LOG_EVERY(1.0, ci::log::LEVEL_ERROR, "markerPoseFailed", { "id", markerIds[i] }, { "what", exc.what() });
 		}
 	}
 
@@ -137,7 +138,7 @@ void  act::comp::MarkerDetector::detect() {
 			cv::drawFrameAxes(outputImage, camera->getIntrinsic(), camera->getDistCoeffs(), candidates[i].rvec, candidates[i].tvec, m_markerSize, 5);
 		}
 		catch (cv::Exception exc) {
-			CI_LOG_E(exc.what());
+			ACT_LOG_EVERY(1.0, ci::log::LEVEL_ERROR, "markerAxesFailed", { "what", exc.what() });
 		}
 	m_feedbackImage = outputImage;
 
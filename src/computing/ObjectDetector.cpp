@@ -17,23 +17,24 @@
 
 #include "roompch.hpp"
 #include "ObjectDetector.hpp"
+#include "Logger.hpp"
 
 #include <chrono>
 using namespace std::chrono_literals;
 
 act::comp::ObjectDetector::ObjectDetector() : DetectorBase("objectDetector") {
-	initNetwork();
+	initInBackground([&]() { initNetwork(); });
 }
 
 act::comp::ObjectDetector::ObjectDetector(room::CameraRoomNodeRef camera) : DetectorBase("objectDetector", camera)
 {
-	initNetwork();
+	initInBackground([&]() { initNetwork(); });
 }
 
 
 act::comp::ObjectDetector::~ObjectDetector()
 {
-
+	m_initialization.wait();
 }
 
 
@@ -148,7 +149,7 @@ void  act::comp::ObjectDetector::detect() {
 		m_feedbackImage = outputImage;
 	}
 	catch (cv::Exception exc) {
-		CI_LOG_E("Failed to detect Objects: " << exc.what());
+		ACT_LOG_EVERY(1.0, ci::log::LEVEL_ERROR, "objectDetectionFailed", { "what", exc.what() });
 	}
 }
 
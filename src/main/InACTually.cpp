@@ -184,6 +184,7 @@ void act::InACTually::onClose()
 
 void InACTually::cleanup()
 {
+	util::Logger::shutdown();
 }
 
 void InACTually::update()
@@ -208,11 +209,11 @@ void InACTually::update()
 
 		if (m_isGettingOpenPath) { // callback needs to be set, optimistic
 			m_isGettingOpenPath = false;  
-			m_getPathCallback(ci::app::getOpenFilePath("", { "json" }));
+			m_getPathCallback(ci::app::getOpenFilePath("", { "iasnap", "json" }));
 		}
 		if (m_isGettingSavePath) {// callback needs to be set, optimistic
 			m_isGettingSavePath = false;
-			m_getPathCallback(ci::app::getSaveFilePath("", { "json" }));
+			m_getPathCallback(ci::app::getSaveFilePath("", { "iasnap", "json" }));
 		}
 	}
 	if (AppState::get() == AS_FEATURETEST) {
@@ -0,0 +1,260 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "GraphSnapshot.hpp"
+
+#include "cinder/Log.h"
+
+
+uint32_t act::mod::GraphSnapshot::intern(const std::string& string)
+{
+	auto [it, isNew] = m_stringIndices.try_emplace(string, (uint32_t)strings.size());
+	if (isNew)
+		strings.push_back(string);
+	return it->second;
+}
+
+ci::Json act::mod::GraphSnapshot::getParams(Node& node)
+{
+	if (!node.packedParams.empty())
+		return ci::Json::from_msgpack(node.packedParams);
+	return node.params;
+}
+
+std::shared_ptr<act::mod::GraphSnapshot> act::mod::GraphSnapshot::fromJson(const ci::Json& description)
+{
+	auto snapshot = std::make_shared<GraphSnapshot>();
+	if (!description.contains("containers"))
+		return snapshot;
+
+	auto getString = [](const ci::Json& json, const char* key) -> std::string {
+		auto it = json.find(key);
+		return it != json.end() && it->is_string() ? it->get<std::string>() : "";
+	};
+	auto getFloat = [](const ci::Json& json, const char* key) -> float {
+		auto it = json.find(key);
+		return it != json.end() && it->is_number() ? it->get<float>() : 0.0f;
+	};
+
+	// first the tables, links and nested containers refer to them by uid
+	std::unordered_map<std::string, uint32_t> nodeIndices;
+	std::unordered_map<std::string, uint32_t> containerIndices;
+
+	const ci::Json& containers = description["containers"];
+	for (auto&& containerJson : containers) {
+		Container container;
+		container.uid		= snapshot->intern(getString(containerJson, "uid"));
+		container.name		= snapshot->intern(getString(containerJson, "name"));
+		container.title		= snapshot->intern(getString(containerJson, "title"));
+		container.level		= containerJson.value("level", 0);
+
+		static const ci::Json kEmpty = ci::Json::object();
+		const ci::Json& params = containerJson.contains("params") ? containerJson["params"] : kEmpty;
+		container.panning	= snapshot->intern(getString(params, "panning"));
+
+		if (params.contains("nodes")) {
+			for (auto&& nodeJson : params["nodes"]) {
+				Node node;
+				node.uid	= snapshot->intern(getString(nodeJson, "uid"));
+				node.name	= snapshot->intern(getString(nodeJson, "name"));
+				node.title	= snapshot->intern(nodeJson.contains("title") && nodeJson["title"].is_string() ? nodeJson["title"].get<std::string>() : snapshot->strings[node.name]);
+				node.x		= getFloat(nodeJson, "x_pos");
+				node.y		= getFloat(nodeJson, "y_pos");
+				if (nodeJson.contains("params"))
+					node.params = nodeJson["params"];
+
+				nodeIndices[snapshot->strings[node.uid]] = (uint32_t)snapshot->nodes.size();
+				container.nodes.push_back((uint32_t)snapshot->nodes.size());
+				snapshot->nodes.push_back(std::move(node));
+			}
+		}
+
+		containerIndices[snapshot->strings[container.uid]] = (uint32_t)snapshot->containers.size();
+		snapshot->containers.push_back(std::move(container));
+	}
+
+	auto endpoint = [&](const std::string& uid, uint32_t& index) {
+		auto node = nodeIndices.find(uid);
+		if (node != nodeIndices.end()) {
+			index = node->second;
+			return true;
+		}
+		auto container = containerIndices.find(uid);
+		if (container != containerIndices.end()) {
+			index = snapshot->getContainerEndpoint(container->second);
+			return true;
+		}
+		return false;
+	};
+
+	for (size_t c = 0; c < snapshot->containers.size(); c++) {
+		const ci::Json& containerJson = containers[c];
+		if (!containerJson.contains("params"))
+			continue;
+		const ci::Json& params = containerJson["params"];
+		Container& container = snapshot->containers[c];
+
+		if (params.contains("containers")) {
+			for (auto&& childJson : params["containers"]) {
+				auto it = containerIndices.find(getString(childJson, "uid"));
+				if (it == containerIndices.end())
+					continue;
+				container.children.push_back({ it->second, getFloat(childJson, "x_pos"), getFloat(childJson, "y_pos") });
+			}
+		}
+
+		if (params.contains("links")) {
+			for (auto&& linkJson : params["links"]) {
+				// "uid\nportName"
+				std::string from = getString(linkJson, "from");
+				std::string to = getString(linkJson, "to");
+				size_t fromSplit = from.find('\n'), toSplit = to.find('\n');
+				if (fromSplit == std::string::npos || toSplit == std::string::npos)
+					continue;
+
+				Link link;
+				if (!endpoint(from.substr(0, fromSplit), link.from) || !endpoint(to.substr(0, toSplit), link.to)) {
+					CI_LOG_W("link to an unknown node is dropped: " << from << " -> " << to);
+					continue;
+				}
+				link.fromPort	= snapshot->intern(from.substr(fromSplit + 1));
+				link.toPort		= snapshot->intern(to.substr(toSplit + 1));
+				container.links.push_back(link);
+			}
+		}
+	}
+
+	return snapshot;
+}
+
+std::vector<uint8_t> act::mod::GraphSnapshot::encode()
+{
+	util::SnapshotWriter writer(util::SK_GRAPH);
+	writer.setStrings(strings);
+
+	writer.write((uint32_t)nodes.size());
+	for (auto&& node : nodes) {
+		writer.write(node.uid);
+		writer.write(node.name);
+		writer.write(node.title);
+		writer.write(node.x);
+		writer.write(node.y);
+		if (node.packedParams.empty() && !node.params.is_null())
+			node.packedParams = ci::Json::to_msgpack(node.params);
+		writer.writeBlob(node.packedParams);
+	}
+
+	writer.write((uint32_t)containers.size());
+	for (auto&& container : containers) {
+		writer.write(container.uid);
+		writer.write(container.name);
+		writer.write(container.title);
+		writer.write(container.panning);
+		writer.write(container.level);
+
+		writer.write((uint32_t)container.nodes.size());
+		for (uint32_t node : container.nodes)
+			writer.write(node);
+
+		writer.write((uint32_t)container.children.size());
+		for (auto&& child : container.children)
+			writer.write(child);
+
+		writer.write((uint32_t)container.links.size());
+		for (auto&& link : container.links)
+			writer.write(link);
+	}
+
+	return writer.finish();
+}
+
+std::shared_ptr<act::mod::GraphSnapshot> act::mod::GraphSnapshot::decode(const std::vector<uint8_t>& data)
+{
+	util::SnapshotReader reader;
+	if (!reader.open(data, util::SK_GRAPH))
+		return nullptr;
+
+	auto snapshot = std::make_shared<GraphSnapshot>();
+	snapshot->strings = std::move(reader.getStrings());
+	uint32_t stringCount = (uint32_t)snapshot->strings.size();
+
+	uint32_t count = 0;
+	reader.read(count);
+	snapshot->nodes.resize(reader.isValid() ? std::min<size_t>(count, data.size()) : 0);
+	for (auto& node : snapshot->nodes) {
+		reader.read(node.uid);
+		reader.read(node.name);
+		reader.read(node.title);
+		reader.read(node.x);
+		reader.read(node.y);
+		reader.readBlob(node.packedParams);
+	}
+
+	reader.read(count);
+	snapshot->containers.resize(reader.isValid() ? std::min<size_t>(count, data.size()) : 0);
+	for (auto& container : snapshot->containers) {
+		reader.read(container.uid);
+		reader.read(container.name);
+		reader.read(container.title);
+		reader.read(container.panning);
+		reader.read(container.level);
+
+		reader.read(count);
+		container.nodes.resize(reader.isValid() ? std::min<size_t>(count, data.size()) : 0);
+		for (auto& node : container.nodes)
+			reader.read(node);
+
+		reader.read(count);
+		container.children.resize(reader.isValid() ? std::min<size_t>(count, data.size()) : 0);
+		for (auto& child : container.children)
+			reader.read(child);
+
+		reader.read(count);
+		container.links.resize(reader.isValid() ? std::min<size_t>(count, data.size()) : 0);
+		for (auto& link : container.links)
+			reader.read(link);
+	}
+
+	if (!reader.isValid()) {
+		CI_LOG_E("graph snapshot is truncated");
+		return nullptr;
+	}
+
+	// indices are trusted from here on
+	uint32_t endpointCount = (uint32_t)(snapshot->nodes.size() + snapshot->containers.size());
+	for (auto&& node : snapshot->nodes) {
+		if (node.uid >= stringCount || node.name >= stringCount || node.title >= stringCount)
+			return nullptr;
+	}
+	for (auto&& container : snapshot->containers) {
+		if (container.uid >= stringCount || container.name >= stringCount || container.title >= stringCount || container.panning >= stringCount)
+			return nullptr;
+		for (uint32_t node : container.nodes) {
+			if (node >= snapshot->nodes.size())
+				return nullptr;
+		}
+		for (auto&& child : container.children) {
+			if (child.container >= snapshot->containers.size())
+				return nullptr;
+		}
+		for (auto&& link : container.links) {
+			if (link.from >= endpointCount || link.to >= endpointCount || link.fromPort >= stringCount || link.toPort >= stringCount)
+				return nullptr;
+		}
+	}
+
+	return snapshot;
+}
@@ -43,15 +43,13 @@ void act::mod::ProcessingModule::setup(act::room::RoomManagers roomMgrs, act::ne
 	m_roomMgrs = roomMgrs;
 	m_networkMgr = networkMgr;
 
-	fs::path path = app::getAssetPath("recentProcessing.json");
-	
-	if (path.empty()) {
-		path = app::getAssetPath("").string() + "recentProcessing.json";
-		ci::writeJson(path,""); // touch
-		saveToFile(path);
-	}
+	// the binary snapshot is preferred, an older recentProcessing.json is still read
+	fs::path path = app::getAssetPath("recentProcessing.iasnap");
+	if (path.empty())
+		path = app::getAssetPath("recentProcessing.json");
 
-	loadFromFile(path);
+	if (!path.empty())
+		loadFromFile(path);
 
 	if (getContainerByName("Root") == nullptr)
 	{
@@ -61,7 +59,8 @@ void act::mod::ProcessingModule::setup(act::room::RoomManagers roomMgrs, act::ne
 }
 
 void act::mod::ProcessingModule::cleanUp() {
-	saveToFile(app::getAssetPath("recentProcessing.json"));
+	saveToFile(getRecentPath());
+	m_saver.flush();
 }
 
 void act::mod::ProcessingModule::update() {
@@ -69,6 +68,10 @@ void act::mod::ProcessingModule::update() {
 		m_rootContainerNode->update();
 }
 
+fs::path act::mod::ProcessingModule::getRecentPath() {
+	return app::getAssetPath("").string() + "recentProcessing.iasnap";
+}
+
 void act::mod::ProcessingModule::draw() {
 	
 }
@@ -276,7 +279,18 @@ void act::mod::ProcessingModule::drawCreateButton(std::string nodeName) {
 };
 
 void act::mod::ProcessingModule::saveToFile(fs::path path) {
-	ci::writeJson(path, getFullDescription());
+	// the saver works on its own copy, the graph may change meanwhile
+	auto description = std::make_shared<const ci::Json>(getFullDescription());
+
+	if (path.extension() == ".json") {
+		m_saver.save(path, [description]() {
+			std::string text = description->dump(4);
+			return std::vector<uint8_t>(text.begin(), text.end());
+		});
+	}
+	else {
+		m_saver.save(path, [description]() { return GraphSnapshot::fromJson(*description)->encode(); });
+	}
 }
 
 ci::Json act::mod::ProcessingModule::getFullDescription()
@@ -311,6 +325,7 @@ void act::mod::ProcessingModule::load(std::filesystem::path path)
 
 	proc::IDBase::resetNextID();
 
+	m_saver.flush();
 	loadFromFile(path);
 }
 
@@ -338,105 +353,126 @@ void act::mod::ProcessingModule::deleteNodeByUID(act::UID uid) {
 	}
 }
 
-//TODO Refactor. put that stuff to container node from JSON
 void act::mod::ProcessingModule::loadFromFile(fs::path path) { 
 	
-	ci::Json nodeConfiguration = ci::loadJson(loadFile(path));
-	std::vector<std::pair<proc::ContainerProcNodeRef, act::UID>> containerToContainerMap;
-	std::vector<std::pair<proc::ContainerProcNodeRef, std::pair<std::string, std::string>>> containerToLinkMap;
-	std::vector<std::pair<proc::ContainerProcNodeRef, ci::Json>> containerToParamsMap;
+	GraphSnapshotRef snapshot;
+	try {
+		if (util::isSnapshotFile(path)) {
+			std::vector<uint8_t> data;
+			if (util::readSnapshotFile(path, data))
+				snapshot = GraphSnapshot::decode(data);
+		}
+		else {
+			snapshot = GraphSnapshot::fromJson(ci::loadJson(loadFile(path)));
+		}
+	}
+	catch (const std::exception& exc) {
+		CI_LOG_E("cannot load " << path << ": " << exc.what());
+	}
 
-	for (auto&& container : nodeConfiguration["containers"]) {
-		act::UID containerUid = container["uid"];
-		std::string name = container["name"];
+	if (!snapshot) {
+		CI_LOG_E("cannot load " << path);
+		return;
+	}
+	loadSnapshot(*snapshot);
+}
+
+//TODO Refactor. put that stuff to container node
+void act::mod::ProcessingModule::loadSnapshot(GraphSnapshot& snapshot) {
+
+	// nodes followed by containers, as referred to by the links
+	std::vector<proc::ProcNodeBaseRef> endpoints(snapshot.nodes.size() + snapshot.containers.size());
+	std::vector<proc::ContainerProcNodeRef> containers(snapshot.containers.size());
+
+	for (size_t i = 0; i < snapshot.containers.size(); i++) {
+		auto&& container = snapshot.containers[i];
 
-		int level = container["level"];	
-		
 		proc::ContainerProcNodeRef  c;
-		if (level == 0) {
+		if (container.level == 0) {
 			c = std::make_shared<proc::ContainerProcNode>(0, "Root", m_onFocusCallback);
-			c->setUID(containerUid);
-
 			m_rootContainerNode = c;
 		}
 		else {
-			c = std::make_shared<proc::ContainerProcNode>(level, name, m_onFocusCallback);
-			c->setUID(containerUid);
+			c = std::make_shared<proc::ContainerProcNode>(container.level, snapshot.getString(container.name), m_onFocusCallback);
 		}
-		
-		for (auto&& n : container["params"]["nodes"]) {
-			act::UID uid = n["uid"];
-			std::string name = n["name"];
-			std::string title = name;
-			if(n["title"].is_string())
-				title = n["title"];
-
-			vec2 pos(0, 0);
-			if (n.contains("x_pos")) {
-				pos = vec2(n["x_pos"], n["y_pos"]);
-			}
+		c->setUID(snapshot.getString(container.uid));
+
+		for (uint32_t index : container.nodes) {
+			auto&& n = snapshot.nodes[index];
 
-			auto node = m_nodeRegistry->create(name);
+			auto node = m_nodeRegistry->create(snapshot.getString(n.name));
 			if (node) {
-				node->setUID(uid);
-				node->setTitle(title);
+				node->setUID(snapshot.getString(n.uid));
+				node->setTitle(snapshot.getString(n.title));
 				node->setup(m_roomMgrs);
 
-				if (n.contains("params"))
-					node->fromParams(n["params"]);
+				try {
+					ci::Json params = snapshot.getParams(n);
+					if (!params.is_null())
+						node->fromParams(params);
+				}
+				catch (const std::exception& exc) {
+					CI_LOG_W("cannot restore params of " << snapshot.getString(n.uid) << ": " << exc.what());
+				}
 
 				c->addNode(node);
-				node->setPosition(pos);
+				node->setPosition(vec2(n.x, n.y));
+				endpoints[index] = node;
 			}
 		}
 
-		for (auto&& nestedContainer : container["params"]["containers"]) {
-			act::UID uid = nestedContainer["uid"];
-			containerToContainerMap.push_back({c, uid});
-		}
-
-		for (auto&& l : container["params"]["links"]) {
-			std::string from = l["from"];
-			std::string to = l["to"];
-			containerToLinkMap.push_back({ c, std::pair<std::string, std::string>(from, to) });
-		}
-		
-		containerToParamsMap.push_back({ c, container["params"] });
-		
+		containers[i] = c;
+		endpoints[snapshot.getContainerEndpoint((uint32_t)i)] = c;
 		m_containers.push_back(c);
 	}
 	
-	for (auto&& p : containerToContainerMap) {
-		proc::ContainerProcNodeRef nestedContainer;
-		for (auto&& c : m_containers) {
-			if (c->getUID() == p.second) {
-				nestedContainer = c;
-				break;
+	for (size_t i = 0; i < snapshot.containers.size(); i++) {
+		for (auto&& child : snapshot.containers[i].children)
+			containers[i]->addContainer(containers[child.container]);
+	}
+
+	for (size_t i = 0; i < snapshot.containers.size(); i++) {
+		for (auto&& link : snapshot.containers[i].links) {
+			auto fromNode = endpoints[link.from];
+			auto toNode = endpoints[link.to];
+
+			if (!fromNode || !toNode) {
+				CI_LOG_W("cannot load from file, as cannot find node");
+				continue;
 			}
+
+			auto out = fromNode->getOutputPortByName(snapshot.getString(link.fromPort));
+			auto in = toNode->getInputPortByName(snapshot.getString(link.toPort));
+			if (!out || !in) {
+				CI_LOG_W("cannot load from file, as cannot find port");
+				continue;
+			}
+
+			containers[i]->connect(out, in);
 		}
-		p.first->addContainer(nestedContainer);
 	}
 
-	for (auto&& value : containerToLinkMap) {
-		std::pair<act::UID, std::string> fromInfo = getNodeUIDAndPortName(value.second.first);
-		std::pair<act::UID, std::string> toInfo = getNodeUIDAndPortName(value.second.second);
-		
-		auto fromNode = value.first->getNodeByUID(fromInfo.first);
-		auto toNode = value.first->getNodeByUID(toInfo.first);
-
-		if (!fromNode || !toNode) {
-			CI_LOG_W("cannot load from file, as cannot find node");
+	// editor state, as written by ContainerProcNode::toParams
+	for (size_t i = 0; i < snapshot.containers.size(); i++) {
+		auto&& container = snapshot.containers[i];
+		if (snapshot.getString(container.panning).empty())
 			continue;
-		}
 
-		auto out = fromNode->getOutputPortByName(fromInfo.second);
-		auto in = toNode->getInputPortByName(toInfo.second);
+		ci::Json params = ci::Json::object();
+		params["panning"] = snapshot.getString(container.panning);
 
-		value.first->connect(out, in);
-	}
+		auto nodes = ci::Json::array();
+		for (uint32_t index : container.nodes) {
+			auto&& n = snapshot.nodes[index];
+			nodes.push_back({ { "uid", snapshot.getString(n.uid) }, { "x_pos", n.x }, { "y_pos", n.y } });
+		}
+		auto children = ci::Json::array();
+		for (auto&& child : container.children)
+			children.push_back({ { "uid", snapshot.getString(snapshot.containers[child.container].uid) }, { "x_pos", child.x }, { "y_pos", child.y } });
 
-	for (auto&& ctp : containerToParamsMap) {
-		ctp.first->fromParams(ctp.second);
+		params["nodes"] = nodes;
+		params["containers"] = children;
+		containers[i]->fromParams(params);
 	}
 }
 /*
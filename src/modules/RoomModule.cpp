@@ -55,17 +55,17 @@ void act::mod::RoomModule::setup(act::room::RoomManagers roomMgrs, act::net::Net
 	}
 
 	m_stage->setup(m_roomMgrs);
-	fs::path path = app::getAssetPath("recentRoom.json");
-	if (path.empty()) {
-		path = app::getAssetPath("").string() + "recentRoom.json";
-		writeJson(path, ""); // touch
-		saveToFile(path);
-	}
-	loadFromFile(path);
+	// the binary snapshot is preferred, an older recentRoom.json is still read
+	fs::path path = app::getAssetPath("recentRoom.iasnap");
+	if (path.empty())
+		path = app::getAssetPath("recentRoom.json");
+	if (!path.empty())
+		loadFromFile(path);
 }
 
 void act::mod::RoomModule::cleanUp() {
-	saveToFile(app::getAssetPath("recentRoom.json"));
+	saveToFile(app::getAssetPath("").string() + "recentRoom.iasnap");
+	m_saver.flush();
 	m_stage.reset();
 }
 
@@ -156,6 +156,7 @@ void act::mod::RoomModule::drawGUI() {
 void act::mod::RoomModule::load(std::filesystem::path path)
 {
 	m_stage->clear();
+	m_saver.flush();
 	loadFromFile(path);
 }
 
@@ -288,17 +289,14 @@ void act::mod::RoomModule::drawDevicePool() {
 
 	ImGui::NewLine();
 	for (auto&& mgr : m_roomMgrs.list) {
-		if (mgr->getName() != "bodyTrackingManager") {
-
-			if (ImGui::CollapsingHeader(mgr->getName().c_str())) {
-				//drawCreateButton("RGB-Camera"); // for instance
-				auto node = mgr->drawMenu();
-				if (node) {
-					// m_stage->addNode(node); // Manager do keep track themselves
-					m_stage->setSelectedNode(node);
-				}
-				ImGui::NewLine();
+		if (ImGui::CollapsingHeader(mgr->getName().c_str())) {
+			//drawCreateButton("RGB-Camera"); // for instance
+			auto node = mgr->drawMenu();
+			if (node) {
+				// m_stage->addNode(node); // Manager do keep track themselves
+				m_stage->setSelectedNode(node);
 			}
+			ImGui::NewLine();
 		}
 	}
 	ImGui::End();
@@ -328,8 +326,19 @@ void act::mod::RoomModule::handleResize() {
 
 
 void act::mod::RoomModule::saveToFile(fs::path path) {
+	// the saver works on its own copy, msgpack in a snapshot when binary
+	auto description = std::make_shared<const ci::Json>(getFullDescription());
+
+	m_saver.save(path, [description, isJson = path.extension() == ".json"]() {
+		if (isJson) {
+			std::string text = description->dump(4);
+			return std::vector<uint8_t>(text.begin(), text.end());
+		}
 
-	ci::writeJson(path, getFullDescription());
+		util::SnapshotWriter writer(util::SK_ROOM);
+		writer.writeBlob(ci::Json::to_msgpack(*description));
+		return writer.finish();
+	});
 }
 
 ci::Json act::mod::RoomModule::getFullDescription()
@@ -355,7 +364,26 @@ std::vector<std::string> act::mod::RoomModule::getNodeNames()
 }
 
 void act::mod::RoomModule::loadFromFile(fs::path path) {
-	ci::Json roomConfiguration = ci::loadJson(loadFile(path));
+	ci::Json roomConfiguration;
+	try {
+		if (util::isSnapshotFile(path)) {
+			std::vector<uint8_t> data, packed;
+			util::SnapshotReader reader;
+			if (util::readSnapshotFile(path, data) && reader.open(data, util::SK_ROOM) && reader.readBlob(packed))
+				roomConfiguration = ci::Json::from_msgpack(packed);
+		}
+		else {
+			roomConfiguration = ci::loadJson(loadFile(path));
+		}
+	}
+	catch (const std::exception& exc) {
+		CI_LOG_E("cannot load " << path << ": " << exc.what());
+	}
+
+	if (!roomConfiguration.contains("stage")) {
+		CI_LOG_E("cannot load " << path);
+		return;
+	}
 
 	m_stage->fromJson(roomConfiguration["stage"]);
 	for (auto&& mgr : m_roomMgrs.list) {
@@ -0,0 +1,344 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "AssetUploader.hpp"
+#include "cinder/app/App.h"
+#include "cinder/Log.h"
+
+#include <fstream>
+#include <array>
+#include <MatToBase64.hpp>
+
+namespace fs = std::filesystem;
+
+act::net::AssetUploader::AssetUploader()
+{
+	m_thread = std::thread([this]() { loop(); });
+}
+
+act::net::AssetUploader::~AssetUploader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isRunning = false;
+	}
+	m_condition.notify_all();
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+void act::net::AssetUploader::begin(act::UID msgUID, ConnectionProviderRef sender, act::UID uid, std::string kind, std::string fileName, uint64_t size, int64_t checksum)
+{
+	// asset path is resolved here, the app is not asked from the upload thread
+	fs::path directory = getDirectory(kind);
+
+	push([this, msgUID, sender, uid, directory, fileName, size, checksum]() {
+		fs::path name = fs::path(fileName).filename(); // no way out of the upload directory
+		if (name.empty()) {
+			replyError(msgUID, sender, "fileName is not valid.");
+			return;
+		}
+
+		std::error_code ec;
+		fs::create_directories(directory, ec);
+
+		Upload upload;
+		upload.targetPath	= directory / name;
+		upload.partPath		= directory / ("." + name.string() + "." + std::to_string(size) + ".part");
+		upload.size			= size;
+		upload.checksum		= checksum;
+		upload.lastActive	= std::chrono::steady_clock::now();
+
+		// what is left of an interrupted upload of the same file is kept
+		if (fs::exists(upload.partPath, ec))
+			upload.received = fs::file_size(upload.partPath, ec);
+		if (ec || upload.received > size) {
+			fs::remove(upload.partPath, ec);
+			upload.received = 0;
+		}
+		m_uploads[uid] = upload;
+
+		auto data = ci::Json::object();
+		data["uid"]		= uid;
+		data["phase"]	= "begin";
+		data["offset"]	= upload.received;
+		data["size"]	= upload.size;
+		reply(msgUID, sender, data);
+	});
+}
+
+void act::net::AssetUploader::chunk(act::UID msgUID, ConnectionProviderRef sender, act::UID uid, uint64_t offset, std::string base64Data, int64_t checksum)
+{
+	push([this, msgUID, sender, uid, offset, base64Data = std::move(base64Data), checksum]() {
+		auto it = m_uploads.find(uid);
+		if (it == m_uploads.end()) {
+			replyError(msgUID, sender, "upload " + uid + " is not begun.");
+			return;
+		}
+		auto& upload = it->second;
+		upload.lastActive = std::chrono::steady_clock::now();
+
+		auto resend = [&]() {
+			auto data = ci::Json::object();
+			data["uid"]		= uid;
+			data["phase"]	= "resend";
+			data["offset"]	= upload.received;
+			reply(msgUID, sender, data);
+		};
+
+		// duplicates and gaps are answered with the offset that is expected
+		if (offset != upload.received) {
+			resend();
+			return;
+		}
+
+		std::vector<BYTE> bytes = base64_decode(base64Data);
+		if (checksum >= 0 && crc32(bytes.data(), bytes.size()) != (uint32_t)checksum) {
+			resend();
+			return;
+		}
+		if (upload.received + bytes.size() > upload.size) {
+			replyError(msgUID, sender, "upload " + uid + " is larger than announced.");
+			return;
+		}
+
+		std::ofstream file(upload.partPath, std::ios::binary | std::ios::app);
+		if (!file || !file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())) {
+			replyError(msgUID, sender, upload.partPath.string() + " cannot be written.");
+			return;
+		}
+		upload.received += bytes.size();
+
+		auto data = ci::Json::object();
+		data["uid"]			= uid;
+		data["phase"]		= "progress";
+		data["offset"]		= upload.received;
+		data["size"]		= upload.size;
+		data["progress"]	= upload.size > 0 ? (double)upload.received / upload.size : 1.0;
+		reply(msgUID, sender, data);
+	});
+}
+
+void act::net::AssetUploader::commit(act::UID msgUID, ConnectionProviderRef sender, act::UID uid)
+{
+	push([this, msgUID, sender, uid]() {
+		auto it = m_uploads.find(uid);
+		if (it == m_uploads.end()) {
+			replyError(msgUID, sender, "upload " + uid + " is not begun.");
+			return;
+		}
+		auto& upload = it->second;
+		upload.lastActive = std::chrono::steady_clock::now();
+
+		auto data = ci::Json::object();
+		data["uid"] = uid;
+
+		if (upload.received != upload.size) {
+			data["phase"]	= "resend";
+			data["offset"]	= upload.received;
+			reply(msgUID, sender, data);
+			return;
+		}
+
+		std::error_code ec;
+		if (upload.checksum >= 0) {
+			std::ifstream file(upload.partPath, std::ios::binary);
+			std::vector<char> buffer(1 << 20);
+			uint32_t crc = 0;
+			while (file) {
+				file.read(buffer.data(), buffer.size());
+				crc = crc32(reinterpret_cast<const uint8_t*>(buffer.data()), (size_t)file.gcount(), crc);
+			}
+			file.close();
+
+			if (crc != (uint32_t)upload.checksum) {
+				fs::remove(upload.partPath, ec);
+				upload.received = 0;
+				data["phase"]	= "resend";
+				data["offset"]	= 0;
+				reply(msgUID, sender, data);
+				return;
+			}
+		}
+
+		fs::rename(upload.partPath, upload.targetPath, ec);
+		if (ec) {
+			replyError(msgUID, sender, upload.targetPath.string() + " cannot be written: " + ec.message());
+			return;
+		}
+
+		data["phase"]	= "commit";
+		data["data"]	= upload.targetPath.string();
+		reply(msgUID, sender, data);
+		m_uploads.erase(it);
+	});
+}
+
+void act::net::AssetUploader::abort(act::UID msgUID, ConnectionProviderRef sender, act::UID uid)
+{
+	push([this, msgUID, sender, uid]() {
+		auto it = m_uploads.find(uid);
+		if (it == m_uploads.end())
+			return;
+
+		std::error_code ec;
+		fs::remove(it->second.partPath, ec);
+		m_uploads.erase(it);
+
+		auto data = ci::Json::object();
+		data["uid"]		= uid;
+		data["phase"]	= "abort";
+		reply(msgUID, sender, data);
+	});
+}
+
+void act::net::AssetUploader::upload(act::UID msgUID, ConnectionProviderRef sender, std::string kind, std::string fileName, std::string base64Data)
+{
+	fs::path directory = getDirectory(kind);
+
+	push([this, msgUID, sender, directory, fileName, base64Data = std::move(base64Data)]() {
+		fs::path name = fs::path(fileName).filename();
+		if (name.empty()) {
+			replyError(msgUID, sender, "fileName is not valid.");
+			return;
+		}
+
+		std::error_code ec;
+		fs::create_directories(directory, ec);
+
+		const fs::path filePath = directory / name;
+		const std::vector<BYTE> bytes = base64_decode(base64Data);
+		std::ofstream file(filePath, std::ios::binary | std::ios::out);
+		if (!file || !file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())) {
+			CI_LOG_D(filePath.string() + " is not valid!");
+			replyError(msgUID, sender, "FilePath is not valid.");
+			return;
+		}
+
+		auto data = ci::Json::object();
+		data["data"] = filePath.string();
+		reply(msgUID, sender, data);
+	});
+}
+
+std::vector<act::net::AssetUploader::Reply> act::net::AssetUploader::takeReplies()
+{
+	std::lock_guard<std::mutex> lock(m_replyMutex);
+	std::vector<Reply> replies;
+	replies.swap(m_replies);
+	return replies;
+}
+
+void act::net::AssetUploader::expireUploads()
+{
+	auto now = std::chrono::steady_clock::now();
+	if (now - m_lastExpire < std::chrono::minutes(1))
+		return;
+	m_lastExpire = now;
+
+	for (auto it = m_uploads.begin(); it != m_uploads.end();) {
+		if (now - it->second.lastActive > m_idleTimeout) {
+			CI_LOG_I("[AssetUploader] upload " << it->first << " of " << it->second.targetPath.filename().string() << " expired after " << it->second.received << " bytes");
+			it = m_uploads.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+uint32_t act::net::AssetUploader::crc32(const uint8_t* data, size_t size, uint32_t crc)
+{
+	// IEEE 802.3, as computed by zlib and most JavaScript implementations
+	static const std::array<uint32_t, 256> table = []() {
+		std::array<uint32_t, 256> table;
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; bit++)
+				value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+			table[i] = value;
+		}
+		return table;
+	}();
+
+	crc = ~crc;
+	for (size_t i = 0; i < size; i++)
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+fs::path act::net::AssetUploader::getDirectory(const std::string& kind)
+{
+	std::string folder = "uploaded-audio";
+	if (kind == "video")
+		folder = "uploaded-video";
+	else if (kind == "model")
+		folder = "uploaded-models";
+	else if (kind == "fixture")
+		folder = "dmx/uploaded-fixtures";
+
+	return ci::app::getAssetPath("") / folder;
+}
+
+void act::net::AssetUploader::push(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+	m_condition.notify_all();
+}
+
+void act::net::AssetUploader::reply(const act::UID& msgUID, const ConnectionProviderRef& sender, ci::Json data)
+{
+	std::lock_guard<std::mutex> lock(m_replyMutex);
+	m_replies.push_back({ msgUID, sender, data, "" });
+}
+
+void act::net::AssetUploader::replyError(const act::UID& msgUID, const ConnectionProviderRef& sender, std::string error)
+{
+	CI_LOG_W("[AssetUploader] " << error);
+	std::lock_guard<std::mutex> lock(m_replyMutex);
+	m_replies.push_back({ msgUID, sender, ci::Json(), error });
+}
+
+void act::net::AssetUploader::loop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		// woken up once in a while to expire idle uploads
+		m_condition.wait_for(lock, std::chrono::minutes(1), [this]() { return !m_jobs.empty() || !m_isRunning; });
+		if (m_jobs.empty() && !m_isRunning)
+			return;	// stopped, everything is written
+
+		std::function<void()> job;
+		if (!m_jobs.empty()) {
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		lock.unlock();
+		try {
+			if (job)
+				job();
+			expireUploads();
+		}
+		catch (const std::exception& exc) {
+			CI_LOG_E("[AssetUploader] " << exc.what());
+		}
+		lock.lock();
+	}
+}
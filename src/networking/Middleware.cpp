@@ -24,6 +24,7 @@
 #include "JsonMsgProcNode.hpp"
 #include "ProcNodeBase.hpp"
 #include <MatToBase64.hpp>
+#include "jsonHelper.hpp"
 using namespace act::proc;
 //#include "MatToBase64.hpp"
 
@@ -44,9 +45,6 @@ act::net::Middleware::Middleware(act::room::RoomManagers roomMgrs)
 		}
 	}
 
-	m_text = "Initializing";
-	createProcNodeTypeData();
-
 	m_text = "Listening";
 }
 
@@ -87,6 +85,7 @@ void act::net::Middleware::recieveJson(ci::Json json, ConnectionProviderRef send
 			break;
 		case MM_REQUEST:
 			sender->sendMsg(getParameterOfProcNode(msg->getUID(), data["uid"]));
+			watchParameterOfProcNode(data["uid"], sender);
 			break;
 		case MM_UPDATE:
 			setParameterOfProcNode(data["uid"], data["params"]);
@@ -127,7 +126,7 @@ void act::net::Middleware::recieveJson(ci::Json json, ConnectionProviderRef send
 	case MT_ASSET:
 		switch (msg->getMethod()) {
 		case MM_UPLOAD:
-			sender->sendMsg(uploadAudio(msg->getUID(), data["uid"], data["fileName"], data["fileData"]));
+			uploadAsset(msg->getUID(), std::move(data), sender);
 			break;
 		default:
 			m_text = "unknown method in json";
@@ -338,11 +337,22 @@ void act::net::Middleware::setParameterOfProcNode(act::UID uid, ci::Json params)
 	m_procMod->getNodeByUID(uid)->fromParams(params);
 }
 
+void act::net::Middleware::watchParameterOfProcNode(act::UID uid, ConnectionProviderRef sender) {
+	if (!sender || !m_procMod->getNodeByUID(uid))
+		return;
+
+	auto& watchers = m_paramWatchers[uid];
+	if (std::find(watchers.begin(), watchers.end(), sender) == watchers.end())
+		watchers.push_back(sender);
+}
+
 ci::Json act::net::Middleware::requestProcNodeTypes(act::UID msgUID) {
 	Message msg(msgUID, MsgType::MT_DESCRIPTION, MsgMethod::MM_UPDATE);
 
 	auto data = ci::Json::object();
 	data["name"] = "procNodeTypes";
+	if (m_procNodeTypeData.empty())
+		createProcNodeTypeData();
 	data["procNodeTypes"] = m_procNodeTypeData;
 	msg.setData(data);
 
@@ -351,48 +361,52 @@ ci::Json act::net::Middleware::requestProcNodeTypes(act::UID msgUID) {
 
 void act::net::Middleware::createProcNodeTypeData()
 {
-	if (m_nodeTypeNodes.empty()) {
-		std::map<act::UID, act::proc::ProcNodeRegistry::nodeCreateFunc> registeredNodes = std::make_shared<act::proc::ProcNodeRegistry>()->getMap();
-		for (auto&& regNode : registeredNodes) {
-			try {
-				m_nodeTypeNodes.push_back(regNode.second());
-			}
-			catch (...) {
-				int panic = 1;
-				continue;
-			}
-		}
-	}
-	m_procNodeTypeData = ci::Json::object();
-	for (auto&& node : m_nodeTypeNodes) {
-		m_procNodeTypeData.update(node->getJsonTypeDefinition());
-	}
+	if (!m_procMod)
+		return;
+
+	m_procNodeTypeData = m_procMod->getNodeRegistry()->getTypeDefinitions();
 }
 
-// TODO refactor to generic upload/transmit data/-blob function
-ci::Json act::net::Middleware::uploadAudio(act::UID msgUID, act::UID uid, std::string fileName, std::string fileData) {
-	const std::vector<BYTE> byteData = _BASE64_H_::base64_decode(fileData);
+void act::net::Middleware::uploadAsset(act::UID msgUID, ci::Json data, ConnectionProviderRef sender) {
+	act::UID	uid			= "";
+	std::string	phase		= "";
+	std::string	kind		= "audio";
+	std::string	fileName	= "";
+	util::setValueFromJson(data, "uid", uid);
+	util::setValueFromJson(data, "phase", phase);
+	util::setValueFromJson(data, "kind", kind);
+	util::setValueFromJson(data, "fileName", fileName);
+
+	// base64 strings are moved on to the upload thread, not copied
+	auto takeData = [&](const std::string& key) {
+		std::string base64Data;
+		if (data.contains(key) && data[key].is_string())
+			base64Data = std::move(data[key].get_ref<std::string&>());
+		return base64Data;
+	};
 
-	if (!std::filesystem::is_directory(getAssetPath("") / "uploaded-audio")) {
-		std::filesystem::create_directory(getAssetPath("") / "uploaded-audio");
+	if (phase.empty()) {
+		if (checkEmpty(fileName, "uploadAsset", "fileName", sender))
+			return;
+		m_uploader.upload(msgUID, sender, kind, fileName, takeData("fileData"));
 	}
-
-	const std::filesystem::path filePath = getAssetPath("") / "uploaded-audio" / fileName;
-	std::ofstream audioFile(filePath, std::ios::binary | std::ios::out);
-	if (!audioFile) {
-		CI_LOG_D(filePath.string() + " is not valid!");
-		return Message().createErrorMsgJson("uploadAudio", "FilePath is not valid.");
+	else if (phase == "begin") {
+		if (checkEmpty(fileName, "uploadAsset", "fileName", sender))
+			return;
+		m_uploader.begin(msgUID, sender, uid, kind, fileName, data.value("size", (uint64_t)0), data.value("checksum", (int64_t)-1));
+	}
+	else if (phase == "chunk") {
+		m_uploader.chunk(msgUID, sender, uid, data.value("offset", (uint64_t)0), takeData("data"), data.value("checksum", (int64_t)-1));
+	}
+	else if (phase == "commit") {
+		m_uploader.commit(msgUID, sender, uid);
+	}
+	else if (phase == "abort") {
+		m_uploader.abort(msgUID, sender, uid);
+	}
+	else {
+		sender->sendMsg(Message().createErrorMsgJson("uploadAsset", "phase '" + phase + "' is unknown."));
 	}
-	audioFile.write(reinterpret_cast<const char*>(byteData.data()), byteData.size());
-	audioFile.close();
-
-	Message msg(msgUID, MsgType::MT_ASSET, MsgMethod::MM_UPLOAD);
-
-	auto data = ci::Json::object();
-	data["data"] = filePath.string();
-	msg.setData(data);
-
-	return msg.toJson();
 }
 
 
@@ -495,6 +509,46 @@ ci::Json act::net::Middleware::callRPC(act::UID msgUID, act::UID uid, std::strin
 }
 
 void act::net::Middleware::update() {
+	// the subscriptions are not part of the ProcNodeModule, their previews are sent from here
+	for (auto&& jsonNode : m_jsonNodes)
+		jsonNode->update();
+
+	for (auto&& reply : m_uploader.takeReplies()) {
+		if (!reply.sender)
+			continue;
+
+		if (!reply.error.empty()) {
+			reply.sender->sendMsg(Message().createErrorMsgJson("uploadAsset", reply.error));
+			continue;
+		}
+
+		Message msg(reply.msgUID, MsgType::MT_ASSET, MsgMethod::MM_UPLOAD);
+		msg.setData(reply.data);
+		reply.sender->sendMsg(msg.toJson());
+	}
+
+	// a requester got all params once, from now on only the changed ones are sent
+	for (auto it = m_paramWatchers.begin(); it != m_paramWatchers.end();) {
+		auto node = m_procMod->getNodeByUID(it->first);
+		if (!node) {
+			it = m_paramWatchers.erase(it);
+			continue;
+		}
+
+		ci::Json params = node->takeParamChanges();
+		if (!params.empty()) {
+			Message msg(UniqueIDBase().getUID(), MsgType::MT_PROCNODE, MsgMethod::MM_UPDATE);
+			auto data = ci::Json::object();
+			data["uid"]		= it->first;
+			data["params"]	= params;
+			msg.setData(data);
+
+			auto json = msg.toJson();
+			for (auto&& watcher : it->second)
+				watcher->sendMsg(json);
+		}
+		++it;
+	}
 }
 
 void act::net::Middleware::draw() {
@@ -25,6 +25,7 @@
 #include "WebUIServer.hpp"
 #include "WebUISecureServer.hpp"
 #include "TCPSocket.hpp"
+#include "OSCReciever.hpp"
 
 #include <algorithm>
 
@@ -94,8 +95,13 @@ void act::net::NetworkManager::publishChanges(act::UID msgUID, ci::Json data, Pu
 
 void act::net::NetworkManager::update()
 {
+	// OSC listeners feed the graph, so they run before it is updated
+	OSCReciever::updateAll();
+
 	m_webUI->update();
 	m_secureWebUI->update();
+
+	m_middleware->update();
 }
 
 void act::net::NetworkManager::getFullDescription() {
@@ -123,6 +129,8 @@ ci::Json act::net::NetworkManager::toJson()
 	ci::Json devices = ci::Json::array();
 	
 	json["devices"] = devices;
+	json["webUI"] = m_webUI->toJson();
+	json["secureWebUI"] = m_secureWebUI->toJson();
 
 	return json;
 	
@@ -137,6 +145,10 @@ void act::net::NetworkManager::fromJson(ci::Json json)
 			
 		}
 	}
+	if (json.contains("webUI"))
+		m_webUI->fromJson(json["webUI"]);
+	if (json.contains("secureWebUI"))
+		m_secureWebUI->fromJson(json["secureWebUI"]);
 }
 
 void act::net::NetworkManager::onMsg(ci::Json json, act::UID uid)
@@ -154,7 +166,12 @@ act::net::ConnectionProviderRef act::net::NetworkManager::getConnectionByUID(act
 
 void act::net::NetworkManager::onConnect(act::UID uid)
 {
-	getConnectionByUID(uid)->sendMsg(m_middleware->getFullDescription());
+	// the WebUI servers send the full description to each new client by onResync
+}
+
+ci::Json act::net::NetworkManager::onResync(act::UID uid)
+{
+	return m_middleware->getFullDescription();
 }
 
 void act::net::NetworkManager::onDisconnect(act::UID uid)
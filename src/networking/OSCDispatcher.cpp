@@ -0,0 +1,219 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "OSCDispatcher.hpp"
+
+#include <algorithm>
+
+
+act::net::OSCDispatcher::OSCDispatcher()
+{
+}
+
+act::net::OSCDispatcher::~OSCDispatcher()
+{
+}
+
+void act::net::OSCDispatcher::setListener(const std::string& pattern, ListenerFn listener)
+{
+	m_listeners[pattern] = std::make_shared<ListenerFn>(std::move(listener));
+	m_isCompiled = false;
+}
+
+void act::net::OSCDispatcher::removeListener(const std::string& pattern)
+{
+	m_listeners.erase(pattern);
+	m_isCompiled = false;
+}
+
+void act::net::OSCDispatcher::split(std::string_view address, std::vector<std::string_view>& parts)
+{
+	parts.clear();
+	size_t begin = address.empty() || address[0] != '/' ? 0 : 1;
+	while (begin <= address.size()) {
+		size_t end = address.find('/', begin);
+		if (end == std::string_view::npos)
+			end = address.size();
+		parts.push_back(address.substr(begin, end - begin));
+		begin = end + 1;
+	}
+}
+
+bool act::net::OSCDispatcher::isWildcard(std::string_view part)
+{
+	return part.find_first_of("*?[{") != std::string_view::npos;
+}
+
+void act::net::OSCDispatcher::compile()
+{
+	m_nodes.assign(1, Node());
+	m_cache.clear();
+
+	std::vector<std::string_view> parts;
+	for (auto&& [pattern, listener] : m_listeners) {
+		split(pattern, parts);
+
+		int32_t index = 0;
+		for (auto part : parts) {
+			int32_t next = -1;
+			if (isWildcard(part)) {
+				auto& wildcards = m_nodes[index].wildcards;
+				auto it = std::find_if(wildcards.begin(), wildcards.end(), [&](auto& w) { return w.first == part; });
+				if (it != wildcards.end())
+					next = it->second;
+				else
+					wildcards.push_back({ std::string(part), next = (int32_t)m_nodes.size() });
+			}
+			else {
+				auto [it, isNew] = m_nodes[index].literals.try_emplace(std::string(part), (int32_t)m_nodes.size());
+				next = it->second;
+			}
+
+			if (next == (int32_t)m_nodes.size())
+				m_nodes.emplace_back();
+			index = next;
+		}
+		m_nodes[index].listeners.push_back(listener);
+	}
+
+	m_isCompiled = true;
+}
+
+void act::net::OSCDispatcher::collect(int32_t index, size_t part, std::vector<ListenerRef>& result)
+{
+	const Node& node = m_nodes[index];
+	if (part == m_parts.size()) {
+		result.insert(result.end(), node.listeners.begin(), node.listeners.end());
+		return;
+	}
+
+	auto it = node.literals.find(std::string(m_parts[part]));
+	if (it != node.literals.end())
+		collect(it->second, part + 1, result);
+
+	for (auto&& [pattern, next] : node.wildcards) {
+		if (matchPart(pattern, m_parts[part]))
+			collect(next, part + 1, result);
+	}
+}
+
+bool act::net::OSCDispatcher::dispatch(const ci::osc::Message& message)
+{
+	if (!m_isCompiled)
+		compile();
+
+	const std::string& address = message.getAddress();
+	auto cached = m_cache.find(address);
+	if (cached == m_cache.end()) {
+		// addresses are chosen by the senders, so the cache is bounded
+		if (m_cache.size() > 4096)
+			m_cache.clear();
+
+		std::vector<ListenerRef> listeners;
+		split(address, m_parts);
+		collect(0, 0, listeners);
+		cached = m_cache.emplace(address, std::move(listeners)).first;
+	}
+
+	// the pointers are copied, a listener may set or remove listeners (e.g. when its node is deleted), which recompiles the trie
+	std::vector<ListenerRef> listeners = cached->second;
+	for (auto&& listener : listeners)
+		(*listener)(message);
+
+	return !listeners.empty();
+}
+
+bool act::net::OSCDispatcher::matchPart(std::string_view pattern, std::string_view part)
+{
+	size_t p = 0, s = 0;
+	while (p < pattern.size()) {
+		char c = pattern[p];
+
+		if (c == '*') {
+			// collapse consecutive stars, then try every possible length
+			while (p < pattern.size() && pattern[p] == '*')
+				p++;
+			if (p == pattern.size())
+				return true;
+			for (size_t rest = s; rest <= part.size(); rest++) {
+				if (matchPart(pattern.substr(p), part.substr(rest)))
+					return true;
+			}
+			return false;
+		}
+
+		if (s >= part.size())
+			return false;
+
+		if (c == '?') {
+			p++;
+			s++;
+		}
+		else if (c == '[') {
+			size_t end = pattern.find(']', p + 1);
+			if (end == std::string_view::npos)
+				return false;
+
+			size_t i = p + 1;
+			bool negate = i < end && pattern[i] == '!';
+			if (negate)
+				i++;
+
+			bool found = false;
+			for (; i < end; i++) {
+				if (i + 2 < end && pattern[i + 1] == '-') {
+					char from = std::min(pattern[i], pattern[i + 2]);
+					char to = std::max(pattern[i], pattern[i + 2]);
+					found |= from <= part[s] && part[s] <= to;
+					i += 2;
+				}
+				else {
+					found |= pattern[i] == part[s];
+				}
+			}
+			if (found == negate)
+				return false;
+			p = end + 1;
+			s++;
+		}
+		else if (c == '{') {
+			size_t end = pattern.find('}', p + 1);
+			if (end == std::string_view::npos)
+				return false;
+
+			std::string_view rest = pattern.substr(end + 1);
+			std::string_view options = pattern.substr(p + 1, end - p - 1);
+			size_t begin = 0;
+			while (begin <= options.size()) {
+				size_t comma = options.find(',', begin);
+				if (comma == std::string_view::npos)
+					comma = options.size();
+				std::string_view option = options.substr(begin, comma - begin);
+				if (part.substr(s, option.size()) == option && matchPart(rest, part.substr(s + option.size())))
+					return true;
+				begin = comma + 1;
+			}
+			return false;
+		}
+		else {
+			if (c != part[s])
+				return false;
+			p++;
+			s++;
+		}
+	}
+	return s == part.size();
+}
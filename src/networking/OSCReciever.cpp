@@ -0,0 +1,144 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "OSCReciever.hpp"
+#include "Logger.hpp"
+
+std::mutex act::net::OSCReciever::s_mutex;
+std::vector<std::weak_ptr<act::net::OSCReciever>> act::net::OSCReciever::s_recievers;
+
+
+act::net::OSCReciever::OSCReciever(uint16_t port)
+	: m_work(asio::make_work_guard(m_ioContext))
+{
+	m_connected = false;
+	m_ring.resize(kRingSize);
+
+	m_receiver = std::make_shared<Receiver>(port, protocol::v4(), m_ioContext);
+
+	// every message ends up in the ring, the dispatcher decides on the main thread who gets it
+	m_receiver->setListener("*", [this](const ci::osc::Message& message) { push(message); });
+
+#if USE_UDP
+	// UDP opens the socket and "listens" accepting any message from any endpoint. The listen
+	// function takes an error handler for the underlying socket. Any errors that would
+	// call this function are because of problems with the socket or with the remote message.
+
+#endif
+}
+
+act::net::OSCReciever::~OSCReciever()
+{
+	// the socket belongs to the network thread, closing it there ends the pending receive
+	auto receiver = m_receiver;
+	asio::post(m_ioContext, [receiver]() { receiver->close(); });
+	m_work.reset();
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+std::shared_ptr<act::net::OSCReciever> act::net::OSCReciever::create(uint16_t localPort)
+{
+	auto reciever = std::make_shared<OSCReciever>(localPort);
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_recievers.push_back(reciever);
+	return reciever;
+}
+
+void act::net::OSCReciever::listen()
+{
+	try{
+		// Bind the receiver to the endpoint. This function may throw.
+		m_receiver->bind();
+	}
+		catch (const osc::Exception& ex) {
+		CI_LOG_E("Error binding: " << ex.what() << " val: " << ex.value());
+	}
+	m_receiver->listen(
+		[this](asio::error_code error, protocol::endpoint endpoint) -> bool {
+			if (error) {
+				ACT_LOG_EVERY(1.0, ci::log::LEVEL_ERROR, "oscListenError", { "error", error.message() }, { "val", error.value() }, { "address", endpoint.address().to_string() }, { "port", endpoint.port() });
+				return false;
+			}
+			else {
+				m_connected = true;
+				return true;
+			}
+		});
+
+	if (!m_thread.joinable())
+		m_thread = std::thread([this]() { m_ioContext.run(); });
+}
+
+void act::net::OSCReciever::push(const ci::osc::Message& message)
+{
+	m_received++;
+
+	size_t head = m_head.load(std::memory_order_relaxed);
+	if (head - m_tail.load(std::memory_order_acquire) >= kRingSize) {
+		m_dropped++;
+		return;
+	}
+
+	m_ring[head & (kRingSize - 1)] = message;
+	m_head.store(head + 1, std::memory_order_release);
+}
+
+void act::net::OSCReciever::update()
+{
+	m_messages.clear();
+
+	size_t tail = m_tail.load(std::memory_order_relaxed);
+	size_t head = m_head.load(std::memory_order_acquire);
+	for (; tail != head; tail++)
+		m_messages.push_back(std::move(m_ring[tail & (kRingSize - 1)]));
+	m_tail.store(tail, std::memory_order_release);
+
+	if (m_messages.empty())
+		return;
+
+	if (m_isCoalescing) {
+		m_latest.clear();
+		for (size_t i = 0; i < m_messages.size(); i++)
+			m_latest[m_messages[i].getAddress()] = i;
+	}
+
+	for (size_t i = 0; i < m_messages.size(); i++) {
+		const ci::osc::Message& message = m_messages[i];
+		if (m_isCoalescing && m_latest[message.getAddress()] != i)
+			continue;
+
+		if (!m_dispatcher.dispatch(message) && m_disregardedAddresses.insert(message.getAddress()).second)
+			CI_LOG_W("Message: " << message.getAddress() << " doesn't have a listener. Disregarding.");
+	}
+}
+
+void act::net::OSCReciever::updateAll()
+{
+	std::vector<std::shared_ptr<OSCReciever>> recievers;
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_recievers.erase(std::remove_if(s_recievers.begin(), s_recievers.end(), [](auto& r) { return r.expired(); }), s_recievers.end());
+		for (auto&& reciever : s_recievers) {
+			if (auto locked = reciever.lock())
+				recievers.push_back(locked);
+		}
+	}
+
+	for (auto&& reciever : recievers)
+		reciever->update();
+}
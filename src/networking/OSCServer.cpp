@@ -1,4 +1,3 @@
-
 /*
 	InACTually
 	> interactive theater for actual acts
@@ -9,7 +8,7 @@
 	Licensed under the MIT License.
 	See LICENSE file in the project root for full license information.
 
-	This file is created and substantially modified: 2021-2023
+	This file is created and substantially modified: 2021-2023, 2025
 
 	contributors:
 	Lars Engeln - mail@lars-engeln.de
@@ -17,37 +16,106 @@
 
 #include "OSCServer.hpp"
 #include "cinder/Log.h"
+#include "Logger.hpp"
 
 using namespace asio;
 using namespace asio::ip;
 
 act::net::OSCServer::OSCServer(uint16_t localPort, asio::ip::address address)
-	: m_socket(new udp::socket(ci::app::App::get()->io_context(), udp::endpoint(udp::v4(), localPort+1)))
+	: m_work(asio::make_work_guard(m_ioContext))
+	, m_socket(new udp::socket(m_ioContext, udp::endpoint(udp::v4(), localPort+1)))
 	// The endpoint that we want to "send" to is the v4 broadcast address.
 	, m_sender(m_socket, udp::endpoint(address, localPort)), m_isConnected(false)
 {
 
 	m_socket->set_option(asio::socket_base::broadcast(true));
 	m_isConnected = true;
+
+	// all sends and their completions run here, the socket is not touched by other threads
+	m_thread = std::thread([this]() { m_ioContext.run(); });
 }
 
 
 act::net::OSCServer::~OSCServer()
 {
+	flush();
+
+	// run() returns once the queued sends are done
+	m_work.reset();
+	if (m_thread.joinable())
+		m_thread.join();
+
 	m_sender.close();
 	m_socket->close();
 }
 
 void act::net::OSCServer::sendMsg(ci::osc::Message msg)
 {
-	m_sender.send(msg, std::bind(&OSCServer::onSendError,
-		this, std::placeholders::_1));
+	if (m_isBundling) {
+		append(msg, 0);
+		return;
+	}
+
+	m_sentMessages++;
+	asio::post(m_ioContext, [this, msg]() {
+		m_sender.send(msg, std::bind(&OSCServer::onSendError, this, std::placeholders::_1));
+		m_sentPackets++;
+	});
+}
+
+void act::net::OSCServer::sendMsg(ci::osc::Message msg, float delay)
+{
+	append(msg, std::max(0, (int)(delay * 1000.0f)));
+}
+
+void act::net::OSCServer::setIsBundling(bool bundling)
+{
+	if (m_isBundling && !bundling)
+		flush();
+	m_isBundling = bundling;
+}
+
+void act::net::OSCServer::append(const ci::osc::Message& msg, int delay)
+{
+	// a message is appended with its 4 byte size, like an element of the bundle
+	size_t size = msg.getPacketSize();
+
+	auto& bundles = m_bundles[delay];
+	if (bundles.empty() || bundles.back().getPacketSize() - 4 + size > m_maxPacketSize)
+		bundles.emplace_back();
+	bundles.back().append(msg);
+	m_sentMessages++;
+}
+
+void act::net::OSCServer::flush()
+{
+	if (m_bundles.empty())
+		return;
+
+	std::vector<ci::osc::Bundle> packets;
+	for (auto&& [delay, bundles] : m_bundles) {
+		// 1 means immediately, the default timetag of a bundle
+		if (delay > 0) {
+			uint64_t timetag = ci::osc::time::get_current_ntp_time(std::chrono::milliseconds(delay));
+			for (auto&& bundle : bundles)
+				bundle.setTimetag(timetag);
+		}
+		packets.insert(packets.end(), std::make_move_iterator(bundles.begin()), std::make_move_iterator(bundles.end()));
+	}
+	m_bundles.clear();
+
+	asio::post(m_ioContext, [this, packets = std::move(packets)]() {
+		for (auto&& bundle : packets) {
+			m_sender.send(bundle, std::bind(&OSCServer::onSendError, this, std::placeholders::_1));
+			m_sentPackets++;
+		}
+	});
 }
 
 void act::net::OSCServer::onSendError(asio::error_code error)
 {
 	if (error) {
-		CI_LOG_E("Error sending: " << error.message() << " val: " << error.value());
+		ACT_LOG_EVERY(1.0, ci::log::LEVEL_ERROR, "oscSendError", { "error", error.message() }, { "val", error.value() });
 		m_isConnected = false;
 		try {
 			m_sender.close();
@@ -47,8 +47,9 @@ act::net::WebUISecureServer::WebUISecureServer(MsgRecieverRef reciever)
 		if (!out_message.empty()) {
 
 			try {
-				this->recieveJson(ci::Json::parse(out_message));
-				// CI_LOG_I("JSON Message Received");
+				auto json = ci::Json::parse(out_message);
+				std::lock_guard<std::mutex> lock(m_inboxMutex);
+				m_inbox.push_back(std::move(json));
 			}
 			catch (const std::exception& exc)
 			{
@@ -62,18 +63,14 @@ act::net::WebUISecureServer::WebUISecureServer(MsgRecieverRef reciever)
 	};
 
 	endpoint.on_open = [&](std::shared_ptr<WssServer::Connection> connection) {
-		m_isConnected = true;
-		m_reciever->onConnect(getUID());
+		m_clients.add(connection);
 		m_text = "A WebUI is connected";
 		CI_LOG_I(m_text);
 	};
 
 	// See RFC 6455 7.4.1. for status codes
 	endpoint.on_close = [&](std::shared_ptr<WssServer::Connection> connection, int status, const std::string& /*reason*/) {
-		if (m_server->get_connections().size() == 0) {
-			m_reciever->onDisconnect(getUID());
-			m_isConnected = false;
-		}
+		m_clients.remove(connection);
 	};
 
 	endpoint.on_handshake = [](std::shared_ptr<WssServer::Connection> /*connection*/, SimpleWeb::CaseInsensitiveMultimap& response_header) {
@@ -82,6 +79,7 @@ act::net::WebUISecureServer::WebUISecureServer(MsgRecieverRef reciever)
 	};
 
 	endpoint.on_error = [&](std::shared_ptr<WssServer::Connection> connection, const SimpleWeb::error_code& ec) {
+		m_clients.remove(connection);
 		std::stringstream strstr;
 		strstr << "Error in connection " << connection.get() << ". " << "Error: " << ec << ", error message: " << ec.message();
 		m_text = strstr.str();
@@ -101,16 +99,22 @@ act::net::WebUISecureServer::WebUISecureServer(MsgRecieverRef reciever)
 }
 
 act::net::WebUISecureServer::~WebUISecureServer() {
-	m_serverThread.join();
+	m_server->stop();
+	if (m_serverThread.joinable())
+		m_serverThread.join();
 }
 
 void act::net::WebUISecureServer::sendMsg(ci::Json msg) {
 	if (!m_isConnected || msg.is_null())
 		return;
 
-	auto str = msg.dump();
-	for (auto& a_connection : m_server->get_connections())
-		a_connection->send(str);
+	m_clients.broadcast(msg);
+}
+
+std::string act::net::WebUISecureServer::getCurrentStatus() {
+	std::stringstream strstr;
+	strstr << "wss-WebUI: " << m_clients.size() << " clients, " << m_clients.getPendingCount() << " pending, " << m_clients.getDroppedCount() << " dropped";
+	return strstr.str();
 }
 
 void act::net::WebUISecureServer::recieveJson(ci::Json json) {
@@ -119,7 +123,24 @@ void act::net::WebUISecureServer::recieveJson(ci::Json json) {
 
 
 void act::net::WebUISecureServer::update() {
+	std::vector<ci::Json> inbox;
+	{
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		inbox.swap(m_inbox);
+	}
+	for (auto&& json : inbox)
+		recieveJson(json);
+
+	bool isConnected = m_clients.size() > 0;
+	if (isConnected != m_isConnected) {
+		m_isConnected = isConnected;
+		if (m_isConnected)
+			m_reciever->onConnect(getUID());
+		else
+			m_reciever->onDisconnect(getUID());
+	}
 
+	m_clients.resync([&]() { return m_reciever->onResync(getUID()); });
 }
 
 void act::net::WebUISecureServer::draw() {
@@ -131,8 +152,11 @@ void act::net::WebUISecureServer::draw() {
 }
 
 ci::Json act::net::WebUISecureServer::toJson() {
-	return ci::Json::object();
+	return m_clients.getConfig().toJson();
 }
 
 void act::net::WebUISecureServer::fromJson(ci::Json json) {
+	auto config = m_clients.getConfig();
+	config.fromJson(json);
+	m_clients.setConfig(config);
 }
@@ -24,6 +24,7 @@
 #include "JsonMsgProcNode.hpp"
 #include "ProcNodeBase.hpp"
 #include <MatToBase64.hpp>
+#include <future>
 using namespace act::proc;
 //#include "MatToBase64.hpp"
 
@@ -33,91 +34,97 @@ act::net::WebUIServer::WebUIServer(MsgRecieverRef reciever)
 {
 	m_port = 9002;
 	m_isConnected = false;
-	m_text = "Initializing";
+	setText("Initializing");
 
-	m_server.connectCloseEventHandler([&]() {
-		m_isConnected = false;
-		m_reciever->onDisconnect(getUID());
-		m_text = "Connection closed";
-		CI_LOG_I(m_text);
-	});
-
-
-	m_server.connectFailEventHandler([&](std::string err) {
-
-		m_text = "Error";
-		if (!err.empty()) {
-			m_text += ": " + err;
-		}
-		CI_LOG_I(m_text);
-	});
+	m_server = std::make_shared<WsServer>();
+	m_server->config.port = m_port;
 
-	m_server.connectInterruptEventHandler([&]() {
-		m_isConnected = false;
-		m_reciever->onDisconnect(getUID());
-		m_text = "Connection Interrupted";
-		CI_LOG_I(m_text);
-	});
+	auto& endpoint = m_server->endpoint["^/?$"];
 
-	m_server.connectMessageEventHandler([&](std::string msg) {
+	endpoint.on_message = [&](std::shared_ptr<WsServer::Connection> connection, std::shared_ptr<WsServer::InMessage> in_message) {
+		auto msg = in_message->string();
 
 		if (!msg.empty()) {
 
 			try {
-				this->recieveJson(ci::Json::parse(msg));
-				CI_LOG_I("JSON Message Received");
+				auto json = ci::Json::parse(msg);
+				std::lock_guard<std::mutex> lock(m_inboxMutex);
+				m_inbox.push_back(std::move(json));
 			}
 			catch (const std::exception& exc)
 			{
-				m_text = "[cannot interprete msg] " + msg + " (string) - " + exc.what();
-				CI_LOG_I(m_text);
+				std::string text = "[cannot interprete msg] " + msg + " (string) - " + exc.what();
+				setText(text);
+				CI_LOG_I(text);
 			}
 		}
+	};
+
+	endpoint.on_open = [&](std::shared_ptr<WsServer::Connection> connection) {
+		m_clients.add(connection);
+		setText("A WebUI is connected");
+		CI_LOG_I("A WebUI is connected");
+	};
+
+	endpoint.on_close = [&](std::shared_ptr<WsServer::Connection> connection, int status, const std::string& /*reason*/) {
+		m_clients.remove(connection);
+		setText("Connection closed");
+		CI_LOG_I("Connection closed");
+	};
+
+	endpoint.on_error = [&](std::shared_ptr<WsServer::Connection> connection, const SimpleWeb::error_code& ec) {
+		m_clients.remove(connection);
+		std::stringstream strstr;
+		strstr << "Error in connection " << connection.get() << ". " << "Error: " << ec << ", error message: " << ec.message();
+		setText(strstr.str());
+		CI_LOG_I(strstr.str());
+	};
+
+	// start() may still throw after it reported the port, the promise is set only once and outlives the constructor
+	auto server_port = std::make_shared<std::promise<unsigned short>>();
+	auto isPortSet = std::make_shared<std::once_flag>();
+	auto setPort = [server_port, isPortSet](unsigned short port) {
+		std::call_once(*isPortSet, [&]() { server_port->set_value(port); });
+	};
+	auto port = server_port->get_future();
+
+	m_serverThread = std::thread([this, setPort]() {
+		try {
+			m_server->start(setPort);
+		}
+		catch (const std::exception& exc) {
+			CI_LOG_E("WebUI cannot listen on " << m_port << ": " << exc.what());
+			setPort(0);
+		}
 	});
-
-	m_server.connectOpenEventHandler([&]() {
-		m_isConnected = true;
-		m_reciever->onConnect(getUID());
-		m_text = "Connected";
-		CI_LOG_I(m_text);
-	});
-
-
-	m_server.connectSocketInitEventHandler([&]() {
-
-		// This routine reads the address of the incoming connection
-		// and prints it to the log
-		/*asio::ip::tcp::socket* socket = m_server.getSocket();
-		if (socket != nullptr) {
-			asio::ip::address address = socket->remote_endpoint().address();
-			string host = "";
-			if (address.is_v4()) {
-				host += address.to_v4().to_string();
-			}
-			else if (address.is_v6()) {
-				host += address.to_v6().to_string();
-			}
-			else {
-				host += address.to_string();
-			}
-			host += ":" + toString(socket->remote_endpoint().port());
-			CI_LOG_I(host);
-		}*/
-		});
-
-	m_server.listen(m_port);
-	m_text = "Listening";
+	std::stringstream strstr;
+	strstr << "Listening on " << port.get();
+	setText(strstr.str());
+	CI_LOG_I("WebUI " + strstr.str());
 }
 
 act::net::WebUIServer::~WebUIServer() {
+	m_server->stop();
+	if (m_serverThread.joinable())
+		m_serverThread.join();
 }
 
 void act::net::WebUIServer::sendMsg(ci::Json msg) {
-	if (!m_isConnected | !msg.is_null())
+	if (!m_isConnected || msg.is_null())
 		return;
 
-	auto str = msg.dump();
-	m_server.write(str);
+	m_clients.broadcast(msg);
+}
+
+std::string act::net::WebUIServer::getCurrentStatus() {
+	std::stringstream strstr;
+	strstr << "WebUI: " << m_clients.size() << " clients, " << m_clients.getPendingCount() << " pending, " << m_clients.getDroppedCount() << " dropped";
+	return strstr.str();
+}
+
+void act::net::WebUIServer::setText(const std::string& text) {
+	std::lock_guard<std::mutex> lock(m_textMutex);
+	m_text = text;
 }
 
 void act::net::WebUIServer::recieveJson(ci::Json json) {
@@ -126,20 +133,43 @@ void act::net::WebUIServer::recieveJson(ci::Json json) {
 
 
 void act::net::WebUIServer::update() {
-	m_server.poll();
+	std::vector<ci::Json> inbox;
+	{
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		inbox.swap(m_inbox);
+	}
+	for (auto&& json : inbox)
+		recieveJson(json);
+
+	bool isConnected = m_clients.size() > 0;
+	if (isConnected != m_isConnected) {
+		m_isConnected = isConnected;
+		if (m_isConnected)
+			m_reciever->onConnect(getUID());
+		else
+			m_reciever->onDisconnect(getUID());
+	}
+
+	m_clients.resync([&]() { return m_reciever->onResync(getUID()); });
 }
 
 void act::net::WebUIServer::draw() {
 
 	std::stringstream strstr;
-	strstr << "WebUI: " << m_text;
+	{
+		std::lock_guard<std::mutex> lock(m_textMutex);
+		strstr << "WebUI: " << m_text;
+	}
 	ImGui::TextUnformatted(strstr.str().c_str());
 
 }
 
 ci::Json act::net::WebUIServer::toJson() {
-	return ci::Json::object();
+	return m_clients.getConfig().toJson();
 }
 
 void act::net::WebUIServer::fromJson(ci::Json json) {
+	auto config = m_clients.getConfig();
+	config.fromJson(json);
+	m_clients.setConfig(config);
 }
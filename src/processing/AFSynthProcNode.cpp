@@ -30,46 +30,6 @@ act::proc::AFSynthProcNode::AFSynthProcNode() : ProcNodeBase("AFSynth") {
 	m_volumePort = createNumberOutput("volume");
 
 	m_scaleValue = 1.0f;
-
-
-
-	ci::audio::Context* ctx = ci::audio::master();
-
-	m_osc		= ctx->makeNode(new audio::GenTriangleNode);
-	m_modFM		= ctx->makeNode(new audio::GenSineNode);
-	m_modAM		= ctx->makeNode(new audio::GenSineNode);
-	m_add		= ctx->makeNode(new audio::AddNode);
-	m_mul		= ctx->makeNode(new audio::MultiplyNode);
-	m_gain		= ctx->makeNode(new audio::GainNode);
-	m_gainFM	= ctx->makeNode(new audio::GainNode);
-	m_lowP		= ctx->makeNode(new audio::FilterLowPassNode);
-	auto monitorFormat = audio::MonitorSpectralNode::Format().fftSize(2048).windowSize(1024);
-	m_monitor	= ctx->makeNode(new audio::MonitorNode(monitorFormat));
-
-	//m_sine >> m_gain;
-
-	m_osc->setFreq(220);
-	m_modFM->setFreq(220);
-	m_modAM->setFreq(20);
-	m_add->setValue(200);
-	m_mul->setValue(50);
-	m_gain->setValue(1.0f);
-	m_gainFM->setValue(200);
-
-	m_modFM >> m_gainFM;
-	m_osc->getParamFreq()->setProcessor(m_gainFM);
-
-	m_mul->getParam()->setProcessor(m_modAM);
-
-	m_osc >> m_mul >> m_lowP >> m_gain >> m_monitor;
-
-	m_osc->enable();
-	m_modFM->enable();
-	m_modAM->enable();
-	m_gain->enable();
-
-
-	m_audioOutPort->send(m_gain);
 }
 
 act::proc::AFSynthProcNode::~AFSynthProcNode() {
@@ -126,7 +86,43 @@ void act::proc::AFSynthProcNode::draw() {
 
 void act::proc::AFSynthProcNode::setup(act::room::RoomManagers rmgr)
 {
-	
+	ci::audio::Context* ctx = ci::audio::master();
+
+	m_osc		= ctx->makeNode(new audio::GenTriangleNode);
+	m_modFM		= ctx->makeNode(new audio::GenSineNode);
+	m_modAM		= ctx->makeNode(new audio::GenSineNode);
+	m_add		= ctx->makeNode(new audio::AddNode);
+	m_mul		= ctx->makeNode(new audio::MultiplyNode);
+	m_gain		= ctx->makeNode(new audio::GainNode);
+	m_gainFM	= ctx->makeNode(new audio::GainNode);
+	m_lowP		= ctx->makeNode(new audio::FilterLowPassNode);
+	auto monitorFormat = audio::MonitorSpectralNode::Format().fftSize(2048).windowSize(1024);
+	m_monitor	= ctx->makeNode(new audio::MonitorNode(monitorFormat));
+
+	//m_sine >> m_gain;
+
+	m_osc->setFreq(220);
+	m_modFM->setFreq(220);
+	m_modAM->setFreq(20);
+	m_add->setValue(200);
+	m_mul->setValue(50);
+	m_gain->setValue(1.0f);
+	m_gainFM->setValue(200);
+
+	m_modFM >> m_gainFM;
+	m_osc->getParamFreq()->setProcessor(m_gainFM);
+
+	m_mul->getParam()->setProcessor(m_modAM);
+
+	m_osc >> m_mul >> m_lowP >> m_gain >> m_monitor;
+
+	m_osc->enable();
+	m_modFM->enable();
+	m_modAM->enable();
+	m_gain->enable();
+
+
+	m_audioOutPort->send(m_gain);
 }
 
 ci::Json act::proc::AFSynthProcNode::toParams() {
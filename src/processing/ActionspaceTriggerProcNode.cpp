@@ -0,0 +1,185 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "procpch.hpp"
+#include "ActionspaceTriggerProcNode.hpp"
+
+act::proc::ActionspaceTriggerProcNode::ActionspaceTriggerProcNode() : ProcNodeBase("ActionspaceTrigger") {
+	m_drawSize = ivec2(200, 175);
+
+	auto positionsIn	= createVec3ListInput("positions", [&](std::vector<vec3> positions) { test(positions); });
+	auto positionIn		= createVec3Input("position", [&](vec3 position) { test({ position }); });
+	auto radiusIn		= createNumberInput("radius", [&](float radius) { m_actorRadius = std::max(0.0f, radius); });
+	auto pointcloudIn	= InputPort<room::Pointcloud>::create(PT_POINTCLOUD, "pointcloud", [&](room::Pointcloud pointcloud) { testPointcloud(pointcloud); });
+	m_inputPorts.push_back(pointcloudIn);
+
+	m_insidePort		= createBoolOutput("inside");
+	m_countPort			= createNumberOutput("count");
+	m_enteredPort		= createNumberListOutput("entered");
+	m_exitedPort		= createNumberListOutput("exited");
+	m_nodeEnteredPort	= createTextOutput("node entered");
+	m_nodeExitedPort	= createTextOutput("node exited");
+	m_pointsPort		= createNumberOutput("points inside");
+	m_occupiedPort		= createBoolOutput("occupied");
+
+	m_params.add("radius", m_actorRadius, 0.0f, 10.0f);
+	m_params.add("minPoints", m_minPoints, 1, 100000);
+}
+
+act::proc::ActionspaceTriggerProcNode::~ActionspaceTriggerProcNode() {
+}
+
+void act::proc::ActionspaceTriggerProcNode::setup(act::room::RoomManagers dMgrs)
+{
+	m_actionspaceMgr = dMgrs.actionspaceMgr;
+	auto node = std::dynamic_pointer_cast<room::ActionspaceRoomNode>(m_actionspaceMgr->addActionspace("trigger", vec3(0.0f, 1.0f, 0.0f)));
+	if (node)
+		m_actionspaceRoomNode = node;
+}
+
+void act::proc::ActionspaceTriggerProcNode::update() {
+	if (!m_actionspaceRoomNode)
+		return;
+
+	m_actionspaceRoomNode->setIsHighlighted(m_isHovered);
+	m_actionspaceRoomNode->setIsShowingDetails(m_isSelected);
+
+	// filled by the Stage's broad phase
+	for (auto&& node : m_actionspaceRoomNode->getEntered())
+		m_nodeEnteredPort->send(node->getName());
+	for (auto&& node : m_actionspaceRoomNode->getExited())
+		m_nodeExitedPort->send(node->getName());
+}
+
+void act::proc::ActionspaceTriggerProcNode::draw() {
+	beginNodeDraw();
+
+	if (!m_actionspaceRoomNode) {
+		endNodeDraw();
+		return;
+	}
+
+	int type = m_actionspaceRoomNode->getType();
+	ImGui::SetNextItemWidth(m_drawSize.x * 0.5f);
+	if (ImGui::Combo("type", &type, "sphere\0cylinder\0cuboid\0cone\0free\0capsule\0")) {
+		m_actionspaceRoomNode->setType((room::ASType)type);
+	}
+
+	vec3 size = m_actionspaceRoomNode->getSize();
+	ImGui::SetNextItemWidth(m_drawSize.x);
+	if (ImGui::DragFloat3("size", &size, 0.01f, 0.01f, 100.0f)) {
+		preventDrag(true);
+		m_actionspaceRoomNode->setSize(size);
+	}
+	else {
+		preventDrag(false);
+	}
+
+	drawParams(m_drawSize.x * 0.5f);
+	ImGui::Text("%d inside, %d points", m_count, m_points);
+
+	endNodeDraw();
+}
+
+ci::Json act::proc::ActionspaceTriggerProcNode::toParams() {
+	ci::Json json = ProcNodeBase::toParams();
+	if (m_actionspaceRoomNode)
+		json["actionspaceNodeUID"] = m_actionspaceRoomNode->getUID();
+
+	return json;
+}
+
+void act::proc::ActionspaceTriggerProcNode::fromParams(ci::Json json) {
+	ProcNodeBase::fromParams(json);
+
+	act::UID uid = "";
+	util::setValueFromJson(json, "actionspaceNodeUID", uid);
+	if (uid.empty() || !m_actionspaceMgr)
+		return;
+
+	if (m_actionspaceRoomNode)
+		m_actionspaceMgr->removeNode(m_actionspaceRoomNode->getUID());
+	m_actionspaceRoomNode = std::dynamic_pointer_cast<room::ActionspaceRoomNode>(m_actionspaceMgr->getNodeByUID(uid));
+	if (!m_actionspaceRoomNode)
+		m_actionspaceRoomNode = std::dynamic_pointer_cast<room::ActionspaceRoomNode>(m_actionspaceMgr->addActionspace("trigger", vec3(0.0f, 1.0f, 0.0f)));
+}
+
+void act::proc::ActionspaceTriggerProcNode::test(const std::vector<vec3>& positions)
+{
+	if (!m_actionspaceRoomNode)
+		return;
+
+	auto bounding = m_actionspaceRoomNode->getBounding();
+	size_t count = positions.size();
+
+	m_result.resize(count);
+	if (m_actorRadius > 0.0f) {
+		m_radii.assign(count, m_actorRadius);
+		bounding->intersectsSpheres(positions.data(), m_radii.data(), count, m_result.data());
+	}
+	else {
+		bounding->containsPoints(positions.data(), count, m_result.data());
+	}
+
+	// indices beyond the last list start outside, the ones that are gone have left
+	m_entered.clear();
+	m_exited.clear();
+	m_inside.resize(std::max(m_inside.size(), count), 0);
+	int inside = 0;
+	for (size_t i = 0; i < m_inside.size(); i++) {
+		uint8_t now = i < count ? m_result[i] : 0;
+		if (now && !m_inside[i])
+			m_entered.push_back((number)i);
+		else if (!now && m_inside[i])
+			m_exited.push_back((number)i);
+		inside += now;
+	}
+	m_inside.assign(m_result.begin(), m_result.end());
+
+	if (!m_exited.empty())
+		m_exitedPort->send(m_exited);
+	if (!m_entered.empty())
+		m_enteredPort->send(m_entered);
+
+	if (inside != m_count) {
+		bool wasInside = m_count > 0;
+		m_count = inside;
+		m_countPort->send(m_count);
+		if (wasInside != (m_count > 0))
+			m_insidePort->send(m_count > 0);
+	}
+}
+
+void act::proc::ActionspaceTriggerProcNode::testPointcloud(const room::Pointcloud& pointcloud)
+{
+	if (!m_actionspaceRoomNode || !pointcloud)
+		return;
+
+	// only the leaves overlapping the actionspace are tested point by point
+	m_octree.build(*pointcloud);
+	int points = (int)m_octree.countInVolume(*m_actionspaceRoomNode->getBounding());
+
+	if (points != m_points) {
+		m_points = points;
+		m_pointsPort->send(m_points);
+	}
+
+	bool isOccupied = m_points >= m_minPoints;
+	if (isOccupied != m_isOccupied) {
+		m_isOccupied = isOccupied;
+		m_occupiedPort->send(m_isOccupied);
+	}
+}
@@ -61,6 +61,9 @@ act::proc::Audio3DPlayerProcNode::Audio3DPlayerProcNode() : ProcNodeBase("Audio3
 }
 
 act::proc::Audio3DPlayerProcNode::~Audio3DPlayerProcNode() {
+	if (m_soundRoomNode)
+		m_soundRoomNode->finishedLoadingFn = []() {};
+
 	if(m_isPlaying) {
 		m_soundRoomNode->stop();
 		m_soundRoomNode->disconnectExternals();
@@ -91,7 +94,7 @@ void act::proc::Audio3DPlayerProcNode::update() {
 		};
 	
 
-		if (m_soundRoomNode->getBufferPlayer()->isEof()) {
+		if (!m_soundRoomNode->isLoading() && m_soundRoomNode->getBufferPlayer()->isEof()) {
 			m_playPosition = 0.0f;
 			m_soundRoomNode->getBufferPlayer()->seek(m_playPosition * m_soundRoomNode->getBufferPlayer()->getNumFrames());
 			if (!m_isLooping) {
@@ -113,7 +116,7 @@ void act::proc::Audio3DPlayerProcNode::update() {
 }
 
 void act::proc::Audio3DPlayerProcNode::draw() {
-	beginNodeDraw();
+	beginNodeDraw(m_soundRoomNode && m_soundRoomNode->isLoading() ? NDS_LOADING : NDS_ACTIVE);
 
 	if(ImGui::Button("load")) {
 		m_isOpenDialog = true;
@@ -159,8 +162,13 @@ void act::proc::Audio3DPlayerProcNode::draw() {
 	}
 
 	if (ImGui::Checkbox("noTimestretch", &m_noTimestretch)) {
-		m_soundRoomNode = m_audioMgr->createSoundFile(m_3DPosition, m_path, 0.2f, m_soundRoomNode->getName(), m_noTimestretch);
-
+		// the sound is decoded again, if it was playing it starts once that is done
+		bool wasPlaying = m_isPlaying;
+		stop();
+		m_soundRoomNode->finishedLoadingFn = []() {};
+		loadSound(m_path);
+		if (wasPlaying)
+			play();
 	}
 
 	if (ImGui::Checkbox("looping", &m_isLooping)) {
@@ -239,7 +247,10 @@ void act::proc::Audio3DPlayerProcNode::onTrigger(bool event) {
 bool act::proc::Audio3DPlayerProcNode::play()
 {
 	bool wasPlaying = m_isPlaying;
-	m_soundRoomNode->play();
+	if (m_soundRoomNode->isLoading())
+		m_isPlayPending = true;
+	else
+		m_soundRoomNode->play();
 	m_isPlaying = true;
 	return !wasPlaying;
 }
@@ -248,6 +259,7 @@ bool act::proc::Audio3DPlayerProcNode::stop()
 {
 	bool wasPlaying = m_isPlaying;
 	m_isPlaying = false;
+	m_isPlayPending = false;
 	m_soundRoomNode->stop();
 	//m_playPosition = 0.0f;
 	return !wasPlaying;
@@ -268,8 +280,24 @@ void act::proc::Audio3DPlayerProcNode::loadSound(std::filesystem::path path) {
 			m_soundRoomNode->setFadeIn(m_fadeInPosition);
 			m_soundRoomNode->setFadeOut(m_fadeOutPosition);
 			set3DPosition(m_3DPosition);
-			
 
+			// the file is decoded in the background, the waveform follows when it is done
+			m_soundRoomNode->finishedLoadingFn = [&]() { onSoundLoaded(); };
+		} catch(...) {
+			// it's not a sound
+		}
+		m_soundRoomNode->stop();
+	}
+}
+
+void act::proc::Audio3DPlayerProcNode::onSoundLoaded() {
+	if (m_soundRoomNode && m_isPlayPending) {
+		m_isPlayPending = false;
+		m_soundRoomNode->play();
+	}
+
+	if (m_soundRoomNode && m_soundRoomNode->getBufferPlayer()->getBuffer()) {
+		try {
 			auto waveform = WaveformPlot();
 			auto buf = m_soundRoomNode->getBufferPlayer()->getBuffer();
 			waveform.load(buf, Rectf(vec2(0, 0), m_drawSize));
@@ -295,7 +323,6 @@ void act::proc::Audio3DPlayerProcNode::loadSound(std::filesystem::path path) {
 		} catch(...) {
 			// it's not a sound
 		}
-		m_soundRoomNode->stop();
 	}
 }
 
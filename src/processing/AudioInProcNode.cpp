@@ -37,19 +37,6 @@ act::proc::AudioInProcNode::AudioInProcNode() : ProcNodeBase("AudioIn") {
 	m_isPlaying = false;
 	
 	m_drawSize	= ivec2(500, 150);
-	
-	auto ctx = audio::Context::master();
-
-	m_bufferPlayer = ctx->makeNode(new audio::BufferPlayerNode());
-	//m_bufferPlayer >> ctx->getOutput();
-
-	auto monitorFormat = audio::MonitorSpectralNode::Format().fftSize(4096).windowSize(2048);
-	m_spectralNode = ctx->makeNode(new audio::MonitorSpectralNode(monitorFormat));
-
-	m_volumeNode = ctx->makeNode(new audio::MonitorNode(monitorFormat));
-
-	m_bufferPlayer >> m_spectralNode;
-	m_bufferPlayer >> m_volumeNode;
 
 	m_audioNodePort = createAudioNodeOutput("audioNode");
 
@@ -67,7 +54,18 @@ act::proc::AudioInProcNode::~AudioInProcNode() {
 }
 
 void act::proc::AudioInProcNode::setup(act::room::RoomManagers roomMgrs) {
-	
+	auto ctx = audio::Context::master();
+
+	m_bufferPlayer = ctx->makeNode(new audio::BufferPlayerNode());
+	//m_bufferPlayer >> ctx->getOutput();
+
+	auto monitorFormat = audio::MonitorSpectralNode::Format().fftSize(4096).windowSize(2048);
+	m_spectralNode = ctx->makeNode(new audio::MonitorSpectralNode(monitorFormat));
+
+	m_volumeNode = ctx->makeNode(new audio::MonitorNode(monitorFormat));
+
+	m_bufferPlayer >> m_spectralNode;
+	m_bufferPlayer >> m_volumeNode;
 }
 
 void act::proc::AudioInProcNode::init() {
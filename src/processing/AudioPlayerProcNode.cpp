@@ -54,13 +54,6 @@ act::proc::AudioPlayerProcNode::AudioPlayerProcNode() : ProcNodeBase("AudioPlaye
 	// This output port is used to let the Frontend Observe, if the Player plays
 	m_isPlayingOut = createBoolOutput("isPlayingOut");
 	//-----------------------------------------------------------------------------
-	auto ctx = audio::Context::master();
-	//ctx->disable();
-
-	m_bufferPlayer	= ctx->makeNode(new audio::BufferPlayerNode());
-	m_gain			= ctx->makeNode(new audio::GainNode(audio::decibelToLinear(m_volume.value())));
-	m_bufferPlayer >> m_gain >> ctx->getOutput();
-
 }
 
 act::proc::AudioPlayerProcNode::~AudioPlayerProcNode() {
@@ -74,6 +67,13 @@ act::proc::AudioPlayerProcNode::~AudioPlayerProcNode() {
 
 void act::proc::AudioPlayerProcNode::setup(act::room::RoomManagers roomMgrs) {
 	m_audioMgr = roomMgrs.audioMgr;
+
+	auto ctx = audio::Context::master();
+	//ctx->disable();
+
+	m_bufferPlayer	= ctx->makeNode(new audio::BufferPlayerNode());
+	m_gain			= ctx->makeNode(new audio::GainNode(audio::decibelToLinear(m_volume.value())));
+	m_bufferPlayer >> m_gain >> ctx->getOutput();
 }
 
 void act::proc::AudioPlayerProcNode::init() {
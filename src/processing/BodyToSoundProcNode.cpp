@@ -33,48 +33,8 @@ act::proc::BodyToSoundProcNode::BodyToSoundProcNode() : ProcNodeBase("BodyToSoun
 	m_localMovement = 0.0f;
 	m_globalMovement = 0.0f;
 	
-	m_oldBody = nullptr;
+	m_hasOldJoints = false;
 	m_scaleValue = 1.0f;
-
-
-
-	ci::audio::Context* ctx = ci::audio::master();
-
-	m_osc		= ctx->makeNode(new audio::GenTriangleNode);
-	m_modFM		= ctx->makeNode(new audio::GenSineNode);
-	m_modAM		= ctx->makeNode(new audio::GenSineNode);
-	m_add		= ctx->makeNode(new audio::AddNode);
-	m_mul		= ctx->makeNode(new audio::MultiplyNode);
-	m_gain		= ctx->makeNode(new audio::GainNode);
-	m_gainFM	= ctx->makeNode(new audio::GainNode);
-	m_lowP		= ctx->makeNode(new audio::FilterLowPassNode);
-
-	//m_sine >> m_gain;
-
-	m_osc->setFreq(220);
-	m_modFM->setFreq(220);
-	m_modAM->setFreq(20);
-	m_add->setValue(200);
-	m_mul->setValue(50);
-	m_gain->setValue(1.0f);
-	m_gainFM->setValue(200);
-
-
-
-	m_modFM >> m_gainFM;
-	m_osc->getParamFreq()->setProcessor(m_gainFM);
-
-	m_mul->getParam()->setProcessor(m_modAM);
-
-	m_osc >> m_mul >> m_lowP >> m_gain;
-
-	m_osc->enable();
-	m_modFM->enable();
-	m_modAM->enable();
-	m_gain->enable();
-
-
-	m_audioOutPort->send(m_gain);
 }
 
 act::proc::BodyToSoundProcNode::~BodyToSoundProcNode() {
@@ -82,26 +42,36 @@ act::proc::BodyToSoundProcNode::~BodyToSoundProcNode() {
 
 void act::proc::BodyToSoundProcNode::onBody(room::BodyRef body)
 {
-	if (m_oldBody == nullptr) {
-		m_oldBody = body;
+	// the joints are taken over once, everything below works on the flat array
+	for (int i = 0; i < room::BJT_COUNT; i++) {
+		m_joints[i] = body->joints[i]->position;
+	}
+
+	if (!m_hasOldJoints) {
+		m_oldJoints		= m_joints;
+		m_hasOldJoints	= true;
 		return;
 	}
 
-	m_localMovement			= calcLocalMovement(body) * m_scaleValue;
-	m_globalMovement		= calcGlobalMovement(body) * m_scaleValue;
-	m_handDistance			= calcHandDistance(body) * m_scaleValue;
-	m_leftHandVelocity		= calcVelocity(m_oldBody->joints[room::BJT_HAND_LEFT]->position, body->joints[room::BJT_HAND_LEFT]->position);
-	m_rightHandVelocity		= calcVelocity(m_oldBody->joints[room::BJT_HAND_RIGHT]->position, body->joints[room::BJT_HAND_RIGHT]->position);
-	m_leftHandDistance		= ci::distance(body->joints[room::BJT_HAND_LEFT]->position, body->joints[room::BJT_SPINE_CHEST]->position);
-	m_leftHandDistanceY		= ci::distance(body->joints[room::BJT_HAND_LEFT]->position.y, body->joints[room::BJT_SPINE_CHEST]->position.y);
-	m_leftHandDistanceXZ	= ci::distance2(vec2(body->joints[room::BJT_HAND_LEFT]->position.x, body->joints[room::BJT_HAND_LEFT]->position.z), vec2(body->joints[room::BJT_SPINE_CHEST]->position.x, body->joints[room::BJT_SPINE_CHEST]->position.z));
-	m_rightHandDistance		= ci::distance(body->joints[room::BJT_HAND_RIGHT]->position, body->joints[room::BJT_SPINE_CHEST]->position);
-	m_rightHandDistanceY	= ci::distance(body->joints[room::BJT_HAND_RIGHT]->position.y, body->joints[room::BJT_SPINE_CHEST]->position.y);
-	m_rightHandDistanceXZ	= ci::distance2(vec2(body->joints[room::BJT_HAND_RIGHT]->position.x, body->joints[room::BJT_HAND_RIGHT]->position.z), vec2(body->joints[room::BJT_SPINE_CHEST]->position.x, body->joints[room::BJT_SPINE_CHEST]->position.z));
-	m_handDistanceY			= ci::distance(body->joints[room::BJT_HAND_LEFT]->position.y, body->joints[room::BJT_HAND_RIGHT]->position.y);
-	m_handDistanceXZ		= ci::distance(vec2(body->joints[room::BJT_HAND_LEFT]->position.x, body->joints[room::BJT_HAND_LEFT]->position.z), vec2(body->joints[room::BJT_HAND_RIGHT]->position.x, body->joints[room::BJT_HAND_RIGHT]->position.z));
+	const vec3& chest		= m_joints[room::BJT_SPINE_CHEST];
+	const vec3& leftHand	= m_joints[room::BJT_HAND_LEFT];
+	const vec3& rightHand	= m_joints[room::BJT_HAND_RIGHT];
+
+	m_localMovement			= calcLocalMovement(m_joints) * m_scaleValue;
+	m_globalMovement		= calcGlobalMovement(m_joints) * m_scaleValue;
+	m_handDistance			= calcHandDistance(m_joints) * m_scaleValue;
+	m_leftHandVelocity		= calcVelocity(m_oldJoints[room::BJT_HAND_LEFT], leftHand);
+	m_rightHandVelocity		= calcVelocity(m_oldJoints[room::BJT_HAND_RIGHT], rightHand);
+	m_leftHandDistance		= ci::distance(leftHand, chest);
+	m_leftHandDistanceY		= ci::distance(leftHand.y, chest.y);
+	m_leftHandDistanceXZ	= ci::distance2(vec2(leftHand.x, leftHand.z), vec2(chest.x, chest.z));
+	m_rightHandDistance		= ci::distance(rightHand, chest);
+	m_rightHandDistanceY	= ci::distance(rightHand.y, chest.y);
+	m_rightHandDistanceXZ	= ci::distance2(vec2(rightHand.x, rightHand.z), vec2(chest.x, chest.z));
+	m_handDistanceY			= ci::distance(leftHand.y, rightHand.y);
+	m_handDistanceXZ		= ci::distance(vec2(leftHand.x, leftHand.z), vec2(rightHand.x, rightHand.z));
 	
-	m_pelvisKneeDistanceY   = ci::distance(body->joints[room::BJT_PELVIS]->position.y, body->joints[room::BJT_KNEE_RIGHT]->position.y);
+	m_pelvisKneeDistanceY   = ci::distance(m_joints[room::BJT_PELVIS].y, m_joints[room::BJT_KNEE_RIGHT].y);
 
 	m_localMovementPort->send(m_localMovement);
 	m_globalMovementPort->send(m_globalMovement);
@@ -116,70 +86,45 @@ void act::proc::BodyToSoundProcNode::onBody(room::BodyRef body)
 
 	m_Q = 8;
 
-	m_oldBody = body;
+	m_oldJoints = m_joints;
 }
 
 
-float act::proc::BodyToSoundProcNode::calcLocalMovement(room::BodyRef body) {
-	if (m_oldBody == nullptr) {
+float act::proc::BodyToSoundProcNode::calcLocalMovement(const Joints& joints) {
+	if (!m_hasOldJoints) {
 		return 0;
 	}
 
-	int numJoints = body->joints.size();
-
 	float totalDist = 0.0f;
-	float distX, distY, distZ;
-
-	for (int i = 0; i < numJoints; i++){
-
-
-		vec3 currJointPos = body->joints[i]->position;
-		vec3 oldJointPos = m_oldBody->joints[i]->position;
-
-		distX = abs(currJointPos.x - oldJointPos.x);
-		distY = abs(currJointPos.y - oldJointPos.y);
-		distZ = abs(currJointPos.z - oldJointPos.z);
-
-		totalDist += distX + distY + distZ;
+	for (int i = 0; i < room::BJT_COUNT; i++) {
+		vec3 dist = glm::abs(joints[i] - m_oldJoints[i]);
+		totalDist += dist.x + dist.y + dist.z;
 	}
 
 	if (totalDist == 0) {
 		return m_localMovement/m_scaleValue;
 	}
 
-	return totalDist/(float)numJoints;
+	return totalDist/(float)room::BJT_COUNT;
 }
 
-float act::proc::BodyToSoundProcNode::calcGlobalMovement(room::BodyRef body) {
-	if (m_oldBody == nullptr){
+float act::proc::BodyToSoundProcNode::calcGlobalMovement(const Joints& joints) {
+	if (!m_hasOldJoints){
 		return 0;
 	}
 
-	float totalDist = 0.0f;
-	float distX, distY, distZ;
-
-	vec3 currJointPos = body->joints[room::BJT_SPINE_CHEST]->position;
-	vec3 oldJointPos = m_oldBody->joints[room::BJT_SPINE_CHEST]->position;
-
-	distX = abs(currJointPos.x - oldJointPos.x);
-	distY = abs(currJointPos.y - oldJointPos.y);
-	distZ = abs(currJointPos.z - oldJointPos.z);
-
+	vec3 dist = glm::abs(joints[room::BJT_SPINE_CHEST] - m_oldJoints[room::BJT_SPINE_CHEST]);
 
-	if (distX + distY + distZ == 0) {
+	if (dist.x + dist.y + dist.z == 0) {
 		return m_globalMovement / m_scaleValue;
 	}
 
-
-	return distX + distY + distZ;
+	return dist.x + dist.y + dist.z;
 }
 
-float act::proc::BodyToSoundProcNode::calcHandDistance(room::BodyRef body)
+float act::proc::BodyToSoundProcNode::calcHandDistance(const Joints& joints)
 {
-	auto left = body->joints[room::BJT_HAND_LEFT]->position;
-	auto right = body->joints[room::BJT_HAND_RIGHT]->position;
-
-	return ci::distance2(left, right);
+	return ci::distance2(joints[room::BJT_HAND_LEFT], joints[room::BJT_HAND_RIGHT]);
 }
 
 float act::proc::BodyToSoundProcNode::calcVelocity(vec3 last, vec3 current)
@@ -233,7 +178,43 @@ void act::proc::BodyToSoundProcNode::draw() {
 
 void act::proc::BodyToSoundProcNode::setup(act::room::RoomManagers rmgr)
 {
-	
+	ci::audio::Context* ctx = ci::audio::master();
+
+	m_osc		= ctx->makeNode(new audio::GenTriangleNode);
+	m_modFM		= ctx->makeNode(new audio::GenSineNode);
+	m_modAM		= ctx->makeNode(new audio::GenSineNode);
+	m_add		= ctx->makeNode(new audio::AddNode);
+	m_mul		= ctx->makeNode(new audio::MultiplyNode);
+	m_gain		= ctx->makeNode(new audio::GainNode);
+	m_gainFM	= ctx->makeNode(new audio::GainNode);
+	m_lowP		= ctx->makeNode(new audio::FilterLowPassNode);
+
+	//m_sine >> m_gain;
+
+	m_osc->setFreq(220);
+	m_modFM->setFreq(220);
+	m_modAM->setFreq(20);
+	m_add->setValue(200);
+	m_mul->setValue(50);
+	m_gain->setValue(1.0f);
+	m_gainFM->setValue(200);
+
+
+
+	m_modFM >> m_gainFM;
+	m_osc->getParamFreq()->setProcessor(m_gainFM);
+
+	m_mul->getParam()->setProcessor(m_modAM);
+
+	m_osc >> m_mul >> m_lowP >> m_gain;
+
+	m_osc->enable();
+	m_modFM->enable();
+	m_modAM->enable();
+	m_gain->enable();
+
+
+	m_audioOutPort->send(m_gain);
 }
 
 ci::Json act::proc::BodyToSoundProcNode::toParams() {
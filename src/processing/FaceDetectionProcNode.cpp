@@ -32,11 +32,17 @@ act::proc::FaceDetectionProcNode::FaceDetectionProcNode() : ProcNodeBase("FaceDe
 	m_faceAvailHistoryMaxSize = 10;
 	m_faceAvailHistoryThreshold = 6;
 	
-	mFaceCascade.load(getAssetPath("3rd/haarcascade_cuda/haarcascade_frontalface_alt.xml").string());
 	mFaceHistorySize = 20;
 
+	m_detectionInterval		= 10;
+	m_framesSinceDetection	= 0;
+	m_hasLostTrack			= true;
+	m_trackThreshold		= 0.6f;
+	m_isUsingDNN			= false;
+
 	m_faceImagePort = createImageOutput("biggest face image");
 	m_faceAvailablePort = createBoolOutput("face is available");
+	m_faceRectsPort = createNumberListOutput("face rects"); // x, y, width, height per face in image pixels
 
 	auto image = createImageInput("image", [&](cv::UMat mat) { this->onMat(mat); });
 }
@@ -44,11 +50,24 @@ act::proc::FaceDetectionProcNode::FaceDetectionProcNode() : ProcNodeBase("FaceDe
 act::proc::FaceDetectionProcNode::~FaceDetectionProcNode() {
 }
 
+void act::proc::FaceDetectionProcNode::setup(act::room::RoomManagers) {
+	// the cascade is only loaded for a node in use, not for describing the type, and in the background
+	if (m_faceCascade.isValid())
+		return;
+
+	m_faceCascade = util::AssetManager::get().load<cv::CascadeClassifier>(getAssetPath("3rd/haarcascade_cuda/haarcascade_frontalface_alt.xml"), [](const fs::path& path) {
+		auto cascade = std::make_shared<cv::CascadeClassifier>();
+		if (!cascade->load(path.string()))
+			return std::shared_ptr<cv::CascadeClassifier>();
+		return cascade;
+	});
+}
+
 void act::proc::FaceDetectionProcNode::update() {
 }
 
 void act::proc::FaceDetectionProcNode::draw() {
-	beginNodeDraw();
+	beginNodeDraw(m_faceCascade.isLoading() || m_dnnDetector.isLoading() ? NDS_LOADING : (m_faceCascade.hasFailed() ? NDS_ERROR : NDS_ACTIVE));
 
 	ImGui::Checkbox("show", &m_show);
 
@@ -73,6 +92,16 @@ void act::proc::FaceDetectionProcNode::draw() {
 	ImGui::SetNextItemWidth(600);
 	ImGui::InputInt("min height for availbility", &m_faceAvailHeightThreshold);
 
+	ImGui::SetNextItemWidth(600);
+	if (ImGui::InputInt("detect every n frames", &m_detectionInterval)) {
+		m_detectionInterval = std::clamp(m_detectionInterval, 1, 300);
+	}
+	ImGui::SetNextItemWidth(600);
+	preventDrag(ImGui::SliderFloat("track threshold", &m_trackThreshold, 0.1f, 1.0f));
+	if (ImGui::Checkbox("use DNN detector", &m_isUsingDNN) && m_isUsingDNN) {
+		loadDNN();
+	}
+
 	if (m_isFixingFaceSize) {
 		//ImGui::SameLine();
 		ImGui::SetNextItemWidth(600);
@@ -89,12 +118,29 @@ void act::proc::FaceDetectionProcNode::onMat(cv::UMat event) {
 	mFaces.clear();
 
 	
-	cv::UMat mat;
+	cv::UMat mat, gray;
 	cv::resize(event, mat, cv::Size(event.cols * m_resizeScale, event.rows * m_resizeScale));
+	cv::cvtColor(mat, gray, cv::COLOR_RGB2GRAY);
 	float calcScale = 1.0f / m_resizeScale;
-	// detect the faces and iterate them, appending them to m_faces
+
+	// the full detection is only done every n frames or when a track got lost,
+	// otherwise the known faces are tracked
+	m_framesSinceDetection++;
+	if (m_hasLostTrack || m_framesSinceDetection >= m_detectionInterval) {
+		resetTracks(detectFaces(mat, gray), gray);
+		m_framesSinceDetection	= 0;
+		m_hasLostTrack			= false;
+	}
+	else {
+		trackFaces(gray);
+	}
+
+	// iterate the faces, appending them to m_faces
 	std::vector<cv::Rect> faces;
-	mFaceCascade.detectMultiScale(mat, faces);
+	for (auto&& track : m_tracks)
+		faces.push_back(track.rect);
+
+	numberList faceRects;
 	float faceArea = 0.0f;
 	float faceHeight = 0.0f;
 	cv::Rect biggestFace;
@@ -114,6 +160,7 @@ void act::proc::FaceDetectionProcNode::onMat(cv::UMat event) {
 			biggestFace = toOcv(Area(faceRect));
 		}
 		mFaces.push_back(faceRect);
+		faceRects.insert(faceRects.end(), { faceRect.x1, faceRect.y1, faceRect.getWidth(), faceRect.getHeight() });
 		cv::rectangle(mat, faceIter->tl(), faceIter->br(), cv::Scalar(util::Design::primaryColor().b*255, util::Design::primaryColor().g * 255, util::Design::primaryColor().r * 255), 5);
 	}
 
@@ -132,17 +179,24 @@ void act::proc::FaceDetectionProcNode::onMat(cv::UMat event) {
 	}
 
 
+	// the rects go first, a receiver pairs them with the face image of this frame that follows
+	cv::Size faceSize = biggestFace.size();
+	if (faceArea > 0.0f && m_isFixingFaceSize)
+		faceSize = cv::Size(m_fixedFaceSize * 0.94f, m_fixedFaceSize);
+	m_faceRectsPort->send(faceRects, std::make_shared<FaceRectsContext>(event, faceArea > 0.0f ? biggestFace : cv::Rect(), faceSize));
+
 	if (faceArea > 0.0f) {
 		if (m_isFixingFaceSize) {
 			auto face = event(biggestFace);
 			cv::UMat mat;
-			cv::resize(face, mat, cv::Size(m_fixedFaceSize*0.94f, m_fixedFaceSize));
+			cv::resize(face, mat, faceSize);
 			m_faceImagePort->send(mat);
 		}
 		else {
 			m_faceImagePort->send(event(biggestFace));
 		}
 	}
+
 	faces.resize(0);
 	faces.clear();
 	mFacesHistory.push_back(mFaces);
@@ -158,10 +212,120 @@ ci::Json act::proc::FaceDetectionProcNode::toParams() {
 	ci::Json json = ci::Json::object();
 	json["resizeScale"]					= m_resizeScale;
 	json["faceAvailHeightThreshold"]	= m_faceAvailHeightThreshold;
+	json["detectionInterval"]			= m_detectionInterval;
+	json["trackThreshold"]				= m_trackThreshold;
+	json["isUsingDNN"]					= m_isUsingDNN;
 	return json;
 }
 
 void act::proc::FaceDetectionProcNode::fromParams(ci::Json json) {
 	util::setValueFromJson(json, "resizeScale", m_resizeScale);
 	util::setValueFromJson(json, "faceAvailHeightThreshold", m_faceAvailHeightThreshold);
+	util::setValueFromJson(json, "detectionInterval", m_detectionInterval);
+	util::setValueFromJson(json, "trackThreshold", m_trackThreshold);
+	util::setValueFromJson(json, "isUsingDNN", m_isUsingDNN);
+	if (m_isUsingDNN)
+		loadDNN();
+}
+
+std::vector<cv::Rect> act::proc::FaceDetectionProcNode::detectFaces(cv::UMat mat, cv::UMat gray) {
+	std::vector<cv::Rect> faces;
+
+	auto dnnDetector = m_dnnDetector.get();
+	if (m_isUsingDNN && dnnDetector) {
+		// frames are BGR already, as YuNet expects them
+		dnnDetector->setInputSize(mat.size());
+
+		cv::Mat detections; // one row per face: x, y, w, h, landmarks, score
+		dnnDetector->detect(mat, detections);
+		for (int i = 0; i < detections.rows; i++) {
+			faces.push_back(cv::Rect(detections.at<float>(i, 0), detections.at<float>(i, 1), detections.at<float>(i, 2), detections.at<float>(i, 3)));
+		}
+	}
+	else if (auto cascade = m_faceCascade.get()) { // nothing is detected while loading
+		cascade->detectMultiScale(gray, faces);
+	}
+
+	cv::Rect bounds(0, 0, gray.cols, gray.rows);
+	for (auto&& face : faces)
+		face &= bounds;
+	faces.erase(std::remove_if(faces.begin(), faces.end(), [](const cv::Rect& face) { return face.area() <= 0; }), faces.end());
+
+	return faces;
+}
+
+void act::proc::FaceDetectionProcNode::resetTracks(const std::vector<cv::Rect>& faces, cv::UMat gray) {
+	std::vector<FaceTrack> tracks;
+
+	for (auto&& face : faces) {
+		FaceTrack track;
+		track.rect		= cv::Rect2f(face);
+		track.velocity	= cv::Point2f(0.0f, 0.0f);
+
+		// keep the motion of the track this face belongs to
+		float bestOverlap = 0.3f;
+		for (auto&& previous : m_tracks) {
+			float intersection	= (previous.rect & track.rect).area();
+			float overlap		= intersection / (previous.rect.area() + track.rect.area() - intersection);
+			if (overlap > bestOverlap) {
+				bestOverlap		= overlap;
+				track.velocity	= previous.velocity;
+			}
+		}
+
+		gray(face).copyTo(track.templ);
+		tracks.push_back(track);
+	}
+
+	m_tracks = tracks;
+}
+
+void act::proc::FaceDetectionProcNode::trackFaces(cv::UMat gray) {
+	cv::Rect bounds(0, 0, gray.cols, gray.rows);
+	cv::UMat result;
+
+	std::vector<FaceTrack> tracks; // lost ones are found again by the next detection
+	for (auto&& track : m_tracks) {
+		// search window around the position predicted by the last motion
+		cv::Rect2f predicted = track.rect + track.velocity;
+		cv::Rect roi = cv::Rect(predicted.x - predicted.width * 0.5f, predicted.y - predicted.height * 0.5f, predicted.width * 2.0f, predicted.height * 2.0f) & bounds;
+
+		if (roi.width < track.templ.cols || roi.height < track.templ.rows) {
+			m_hasLostTrack = true;
+			continue;
+		}
+
+		double score;
+		cv::Point location;
+		cv::matchTemplate(gray(roi), track.templ, result, cv::TM_CCOEFF_NORMED);
+		cv::minMaxLoc(result, nullptr, &score, nullptr, &location);
+
+		if (score < m_trackThreshold) {
+			m_hasLostTrack = true;
+			continue;
+		}
+
+		cv::Rect2f rect(roi.x + location.x, roi.y + location.y, track.rect.width, track.rect.height);
+		track.velocity	= 0.5f * track.velocity + 0.5f * cv::Point2f(rect.x - track.rect.x, rect.y - track.rect.y);
+		track.rect		= rect;
+		gray(cv::Rect(rect) & bounds).copyTo(track.templ);
+		tracks.push_back(track);
+	}
+
+	m_tracks = tracks;
+}
+
+void act::proc::FaceDetectionProcNode::loadDNN() {
+	if (m_dnnDetector.isValid())
+		return;
+
+	auto path = getAssetPath("3rd/face/face_detection_yunet_2022mar.onnx");
+	if (path.empty()) {
+		CI_LOG_W("DNN face detection model not found in assets/3rd/face, using the cascade");
+		m_isUsingDNN = false;
+		return;
+	}
+	m_dnnDetector = util::AssetManager::get().run<cv::FaceDetectorYN>([path]() {
+		return std::shared_ptr<cv::FaceDetectorYN>(cv::FaceDetectorYN::create(path.string(), "", cv::Size(320, 320)));
+	});
 }
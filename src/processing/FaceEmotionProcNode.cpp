@@ -24,18 +24,23 @@ act::proc::FaceEmotionProcNode::FaceEmotionProcNode() : ProcNodeBase("FaceEmotio
 	m_displayScale = 0.8f;
 	
 	auto image = createImageInput("image", [&](cv::UMat mat) { this->onMat(mat); });
+	auto faceRects = InputPort<numberList>::create(PT_NUMBERLIST, "face rects", [&](numberList rects, PortContextRef context) { this->onFaceRects(rects, context); });
+	faceRects->setConnectionCB([&]() { m_hasFaceRects = true; });
+	faceRects->setDisconnectionCB([&]() {
+		m_hasFaceRects = false;
+		m_isFaceRectsPending = false;
+		m_faceRects.clear();
+		m_faceRectsContext = nullptr;
+		if (!m_waitingImage.empty())
+			sendEmotion(m_waitingImage);
+		m_waitingImage = cv::UMat();
+	});
+	m_inputPorts.push_back(faceRects);
 
 	m_imagePort = createImageOutput("pass-through image");
 	m_emotionPort = createFeatureOutput("emotion");
+	m_emotionsPort = createFeatureListOutput("emotion per face");
 
-	//init network
-	std::string onnxFile = ci::app::getAssetPath("3rd/emotion/emotion-ferplus-8.onnx").string();
-	m_network = cv::dnn::readNetFromONNX(onnxFile);
-
-	if (m_network.empty()) {
-		CI_LOG_E("Failed to load network");
-	};
-	
 	m_emotions = { "Neutral", "Happy", "Surprise", "Sad", "Anger", "Disgust", "Fear", "Contempt" };
 	m_currentEmotion = std::make_pair("Idle",0.0f);
 }
@@ -43,11 +48,29 @@ act::proc::FaceEmotionProcNode::FaceEmotionProcNode() : ProcNodeBase("FaceEmotio
 act::proc::FaceEmotionProcNode::~FaceEmotionProcNode() {
 }
 
+void act::proc::FaceEmotionProcNode::setup(act::room::RoomManagers) {
+	// the network is only loaded for a node in use, not for describing the type, and in the background;
+	// all FaceEmotion nodes run it on the main thread, so they can share it
+	if (m_networkAsset.isValid())
+		return;
+
+	m_networkAsset = util::AssetManager::get().load<cv::dnn::Net>(ci::app::getAssetPath("3rd/emotion/emotion-ferplus-8.onnx"), [](const fs::path& path) {
+		auto network = std::make_shared<cv::dnn::Net>(cv::dnn::readNetFromONNX(path.string()));
+		if (network->empty())
+			throw std::runtime_error("Failed to load network " + path.string());
+		return network;
+	});
+}
+
 void act::proc::FaceEmotionProcNode::update() {
+	if (m_network.empty() && m_networkAsset.isReady()) {
+		if (auto network = m_networkAsset.get())
+			m_network = *network;
+	}
 }
 
 void act::proc::FaceEmotionProcNode::draw() {
-	beginNodeDraw();
+	beginNodeDraw(m_networkAsset.isLoading() ? NDS_LOADING : (m_networkAsset.hasFailed() ? NDS_ERROR : NDS_ACTIVE));
 
 	ImGui::Checkbox("show", &m_show);
 
@@ -77,10 +100,103 @@ void act::proc::FaceEmotionProcNode::onMat(cv::UMat event) {
 		m_texture = gl::Texture2d::create(fromOcv(event));
 	}
 
-	cv::Mat emotions = detectCurrentEmotions(event);
+	if (m_network.empty())
+		return;
+
+	if (!m_hasFaceRects) {
+		sendEmotion(event);
+		return;
+	}
+
+	if (m_isFaceRectsPending && sendEmotionsPerFace(event))
+		return;
+
+	// the rects of this frame may still come, e.g. if the frame is connected here and to the FaceDetection,
+	// an image that did not get its rects is taken as a single face
+	if (!m_waitingImage.empty())
+		sendEmotion(m_waitingImage);
+	m_waitingImage = event;
+}
+
+void act::proc::FaceEmotionProcNode::sendEmotion(cv::UMat image) {
+	cv::Mat emotions = detectCurrentEmotions(image);
 	m_currentEmotion = getCurrentEmotion(softmax(&emotions));
 
 	m_emotionPort->send(m_currentEmotion);
+	m_emotionsPort->send({ m_currentEmotion });
+}
+
+bool act::proc::FaceEmotionProcNode::sendEmotionsPerFace(cv::UMat image) {
+	std::vector<cv::Rect> faces;
+	if (!mapFaceRects(image, faces))
+		return false;
+	m_isFaceRectsPending = false; // the rects are only used for the image of their frame
+
+	// all tracked faces at once
+	std::vector<size_t> faceOfRow;
+	cv::Mat emotions = detectCurrentEmotions(image, faces, faceOfRow);
+
+	// in the order of the face rects, faces outside the image keep an empty feature
+	featureList perFace(faces.size(), feature("", 0.0f));
+	for (int i = 0; i < emotions.rows; i++)
+		perFace[faceOfRow[i]] = getCurrentEmotion(softmax(&emotions, i));
+
+	if (emotions.rows > 0) {
+		m_currentEmotion = perFace[faceOfRow.front()];
+		m_emotionPort->send(m_currentEmotion);
+	}
+	m_emotionsPort->send(perFace);
+	return true;
+}
+
+void act::proc::FaceEmotionProcNode::onFaceRects(numberList rects, PortContextRef context) {
+	m_hasFaceRects = true;
+	m_isFaceRectsPending = true;
+	m_faceRectsContext = std::dynamic_pointer_cast<FaceRectsContext>(context);
+	m_faceRects.clear();
+	for (size_t i = 0; i + 3 < rects.size(); i += 4) {
+		m_faceRects.push_back(cv::Rect(rects[i], rects[i + 1], rects[i + 2], rects[i + 3]));
+	}
+
+	if (m_waitingImage.empty() || m_network.empty())
+		return;
+
+	cv::UMat image = m_waitingImage;
+	m_waitingImage = cv::UMat();
+	if (!sendEmotionsPerFace(image))
+		sendEmotion(image);
+}
+
+bool act::proc::FaceEmotionProcNode::mapFaceRects(cv::UMat image, std::vector<cv::Rect>& faces) {
+	cv::Size imageSize = image.size();
+
+	// rects without a context are taken as they are, in pixels of the image
+	cv::Rect area(cv::Point(0, 0), imageSize);
+	if (m_faceRectsContext) {
+		const cv::UMat& frame = m_faceRectsContext->frame;
+		const cv::Rect& faceRect = m_faceRectsContext->imageRect;
+		bool isSameBuffer = image.u != nullptr && image.u == frame.u;
+
+		if (isSameBuffer && imageSize == frame.size())
+			area = cv::Rect(cv::Point(0, 0), frame.size());	// the frame itself
+		else if (isSameBuffer && imageSize == faceRect.size())
+			area = faceRect;								// the crop of the biggest face
+		else if (!faceRect.empty() && imageSize == m_faceRectsContext->imageSize)
+			area = faceRect;								// the resized crop, sent right after the rects
+		else
+			return false;
+	}
+	if (area.empty())
+		return false;
+
+	float scaleX = imageSize.width / (float)area.width;
+	float scaleY = imageSize.height / (float)area.height;
+
+	faces.clear();
+	for (auto&& rect : m_faceRects) {
+		faces.push_back(cv::Rect(cvRound((rect.x - area.x) * scaleX), cvRound((rect.y - area.y) * scaleY), cvRound(rect.width * scaleX), cvRound(rect.height * scaleY)));
+	}
+	return true;
 }
 
 ci::ivec2 act::proc::FaceEmotionProcNode::adaptSize(ci::ivec2 size) {
@@ -106,6 +222,49 @@ cv::Mat	act::proc::FaceEmotionProcNode::detectCurrentEmotions(cv::UMat uframe) {
 	return out;
 }
 
+cv::Mat	act::proc::FaceEmotionProcNode::detectCurrentEmotions(cv::UMat uframe, const std::vector<cv::Rect>& faces, std::vector<size_t>& faceOfRow) {
+	cv::UMat gray;
+	cv::cvtColor(uframe, gray, cv::COLOR_RGB2GRAY);
+
+	cv::Rect bounds(0, 0, gray.cols, gray.rows);
+	std::vector<cv::Mat> crops;
+	faceOfRow.clear();
+	for (size_t i = 0; i < faces.size(); i++) {
+		cv::Rect roi = faces[i] & bounds;
+		if (roi.area() <= 0)
+			continue;
+
+		cv::Mat crop;
+		cv::equalizeHist(gray(roi), crop);
+		crops.push_back(crop);
+		faceOfRow.push_back(i);
+	}
+	if (crops.empty())
+		return cv::Mat();
+
+	// all faces as one batch, the network is only run once
+	if (m_isBatching) {
+		try {
+			cv::Mat blob = cv::dnn::blobFromImages(crops, 1.0f, cv::Size(64, 64));
+			m_network.setInput(blob);
+
+			cv::Mat out = m_network.forward();
+			return out.reshape(1, (int)crops.size());
+		}
+		catch (cv::Exception& e) {
+			CI_LOG_W("[FaceEmotionProcNode] network does not take batches, falling back to single faces: " << e.what());
+			m_isBatching = false;
+		}
+	}
+
+	cv::Mat out;
+	for (auto&& crop : crops) {
+		m_network.setInput(cv::dnn::blobFromImage(crop, 1.0f, cv::Size(64, 64)));
+		out.push_back(m_network.forward().reshape(1, 1));
+	}
+	return out;
+}
+
 act::proc::feature act::proc::FaceEmotionProcNode::getCurrentEmotion(std::vector<float> result) {
 	float min = 0.0f;
 	float max = 0.0f;
@@ -126,7 +285,7 @@ act::proc::feature act::proc::FaceEmotionProcNode::getCurrentEmotion(std::vector
 	return std::make_pair(m_emotions[maxI], max);
 };
 
-std::vector<float> act::proc::FaceEmotionProcNode::softmax(cv::Mat* mat) {
+std::vector<float> act::proc::FaceEmotionProcNode::softmax(cv::Mat* mat, int row) {
 
 	int i;
 	double m, sum, constant;
@@ -135,20 +294,20 @@ std::vector<float> act::proc::FaceEmotionProcNode::softmax(cv::Mat* mat) {
 
 	m = -INFINITY;
 	for (i = 0; i < mat->cols; ++i) {
-		if (m < mat->at<float>(0, i)){
+		if (m < mat->at<float>(row, i)){
 
-			m = mat->at<float>(0, i);
+			m = mat->at<float>(row, i);
 		}
 	}
 
 	sum = 0.0;
 	for (i = 0; i < mat->cols; ++i) {
-		sum += exp(mat->at<float>(0, i) - m);
+		sum += exp(mat->at<float>(row, i) - m);
 	}
 
 	constant = m + std::log(sum);
 	for (i = 0; i < mat->cols; ++i) {
-		results.push_back( exp(mat->at<float>(0, i) - constant));
+		results.push_back( exp(mat->at<float>(row, i) - constant));
 	}
 
 	return results;
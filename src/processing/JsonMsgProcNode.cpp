@@ -111,12 +111,7 @@ act::proc::JsonMsgProcNode::JsonMsgProcNode() : ProcNodeBase("JsonMsg") {
 	});
 
 	auto image = createImageInput("image", [&](cv::UMat uMat) {
-		std::string base64 = matToBase64(uMat.getMat(cv::ACCESS_FAST), ".jpg", 85, true, 1280);
-		auto json = ci::Json::object();
-		json["params"]["name"]		= m_msgName;
-		json["params"]["type"]		= "image";
-		json["params"]["base64"]	= base64;
-		m_jsonPort->send(json);
+		m_preview.submit(uMat);
 	});
 
 	auto bodies = InputPort<std::vector<room::BodyRef>>::create(PT_BODYLIST, "bodies", [&](std::vector<room::BodyRef> bodies) {
@@ -196,33 +191,33 @@ act::proc::JsonMsgProcNode::JsonMsgProcNode() : ProcNodeBase("JsonMsg") {
 
 	m_jsonPort = createJsonOutput("json");
 
+	auto applyPreviewSettings = [&]() { m_preview.setSettings(m_previewSettings); };
+	m_params.add("msgname", m_msgName);
+	m_params.add("previewWidth", m_previewSettings.maxWidth, 64, 4096, applyPreviewSettings);
+	m_params.add("previewRate", m_previewSettings.maxRate, 0.0f, 60.0f, 0.1f, applyPreviewSettings, "%.1f fps");
+	m_params.add("previewQuality", m_previewSettings.quality, 1, 100, applyPreviewSettings);
+	m_params.add("previewWebP", m_previewSettings.isWebP, applyPreviewSettings);
+	applyPreviewSettings();
 }
 
 act::proc::JsonMsgProcNode::~JsonMsgProcNode() {
 }
 
 void act::proc::JsonMsgProcNode::update() {
-
+	if (!m_preview.take(m_previewBase64))
+		return;
+
+	auto json = ci::Json::object();
+	json["params"]["name"]		= m_msgName;
+	json["params"]["type"]		= "image";
+	json["params"]["base64"]	= m_previewBase64;
+	m_jsonPort->send(json);
 }
 
 void act::proc::JsonMsgProcNode::draw() {
 	beginNodeDraw();
 
-	ImGui::SetNextItemWidth(m_drawSize.x);
-	ImGui::InputText("msg name", &m_msgName);
-	
-	std::stringstream strstr;
+	drawParams(m_drawSize.x);
 	
 	endNodeDraw();
 }
-
-
-ci::Json act::proc::JsonMsgProcNode::toParams() {
-	ci::Json json = ci::Json::object();
-	json["msgname"] = m_msgName;
-	return json;
-}
-
-void act::proc::JsonMsgProcNode::fromParams(ci::Json json) {
-	util::setValueFromJson(json, "msgname", m_msgName);
-}
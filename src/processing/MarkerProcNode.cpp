@@ -31,6 +31,9 @@ act::proc::MarkerProcNode::MarkerProcNode() : ProcNodeBase("Marker") {
 }
 
 act::proc::MarkerProcNode::~MarkerProcNode() {
+	if (!m_markerMgr) // never set up, e.g. only described by the registry
+		return;
+
 	auto&& port = m_markerMgr->getMarkerPort(m_selectedMarker);
 	if (port)
 		port->disconnect(m_markerPositionInPort);
@@ -18,96 +18,97 @@
 
 #include "MatToBase64.hpp"
 
-static const std::string base64_chars =
+#include <array>
+#include <algorithm>
+
+static const char base64_chars[] =
 "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
 "abcdefghijklmnopqrstuvwxyz"
 "0123456789+/";
 
-
-static inline bool is_base64(BYTE c) {
-    return (isalnum(c) || (c == '+') || (c == '/'));
-}
+// value of each character, 0xFF for the ones that end the encoded data (padding and everything else)
+static const std::array<BYTE, 256> base64_values = []() {
+    std::array<BYTE, 256> values;
+    values.fill(0xFF);
+    for (BYTE i = 0; i < 64; i++)
+        values[(BYTE)base64_chars[i]] = i;
+    return values;
+}();
 
 std::string base64_encode(BYTE const* buf, unsigned int bufLen) {
     std::string ret;
-    int i = 0;
-    int j = 0;
-    BYTE char_array_3[3];
-    BYTE char_array_4[4];
-
-    while (bufLen--) {
-        char_array_3[i++] = *(buf++);
-        if (i == 3) {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; (i < 4); i++)
-                ret += base64_chars[char_array_4[i]];
-            i = 0;
-        }
-    }
-
-    if (i)
-    {
-        for (j = i; j < 3; j++)
-            char_array_3[j] = '\0';
-
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3f;
-
-        for (j = 0; (j < i + 1); j++)
-            ret += base64_chars[char_array_4[j]];
+    base64_encode(buf, bufLen, ret);
+    return ret;
+}
 
-        while ((i++ < 3))
-            ret += '=';
+void base64_encode(BYTE const* buf, size_t bufLen, std::string& out) {
+    out.resize(4 * ((bufLen + 2) / 3));
+    char* dst = out.data();
+
+    size_t i = 0;
+    for (; i + 2 < bufLen; i += 3) {
+        uint32_t triple = (buf[i] << 16) | (buf[i + 1] << 8) | buf[i + 2];
+        dst[0] = base64_chars[(triple >> 18) & 0x3F];
+        dst[1] = base64_chars[(triple >> 12) & 0x3F];
+        dst[2] = base64_chars[(triple >> 6) & 0x3F];
+        dst[3] = base64_chars[triple & 0x3F];
+        dst += 4;
     }
 
-    return ret;
+    size_t rest = bufLen - i;
+    if (rest) {
+        uint32_t triple = (buf[i] << 16) | (rest == 2 ? buf[i + 1] << 8 : 0);
+        dst[0] = base64_chars[(triple >> 18) & 0x3F];
+        dst[1] = base64_chars[(triple >> 12) & 0x3F];
+        dst[2] = rest == 2 ? base64_chars[(triple >> 6) & 0x3F] : '=';
+        dst[3] = '=';
+    }
 }
 
 std::vector<BYTE> base64_decode(std::string const& encoded_string) {
-    int in_len = encoded_string.size();
-    int i = 0;
-    int j = 0;
-    int in_ = 0;
-    BYTE char_array_4[4], char_array_3[3];
     std::vector<BYTE> ret;
+    base64_decode(encoded_string, ret);
+    return ret;
+}
+
+void base64_decode(std::string const& encoded_string, std::vector<BYTE>& out) {
+    const BYTE* src = reinterpret_cast<const BYTE*>(encoded_string.data());
 
-    while (in_len-- && (encoded_string[in_] != '=') && is_base64(encoded_string[in_])) {
-        char_array_4[i++] = encoded_string[in_]; in_++;
-        if (i == 4) {
-            for (i = 0; i < 4; i++)
-                char_array_4[i] = base64_chars.find(char_array_4[i]);
+    size_t len = 0;
+    while (len < encoded_string.size() && base64_values[src[len]] != 0xFF)
+        len++;
 
-            char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-            char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+    out.resize(len / 4 * 3 + 2);
+    BYTE* dst = out.data();
 
-            for (i = 0; (i < 3); i++)
-                ret.push_back(char_array_3[i]);
-            i = 0;
-        }
+    size_t i = 0;
+    for (; i + 3 < len; i += 4) {
+        uint32_t quad = (base64_values[src[i]] << 18) | (base64_values[src[i + 1]] << 12) | (base64_values[src[i + 2]] << 6) | base64_values[src[i + 3]];
+        dst[0] = (BYTE)(quad >> 16);
+        dst[1] = (BYTE)(quad >> 8);
+        dst[2] = (BYTE)quad;
+        dst += 3;
     }
 
-    if (i) {
-        for (j = i; j < 4; j++)
-            char_array_4[j] = 0;
+    size_t rest = len - i;
+    if (rest >= 2) {
+        uint32_t quad = (base64_values[src[i]] << 18) | (base64_values[src[i + 1]] << 12) | (rest == 3 ? base64_values[src[i + 2]] << 6 : 0);
+        *dst++ = (BYTE)(quad >> 16);
+        if (rest == 3)
+            *dst++ = (BYTE)(quad >> 8);
+    }
 
-        for (j = 0; j < 4; j++)
-            char_array_4[j] = base64_chars.find(char_array_4[j]);
+    out.resize(dst - out.data());
+}
 
-        char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-        char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-        char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+bool encodeImage(const cv::Mat& imgMat, cv::String ext, int quality, std::vector<uchar>& buf) {
+    std::vector<int> params;
+    if (ext == ".jpg")
+        params = { cv::IMWRITE_JPEG_QUALITY, quality }; //default(95) 0-100
+    else if (ext == ".webp")
+        params = { cv::IMWRITE_WEBP_QUALITY, std::max(1, quality) }; // 1-100, lossless above 100
 
-        for (j = 0; (j < i - 1); j++) ret.push_back(char_array_3[j]);
-    }
-
-    return ret;
+    return cv::imencode(ext, imgMat, buf, params);
 }
 
 
@@ -117,22 +118,12 @@ std::string surface8uToBase64(ci::Surface8u img, cv::String ext) {
 }
 
 std::string matToBase64(cv::Mat imgMat, cv::String ext, int quality, bool scale, int newWidth) {
-    std::vector<uchar> buf;
+    thread_local std::vector<uchar> buf; // reused between frames
 
     if (scale && imgMat.cols > newWidth) {
-        float hScale = (float)imgMat.cols / (float)imgMat.rows;
-        cv::resize(imgMat, imgMat, cv::Size(newWidth, newWidth * hScale));
+        cv::resize(imgMat, imgMat, cv::Size(newWidth, imgMat.rows * newWidth / imgMat.cols), 0, 0, cv::INTER_AREA);
     }
 
-    if (ext == ".jpg") {
-        std::vector<int> param(2);
-        param[0] = cv::IMWRITE_JPEG_QUALITY;
-        param[1] = quality;//default(95) 0-100
-        cv::imencode(ext, imgMat, buf, param);
-    }
-    else {
-        cv::imencode(ext, imgMat, buf);
-    }
-    auto* enc_msg = reinterpret_cast<unsigned char*>(buf.data());
-    return base64_encode(enc_msg, buf.size());
-}
\ No newline at end of file
+    encodeImage(imgMat, ext, quality, buf);
+    return base64_encode(buf.data(), (unsigned int)buf.size());
+}
@@ -94,16 +94,14 @@ act::proc::NetworkProcNode::NetworkProcNode() : ProcNodeBase("Network") {
 			CI_LOG_I(host);
 		}*/
 	});
-	
-	m_server.listen(m_port);
-	m_text = "Listening";
 }
 
 act::proc::NetworkProcNode::~NetworkProcNode() {
 }
 
 void act::proc::NetworkProcNode::setup(act::room::RoomManagers roomMgrs) {
-	
+	m_server.listen(m_port);
+	m_text = "Listening";
 }
 
 void act::proc::NetworkProcNode::sendJson(ci::Json json) {
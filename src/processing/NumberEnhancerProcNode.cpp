@@ -18,7 +18,7 @@
 #include "procpch.hpp"
 #include "NumberEnhancerProcNode.hpp"
 
-#include <numeric>
+#include <chrono>
 
 
 act::proc::NumberEnhancerProcNode::NumberEnhancerProcNode() : ProcNodeBase("NumberEnhancer") {
@@ -30,8 +30,15 @@ act::proc::NumberEnhancerProcNode::NumberEnhancerProcNode() : ProcNodeBase("Numb
 	
 	m_historySize = 1;
 	m_history.resize(10, 0.0f);
+	m_mean.setWindowSize(m_historySize);
 
 	m_rawHistory.resize(20,0.0f);
+	m_rawMin.setWindowSize(20);
+	m_rawMax.setWindowSize(20);
+	for (auto&& raw : m_rawHistory) {
+		m_rawMin.insertValue(raw);
+		m_rawMax.insertValue(raw);
+	}
 
 	m_currentMin = 0.0f;
 	m_currentMax = 1.0f;
@@ -65,7 +72,10 @@ void act::proc::NumberEnhancerProcNode::draw() {
 
 	bool prvntDrag = false;
 
-	prvntDrag = ImGui::SliderInt("Filter History", &m_historySize, 1, 100);
+	int historySize = m_historySize;
+	prvntDrag = ImGui::SliderInt("Filter History", &historySize, 1, 100);
+	if (historySize != m_historySize)
+		setHistorySize(historySize);
 
 	auto vec = std::vector<float>(m_history.begin(), m_history.end());
 	ImGui::PlotLines("Filter History", vec.data(), vec.size());
@@ -98,6 +108,9 @@ void act::proc::NumberEnhancerProcNode::draw() {
 			}
 		}
 	}
+
+	if (ImGui::Button("benchmark"))
+		benchmark();
 	
 	endNodeDraw();
 }
@@ -116,7 +129,9 @@ ci::Json act::proc::NumberEnhancerProcNode::toParams() {
 }
 
 void act::proc::NumberEnhancerProcNode::fromParams(ci::Json json) {
-	util::setValueFromJson(json, "historySize", m_historySize);
+	int historySize = m_historySize;
+	util::setValueFromJson(json, "historySize", historySize);
+	setHistorySize(historySize);
 	util::setValueFromJson(json, "currentMin", m_currentMin);
 	util::setValueFromJson(json, "currentMax", m_currentMax);
 	util::setValueFromJson(json, "mappedMin", m_mappedMin);
@@ -132,10 +147,10 @@ void act::proc::NumberEnhancerProcNode::onNumber(float number) {
 		m_rawHistory.pop_front();
 	}
 
-	auto min_max = std::minmax_element(m_rawHistory.begin(), m_rawHistory.end());
-
-	m_rawInputMin = *min_max.first;
-	m_rawInputMax = *min_max.second;
+	m_rawMin.insertValue(number);
+	m_rawMax.insertValue(number);
+	m_rawInputMin = m_rawMin.getValue();
+	m_rawInputMax = m_rawMax.getValue();
 
 	if (m_doGate) {
 
@@ -156,6 +171,57 @@ void act::proc::NumberEnhancerProcNode::onNumber(float number) {
 	while (m_history.size() > m_historySize + 10)
 		m_history.pop_front();
 
-	m_meanNumber = std::accumulate(m_history.begin() + 10, m_history.end(), 0.0f) / (m_history.size() - 10);	
+	m_mean.insertValue(number);
+	m_meanNumber = m_mean.getValue();
 	m_numberPort->send(m_meanNumber); 
 }
+
+void act::proc::NumberEnhancerProcNode::setHistorySize(int size)
+{
+	m_historySize = std::max(1, size);
+
+	// refill the window from the history, so the mean does not start over
+	m_mean.setWindowSize(m_historySize);
+	size_t count = std::min(m_history.size() - 10, (size_t)m_historySize);
+	for (auto it = m_history.end() - count; it != m_history.end(); ++it) {
+		m_mean.insertValue(*it);
+	}
+}
+
+void act::proc::NumberEnhancerProcNode::benchmark(int samples)
+{
+	std::vector<float> input(4096);
+	for (auto&& value : input) {
+		value = ci::randFloat(-1.0f, 1.0f);
+	}
+
+	auto measure = [&](FilterBase<float>& filter) {
+		float sink = 0.0f;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < samples; i++) {
+			filter.insertValue(input[i & 4095]);
+			sink += filter.getValue();
+		}
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		return sink == 12345.0f ? 0.0 : ns / samples; // sink keeps the loop alive
+	};
+
+	for (int window : { 10, 100, 1000, 10000 }) {
+		windowfilter::RunningMean<float>		mean(window);
+		windowfilter::RunningVariance<float>	variance(window);
+		windowfilter::MovingMin<float>			minimum(window);
+		windowfilter::MovingMax<float>			maximum(window);
+		Filter<float>							movingAverage(window);
+
+		CI_LOG_I("[NumberEnhancerProcNode] window " << window << ", ns per sample:"
+			<< " mean " << measure(mean)
+			<< ", variance " << measure(variance)
+			<< ", min " << measure(minimum)
+			<< ", max " << measure(maximum)
+			<< ", Filter " << measure(movingAverage));
+	}
+
+	windowfilter::EMA<float>	ema(0.1f);
+	windowfilter::Biquad<float>	biquad;
+	CI_LOG_I("[NumberEnhancerProcNode] ns per sample: ema " << measure(ema) << ", biquad " << measure(biquad));
+}
@@ -19,7 +19,7 @@
 #include "OSCSenderProcNode.hpp"
 
 act::proc::OSCSenderProcNode::OSCSenderProcNode() : ProcNodeBase("OSCSender", NT_OUTPUT) {
-	m_drawSize = ivec2(200, 200);
+	m_drawSize = ivec2(200, 250);
 
 	auto osc = InputPort<ci::osc::Message>::create(PT_OSC, "osc", [&](ci::osc::Message osc) { this->onOSC(osc); });
 	m_inputPorts.push_back(osc);
@@ -55,8 +55,11 @@ void act::proc::OSCSenderProcNode::initialize()
 		}
 	}
 
-	if(m_text != "Invalid address")
+	if (m_text != "Invalid address") {
 		m_server = act::net::OSCServer::create(m_port, m_address);
+		m_server->setIsBundling(m_isBundling);
+		m_server->setMaxPacketSize(m_maxPacketSize);
+	}
 }
 
 void act::proc::OSCSenderProcNode::update() {
@@ -67,6 +70,9 @@ void act::proc::OSCSenderProcNode::update() {
 		m_text = "Opened";
 	else
 		m_text = "Can't open";
+
+	// everything received since the last update leaves in as few packets as possible
+	m_server->flush();
 }
 
 void act::proc::OSCSenderProcNode::draw() {
@@ -90,6 +96,27 @@ void act::proc::OSCSenderProcNode::draw() {
 		}
 	}
 
+	if (ImGui::Checkbox("bundle", &m_isBundling) && m_server)
+		m_server->setIsBundling(m_isBundling);
+
+	ImGui::SetNextItemWidth(m_drawSize.x * 0.5f);
+	if (ImGui::InputInt("max bytes", &m_maxPacketSize, 100, 1000)) {
+		m_maxPacketSize = std::clamp(m_maxPacketSize, 64, 65000);
+		if (m_server)
+			m_server->setMaxPacketSize(m_maxPacketSize);
+	}
+
+	ImGui::SetNextItemWidth(m_drawSize.x * 0.5f);
+	if (ImGui::DragFloat("delay (s)", &m_delay, 0.01f, 0.0f, 60.0f)) {
+		preventDrag(true);
+	}
+	else {
+		preventDrag(false);
+	}
+
+	if (m_server)
+		ImGui::Text("%llu msgs in %llu packets", m_server->getSentMessages(), m_server->getSentPackets());
+
 	if (!m_text.empty()) {
 		std::stringstream strstr;
 		strstr << m_text << ": " << m_addressString << ":" << m_port;
@@ -100,13 +127,21 @@ void act::proc::OSCSenderProcNode::draw() {
 }
 
 void act::proc::OSCSenderProcNode::onOSC(ci::osc::Message msg) {
-	if(m_server)
+	if (!m_server)
+		return;
+
+	if (m_delay > 0.0f)
+		m_server->sendMsg(msg, m_delay);
+	else
 		m_server->sendMsg(msg);
 }
 
 ci::Json act::proc::OSCSenderProcNode::toParams() {
 	ci::Json json = ci::Json::object();
 	json["port"] = m_port;
+	json["isBundling"] = m_isBundling;
+	json["maxPacketSize"] = m_maxPacketSize;
+	json["delay"] = m_delay;
 
 	if(m_server)
 		json["isRunning"] = m_server->isRunning();
@@ -118,6 +153,9 @@ ci::Json act::proc::OSCSenderProcNode::toParams() {
 
 void act::proc::OSCSenderProcNode::fromParams(ci::Json json) {
 	util::setValueFromJson(json, "port", m_port);
+	util::setValueFromJson(json, "isBundling", m_isBundling);
+	util::setValueFromJson(json, "maxPacketSize", m_maxPacketSize);
+	util::setValueFromJson(json, "delay", m_delay);
 	util::setValueFromJson(json, "isRunning", m_isRunning); 
 
 	if (m_isRunning) {
@@ -34,8 +34,6 @@ act::proc::ObjectDetectionProcNode::ObjectDetectionProcNode() : ProcNodeBase("Ob
     m_detectionImagePort = createImageOutput("detection image");
     m_featureListPort = createFeatureListOutput("feature list");
 
-	initNetwork();
-
     m_currentObjects.resize(0);
 }
 
@@ -45,40 +43,55 @@ act::proc::ObjectDetectionProcNode::~ObjectDetectionProcNode() {
         m_thread.join();
 }
 
+void act::proc::ObjectDetectionProcNode::setup(act::room::RoomManagers) {
+	// the network is only loaded for a node in use, not for describing the type, and in the background
+	if (m_model.isValid())
+		return;
 
-void act::proc::ObjectDetectionProcNode::initNetwork() {
-
-	// get labels of all classes
 	std::string classesFile = ci::app::getAssetPath("your-model-here").string();
+	std::string cfgFile = ci::app::getAssetPath("your-model-here").string();
+	std::string weightsFile = ci::app::getAssetPath("your-model-here").string();
 
-	std::ifstream ifs(classesFile);
-	std::string line;
-	while (getline(ifs, line)) m_classes.push_back(line);
+	m_model = util::AssetManager::get().run<Model>([classesFile, cfgFile, weightsFile]() { return loadModel(classesFile, cfgFile, weightsFile); });
+}
 
 
-	std::string cfgFile = ci::app::getAssetPath("your-model-here").string();
-	std::string weightsFile = ci::app::getAssetPath("your-model-here").string();
+std::shared_ptr<act::proc::ObjectDetectionProcNode::Model> act::proc::ObjectDetectionProcNode::loadModel(std::string classesFile, std::string cfgFile, std::string weightsFile) {
+	auto model = std::make_shared<Model>();
+
+	// get labels of all classes
+	std::ifstream ifs(classesFile);
+	std::string line;
+	while (getline(ifs, line)) model->classes.push_back(line);
 
-	m_network = cv::dnn::readNetFromDarknet(cfgFile, weightsFile);
+	model->network = cv::dnn::readNetFromDarknet(cfgFile, weightsFile);
 
 	//add this for cuda support
 	// 
-	m_network.setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);
-	m_network.setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);
+	model->network.setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);
+	model->network.setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);
 
-	if (m_network.empty()) {
+	if (model->network.empty()) {
 		std::ostringstream ss;
 		ss << "Failed to load network with the following settings:\n";
 		throw std::invalid_argument(ss.str());
 	}
 
-	std::vector<std::string> layers = m_network.getLayerNames();
-	auto i = m_network.getUnconnectedOutLayers();
-	m_outputLayer = layers[i[0] - 1];
+	std::vector<std::string> layers = model->network.getLayerNames();
+	auto i = model->network.getUnconnectedOutLayers();
+	model->outputLayer = layers[i[0] - 1];
 
+	return model;
 }
 
 void act::proc::ObjectDetectionProcNode::update() {
+	if (m_network.empty() && m_model.isReady()) {
+		if (auto model = m_model.get()) {
+			m_network		= model->network;
+			m_classes		= model->classes;
+			m_outputLayer	= model->outputLayer;
+		}
+	}
 
 	if(m_isProcessingDone) {
         m_thread.join();
@@ -99,7 +112,7 @@ void act::proc::ObjectDetectionProcNode::update() {
 }
 
 void act::proc::ObjectDetectionProcNode::draw() {
-    beginNodeDraw();
+    beginNodeDraw(m_model.isLoading() ? NDS_LOADING : (m_model.hasFailed() ? NDS_ERROR : NDS_ACTIVE));
 	
     ImGui::Checkbox("show", &m_show);
     
@@ -128,7 +141,7 @@ void act::proc::ObjectDetectionProcNode::draw() {
 void act::proc::ObjectDetectionProcNode::onMat(cv::UMat event) {
 	m_imagePort->send(event);
 
-    if (m_isProcessing)
+    if (m_isProcessing || m_network.empty())
         return;
 	
     cv::UMat frame;
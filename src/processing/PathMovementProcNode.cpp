@@ -9,7 +9,7 @@
 	Licensed under the MIT License.
 	See LICENSE file in the project root for full license information.
 
-	This file is created and substantially modified: 2024
+	This file is created and substantially modified: 2024-2025
 
 	contributors:
 	Lars Engeln - mail@lars-engeln.de
@@ -23,15 +23,47 @@ act::proc::PathMovementProcNode::PathMovementProcNode() : ProcNodeBase("PathMove
 
 	m_position = vec3(0.0f, 0.0f, 0.0f);
 
-	auto tIn = createNumberInput("position on path", [&](float t) { evaluate(t); });
+	auto tIn		= createNumberInput("position on path", [&](float t) { evaluate(t); });
+	auto dIn		= createNumberInput("distance", [&](float distance) { evaluateAtDistance(distance); });
+	auto speedIn	= createNumberInput("speed", [&](float speed) { m_speed = speed; });
+	auto tsIn		= createNumberListInput("positions on path", [&](std::vector<number> ts) { evaluateList(ts); });
+	auto snapIn		= createVec3Input("snap", [&](vec3 position) { snap(position); });
 
-	m_positionPort = createVec3Output("position");
+	m_positionPort	= createVec3Output("position");
+	m_positionsPort	= createVec3ListOutput("positions");
+	m_snappedPort	= createVec3Output("snapped");
+	m_snappedAtPort	= createNumberOutput("snapped at");
 }
 
 act::proc::PathMovementProcNode::~PathMovementProcNode() {
 }
 
+void act::proc::PathMovementProcNode::setup(act::room::RoomManagers dMgrs)
+{
+	m_posMgr = dMgrs.positionMgr;
+	auto node = std::dynamic_pointer_cast<room::PositionRoomNode>(m_posMgr->addPosition(m_position));
+	if (!node)
+		return;
+
+	m_pathRoomNode = node;
+	m_pathRoomNode->setPathType(room::PathSpline::PT_CATMULLROM);
+	m_pathRoomNode->addControlPoint(vec3(1.0f, 0.0f, 0.0f));
+	m_pathRoomNode->addControlPoint(vec3(1.0f, 0.0f, 1.0f));
+	m_pathRoomNode->addControlPoint(vec3(0.0f, 0.0f, 1.0f));
+	m_pathRoomNode->setIsLooping(true);
+}
+
 void act::proc::PathMovementProcNode::update() {
+	if (!m_pathRoomNode)
+		return;
+
+	m_pathRoomNode->setIsHighlighted(m_isHovered);
+	m_pathRoomNode->setIsShowingDetails(m_isSelected);
+
+	double now = app::getElapsedSeconds();
+	if (m_speed != 0.0f && m_lastTime > 0.0)
+		evaluateAtDistance(m_distance + m_speed * (float)(now - m_lastTime));
+	m_lastTime = now;
 }
 
 void act::proc::PathMovementProcNode::draw() {
@@ -41,13 +73,69 @@ void act::proc::PathMovementProcNode::draw() {
 
 	if (ImGui::DragFloat3("center", &m_position, 0.01f)) {
 		preventDrag(true);
-		update();
+		if (m_pathRoomNode) {
+			m_pathRoomNode->setPosition(m_position);
+			evaluateAtDistance(m_distance);
+		}
+	}
+	else {
+		preventDrag(false);
+	}
+
+	if (!m_pathRoomNode) {
+		endNodeDraw();
+		return;
+	}
+
+	ImGui::SetNextItemWidth(m_drawSize.x * 0.5f);
+	if (ImGui::DragFloat("speed", &m_speed, 0.01f)) {
+		preventDrag(true);
 	}
 	else {
 		preventDrag(false);
 	}
+	ImGui::SameLine();
+	ImGui::Text("%.2f / %.2f m", m_distance, m_pathRoomNode->getLength());
+
+	int type = m_pathRoomNode->getPathType();
+	ImGui::SetNextItemWidth(m_drawSize.x * 0.5f);
+	if (ImGui::Combo("type", &type, "B-spline\0Catmull-Rom\0Bezier\0")) {
+		m_pathRoomNode->setPathType((room::PathSpline::PathType)type);
+		evaluateAtDistance(m_distance);
+	}
+	ImGui::SameLine();
+	bool loop = m_pathRoomNode->getIsLooping();
+	if (ImGui::Checkbox("loop", &loop)) {
+		m_pathRoomNode->setIsLooping(loop);
+		evaluateAtDistance(m_distance);
+	}
+
+	ImGui::Spacing();
+	if (ImGui::Button(ICON_FA_PLUS " add point")) {
+		m_pathRoomNode->addControlPoint(m_pathRoomNode->getLastControlPoint());
+		evaluateAtDistance(m_distance);
+	}
 
-	endNodeDraw();
+	auto points = m_pathRoomNode->getControlPoints();
+	for (int i = 0; i < points.size(); i++) {
+		ImGui::PushID(i);
+		if (ImGui::Button(ICON_FA_MINUS)) {
+			m_pathRoomNode->removeControlPoint(i);
+		}
+		ImGui::SameLine();
+		vec3 pt = points[i];
+		if (ImGui::DragFloat3("", &pt, 0.01f)) {
+			preventDrag(true);
+			m_pathRoomNode->setControlPoint(i, pt);
+			evaluateAtDistance(m_distance);
+		}
+		else {
+			preventDrag(false);
+		}
+		ImGui::PopID();
+	}
+
+	endNodeDraw(false, true);
 }
 
 ci::Json act::proc::PathMovementProcNode::toParams() {
@@ -55,6 +143,10 @@ ci::Json act::proc::PathMovementProcNode::toParams() {
 	json["x"]		= m_position.x;
 	json["y"]		= m_position.y;
 	json["z"]		= m_position.z;
+	json["speed"]	= m_speed;
+	json["distance"] = m_distance;
+	if (m_pathRoomNode)
+		json["pathNodeUID"] = m_pathRoomNode->getUID();
 	
 	return json;
 }
@@ -63,9 +155,72 @@ void act::proc::PathMovementProcNode::fromParams(ci::Json json) {
 	util::setValueFromJson(json, "x", m_position.x);
 	util::setValueFromJson(json, "y", m_position.y);
 	util::setValueFromJson(json, "z", m_position.z);
+	util::setValueFromJson(json, "speed", m_speed);
+	util::setValueFromJson(json, "distance", m_distance);
+
+	act::UID uid = "";
+	util::setValueFromJson(json, "pathNodeUID", uid);
+	if (uid.empty() || !m_posMgr)
+		return;
+
+	if (m_pathRoomNode)
+		m_posMgr->removeNode(m_pathRoomNode->getUID());
+	m_pathRoomNode = std::dynamic_pointer_cast<room::PositionRoomNode>(m_posMgr->getNodeByUID(uid));
+	if (!m_pathRoomNode)
+		m_pathRoomNode = std::dynamic_pointer_cast<room::PositionRoomNode>(m_posMgr->addPosition(m_position));
+
+	m_pathRoomNode->setPosition(m_position);
+	evaluateAtDistance(m_distance);
 }
 
 void act::proc::PathMovementProcNode::evaluate(float t)
 {
+	if (!m_pathRoomNode)
+		return;
+
+	evaluateAtDistance(t * m_pathRoomNode->getLength());
+}
+
+void act::proc::PathMovementProcNode::evaluateAtDistance(float distance)
+{
+	if (!m_pathRoomNode)
+		return;
+
+	float length = m_pathRoomNode->getLength();
+	if (m_pathRoomNode->getIsLooping() && length > 0.0f) { // keep the distance small while travelling endlessly
+		distance = fmodf(distance, length);
+		if (distance < 0.0f)
+			distance += length;
+	}
+	m_distance = distance;
+
+	m_positionPort->send(m_pathRoomNode->evaluatePositionAtDistance(m_distance));
+}
+
+void act::proc::PathMovementProcNode::evaluateList(std::vector<number> ts)
+{
+	if (!m_pathRoomNode)
+		return;
+
+	float length = m_pathRoomNode->getLength();
+	m_distances.resize(ts.size());
+	for (size_t i = 0; i < ts.size(); i++) {
+		m_distances[i] = ts[i] * length;
+	}
+
+	m_pathRoomNode->evaluatePositionsAtDistances(m_distances, m_positions);
+	m_positionsPort->send(m_positions);
+}
+
+void act::proc::PathMovementProcNode::snap(vec3 position)
+{
+	if (!m_pathRoomNode)
+		return;
+
+	float distance	= 0.0f;
+	vec3 snapped	= m_pathRoomNode->getClosestPosition(position, &distance);
+	float length	= m_pathRoomNode->getLength();
 
+	m_snappedPort->send(snapped);
+	m_snappedAtPort->send(length > 0.0f ? distance / length : 0.0f);
 }
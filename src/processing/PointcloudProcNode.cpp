@@ -18,6 +18,8 @@
 #include "procpch.hpp"
 #include "PointcloudProcNode.hpp"
 
+#include <chrono>
+
 
 act::room::Pointcloud globalPointcloud;
 
@@ -58,73 +60,112 @@ void act::proc::PointcloudProcNode::draw() {
 	if (ImGui::Checkbox("Scan whole room", &m_scanWholeRoom)) {
 	}
 	ImGui::PushItemWidth(100);
-	ImGui::DragInt("Threshold", &m_threshold, 1, 1, 100);
-	ImGui::DragFloat("Voxel Size", &m_boxSize, 0.01, 0.1, 10);
+	ImGui::DragInt("Threshold", &m_threshold, 1, 0, 64);
+	ImGui::DragFloat("Voxel Size", &m_boxSize, 0.001f, 0.0f, 1.0f, "%.3f m");
+	ImGui::DragFloat("Depth Range", &m_depthRange, 0.1f, 0.5f, 20.0f, "%.1f m");
+	if (m_pointcloud)
+		ImGui::Text("%d points", (int)m_pointcloud->size());
+
+	if (ImGui::Button("benchmark")) {
+		auto path = ci::app::getOpenFilePath("", { "iarec" });
+		if (!path.empty())
+			benchmark(path);
+	}
 
 	endNodeDraw();
 }
 
 void act::proc::PointcloudProcNode::createPointcloud(cv::UMat depthImage, cv::UMat colorImage)
 {
-	bool calcPointCloud = true;
-
 	if (depthImage.empty()) return;
 
-	cv::Mat depth = depthImage.getMat(cv::ACCESS_FAST);
-	cv::Mat color = colorImage.getMat(cv::ACCESS_FAST);
-
-	if (depth.type() == CV_8UC1) {
-		int panic = 0;
-	}
-
-	float fx = 5.8f; //_intrinsics(0, 0);
-	float fy = 5.8f; //_intrinsics(1, 1);
-	float cy = depth.rows * 0.5f; //_intrinsics(0, 2);
-	float cx = depth.cols * 0.5f; //_intrinsics(1, 2);
-
-	float factor = 38.0f;
-
-	act::room::Pointcloud pointcloudPointcloud;
-	act::room::Pointcloud pointcloudFiltered;
-
 	try {
-#pragma omp parallel for
-		for (int v = 0; v < depth.rows; v++)
-		{
-			for (int u = 0; u < depth.cols; u++)
-			{
+		cv::Mat depth = depthImage.getMat(cv::ACCESS_READ);
+		if (depth.channels() != 1 || (depth.depth() != CV_8U && depth.depth() != CV_16U)) {
+			CI_LOG_E("pointcloud needs a single channel 8 or 16 bit depth image");
+			return;
+		}
 
-				auto depthColor = depth.at<uchar>(v, u);
-				float Z = static_cast<float>(depthColor) / 255;
-				//if (Z < 0) {Z = Z + 1;}
+		// a fresh pointcloud each time, receivers may keep the previous one
+		auto pointcloud = std::make_shared<std::vector<glm::vec3>>();
+		filterDepth(depth, *pointcloud);
+
+		m_pointcloud = pointcloud;
+		m_pointcloudOutPort->send(m_pointcloud);
+	}
+	catch (cv::Exception exc) {
+		CI_LOG_E("pointcloud error:" << exc.what());
+	}
+}
 
-				if (Z > 0.12) {
+void act::proc::PointcloudProcNode::filterDepth(const cv::Mat& depth, std::vector<glm::vec3>& result)
+{
+	// pinhole camera from the field of view, the principal point is assumed to be in the center
+	float cx = depth.cols * 0.5f;
+	float cy = depth.rows * 0.5f;
+	float fx = cx / tanf(glm::radians(m_fov.x) * 0.5f);
+	float fy = cy / tanf(glm::radians(m_fov.y) * 0.5f);
+	float scale = depth.depth() == CV_16U ? 0.001f : m_depthRange / 255.0f;
+
+	// one slot per pixel, so rows can be unprojected in parallel; invalid pixels are dropped afterwards
+	m_unprojected.resize((size_t)depth.rows * depth.cols);
+	room::PointcloudFilter::parallelFor(depth.rows, [&](size_t v) {
+		glm::vec3* row = &m_unprojected[v * depth.cols];
+		for (int u = 0; u < depth.cols; u++) {
+			float z = (depth.depth() == CV_16U ? depth.at<uint16_t>((int)v, u) : depth.at<uchar>((int)v, u)) * scale;
+			row[u] = glm::vec3((u - cx) * z / fx, -((float)v - cy) * z / fy, z);
+		}
+	}, 16);
+	m_unprojected.erase(std::remove_if(m_unprojected.begin(), m_unprojected.end(), [](const glm::vec3& p) { return p.z <= 0.0f; }), m_unprojected.end());
 
-					/*p.z = -(Z * factor) + 30;
-					p.x = -((u - cx) * Z / fx);
-					p.y = -((v - cy) * Z / fy) + 10;
+	room::PointcloudFilter::voxelDownsample(m_unprojected, m_boxSize, m_downsampled);
+	room::PointcloudFilter::removeOutliers(m_downsampled, m_threshold, 1.0f, std::max(0.1f, m_boxSize * 4.0f), result);
+}
 
-					cv::Vec4b bgr = color.at<cv::Vec4b>(v, u);
+void act::proc::PointcloudProcNode::benchmark(const fs::path& path, int frames)
+{
+	room::KinectRecordingPlayer player;
+	if (!player.open(path))
+		return;
+	player.seek(player.getDuration()); // the last depth image and pointcloud of the recording
+
+	cv::Mat depth	= player.getDepth();
+	auto points		= player.getPoints();
+	if (depth.empty() && !points) {
+		CI_LOG_W("[PointcloudProcNode] " << path << " has neither depth images nor pointclouds");
+		return;
+	}
 
-					unsigned char alpha = bgr[3] / 255.0f;
+	std::vector<glm::vec3> result;
+	if (!depth.empty()) {
+		filterDepth(depth, result); // allocates the buffers
 
-					p.r = static_cast<float>(bgr[2]) * alpha;
-					p.g = static_cast<float>(bgr[1]) * alpha;
-					p.b = static_cast<float>(bgr[0]) * alpha;
-					*/
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < frames; i++)
+			filterDepth(depth, result);
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
-					//pointcloud.push_back(p);
+		CI_LOG_I("[PointcloudProcNode] depth " << depth.cols << "x" << depth.rows << " benchmark: " << ms / frames << " ms per frame, " << result.size() << " points");
+	}
 
-				}
-			}
+	if (points) {
+		// the recorded cloud is already unprojected, so downsampling, outlier removal and an octree query over the result
+		room::PointcloudOctree octree;
+		size_t inside = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < frames; i++) {
+			room::PointcloudFilter::voxelDownsample(*points, m_boxSize, m_downsampled);
+			room::PointcloudFilter::removeOutliers(m_downsampled, m_threshold, 1.0f, std::max(0.1f, m_boxSize * 4.0f), result);
+			octree.build(result);
+			inside = octree.countInSphere(vec3(0.0f, 1.0f, 2.0f), 1.0f);
 		}
-	}
-	catch (cv::Exception exc) {
-		CI_LOG_E("PCL error:" << exc.what());
-	}
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
+		CI_LOG_I("[PointcloudProcNode] pointcloud of " << points->size() << " points benchmark: " << ms / frames << " ms per frame, " << result.size() << " filtered, " << inside << " in the test sphere");
+	}
 }
-		
+
 
 
 ci::Json act::proc::PointcloudProcNode::toParams() {
@@ -132,6 +173,7 @@ ci::Json act::proc::PointcloudProcNode::toParams() {
 	json["threshold"]		= m_threshold;
 	json["voxelSize"]		= m_boxSize;
 	json["scanWholeRoom"]	= m_scanWholeRoom;
+	json["depthRange"]		= m_depthRange;
 	return json;
 }
 
@@ -139,4 +181,5 @@ void act::proc::PointcloudProcNode::fromParams(ci::Json json) {
 	util::setValueFromJson(json, "threshold", m_threshold);
 	util::setValueFromJson(json, "voxelSize", m_boxSize);
 	util::setValueFromJson(json, "scanWholeRoom", m_scanWholeRoom);
+	util::setValueFromJson(json, "depthRange", m_depthRange);
 }
\ No newline at end of file
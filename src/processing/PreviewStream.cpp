@@ -0,0 +1,185 @@
+
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "procpch.hpp"
+#include "PreviewStream.hpp"
+
+#include "processing/MatToBase64.hpp"
+
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+struct act::proc::PreviewState {
+	std::mutex								mutex;
+	PreviewSettings							settings;
+	std::chrono::steady_clock::time_point	lastSubmit;
+
+	cv::Mat			pending;				// scaled on submit, swapped with encoding by the encoder
+	bool			hasPending	= false;
+	bool			isQueued	= false;
+	std::string		result;
+	bool			hasResult	= false;
+
+	// only used on the preview thread
+	cv::Mat				encoding;
+	std::vector<uchar>	encoded;
+	std::string			base64;
+};
+
+namespace {
+
+	/** @brief the one thread encoding the previews of all streams, a stream is queued at most once */
+	class PreviewEncoder
+	{
+	public:
+		static PreviewEncoder& get() {
+			static PreviewEncoder encoder;
+			return encoder;
+		}
+
+		~PreviewEncoder() {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_isRunning = false;
+			}
+			m_condition.notify_all();
+			if (m_thread.joinable())
+				m_thread.join();
+		}
+
+		void push(std::weak_ptr<act::proc::PreviewState> state) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_queue.push_back(state);
+			}
+			m_condition.notify_all();
+		}
+
+	private:
+		std::thread										m_thread;
+		std::mutex										m_mutex;
+		std::condition_variable							m_condition;
+		bool											m_isRunning = true;
+		std::deque<std::weak_ptr<act::proc::PreviewState>>	m_queue;
+
+		PreviewEncoder() {
+			m_thread = std::thread([this]() { loop(); });
+		}
+
+		void loop() {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (true) {
+				m_condition.wait(lock, [this]() { return !m_queue.empty() || !m_isRunning; });
+				if (!m_isRunning)
+					return;
+
+				auto state = m_queue.front().lock();
+				m_queue.pop_front();
+				if (!state)
+					continue; // stream is gone
+
+				lock.unlock();
+				try {
+					encode(*state);
+				}
+				catch (const std::exception& exc) {
+					CI_LOG_E("[PreviewStream] " << exc.what());
+				}
+				lock.lock();
+			}
+		}
+
+		void encode(act::proc::PreviewState& state) {
+			act::proc::PreviewSettings settings;
+			{
+				std::lock_guard<std::mutex> lock(state.mutex);
+				state.isQueued = false;
+				if (!state.hasPending)
+					return;
+				cv::swap(state.pending, state.encoding);
+				state.hasPending	= false;
+				settings			= state.settings;
+			}
+
+			if (!encodeImage(state.encoding, settings.isWebP ? ".webp" : ".jpg", settings.quality, state.encoded))
+				return;
+			base64_encode(state.encoded.data(), state.encoded.size(), state.base64);
+
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.result.swap(state.base64);
+			state.hasResult = true;
+		}
+	};
+
+}
+
+act::proc::PreviewStream::PreviewStream()
+	: m_state(std::make_shared<PreviewState>())
+{
+}
+
+bool act::proc::PreviewStream::submit(const cv::UMat& image) {
+	if (image.empty())
+		return false;
+
+	bool isToQueue = false;
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		auto&& settings = m_state->settings;
+
+		auto now = std::chrono::steady_clock::now();
+		if (settings.maxRate > 0.0f && now - m_state->lastSubmit < std::chrono::duration<float>(1.0f / settings.maxRate))
+			return false;
+		m_state->lastSubmit = now;
+
+		if (settings.maxWidth > 0 && image.cols > settings.maxWidth)
+			cv::resize(image, m_state->pending, cv::Size(settings.maxWidth, image.rows * settings.maxWidth / image.cols), 0, 0, cv::INTER_AREA);
+		else
+			image.copyTo(m_state->pending);
+
+		m_state->hasPending = true;
+		isToQueue			= !m_state->isQueued;
+		m_state->isQueued	= true;
+	}
+
+	if (isToQueue)
+		PreviewEncoder::get().push(m_state);
+	return true;
+}
+
+bool act::proc::PreviewStream::take(std::string& base64) {
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	if (!m_state->hasResult)
+		return false;
+
+	base64.swap(m_state->result);
+	m_state->hasResult = false;
+	return true;
+}
+
+void act::proc::PreviewStream::setSettings(const PreviewSettings& settings) {
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	m_state->settings = settings;
+}
+
+act::proc::PreviewSettings act::proc::PreviewStream::getSettings() {
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->settings;
+}
@@ -40,6 +40,9 @@ void act::proc::ProcNodeBase::beginNodeDraw(ProcNodeDrawState state)
 			color = m_darkprocessingNodeColor;
 		}
 	}
+	else if (state == ProcNodeDrawState::NDS_LOADING) {
+		color = m_loadingNodeColor;
+	}
 	else {
 		color = m_darkErrorNodeColor;
 	}
@@ -51,7 +54,9 @@ void act::proc::ProcNodeBase::beginNodeDraw(ProcNodeDrawState state)
 	ImNodes::BeginNode(m_id);
 
 	ImNodes::BeginNodeTitleBar();
-	if(isEnabled())
+	if (state == ProcNodeDrawState::NDS_LOADING)
+		ImGui::TextUnformatted((getTitle() + " [loading]").c_str());
+	else if(isEnabled())
 		ImGui::TextUnformatted(getTitle().c_str());
 	else
 		ImGui::TextUnformatted((getTitle() + " [disabled]").c_str());
@@ -115,6 +120,8 @@ ci::Json act::proc::ProcNodeBase::getJsonTypeDefinition()
 	typeDefinition[m_name]["outputs"]	= outputs;
 	typeDefinition[m_name]["rpcs"]		= rpcs;
 	typeDefinition[m_name]["params"]	= params;
+	if (!m_params.empty())
+		typeDefinition[m_name]["paramSchema"] = m_params.getSchema();
 
 	return typeDefinition;
 }
@@ -17,6 +17,9 @@
 
 #include "ProcNodeRegistry.hpp"
 
+#include "cinder/Log.h"
+
+#include "ActionspaceTriggerProcNode.hpp"
 #include "Audio3DPlayerProcNode.hpp"
 #include "Audio3DPlayerTimestretchProcNode.hpp"
 #include "Audio3DProcNode.hpp"
@@ -76,72 +79,73 @@
 
 act::proc::ProcNodeRegistry::ProcNodeRegistry()
 {
-    act::proc::ProcNodeRegistry::add("", "Linker", act::proc::LinkerProcNode::create);
-
-    act::proc::ProcNodeRegistry::add("Utility", "Color", act::proc::ColorProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "ColorMapping", act::proc::ColorMappingProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "If", act::proc::IfProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "ImageEnhancer", act::proc::ImageEnhancerProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "NumberEnhancer", act::proc::NumberEnhancerProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "Position", act::proc::PositionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "Speed", act::proc::SpeedProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "BackgroundSubstraction", act::proc::BackgroundSubstractionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Utility", "Noise", act::proc::NoiseProcNode::create);
-
-    act::proc::ProcNodeRegistry::add("Audio", "AFSynth", act::proc::AFSynthProcNode::create);
-    act::proc::ProcNodeRegistry::add("Audio", "Audio3D", act::proc::Audio3DProcNode::create);
-    act::proc::ProcNodeRegistry::add("Audio", "Audio3DPlayer", act::proc::Audio3DPlayerProcNode::create);
-    act::proc::ProcNodeRegistry::add("Audio", "Audio3DPlayerTimestretch", act::proc::Audio3DPlayerTimestretchProcNode::create);
-    act::proc::ProcNodeRegistry::add("Audio", "AudioIn", act::proc::AudioInProcNode::create);
-    act::proc::ProcNodeRegistry::add("Audio", "AudioPlayer", act::proc::AudioPlayerProcNode::create);
-    act::proc::ProcNodeRegistry::add("Audio", "Spectrum", act::proc::SpectrumProcNode::create);
-
-    act::proc::ProcNodeRegistry::add("Person", "BodyTracking", act::proc::BodyTrackingProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "BodiesFilter", act::proc::BodiesFilterProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "MultiBodyPositions", act::proc::MultiBodyPositionsProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "SkeletonMovement", act::proc::SkeletonMovementProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "BoneVector", act::proc::BoneVectorProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "BodyToSound", act::proc::BodyToSoundProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "FaceDetection", act::proc::FaceDetectionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Person", "FaceEmotion", act::proc::FaceEmotionProcNode::create);
-
-    act::proc::ProcNodeRegistry::add("general IO", "KeyIn", act::proc::KeyInProcNode::create);
-    act::proc::ProcNodeRegistry::add("general IO", "CameraDevice", act::proc::CameraProcNode::create);
-    act::proc::ProcNodeRegistry::add("general IO", "Monitor", act::proc::MonitorProcNode::create);
-    act::proc::ProcNodeRegistry::add("general IO", "VideoRecorder", act::proc::VideoRecorderProcNode::create);
-    act::proc::ProcNodeRegistry::add("general IO", "Marker", act::proc::MarkerProcNode::create);
-    act::proc::ProcNodeRegistry::add("general IO", "Microphone", act::proc::MicrophoneProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::LinkerProcNode>("", "Linker");
+
+    act::proc::ProcNodeRegistry::add<act::proc::ColorProcNode>("Utility", "Color");
+    act::proc::ProcNodeRegistry::add<act::proc::ColorMappingProcNode>("Utility", "ColorMapping");
+    act::proc::ProcNodeRegistry::add<act::proc::IfProcNode>("Utility", "If");
+    act::proc::ProcNodeRegistry::add<act::proc::ImageEnhancerProcNode>("Utility", "ImageEnhancer");
+    act::proc::ProcNodeRegistry::add<act::proc::NumberEnhancerProcNode>("Utility", "NumberEnhancer");
+    act::proc::ProcNodeRegistry::add<act::proc::PositionProcNode>("Utility", "Position");
+    act::proc::ProcNodeRegistry::add<act::proc::ActionspaceTriggerProcNode>("Utility", "ActionspaceTrigger");
+    act::proc::ProcNodeRegistry::add<act::proc::SpeedProcNode>("Utility", "Speed");
+    act::proc::ProcNodeRegistry::add<act::proc::BackgroundSubstractionProcNode>("Utility", "BackgroundSubstraction");
+    act::proc::ProcNodeRegistry::add<act::proc::NoiseProcNode>("Utility", "Noise");
+
+    act::proc::ProcNodeRegistry::add<act::proc::AFSynthProcNode>("Audio", "AFSynth");
+    act::proc::ProcNodeRegistry::add<act::proc::Audio3DProcNode>("Audio", "Audio3D");
+    act::proc::ProcNodeRegistry::add<act::proc::Audio3DPlayerProcNode>("Audio", "Audio3DPlayer");
+    act::proc::ProcNodeRegistry::add<act::proc::Audio3DPlayerTimestretchProcNode>("Audio", "Audio3DPlayerTimestretch");
+    act::proc::ProcNodeRegistry::add<act::proc::AudioInProcNode>("Audio", "AudioIn");
+    act::proc::ProcNodeRegistry::add<act::proc::AudioPlayerProcNode>("Audio", "AudioPlayer");
+    act::proc::ProcNodeRegistry::add<act::proc::SpectrumProcNode>("Audio", "Spectrum");
+
+    act::proc::ProcNodeRegistry::add<act::proc::BodyTrackingProcNode>("Person", "BodyTracking");
+    act::proc::ProcNodeRegistry::add<act::proc::BodiesFilterProcNode>("Person", "BodiesFilter");
+    act::proc::ProcNodeRegistry::add<act::proc::MultiBodyPositionsProcNode>("Person", "MultiBodyPositions");
+    act::proc::ProcNodeRegistry::add<act::proc::SkeletonMovementProcNode>("Person", "SkeletonMovement");
+    act::proc::ProcNodeRegistry::add<act::proc::BoneVectorProcNode>("Person", "BoneVector");
+    act::proc::ProcNodeRegistry::add<act::proc::BodyToSoundProcNode>("Person", "BodyToSound");
+    act::proc::ProcNodeRegistry::add<act::proc::FaceDetectionProcNode>("Person", "FaceDetection");
+    act::proc::ProcNodeRegistry::add<act::proc::FaceEmotionProcNode>("Person", "FaceEmotion");
+
+    act::proc::ProcNodeRegistry::add<act::proc::KeyInProcNode>("general IO", "KeyIn");
+    act::proc::ProcNodeRegistry::add<act::proc::CameraProcNode>("general IO", "CameraDevice");
+    act::proc::ProcNodeRegistry::add<act::proc::MonitorProcNode>("general IO", "Monitor");
+    act::proc::ProcNodeRegistry::add<act::proc::VideoRecorderProcNode>("general IO", "VideoRecorder");
+    act::proc::ProcNodeRegistry::add<act::proc::MarkerProcNode>("general IO", "Marker");
+    act::proc::ProcNodeRegistry::add<act::proc::MicrophoneProcNode>("general IO", "Microphone");
    
-    act::proc::ProcNodeRegistry::add("Network", "JsonMsg", act::proc::JsonMsgProcNode::create);
-    act::proc::ProcNodeRegistry::add("Network", "JsonSender", act::proc::NetworkProcNode::create);
-    act::proc::ProcNodeRegistry::add("Network", "OSCMsg", act::proc::OSCMsgProcNode::create);
-    act::proc::ProcNodeRegistry::add("Network", "OSCSplitter", act::proc::OSCSplitterProcNode::create);
-    act::proc::ProcNodeRegistry::add("Network", "OSCSender", act::proc::OSCSenderProcNode::create);
-    act::proc::ProcNodeRegistry::add("Network", "OSCReciever", act::proc::OSCRecieverProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::JsonMsgProcNode>("Network", "JsonMsg");
+    act::proc::ProcNodeRegistry::add<act::proc::NetworkProcNode>("Network", "JsonSender");
+    act::proc::ProcNodeRegistry::add<act::proc::OSCMsgProcNode>("Network", "OSCMsg");
+    act::proc::ProcNodeRegistry::add<act::proc::OSCSplitterProcNode>("Network", "OSCSplitter");
+    act::proc::ProcNodeRegistry::add<act::proc::OSCSenderProcNode>("Network", "OSCSender");
+    act::proc::ProcNodeRegistry::add<act::proc::OSCRecieverProcNode>("Network", "OSCReciever");
     
-    act::proc::ProcNodeRegistry::add("Azure Kinect", "Kinect", act::proc::KinectProcNode::create);
-    act::proc::ProcNodeRegistry::add("Azure Kinect", "SkeletonFilter", act::proc::SkeletonFilterProcNode::create);
-    act::proc::ProcNodeRegistry::add("Azure Kinect", "Head", act::proc::HeadProcNode::create);
-    act::proc::ProcNodeRegistry::add("Azure Kinect", "Hand", act::proc::HandProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::KinectProcNode>("Azure Kinect", "Kinect");
+    act::proc::ProcNodeRegistry::add<act::proc::SkeletonFilterProcNode>("Azure Kinect", "SkeletonFilter");
+    act::proc::ProcNodeRegistry::add<act::proc::HeadProcNode>("Azure Kinect", "Head");
+    act::proc::ProcNodeRegistry::add<act::proc::HandProcNode>("Azure Kinect", "Hand");
     
 
-    act::proc::ProcNodeRegistry::add("Light", "DMXDimmer", act::proc::DMXDimmerProcNode::create);
-    act::proc::ProcNodeRegistry::add("Light", "MovingHead", act::proc::MovingHeadProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::DMXDimmerProcNode>("Light", "DMXDimmer");
+    act::proc::ProcNodeRegistry::add<act::proc::MovingHeadProcNode>("Light", "MovingHead");
     
-    act::proc::ProcNodeRegistry::add("Animation", "CircleMovement", act::proc::CircleMovementProcNode::create);
-    act::proc::ProcNodeRegistry::add("Animation", "PathMovement", act::proc::PathMovementProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::CircleMovementProcNode>("Animation", "CircleMovement");
+    act::proc::ProcNodeRegistry::add<act::proc::PathMovementProcNode>("Animation", "PathMovement");
 
-    act::proc::ProcNodeRegistry::add("Object & Marker", "FlowDetection", act::proc::FlowDetectionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Object & Marker", "MarkerDetection", act::proc::MarkerDetectionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Object & Marker", "MovementDetection", act::proc::MovementDetectionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Object & Marker", "ObjectDetection", act::proc::ObjectDetectionProcNode::create);
-    act::proc::ProcNodeRegistry::add("Object & Marker", "BlobDetection", act::proc::BlobDetectionProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::FlowDetectionProcNode>("Object & Marker", "FlowDetection");
+    act::proc::ProcNodeRegistry::add<act::proc::MarkerDetectionProcNode>("Object & Marker", "MarkerDetection");
+    act::proc::ProcNodeRegistry::add<act::proc::MovementDetectionProcNode>("Object & Marker", "MovementDetection");
+    act::proc::ProcNodeRegistry::add<act::proc::ObjectDetectionProcNode>("Object & Marker", "ObjectDetection");
+    act::proc::ProcNodeRegistry::add<act::proc::BlobDetectionProcNode>("Object & Marker", "BlobDetection");
 
-    act::proc::ProcNodeRegistry::add("Pointcloud", "Pointcloud", act::proc::PointcloudProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::PointcloudProcNode>("Pointcloud", "Pointcloud");
 
-    act::proc::ProcNodeRegistry::add("Timeline", "Easing", act::proc::EasingProcNode::create);
-    act::proc::ProcNodeRegistry::add("Timeline", "TriggerList", act::proc::TriggerListProcNode::create);
-    act::proc::ProcNodeRegistry::add("Timeline", "Clock", act::proc::ClockProcNode::create);
+    act::proc::ProcNodeRegistry::add<act::proc::EasingProcNode>("Timeline", "Easing");
+    act::proc::ProcNodeRegistry::add<act::proc::TriggerListProcNode>("Timeline", "TriggerList");
+    act::proc::ProcNodeRegistry::add<act::proc::ClockProcNode>("Timeline", "Clock");
 }
 
 bool act::proc::ProcNodeRegistry::add(std::string group, const std::string name, nodeCreateFunc funcCreate)
@@ -152,6 +156,7 @@ bool act::proc::ProcNodeRegistry::add(std::string group, const std::string name,
 
     if (auto it = getMap().find(name); it == getMap().end()) {
         getMap()[name] = funcCreate;
+        m_types[name] = NodeType{ group, name, funcCreate };
 
         // if the entry was not in getMap, than assume that it is also not in getGroups
         getGroups()[group].push_back(name);
@@ -167,4 +172,45 @@ std::shared_ptr<act::proc::ProcNodeBase> act::proc::ProcNodeRegistry::create(con
         return it->second();
 
     return nullptr;
+}
+
+ci::Json act::proc::ProcNodeRegistry::getTypeDefinition(const std::string& name)
+{
+    auto it = m_types.find(name);
+    if (it == m_types.end())
+        return nullptr;
+
+    if (!it->second.isDescribed)
+        describe(it->second);
+    return it->second.definition;
+}
+
+ci::Json act::proc::ProcNodeRegistry::getTypeDefinitions()
+{
+    ci::Json definitions = ci::Json::object();
+    for (auto&& type : m_types)
+        definitions[type.first] = getTypeDefinition(type.first);
+    return definitions;
+}
+
+void act::proc::ProcNodeRegistry::describe(NodeType& type)
+{
+    type.isDescribed = true;
+    type.definition = ci::Json::object();
+
+    // constructing only creates the ports, devices, models, audio nodes and sockets are acquired in setup(),
+    // the prototype is dropped right away
+    try {
+        auto prototype = type.create();
+        if (prototype) {
+            ci::Json definition = prototype->getJsonTypeDefinition();
+            if (!definition.empty())
+                type.definition = definition.begin().value();
+        }
+    }
+    catch (const std::exception& exc) {
+        CI_LOG_W("ProcNode '" << type.name << "' could not be described: " << exc.what());
+    }
+
+    type.definition["group"] = type.group;
 }
\ No newline at end of file
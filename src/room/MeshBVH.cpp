@@ -0,0 +1,331 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "MeshBVH.hpp"
+
+#include <mutex>
+
+
+act::room::MeshBVH::MeshBVH(ci::TriMeshRef triMesh)
+{
+	size_t count = triMesh ? triMesh->getNumTriangles() : 0;
+	if (count == 0)
+		return;
+
+	std::vector<ci::vec3>	vertices(count * 3);
+	std::vector<ci::vec3>	centroids(count);
+	std::vector<uint32_t>	triangles(count);
+	for (size_t i = 0; i < count; i++) {
+		triMesh->getTriangleVertices(i, &vertices[i * 3], &vertices[i * 3 + 1], &vertices[i * 3 + 2]);
+		centroids[i] = (vertices[i * 3] + vertices[i * 3 + 1] + vertices[i * 3 + 2]) / 3.0f;
+		triangles[i] = (uint32_t)i;
+	}
+
+	m_nodes.reserve(2 * count / kLeafSize + 1);
+	m_vertices.reserve(count * 3);
+	build(triangles, centroids, vertices, 0, (uint32_t)count);
+
+	m_bounds = ci::AxisAlignedBox(m_nodes[0].min, m_nodes[0].max);
+}
+
+act::room::MeshBVH::~MeshBVH()
+{
+}
+
+act::room::MeshBVHRef act::room::MeshBVH::get(ci::TriMeshRef triMesh)
+{
+	struct Entry {
+		std::weak_ptr<ci::TriMesh>	mesh;
+		std::weak_ptr<MeshBVH>		bvh;
+	};
+	static std::map<const ci::TriMesh*, Entry> cache;
+	static std::mutex mutex;	// room nodes and boundings may set their meshes from any thread
+
+	if (!triMesh)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// a freed mesh can leave its address to a new one, so the mesh itself is compared as well
+	auto it = cache.find(triMesh.get());
+	if (it != cache.end() && it->second.mesh.lock() == triMesh) {
+		if (auto bvh = it->second.bvh.lock())
+			return bvh;
+	}
+
+	for (auto entry = cache.begin(); entry != cache.end(); ) {
+		if (entry->second.bvh.expired())
+			entry = cache.erase(entry);
+		else
+			++entry;
+	}
+
+	auto bvh = MeshBVH::create(triMesh);
+	cache[triMesh.get()] = Entry{ triMesh, bvh };
+	return bvh;
+}
+
+uint32_t act::room::MeshBVH::build(std::vector<uint32_t>& triangles, std::vector<ci::vec3>& centroids, const std::vector<ci::vec3>& vertices, uint32_t begin, uint32_t end)
+{
+	uint32_t index = (uint32_t)m_nodes.size();
+	m_nodes.push_back(Node());
+
+	ci::vec3 min(FLT_MAX), max(-FLT_MAX), cMin(FLT_MAX), cMax(-FLT_MAX);
+	for (uint32_t i = begin; i < end; i++) {
+		uint32_t t = triangles[i];
+		for (int v = 0; v < 3; v++) {
+			min = glm::min(min, vertices[t * 3 + v]);
+			max = glm::max(max, vertices[t * 3 + v]);
+		}
+		cMin = glm::min(cMin, centroids[t]);
+		cMax = glm::max(cMax, centroids[t]);
+	}
+	m_nodes[index].min = min;
+	m_nodes[index].max = max;
+
+	if (end - begin <= kLeafSize) {
+		m_nodes[index].first = (uint32_t)(m_vertices.size() / 3);
+		m_nodes[index].count = end - begin;
+		for (uint32_t i = begin; i < end; i++) {
+			uint32_t t = triangles[i];
+			m_vertices.push_back(vertices[t * 3]);
+			m_vertices.push_back(vertices[t * 3 + 1]);
+			m_vertices.push_back(vertices[t * 3 + 2]);
+		}
+		return index;
+	}
+
+	// median split along the longest axis of the centroids
+	ci::vec3 extent = cMax - cMin;
+	int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	uint32_t mid = begin + (end - begin) / 2;
+	std::nth_element(triangles.begin() + begin, triangles.begin() + mid, triangles.begin() + end, [&](uint32_t a, uint32_t b) {
+		return centroids[a][axis] < centroids[b][axis];
+	});
+
+	build(triangles, centroids, vertices, begin, mid);
+	uint32_t right = build(triangles, centroids, vertices, mid, end);
+	m_nodes[index].first = right;
+	m_nodes[index].count = 0;
+
+	return index;
+}
+
+bool act::room::MeshBVH::intersect(const ci::Ray& ray, float* distance) const
+{
+	if (m_nodes.empty())
+		return false;
+
+	ci::vec3 origin	= ray.getOrigin();
+	ci::vec3 invDir	= inverseDirection(ray.getDirection());
+	float best		= FLT_MAX;
+	float entry		= 0.0f;
+
+	uint32_t stack[64];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		const Node& node = m_nodes[stack[--top]];
+		if (!intersectBox(node, origin, invDir, best, entry))
+			continue;
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				float t = 0.0f;
+				if (ray.calcTriangleIntersection(m_vertices[i * 3], m_vertices[i * 3 + 1], m_vertices[i * 3 + 2], &t) && t > 0.0f && t < best)
+					best = t;
+			}
+			continue;
+		}
+
+		// the nearer child is visited first, so the farther one is often culled by best
+		uint32_t left	= (uint32_t)(&node - m_nodes.data()) + 1;
+		uint32_t right	= node.first;
+		float leftEntry, rightEntry;
+		bool hitLeft	= intersectBox(m_nodes[left], origin, invDir, best, leftEntry);
+		bool hitRight	= intersectBox(m_nodes[right], origin, invDir, best, rightEntry);
+		if (hitLeft && hitRight) {
+			if (leftEntry < rightEntry)
+				std::swap(left, right);
+			stack[top++] = left;
+			stack[top++] = right;
+		}
+		else if (hitLeft)
+			stack[top++] = left;
+		else if (hitRight)
+			stack[top++] = right;
+	}
+
+	if (best == FLT_MAX)
+		return false;
+
+	if (distance)
+		*distance = best;
+	return true;
+}
+
+int act::room::MeshBVH::countIntersections(const ci::Ray& ray) const
+{
+	if (m_nodes.empty())
+		return 0;
+
+	ci::vec3 origin	= ray.getOrigin();
+	ci::vec3 invDir	= inverseDirection(ray.getDirection());
+	float entry		= 0.0f;
+	int count		= 0;
+
+	uint32_t stack[64];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		uint32_t index = stack[--top];
+		const Node& node = m_nodes[index];
+		if (!intersectBox(node, origin, invDir, FLT_MAX, entry))
+			continue;
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				float t = 0.0f;
+				if (ray.calcTriangleIntersection(m_vertices[i * 3], m_vertices[i * 3 + 1], m_vertices[i * 3 + 2], &t) && t > 0.0f)
+					count++;
+			}
+			continue;
+		}
+
+		stack[top++] = index + 1;
+		stack[top++] = node.first;
+	}
+
+	return count;
+}
+
+bool act::room::MeshBVH::intersectsSphere(const ci::vec3& center, float radius) const
+{
+	if (m_nodes.empty())
+		return false;
+
+	float radiusSq = radius * radius;
+
+	uint32_t stack[64];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		uint32_t index = stack[--top];
+		const Node& node = m_nodes[index];
+
+		ci::vec3 closest = glm::clamp(center, node.min, node.max);
+		if (glm::distance2(closest, center) > radiusSq)
+			continue;
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				ci::vec3 p = closestPointOnTriangle(center, m_vertices[i * 3], m_vertices[i * 3 + 1], m_vertices[i * 3 + 2]);
+				if (glm::distance2(p, center) <= radiusSq)
+					return true;
+			}
+			continue;
+		}
+
+		stack[top++] = index + 1;
+		stack[top++] = node.first;
+	}
+
+	return false;
+}
+
+bool act::room::MeshBVH::contains(const ci::vec3& point) const
+{
+	if (!m_bounds.contains(point))
+		return false;
+
+	// odd number of crossings, the direction is skewed to not run along edges of axis-aligned meshes
+	return countIntersections(ci::Ray(point, glm::normalize(ci::vec3(1.0f, 0.0137f, 0.0071f)))) % 2 == 1;
+}
+
+ci::vec3 act::room::MeshBVH::inverseDirection(const ci::vec3& direction)
+{
+	ci::vec3 invDir;
+	for (int axis = 0; axis < 3; axis++)
+		invDir[axis] = direction[axis] != 0.0f ? 1.0f / direction[axis] : std::copysign(INFINITY, direction[axis]);
+	return invDir;
+}
+
+bool act::room::MeshBVH::intersectBox(const Node& node, const ci::vec3& origin, const ci::vec3& invDir, float maxDistance, float& entry)
+{
+	float tNear	= 0.0f;
+	float tFar	= maxDistance;
+	for (int axis = 0; axis < 3; axis++) {
+		// parallel to the slab, 0 * infinity would be NaN if the origin lies on one of its planes
+		if (std::isinf(invDir[axis])) {
+			if (origin[axis] < node.min[axis] || origin[axis] > node.max[axis])
+				return false;
+			continue;
+		}
+
+		float t0 = (node.min[axis] - origin[axis]) * invDir[axis];
+		float t1 = (node.max[axis] - origin[axis]) * invDir[axis];
+		tNear	= std::max(tNear, std::min(t0, t1));
+		tFar	= std::min(tFar, std::max(t0, t1));
+	}
+
+	entry = tNear;
+	return tNear <= tFar;
+}
+
+ci::vec3 act::room::MeshBVH::closestPointOnTriangle(const ci::vec3& p, const ci::vec3& a, const ci::vec3& b, const ci::vec3& c)
+{
+	// see Ericson, Real-Time Collision Detection, 5.1.5
+	ci::vec3 ab = b - a;
+	ci::vec3 ac = c - a;
+	ci::vec3 ap = p - a;
+	float d1 = glm::dot(ab, ap);
+	float d2 = glm::dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+		return a;
+
+	ci::vec3 bp = p - b;
+	float d3 = glm::dot(ab, bp);
+	float d4 = glm::dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+		return b;
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		return a + ab * (d1 / (d1 - d3));
+
+	ci::vec3 cp = p - c;
+	float d5 = glm::dot(ab, cp);
+	float d6 = glm::dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+		return c;
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		return a + ac * (d2 / (d2 - d6));
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	float denom = 1.0f / (va + vb + vc);
+	float v = vb * denom;
+	float w = vc * denom;
+	return a + ab * v + ac * w;
+}
@@ -0,0 +1,298 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "RoomNodeBVH.hpp"
+
+
+act::room::RoomNodeBVH::RoomNodeBVH()
+{
+}
+
+act::room::RoomNodeBVH::~RoomNodeBVH()
+{
+}
+
+void act::room::RoomNodeBVH::update(const std::vector<RoomNodeBaseRef>& nodes)
+{
+	bool changed = nodes.size() != m_order.size();
+	for (size_t i = 0; !changed && i < nodes.size(); i++)
+		changed = nodes[i].get() != m_order[i];
+
+	if (changed) {
+		rebuild(nodes);
+		return;
+	}
+
+	// refitting keeps the topology, after the nodes have moved far it is worth to sort them again
+	if (refit() && area(m_nodes[0].min, m_nodes[0].max) > 2.0f * m_buildArea)
+		rebuild(nodes);
+}
+
+void act::room::RoomNodeBVH::clear()
+{
+	m_nodes.clear();
+	m_items.clear();
+	m_itemMin.clear();
+	m_itemMax.clear();
+	m_order.clear();
+	m_buildArea = 0.0f;
+}
+
+void act::room::RoomNodeBVH::rebuild(const std::vector<RoomNodeBaseRef>& nodes)
+{
+	clear();
+
+	m_order.reserve(nodes.size());
+	for (auto&& node : nodes)
+		m_order.push_back(node.get());
+
+	if (nodes.empty())
+		return;
+
+	std::vector<ci::vec3>	min(nodes.size());
+	std::vector<ci::vec3>	max(nodes.size());
+	std::vector<ci::vec3>	centers(nodes.size());
+	std::vector<uint32_t>	items(nodes.size());
+	for (size_t i = 0; i < nodes.size(); i++) {
+		ci::AxisAlignedBox bounds = nodes[i]->getWorldBounds();
+		min[i]		= bounds.getMin();
+		max[i]		= bounds.getMax();
+		centers[i]	= bounds.getCenter();
+		items[i]	= (uint32_t)i;
+	}
+
+	m_nodes.reserve(2 * nodes.size());
+	m_items.reserve(nodes.size());
+	m_itemMin.reserve(nodes.size());
+	m_itemMax.reserve(nodes.size());
+
+	// the leaves refer to ranges of items, so the items take over the order of the build
+	build(items, centers, 0, (uint32_t)items.size());
+	for (uint32_t index : items) {
+		m_items.push_back(nodes[index]);
+		m_itemMin.push_back(min[index]);
+		m_itemMax.push_back(max[index]);
+	}
+
+	fit();
+	m_buildArea = area(m_nodes[0].min, m_nodes[0].max);
+}
+
+bool act::room::RoomNodeBVH::refit()
+{
+	bool changed = false;
+	for (size_t i = 0; i < m_items.size(); i++) {
+		ci::AxisAlignedBox bounds = m_items[i]->getWorldBounds();
+		if (bounds.getMin() != m_itemMin[i] || bounds.getMax() != m_itemMax[i]) {
+			m_itemMin[i] = bounds.getMin();
+			m_itemMax[i] = bounds.getMax();
+			changed = true;
+		}
+	}
+
+	if (changed)
+		fit();
+	return changed;
+}
+
+void act::room::RoomNodeBVH::fit()
+{
+	// nodes are stored in pre-order, so going backwards visits the children before their parent
+	for (size_t i = m_nodes.size(); i-- > 0; ) {
+		Node& node = m_nodes[i];
+		if (node.count > 0) {
+			node.min = m_itemMin[node.first];
+			node.max = m_itemMax[node.first];
+			for (uint32_t item = node.first + 1; item < node.first + node.count; item++) {
+				node.min = glm::min(node.min, m_itemMin[item]);
+				node.max = glm::max(node.max, m_itemMax[item]);
+			}
+		}
+		else {
+			const Node& left	= m_nodes[i + 1];
+			const Node& right	= m_nodes[node.first];
+			node.min = glm::min(left.min, right.min);
+			node.max = glm::max(left.max, right.max);
+		}
+	}
+}
+
+uint32_t act::room::RoomNodeBVH::build(std::vector<uint32_t>& items, const std::vector<ci::vec3>& centers, uint32_t begin, uint32_t end)
+{
+	uint32_t index = (uint32_t)m_nodes.size();
+	m_nodes.push_back(Node());
+
+	if (end - begin <= kLeafSize) {
+		m_nodes[index].first = begin;
+		m_nodes[index].count = end - begin;
+		return index;
+	}
+
+	// median split along the longest axis of the centers
+	ci::vec3 cMin(FLT_MAX), cMax(-FLT_MAX);
+	for (uint32_t i = begin; i < end; i++) {
+		cMin = glm::min(cMin, centers[items[i]]);
+		cMax = glm::max(cMax, centers[items[i]]);
+	}
+	ci::vec3 extent = cMax - cMin;
+	int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	uint32_t mid = begin + (end - begin) / 2;
+	std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end, [&](uint32_t a, uint32_t b) {
+		return centers[a][axis] < centers[b][axis];
+	});
+
+	build(items, centers, begin, mid);
+	uint32_t right = build(items, centers, mid, end);
+	m_nodes[index].first = right;
+	m_nodes[index].count = 0;
+
+	return index;
+}
+
+template<typename Visit>
+void act::room::RoomNodeBVH::traverseRay(const ci::Ray& ray, Visit visit)
+{
+	if (m_nodes.empty())
+		return;
+
+	ci::vec3 origin	= ray.getOrigin();
+	ci::vec3 invDir	= inverseDirection(ray.getDirection());
+
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+
+	while (!stack.empty()) {
+		uint32_t index = stack.back();
+		stack.pop_back();
+
+		const Node& node = m_nodes[index];
+		if (!intersectBox(node.min, node.max, origin, invDir))
+			continue;
+
+		if (node.count == 0) {
+			stack.push_back(node.first);
+			stack.push_back(index + 1);
+			continue;
+		}
+
+		for (uint32_t item = node.first; item < node.first + node.count; item++) {
+			if (intersectBox(m_itemMin[item], m_itemMax[item], origin, invDir) && !visit(m_items[item]))
+				return;
+		}
+	}
+}
+
+bool act::room::RoomNodeBVH::hitRay(const ci::Ray& ray)
+{
+	bool hit = false;
+	traverseRay(ray, [&](const RoomNodeBaseRef& node) {
+		hit = node->hitRay(ray);
+		return !hit;
+	});
+	return hit;
+}
+
+act::room::RoomNodeBaseRef act::room::RoomNodeBVH::getNodeOnRay(const ci::Ray& ray)
+{
+	float distance = FLT_MAX;
+	RoomNodeBaseRef candidate;
+
+	traverseRay(ray, [&](const RoomNodeBaseRef& node) {
+		if (node->hitRay(ray)) {
+			float d = ci::distance(node->getPosition(), ray.getOrigin());
+			if (distance > d) {
+				distance = d;
+				candidate = node;
+			}
+		}
+		return true;
+	});
+
+	return candidate;
+}
+
+void act::room::RoomNodeBVH::getNodesInBox(const ci::AxisAlignedBox& box, std::vector<RoomNodeBaseRef>& result)
+{
+	if (m_nodes.empty())
+		return;
+
+	ci::vec3 min = box.getMin();
+	ci::vec3 max = box.getMax();
+	auto overlaps = [&](const ci::vec3& nodeMin, const ci::vec3& nodeMax) {
+		return glm::all(glm::lessThanEqual(nodeMin, max)) && glm::all(glm::lessThanEqual(min, nodeMax));
+	};
+
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+
+	while (!stack.empty()) {
+		uint32_t index = stack.back();
+		stack.pop_back();
+
+		const Node& node = m_nodes[index];
+		if (!overlaps(node.min, node.max))
+			continue;
+
+		if (node.count == 0) {
+			stack.push_back(node.first);
+			stack.push_back(index + 1);
+			continue;
+		}
+
+		for (uint32_t item = node.first; item < node.first + node.count; item++) {
+			if (overlaps(m_itemMin[item], m_itemMax[item]))
+				result.push_back(m_items[item]);
+		}
+	}
+}
+
+float act::room::RoomNodeBVH::area(const ci::vec3& min, const ci::vec3& max)
+{
+	ci::vec3 d = glm::max(max - min, ci::vec3(0.0f));
+	return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+ci::vec3 act::room::RoomNodeBVH::inverseDirection(const ci::vec3& direction)
+{
+	ci::vec3 invDir;
+	for (int axis = 0; axis < 3; axis++)
+		invDir[axis] = direction[axis] != 0.0f ? 1.0f / direction[axis] : std::copysign(INFINITY, direction[axis]);
+	return invDir;
+}
+
+bool act::room::RoomNodeBVH::intersectBox(const ci::vec3& min, const ci::vec3& max, const ci::vec3& origin, const ci::vec3& invDir)
+{
+	float tNear	= 0.0f;
+	float tFar	= INFINITY;
+	for (int axis = 0; axis < 3; axis++) {
+		// parallel to the slab, 0 * infinity would be NaN if the origin lies on one of its planes
+		if (std::isinf(invDir[axis])) {
+			if (origin[axis] < min[axis] || origin[axis] > max[axis])
+				return false;
+			continue;
+		}
+
+		float t0 = (min[axis] - origin[axis]) * invDir[axis];
+		float t1 = (max[axis] - origin[axis]) * invDir[axis];
+		tNear	= std::max(tNear, std::min(t0, t1));
+		tFar	= std::min(tFar, std::max(t0, t1));
+	}
+
+	return tNear <= tFar;
+}
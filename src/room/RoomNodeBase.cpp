@@ -89,6 +89,9 @@ void act::room::RoomNodeBase::drawSettings()
 	
 	ImGui::Separator();
 	drawSpecificSettings();
+
+	if (m_params.draw())
+		publishChanges("params", m_params.takeChanges());
 }
 
 void act::room::RoomNodeBase::setPosition(ci::vec3 position, bool publish)
@@ -178,6 +181,7 @@ void act::room::RoomNodeBase::setTriMesh(ci::TriMeshRef triMesh)
 	m_mesh = ci::gl::Batch::create(*m_triMesh, colorShader);
 
 	m_bounds = m_triMesh->calcBoundingBox();
+	m_bvh = MeshBVH::get(m_triMesh);
 }
 
 void act::room::RoomNodeBase::lookAt(ci::vec3 at)
@@ -219,46 +223,29 @@ bool act::room::RoomNodeBase::hitRay(ci::Ray ray)
 	if (!worldBoundsApprox.intersects(ray))
 		return false;
 
-	// Set initial distance to something far, far away.
-	float result = FLT_MAX;
-
-	// Traverse triangle list and find the closest intersecting triangle.
-	const size_t polycount = m_triMesh->getNumTriangles();
+	// the ray goes into model space instead of every triangle into world space,
+	// the direction is not normalized, so distances along the ray stay the same
+	ci::mat4 inverse = glm::inverse(m_transform);
+	ci::Ray localRay(ci::vec3(inverse * ci::vec4(ray.getOrigin(), 1.0f)), ci::vec3(inverse * ci::vec4(ray.getDirection(), 0.0f)));
 
 	float distance = 0.0f;
-	for (size_t i = 0; i < polycount; ++i) {
-		// Get a single triangle from the mesh.
-		ci::vec3 v0, v1, v2;
-		m_triMesh->getTriangleVertices(i, &v0, &v1, &v2);
-
-		// Transform triangle to world space.
-		v0 = ci::vec3(m_transform * ci::vec4(v0, 1.0));
-		v1 = ci::vec3(m_transform * ci::vec4(v1, 1.0));
-		v2 = ci::vec3(m_transform * ci::vec4(v2, 1.0));
-
-		// Test to see if the ray intersects this triangle.
-		if (ray.calcTriangleIntersection(v0, v1, v2, &distance)) {
-			// Keep the result if it's closer than any intersection we've had so far.
-			if (distance < result) {
-				result = distance;
-
-				// Assuming this is the closest triangle, we'll calculate our normal
-				// while we've got all the points handy.
-				//*pickedNormal = normalize(cross(v1 - v0, v2 - v0));
-			}
-		}
-	}
-
-	// Did we have a hit?
-	if (distance > 0) {
+	if (m_bvh->intersect(localRay, &distance)) {
 		// Calculate the exact position of the hit.
-		//*pickedPoint = ray.calcPosition(result);
+		//*pickedPoint = ray.calcPosition(distance);
 
 		return true;
 	}
 	else
 		return false;
 }
+
+ci::AxisAlignedBox act::room::RoomNodeBase::getWorldBounds()
+{
+	if (!m_triMesh)
+		setTriMesh(ci::TriMesh::create(ci::geom::Cube()));
+
+	return m_bounds.transformed(m_transform);
+}
 /*
 void act::room::RoomNodeBase::connectPositionPort(std::shared_ptr<RoomNodeBase> node)
 {
@@ -363,6 +350,7 @@ void act::room::RoomNodeBase::fromJson(ci::Json json, act::UID replyUID)
 
 	if (json.contains("params")) {
 		fromParams(json["params"]);
+		m_params.takeChanges(); // echoed below as a whole
 	}
 
 	if (m_publisher)
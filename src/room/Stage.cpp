@@ -17,6 +17,7 @@
 
 #include "roompch.hpp"
 #include "Stage.hpp"
+#include "actionspace/ActionspaceRoomNode.hpp"
 
 act::room::Stage::Stage()
 	: RoomNodeBase("stage")
@@ -43,6 +44,32 @@ void act::room::Stage::update()
 	for (auto&& node : m_nodes) {
 		node->update();
 	}
+
+	m_nodeTree.update(getAllNodes());
+	updateActionspaces();
+}
+
+void act::room::Stage::updateActionspaces()
+{
+	// the tree only gives candidates by their bounds, each node counts as a sphere of its radius against the exact volume
+	std::vector<RoomNodeBaseRef> candidates;
+	std::vector<RoomNodeBaseRef> occupants;
+	for (auto&& node : m_nodeTree.getItems()) {
+		auto space = dynamic_cast<ActionspaceRoomNode*>(node.get());
+		if (!space)
+			continue;
+
+		candidates.clear();
+		occupants.clear();
+		m_nodeTree.getNodesInBox(space->getWorldBounds(), candidates);
+		for (auto&& other : candidates) {
+			if (dynamic_cast<ActionspaceRoomNode*>(other.get()))
+				continue;
+			if (space->getBounding()->intersectsSphere(other->getPosition(), other->getRadius()))
+				occupants.push_back(other);
+		}
+		space->setOccupants(occupants);
+	}
 }
 
 void act::room::Stage::draw()
@@ -119,15 +146,8 @@ bool act::room::Stage::hit(ci::vec3 pos)
 
 bool act::room::Stage::hitRay(ci::Ray ray)
 {
-	for (auto&& node : m_nodes) {
-		if (node->hitRay(ray))
-			return true;
-	}
-	for (auto&& mgr : m_roomMgrs.list) {
-		if (mgr->hitRay(ray))
-			return true;
-	}
-	return false;
+	m_nodeTree.update(getAllNodes());
+	return m_nodeTree.hitRay(ray);
 }
 
 act::room::RoomNodeBaseRef act::room::Stage::getNodeAtPos(ci::vec3 pos)
@@ -146,30 +166,8 @@ act::room::RoomNodeBaseRef act::room::Stage::getNodeAtPos(ci::vec3 pos)
 
 act::room::RoomNodeBaseRef act::room::Stage::getNodeOnRay(ci::Ray ray)
 {
-	float distance = FLT_MAX;
-	RoomNodeBaseRef candidate;
-
-	for (auto&& node : m_nodes) {
-		if (node->hitRay(ray)) {
-			float d = ci::distance(node->getPosition(), ray.getOrigin());
-			if (distance > d) {
-				distance = d;
-				candidate = node;
-			}
-		}
-	}
-	for (auto&& mgr : m_roomMgrs.list) {
-		auto node = mgr->getNodeOnRay(ray);
-		if (node) {
-			float d = ci::distance(node->getPosition(), ray.getOrigin());
-			if (distance > d) {
-				distance = d;
-				candidate = node;
-			}
-		}
-	}
-
-	return candidate;
+	m_nodeTree.update(getAllNodes());
+	return m_nodeTree.getNodeOnRay(ray);
 }
 
 
@@ -177,6 +175,7 @@ bool act::room::Stage::removeNode(act::UID uid)
 {
 	if (m_selectedNode->getUID() == uid)
 		m_selectedNode.reset();
+	m_nodeTree.clear(); // holds the node as well
 
 	size_t nsize = m_nodes.size();
 	bool removed = false;
@@ -199,6 +198,7 @@ void act::room::Stage::clear()
 	for (auto&& mgr : m_roomMgrs.list)
 		mgr->clear();
 	m_nodes.clear();
+	m_nodeTree.clear();
 }
 
 std::vector<act::room::RoomNodeBaseRef> act::room::Stage::getAllNodes()
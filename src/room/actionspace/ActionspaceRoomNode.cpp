@@ -22,7 +22,8 @@
 act::room::ActionspaceRoomNode::ActionspaceRoomNode(std::string name, ci::vec3 position, ci::vec3 rotation, float radius, act::UID replyUID)
 	: RoomNodeBase(name, position, rotation, radius, replyUID)
 {
-	m_bounding = BoundingSphere::create(position, radius);
+	m_size = vec3(radius * 2.0f);
+	updateBounding();
 }
 
 act::room::ActionspaceRoomNode::~ActionspaceRoomNode()
@@ -39,16 +40,30 @@ void act::room::ActionspaceRoomNode::update()
 
 void act::room::ActionspaceRoomNode::draw()
 {
+	ci::gl::ScopedColor color(m_occupants.empty() ? ci::Color::gray(0.6f) : ci::Color(1.0f, 0.6f, 0.2f));
 	m_bounding->draw();
 }
 
 void act::room::ActionspaceRoomNode::drawSpecificSettings()
 {
+	int type = m_type;
+	if (ImGui::Combo("type", &type, "sphere\0cylinder\0cuboid\0cone\0free\0capsule\0")) {
+		setType((ASType)type);
+	}
+
+	vec3 size = m_size;
+	if (ImGui::DragFloat3("size", &size, 0.01f, 0.01f, 100.0f)) {
+		setSize(size);
+	}
+
+	ImGui::Text("%d inside", (int)m_occupants.size());
 }
 
 ci::Json act::room::ActionspaceRoomNode::toParams()
 {
 	ci::Json params = ci::Json();
+	params["typename"]	= toTypeString(m_type);
+	params["size"]		= util::valueToJson(m_size);
 	return params;
 }
 
@@ -62,15 +77,92 @@ void act::room::ActionspaceRoomNode::fromParams(ci::Json params)
 	if (params.contains("typename"))
 		m_type = fromTypeString(params["typename"]);
 
-	if (params.contains("size")) {
-		int x, y, z = -1;
-		ci::Json size = params["size"];
-		util::setValueFromJson(size, "x", x);
-		util::setValueFromJson(size, "y", y);
-		util::setValueFromJson(size, "z", z);
+	util::setValueFromJson(params, "size", m_size);
+
+	updateBounding();
+}
+
+ci::AxisAlignedBox act::room::ActionspaceRoomNode::getWorldBounds()
+{
+	return m_bounding->getWorldBounds();
+}
+
+bool act::room::ActionspaceRoomNode::hitRay(ci::Ray ray)
+{
+	return m_bounding->intersects(ray);
+}
+
+void act::room::ActionspaceRoomNode::setType(ASType type)
+{
+	m_type = type;
+	updateBounding();
+}
+
+void act::room::ActionspaceRoomNode::setSize(vec3 size)
+{
+	m_size = glm::max(size, vec3(0.01f));
+	updateBounding();
+}
+
+void act::room::ActionspaceRoomNode::setOccupants(const std::vector<RoomNodeBaseRef>& occupants)
+{
+	m_entered.clear();
+	m_exited.clear();
+
+	for (auto&& node : occupants) {
+		if (std::find(m_occupants.begin(), m_occupants.end(), node) == m_occupants.end())
+			m_entered.push_back(node);
+	}
+	for (auto&& node : m_occupants) {
+		if (std::find(occupants.begin(), occupants.end(), node) == occupants.end())
+			m_exited.push_back(node);
+	}
+
+	m_occupants = occupants;
+}
+
+void act::room::ActionspaceRoomNode::updateTransform()
+{
+	RoomNodeBase::updateTransform();
+
+	if (m_bounding) {
+		m_bounding->setPosition(getPosition());
+		m_bounding->setOrientation(getOrientation());
 	}
 }
 
+void act::room::ActionspaceRoomNode::updateBounding()
+{
+	vec3 position	= getPosition();
+	quat orientation = getOrientation();
+	float radius	= m_size.x * 0.5f;
+
+	switch (m_type) {
+	case AST_CYLINDER:
+		m_bounding = BoundingCylinder::create(position, radius, m_size.y);
+		break;
+	case AST_CUBOID:
+		m_bounding = BoundingOrientedBox::create(position, m_size);
+		break;
+	case AST_CONE:
+		m_bounding = BoundingConvex::create(ci::TriMesh::create(ci::geom::Cone().base(radius).apex(0.0f).height(m_size.y)));
+		break;
+	case AST_FREE:
+		m_bounding = BoundingMesh::create(ci::TriMesh::create(ci::geom::Cube().size(m_size)));
+		break;
+	case AST_CAPSULE:
+		m_bounding = BoundingCapsule::create(position, radius, std::max(0.0f, m_size.y - m_size.x));
+		break;
+	case AST_SPHERE:
+	default:
+		m_bounding = BoundingSphere::create(position, radius);
+		break;
+	}
+
+	m_bounding->setPosition(position);
+	m_bounding->setOrientation(orientation);
+}
+
 act::room::ASType act::room::ActionspaceRoomNode::fromTypeString(std::string typestring)
 {
 	if (typestring == "sphere")
@@ -83,6 +175,21 @@ act::room::ASType act::room::ActionspaceRoomNode::fromTypeString(std::string typ
 		return AST_CONE;
 	if (typestring == "free")
 		return AST_FREE;
+	if (typestring == "capsule")
+		return AST_CAPSULE;
 
 	return AST_UNKOWN;
 }
+
+std::string act::room::ActionspaceRoomNode::toTypeString(ASType type)
+{
+	switch (type) {
+	case AST_SPHERE:	return "sphere";
+	case AST_CYLINDER:	return "cylinder";
+	case AST_CUBOID:	return "cuboid";
+	case AST_CONE:		return "cone";
+	case AST_FREE:		return "free";
+	case AST_CAPSULE:	return "capsule";
+	default:			return "unknown";
+	}
+}
@@ -97,6 +97,13 @@ bool act::room::HeadphoneRoomNode::hitRay(ci::Ray ray)
 	return m_leftSpeaker->hitRay(ray) || m_rightSpeaker->hitRay(ray);
 }
 
+ci::AxisAlignedBox act::room::HeadphoneRoomNode::getWorldBounds()
+{
+	ci::AxisAlignedBox bounds = m_leftSpeaker->getWorldBounds();
+	bounds.include(m_rightSpeaker->getWorldBounds());
+	return bounds;
+}
+
 void act::room::HeadphoneRoomNode::setIsHovered(bool hovered)
 {
 	//m_isHovered = hovered; 
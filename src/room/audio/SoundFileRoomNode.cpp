@@ -73,7 +73,12 @@ void act::room::SoundFileRoomNode::update()
 		auto path = ci::app::getOpenFilePath();
 		loadFile(path);
 	}
-	
+
+	if (m_isBufferPending) {
+		if (!m_bufferAsset.isReady())
+			return;
+		applyBuffer();
+	}
 
 	if(m_bufferPlayerNode->isEof() || getPlayPosition() >= 0.99f) {
 		m_isFading = false;
@@ -164,16 +169,32 @@ void act::room::SoundFileRoomNode::loop(bool isLooping)
 
 void act::room::SoundFileRoomNode::loadFile(fs::path path)
 {
-	try {
-		auto source = ci::audio::load(ci::loadFile(path), ci::audio::Context::master()->getSampleRate());
+	size_t sampleRate = ci::audio::Context::master()->getSampleRate();
+
+	m_path = path;
+	m_bufferAsset = util::AssetManager::get().load<ci::audio::Buffer>(path, [sampleRate](const fs::path& path) {
+		auto source = ci::audio::load(ci::loadFile(path), sampleRate);
+		return source->loadBuffer();
+	}, std::to_string(sampleRate));
+
+	m_isBufferPending = true;
+	m_isLoadingFile = false;
+}
+
+void act::room::SoundFileRoomNode::applyBuffer()
+{
+	m_isBufferPending = false;
 
-		ci::audio::BufferRef buffer = source->loadBuffer();
-		m_bufferPlayerNode->setBuffer(buffer);
+	try {
+		ci::audio::BufferRef buffer = m_bufferAsset.get();
+		if (buffer)
+			m_bufferPlayerNode->setBuffer(buffer);
 
-		if (!m_noTimestretch) {
+		if (buffer && !m_noTimestretch) {
 			m_gain->disconnectAll();
 
 			auto ctx = audio::Context::master();
+			auto source = ci::audio::load(ci::loadFile(m_path), ctx->getSampleRate());
 			m_stretcherNode = ctx->makeNode(new aio::TimeStretchingNode(source, 120));
 			m_stretcherNode >> m_gain >> ctx->getOutput();
 			m_gain >> m_monitorNode;
@@ -181,7 +202,6 @@ void act::room::SoundFileRoomNode::loadFile(fs::path path)
 	}
 	catch (...) {
 	}
-	m_isLoadingFile = false;
 	finishedLoadingFn();
 }
 
@@ -0,0 +1,129 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "body/BodyFilterBank.hpp"
+
+
+act::room::BodyFilterBank::BodyFilterBank(float minCutoff, float beta, float dCutoff)
+{
+	setParams(minCutoff, beta, dCutoff);
+}
+
+act::room::BodyFilterBank::~BodyFilterBank()
+{
+}
+
+void act::room::BodyFilterBank::setParams(float minCutoff, float beta, float dCutoff)
+{
+	m_minCutoff = std::max(0.001f, minCutoff);
+	m_beta		= beta;
+	m_dCutoff	= std::max(0.001f, dCutoff);
+}
+
+void act::room::BodyFilterBank::apply(BodyStore& store, float dt)
+{
+	size_t count = store.size();
+	if (count < m_count)
+		m_count = count;
+
+	if (count == 0)
+		return;
+
+	resize(m_positions,		count * BJT_COUNT * 3);
+	resize(m_orientations,	count * BJT_COUNT * 4);
+
+	// a slot that got another id starts over, it must not continue the history of the one before
+	for (size_t body = 0; body < m_count; body++) {
+		if (store.isNew(body) || !store.isActive(body)) {
+			reset(m_positions,		store.getPositionData(),	body * BJT_COUNT * 3, BJT_COUNT * 3);
+			reset(m_orientations,	store.getOrientationData(),	body * BJT_COUNT * 4, BJT_COUNT * 4);
+		}
+	}
+
+	// keep quaternions in the same hemisphere as their filtered value, q and -q are the same rotation
+	glm::quat* orientations = store.getOrientations(0);
+	size_t filteredJoints	= m_count * BJT_COUNT;
+	for (size_t i = 0; i < filteredJoints; i++) {
+		const float* last = &m_orientations.value[i * 4];
+		glm::quat& q = orientations[i];
+		if (q.x * last[0] + q.y * last[1] + q.z * last[2] + q.w * last[3] < 0.0f)
+			q = -q;
+	}
+
+	filter(m_positions,		store.getPositionData(),	m_count * BJT_COUNT * 3, count * BJT_COUNT * 3, dt);
+	filter(m_orientations,	store.getOrientationData(),	m_count * BJT_COUNT * 4, count * BJT_COUNT * 4, dt);
+
+	for (size_t i = 0; i < filteredJoints; i++) {
+		orientations[i] = glm::normalize(orientations[i]);
+	}
+
+	m_count = count;
+}
+
+void act::room::BodyFilterBank::resize(Channel& channel, size_t total)
+{
+	if (channel.value.size() < total) {
+		channel.value.resize(total);
+		channel.raw.resize(total);
+		channel.deriv.resize(total);
+	}
+}
+
+void act::room::BodyFilterBank::reset(Channel& channel, const float* data, size_t begin, size_t count)
+{
+	for (size_t i = begin; i < begin + count; i++) {
+		channel.value[i]	= data[i];
+		channel.raw[i]		= data[i];
+		channel.deriv[i]	= 0.0f;
+	}
+}
+
+void act::room::BodyFilterBank::filter(Channel& channel, float* data, size_t filtered, size_t total, float dt)
+{
+	float* value	= channel.value.data();
+	float* raw		= channel.raw.data();
+	float* deriv	= channel.deriv.data();
+
+	// slots that are new in this frame start at their measurement
+	reset(channel, data, filtered, total - filtered);
+
+	if (dt <= 0.0f)
+		return;
+
+	const float twoPiDt	= 2.0f * glm::pi<float>() * dt;
+	const float alphaD	= twoPiDt * m_dCutoff / (1.0f + twoPiDt * m_dCutoff);
+	const float invDt	= 1.0f / dt;
+	const float minCutoff	= m_minCutoff;
+	const float beta		= m_beta;
+
+	// no branches and no calls, so the compiler can vectorise it
+	for (size_t i = 0; i < filtered; i++) {
+		float x		= data[i];
+		float dx	= (x - raw[i]) * invDt;
+		raw[i]		= x;
+
+		float d		= deriv[i] + alphaD * (dx - deriv[i]);
+		deriv[i]	= d;
+
+		float cutoff	= minCutoff + beta * fabsf(d);
+		float alpha		= twoPiDt * cutoff / (1.0f + twoPiDt * cutoff);
+
+		float v		= value[i] + alpha * (x - value[i]);
+		value[i]	= v;
+		data[i]		= v;
+	}
+}
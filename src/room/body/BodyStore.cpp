@@ -0,0 +1,112 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "body/BodyStore.hpp"
+
+
+act::room::BodyStore::BodyStore()
+{
+}
+
+act::room::BodyStore::~BodyStore()
+{
+}
+
+void act::room::BodyStore::beginFrame()
+{
+	for (auto&& slot : m_slots) {
+		slot.isSeen	= false;
+		slot.isNew	= false;
+	}
+}
+
+size_t act::room::BodyStore::acquire(uint32_t id)
+{
+	auto it = m_idToSlot.find(id);
+	if (it != m_idToSlot.end()) {
+		m_slots[it->second].isSeen = true;
+		return it->second;
+	}
+
+	size_t body = 0;
+	while (body < m_slots.size() && m_slots[body].isActive)
+		body++;
+
+	if (body == m_slots.size()) {
+		m_slots.push_back(Slot());
+		m_uids.push_back("");
+
+		size_t joints = m_slots.size() * BJT_COUNT;
+		m_positions.resize(joints, glm::vec3(0.0f));
+		m_orientations.resize(joints, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		m_confidences.resize(joints, BJC_NONE);
+	}
+
+	// another person, so another UID
+	m_slots[body]	= { id, true, true, true };
+	m_uids[body]	= UniqueIDBase().getUID();
+	m_idToSlot[id]	= body;
+
+	m_count = std::max(m_count, body + 1);
+	return body;
+}
+
+void act::room::BodyStore::endFrame()
+{
+	m_count = 0;
+	for (size_t body = 0; body < m_slots.size(); body++) {
+		auto& slot = m_slots[body];
+		if (slot.isActive && !slot.isSeen) {
+			m_idToSlot.erase(slot.id);
+			slot.isActive = false;
+		}
+		if (slot.isActive)
+			m_count = body + 1;
+	}
+}
+
+void act::room::BodyStore::setOrientationsFromPose(size_t body)
+{
+	glm::vec3* positions	= getPositions(body);
+	glm::quat* orientations = getOrientations(body);
+
+	for (int i = 0; i < BJT_COUNT; i++) {
+		auto info = bodyMap.find((BodyJointType)i);
+		if (info == bodyMap.end()) {
+			orientations[i] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+			continue;
+		}
+
+		glm::vec3 dir	= positions[info->second->nextJoint] - positions[i];
+		orientations[i] = glm::quatLookAt(glm::normalize(dir), glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+}
+
+void act::room::BodyStore::toBody(size_t body, BodyRef target) const
+{
+	const glm::vec3* positions				= getPositions(body);
+	const glm::quat* orientations			= getOrientations(body);
+	const BodyJointConfidence* confidences	= getConfidences(body);
+
+	target->setUID(m_uids[body]);
+	for (int i = 0; i < BJT_COUNT; i++) {
+		auto& joint				= target->joints[i];
+		joint->position			= positions[i];
+		joint->orientation		= orientations[i];
+		joint->confidenceLevel	= confidences[i];
+	}
+}
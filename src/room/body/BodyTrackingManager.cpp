@@ -36,7 +36,23 @@ void act::room::BodyTrackingManager::setup()
 
 void act::room::BodyTrackingManager::update()
 {
-	m_bodies = m_kinectMgr->getBodies();
+	m_kinectMgr->getBodies(m_store);
+
+	double now	= app::getElapsedSeconds();
+	float dt	= m_lastTime > 0.0 ? (float)(now - m_lastTime) : 0.0f;
+	m_lastTime	= now;
+	if (m_isFiltering)
+		m_filterBank.apply(m_store, dt);
+
+	// consumers may keep the Bodys of earlier frames, so these are not recycled
+	m_bodies.clear();
+	for (size_t i = 0; i < m_store.size(); i++) {
+		if (!m_store.isActive(i))
+			continue;
+		m_bodies.push_back(Body::create());
+		m_store.toBody(i, m_bodies.back());
+	}
+
 	if(!m_wereZeroBodiesBefore)
 		m_bodiesOutPort->send(m_bodies);
 
@@ -70,6 +86,18 @@ void act::room::BodyTrackingManager::draw()
 
 act::room::RoomNodeBaseRef act::room::BodyTrackingManager::drawMenu()
 {
+	if (ImGui::Checkbox("filter joints", &m_isFiltering))
+		m_filterBank.reset();
+
+	if (m_isFiltering) {
+		float minCutoff = m_filterBank.getMinCutoff();
+		float beta		= m_filterBank.getBeta();
+		bool changed	= ImGui::DragFloat("min cutoff", &minCutoff, 0.01f, 0.01f, 10.0f);
+		changed			= ImGui::DragFloat("beta", &beta, 0.001f, 0.0f, 1.0f, "%.4f") || changed;
+		if (changed)
+			m_filterBank.setParams(minCutoff, beta, m_filterBank.getDCutoff());
+	}
+
 	return nullptr;
 }
 
@@ -77,12 +105,24 @@ ci::Json act::room::BodyTrackingManager::toJson()
 {
 	auto json = ci::Json::object();
 	json["name"] = getName();
+	json["isFiltering"]	= m_isFiltering;
+	json["minCutoff"]	= m_filterBank.getMinCutoff();
+	json["beta"]		= m_filterBank.getBeta();
+	json["dCutoff"]		= m_filterBank.getDCutoff();
 
 	return json;
 }
 
 void act::room::BodyTrackingManager::fromJson(ci::Json json)
 {
+	float minCutoff = m_filterBank.getMinCutoff();
+	float beta		= m_filterBank.getBeta();
+	float dCutoff	= m_filterBank.getDCutoff();
+	util::setValueFromJson(json, "isFiltering", m_isFiltering);
+	util::setValueFromJson(json, "minCutoff", minCutoff);
+	util::setValueFromJson(json, "beta", beta);
+	util::setValueFromJson(json, "dCutoff", dCutoff);
+	m_filterBank.setParams(minCutoff, beta, dCutoff);
 }
 
 act::room::BodyRoomNodeRef act::room::BodyTrackingManager::getBodyRoomNodeByBodyUID(UID uid)
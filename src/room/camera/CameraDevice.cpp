@@ -1,4 +1,3 @@
-
 /*
 	InACTually
 	> interactive theater for actual acts
@@ -18,6 +17,8 @@
 #include "roompch.hpp"
 #include "camera/CameraDevice.hpp"
 
+#include <chrono>
+
 
 act::room::CameraDevice::CameraDevice() {
 
@@ -29,7 +30,9 @@ act::room::CameraDevice::CameraDevice(ci::Capture::DeviceRef deviceReference) {
 		m_name = deviceReference->getName();
 		m_capture = Capture::create(m_captureSize.x, m_captureSize.y, m_device);
 		m_captureSize = m_capture->getSize();
+		m_cvSize = cv::Size(m_captureSize.x, m_captureSize.y);
 		m_capture->start();
+		start();
 	}
 	catch (...) {
 		m_error = true;
@@ -38,7 +41,34 @@ act::room::CameraDevice::CameraDevice(ci::Capture::DeviceRef deviceReference) {
 
 }
 
+act::room::CameraDevice::CameraDevice(fs::path videoPath) {
+	m_sourceType = ST_FILE;
+	m_name = videoPath.filename().string();
+
+	m_video = cv::VideoCapture(videoPath.string());
+	if (!m_video.isOpened()) {
+		m_error = true;
+		CI_LOG_E("Failed to open video " << videoPath);
+		return;
+	}
+
+	m_fps = (float)m_video.get(cv::CAP_PROP_FPS);
+	if (m_fps <= 0.0f)
+		m_fps = 30.0f;
+	setCaptureSize(ci::ivec2(m_video.get(cv::CAP_PROP_FRAME_WIDTH), m_video.get(cv::CAP_PROP_FRAME_HEIGHT)));
+	start();
+}
+
+act::room::CameraDevice::CameraDevice(ci::ivec2 size, float fps) {
+	m_sourceType = ST_SYNTHETIC;
+	m_name = "test pattern";
+	m_fps = std::max(1.0f, fps);
+	setCaptureSize(size);
+	start();
+}
+
 act::room::CameraDevice::~CameraDevice() {
+	stop();
 	try {
 		//if(m_capture && m_capture->isCapturing())
 			//m_capture->stop();
@@ -49,28 +79,167 @@ act::room::CameraDevice::~CameraDevice() {
 	}
 }
 
+void act::room::CameraDevice::start()
+{
+	if (m_isRunning)
+		return;
 
-bool act::room::CameraDevice::update() {
-	if (!m_capture)
-		return false;
+	m_isRunning = true;
+	m_thread = std::thread([&]() {
+		auto interval	= std::chrono::microseconds((int64_t)(1000000 / m_fps));
+		auto next		= std::chrono::steady_clock::now();
+		cv::Mat frame;
+		int colorConversion = -1;
+
+		while (m_isRunning) {
+			if (m_sourceType != ST_CAPTURE) { // files and test patterns are paced by their own frame rate
+				next += interval;
+				std::this_thread::sleep_until(next);
+			}
+
+			if (grab(frame, colorConversion))
+				publish(frame, colorConversion, now());
+			else if (m_sourceType == ST_CAPTURE)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+}
+
+void act::room::CameraDevice::stop()
+{
+	m_isRunning = false;
+	if (m_thread.joinable())
+		m_thread.join();
+}
 
-	if (m_capture && m_capture->checkNewFrame()) {
-		cv::UMat image = toOcv(*m_capture->getSurface()).getUMat(cv::ACCESS_FAST);
+bool act::room::CameraDevice::grab(cv::Mat& frame, int& colorConversion)
+{
+	colorConversion = -1;
 
-		if (m_flipped) cv::flip(image, image, 1);
-		//m_captureSurface = m_capture->getSurface();
+	switch (m_sourceType) {
+	case ST_CAPTURE: {
+		if (!m_capture || !m_capture->checkNewFrame())
+			return false;
+		m_surface = m_capture->getSurface();
+		if (!m_surface)
+			return false;
 
-		image.copyTo(m_currentImage);
-		if (m_isCalibrated) {
-			//cv::flip(image, image, 1);
-			m_undistoretedImage = remap(image);
+		// wraps the surface, publish() converts it to BGR straight into the frame buffer
+		const ci::Surface8u& surface = *m_surface;
+		bool isRGB = surface.getRedOffset() == 0 && surface.getBlueOffset() == 2;
+		bool isBGR = surface.getBlueOffset() == 0 && surface.getRedOffset() == 2;
+		if (!isRGB && !isBGR) {
+			frame = toOcv(surface); // other channel orders are converted pixel by pixel
+			return true;
 		}
 
+		frame = toOcvRef(*m_surface);
+		if (surface.hasAlpha())
+			colorConversion = isRGB ? cv::COLOR_RGBA2BGR : cv::COLOR_BGRA2BGR;
+		else if (isRGB)
+			colorConversion = cv::COLOR_RGB2BGR;
+		return true;
+	}
+
+	case ST_FILE:
+		if (!m_video.read(frame)) { // loop
+			m_video.set(cv::CAP_PROP_POS_FRAMES, 0);
+			if (!m_video.read(frame))
+				return false;
+		}
+		return true; // BGR, as toOcv() gives for ci::Capture
+
+	case ST_SYNTHETIC:
+		drawTestPattern(frame);
 		return true;
 	}
 	return false;
 }
 
+void act::room::CameraDevice::publish(const cv::Mat& frame, int colorConversion, double timestamp)
+{
+	CameraFrame& target = m_frames[m_write];
+	target.image = cv::UMat(); // the image of an earlier round may be free now
+
+	cv::UMat& image = acquireBuffer();
+	if (colorConversion >= 0) {
+		cv::cvtColor(frame, image, colorConversion);
+		if (m_flipped)
+			cv::flip(image, image, 1);
+	}
+	else if (m_flipped)
+		cv::flip(frame, image, 1);
+	else
+		frame.copyTo(image);
+	target.image = image;
+
+	target.timestamp	= timestamp;
+	target.sequence		= ++m_written;
+
+	int previous = m_ready.exchange(m_write | kFresh);
+	if (previous & kFresh)
+		m_droppedFrames++;
+	m_write = previous & kIndex;
+}
+
+cv::UMat& act::room::CameraDevice::acquireBuffer()
+{
+	for (int i = 0; i < kPoolSize; i++) {
+		int slot = (m_poolNext + i) % kPoolSize;
+		cv::UMat& buffer = m_pool[slot];
+		// only the pool refers to it, the ports cache just the latest image they sent or received
+		if (buffer.empty() || (buffer.u && buffer.u->urefcount == 1 && buffer.u->refcount == 0)) {
+			m_poolNext = (slot + 1) % kPoolSize;
+			return buffer;
+		}
+	}
+
+	// all held by consumers, the slot gets a new buffer and the held one lives on with them
+	cv::UMat& buffer = m_pool[m_poolNext];
+	buffer = cv::UMat();
+	m_poolNext = (m_poolNext + 1) % kPoolSize;
+	return buffer;
+}
+
+void act::room::CameraDevice::drawTestPattern(cv::Mat& frame)
+{
+	if (frame.size() != m_cvSize || frame.type() != CV_8UC3)
+		frame = cv::Mat(m_cvSize, CV_8UC3);
+
+	// colour bars with a bar running across, so motion and latency are visible
+	static const cv::Scalar bars[] = { {255, 255, 255}, {255, 255, 0}, {0, 255, 255}, {0, 255, 0}, {255, 0, 255}, {255, 0, 0}, {0, 0, 255} };
+	int barWidth = std::max(1, m_cvSize.width / 7);
+	for (int i = 0; i < 7; i++)
+		cv::rectangle(frame, cv::Rect(i * barWidth, 0, barWidth + 1, m_cvSize.height), bars[i], cv::FILLED);
+
+	int x = (int)((m_written * 8) % std::max(1, m_cvSize.width));
+	cv::rectangle(frame, cv::Rect(x, 0, 8, m_cvSize.height), cv::Scalar(0, 0, 0), cv::FILLED);
+	cv::putText(frame, std::to_string(m_written + 1), cv::Point(20, m_cvSize.height - 20), cv::FONT_HERSHEY_SIMPLEX, 1.5, cv::Scalar(0, 0, 0), 3);
+}
+
+double act::room::CameraDevice::now()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool act::room::CameraDevice::update() {
+	if (!(m_ready.load() & kFresh))
+		return false;
+
+	m_read = m_ready.exchange(m_read) & kIndex;
+
+	const CameraFrame& frame = m_frames[m_read];
+	m_currentImage	= frame.image;
+	m_timestamp		= frame.timestamp;
+	m_sequence		= frame.sequence;
+
+	if (m_isCalibrated) {
+		m_undistoretedImage = remap(m_currentImage);
+	}
+
+	return true;
+}
+
 cv::UMat act::room::CameraDevice::getCurrentImage()
 {
 	return m_currentImage;
@@ -100,6 +269,3 @@ cv::UMat act::room::CameraDevice::remap(cv::UMat image)
 	cv::remap(image, imageUndistorted, m_map1, m_map2, cv::INTER_LINEAR);
 	return imageUndistorted;
 }
-
-
-
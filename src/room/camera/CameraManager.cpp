@@ -54,6 +54,13 @@ act::room::RoomNodeBaseRef act::room::CameraManager::drawMenu()
 		refreshLists();
 	}
 
+	if (ImGui::Button("add Test Pattern")) { // synthetic source, to try camera chains without hardware
+		auto cam = CameraRoomNode::create(CameraDevice::createSynthetic(), "test pattern");
+		m_nodes.push_back(cam);
+		refreshLists();
+		return cam;
+	}
+
 	if (m_doCalibrate) {
 		ImGui::OpenPopup("Add Device");
 	}
@@ -0,0 +1,219 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "dmx/DMXColorProfile.hpp"
+
+#include "RGBAWHelper.h"
+
+
+act::room::DMXColorProfile::DMXColorProfile(ci::Json description)
+{
+	auto offset = [&](std::string channel) {
+		auto mapping = description["mapping"];
+		if (!mapping.contains(channel))
+			return -1;
+		return (int)mapping[channel] - 1;
+	};
+
+	m_red			= offset("R");
+	m_green			= offset("G");
+	m_blue			= offset("B");
+	m_amber			= offset("A");
+	m_white			= offset("W");
+	m_colorWheel	= offset("color");
+	m_dimmer		= offset("dimmer");
+
+	float gamma			= 1.0f;
+	float dimmerGamma	= 1.0f;
+	util::setValueFromJson(description, "gamma",		gamma);
+	util::setValueFromJson(description, "dimmerGamma",	dimmerGamma);
+
+	createHueLookUp(m_amber >= 0);
+	createCurve(m_colorCurve, gamma);
+	createCurve(m_dimmerCurve, dimmerGamma);
+
+	m_colorWheelLookUp.fill(0);
+	if (m_colorWheel >= 0 && description.contains("colorMap"))
+		createColorWheelLookUp(description["colorMap"]);
+}
+
+act::room::DMXColorProfile::~DMXColorProfile()
+{
+}
+
+void act::room::DMXColorProfile::convert(const ci::Color* colors, const float* dimmers, const int* startAddresses, size_t count, std::vector<int>& channels, std::vector<unsigned char>& values) const
+{
+	auto emit = [&](int start, int offset, int value) {
+		if (offset < 0)
+			return;
+		channels.push_back(start + offset);
+		values.push_back((unsigned char)std::clamp(value, 0, 255));
+	};
+
+	for (size_t i = 0; i < count; i++) {
+		const ci::Color& color = colors[i];
+		int start = startAddresses[i];
+
+		// rgb to hsv, see ci::rgbToHsv
+		float max	= std::max(color.r, std::max(color.g, color.b));
+		float min	= std::min(color.r, std::min(color.g, color.b));
+		float delta	= max - min;
+
+		float hue = 0.0f;
+		if (delta > 0.0f) {
+			if (max == color.r)
+				hue = (color.g - color.b) / delta;
+			else if (max == color.g)
+				hue = 2.0f + (color.b - color.r) / delta;
+			else
+				hue = 4.0f + (color.r - color.g) / delta;
+			hue /= 6.0f;
+			if (hue < 0.0f)
+				hue += 1.0f;
+		}
+		float saturation	= max > 0.0f ? delta / max : 0.0f;
+		float value			= max;
+
+		float chroma	= value * saturation;
+		float white		= value * (1.0f - saturation);
+		int degree		= std::clamp((int)(hue * 360.0f), 0, 359);
+
+		if (m_colorWheel >= 0) {
+			int wheelValue = m_whiteColorWheelValue >= 0 && saturation <= 0.1f ? m_whiteColorWheelValue : m_colorWheelLookUp[std::clamp((int)(hue * 255), 0, 255)];
+			emit(start, m_colorWheel, wheelValue);
+		}
+		else {
+			emit(start, m_red,		m_colorCurve[std::clamp((int)(chroma * m_hueRed[degree] * 255), 0, 255)]);
+			emit(start, m_green,	m_colorCurve[std::clamp((int)((chroma * m_hueGreen[degree] + m_hueGreenOffset[degree]) * 255), 0, 255)]);
+			emit(start, m_blue,		m_colorCurve[std::clamp((int)(chroma * m_hueBlue[degree] * 255), 0, 255)]);
+		}
+		emit(start, m_white,	m_colorCurve[std::clamp((int)(white * 255), 0, 255)]);
+		emit(start, m_amber,	m_colorCurve[std::clamp((int)(chroma * m_hueAmber[degree] * 255), 0, 255)]);
+
+		emit(start, m_dimmer,	m_dimmerCurve[std::clamp((int)(dimmers[i] * 255), 0, 255)]);
+	}
+}
+
+void act::room::DMXColorProfile::createHueLookUp(bool hasAmber)
+{
+	// same segments as RGBAWHelper::RGBtoRGBAW() and RGBtoRGBW(), evaluated for a chroma of 1
+	for (int degree = 0; degree < 360; degree++) {
+		float p = (degree % 60) / 60.0f;
+		int s	= degree / 60;
+
+		float r = 0, g = 0, b = 0, a = 0, gOffset = 0;
+		if (s < 1) {
+			if (hasAmber) {
+				r = 1 - p * amber_r;
+				g = p * (1 - amber_g);
+				a = p;
+			}
+			else {
+				r = 1;
+				g = p;
+			}
+		}
+		else if (s < 2) {
+			if (hasAmber) {
+				r = (1 - p) * (1 - amber_r);
+				g = p * amber_g;
+				gOffset = 1 - amber_g;
+				a = 1 - p;
+			}
+			else {
+				r = 1 - p;
+				g = 1;
+			}
+		}
+		else if (s < 3) {
+			g = 1;
+			b = p;
+		}
+		else if (s < 4) {
+			g = 1 - p;
+			b = 1;
+		}
+		else if (s < 5) {
+			r = p;
+			b = 1;
+		}
+		else {
+			r = 1;
+			b = 1 - p;
+		}
+
+		m_hueRed[degree]			= r;
+		m_hueGreen[degree]			= g;
+		m_hueBlue[degree]			= b;
+		m_hueAmber[degree]			= a;
+		m_hueGreenOffset[degree]	= gOffset;
+	}
+}
+
+void act::room::DMXColorProfile::createColorWheelLookUp(ci::Json colorMap)
+{
+	std::map<int, int> hueToVal;
+	m_whiteColorWheelValue = -1;
+
+	for (auto color : colorMap["colors"]) {
+		if (color.find("value") == color.end())
+			continue;
+		int value = color["value"];
+
+		ci::Color rgb = ci::Color(color["R"], color["G"], color["B"]);
+		vec3 hsv = ci::rgbToHsv(rgb);
+
+		if (hsv.y <= 0.05f) {
+			m_whiteColorWheelValue = value;
+			continue;
+		}
+
+		hueToVal[hsv.x * 255] = value;
+	}
+	if (hueToVal.empty())
+		return;
+
+	// every hue takes the nearest slot of the wheel, wrapping around at red
+	int mapHue = 0;
+	for (auto entry = hueToVal.begin(); entry != hueToVal.end(); ++entry) {
+		auto nextEntry = std::next(entry);
+		if (nextEntry == hueToVal.end())
+			nextEntry = hueToVal.begin();
+
+		int currentHue	= entry->first;
+		int nextHue		= nextEntry->first;
+		if (nextHue <= currentHue) // next is the first entry again
+			nextHue += 255;
+
+		int halfHue = (currentHue + nextHue) / 2;
+
+		for (; mapHue < halfHue && mapHue <= 255; mapHue++)
+			m_colorWheelLookUp[mapHue] = entry->second;
+		for (; mapHue < nextHue && mapHue <= 255; mapHue++)
+			m_colorWheelLookUp[mapHue] = nextEntry->second;
+	}
+	for (; mapHue <= 255; mapHue++)
+		m_colorWheelLookUp[mapHue] = hueToVal.begin()->second;
+}
+
+void act::room::DMXColorProfile::createCurve(std::array<unsigned char, 256>& curve, float gamma)
+{
+	gamma = std::max(0.01f, gamma);
+	for (int i = 0; i < 256; i++) {
+		curve[i] = (unsigned char)std::clamp((int)std::round(powf(i / 255.0f, gamma) * 255.0f), 0, 255);
+	}
+}
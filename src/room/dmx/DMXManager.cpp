@@ -32,6 +32,9 @@ act::room::DMXManager::DMXManager()
 	m_fixtureNames = std::vector<std::string>(0);
 	m_availableDeviceNames = std::vector<std::string>(0);
 
+	m_movingHeadSolver = MovingHeadSolver::create();
+	m_movingHeadPlanner = MovingHeadPlanner::create();
+
 	refreshInterfaceNames();
 	loadFixtures();
 	refreshLists();
@@ -39,17 +42,29 @@ act::room::DMXManager::DMXManager()
 
 act::room::DMXManager::~DMXManager()
 {	
+	m_movingHeadPlanner->stop();
 }
 
 void act::room::DMXManager::setup()
 {
+	m_movingHeadPlanner->start();
+}
+
+void act::room::DMXManager::update()
+{
+	RoomNodeManagerBase::update();
+	updateMovingHeads();
+	updateColors();
 }
 
 void act::room::DMXManager::cleanUp()
 {
+	m_movingHeadPlanner->stop();
+
 	for (auto&& node : m_nodes) {
 		node->cleanUp();
 	}
+	updateColors();
 }
 
 act::room::RoomNodeBaseRef act::room::DMXManager::drawMenu()
@@ -66,6 +81,11 @@ act::room::RoomNodeBaseRef act::room::DMXManager::drawMenu()
 		}
 	}
 
+	float lead = m_movingHeadPlanner->getLead() * 1000.0f;
+	if (ImGui::DragFloat("tracking latency (ms)", &lead, 1.0f, 0.0f, 500.0f)) {
+		m_movingHeadPlanner->setLead(lead * 0.001f);
+	}
+
 	//ImGui::SetNextItemWidth(m_displaySize.x - ImGui::CalcTextSize("Device").x);
 	ImGui::Combo("Device", &m_selectedFixture, m_fixtureNames);
 	if (ImGui::InputInt("address", &m_currentAddress)) {
@@ -113,6 +133,7 @@ ci::Json act::room::DMXManager::toJson()
 
 	if(m_dmxInterface)
 		json["interfaceName"] = m_dmxInterface->getDeviceName();
+	json["trackingLatency"] = m_movingHeadPlanner->getLead();
 
 	ci::Json nodes = ci::Json::array();
 	for (auto&& node : m_nodes) {
@@ -148,6 +169,10 @@ void act::room::DMXManager::fromJson(ci::Json json)
 			m_selectedInterface = -1;
 		}
 	}
+	float lead = 0.0f;
+	if (util::setValueFromJson(json, "trackingLatency", lead)) {
+		m_movingHeadPlanner->setLead(lead);
+	}
 	if (json.contains("nodes")) {
 		auto nodesJson = json["nodes"];
 		for (auto&& node : nodesJson) {
@@ -188,6 +213,8 @@ void act::room::DMXManager::changeInterface(std::string interfaceName)
 		m_dmxInterface.reset();
 
 	m_dmxInterface = DMXPro::create(interfaceName);
+	if (m_movingHeadPlanner)
+		m_movingHeadPlanner->setDMXInterface(m_dmxInterface);
 }
 
 void act::room::DMXManager::loadFixtures()
@@ -201,11 +228,13 @@ void act::room::DMXManager::loadFixtures()
 
 	m_fixtureDescriptions.clear();
 	m_fixtureNames.clear();
+	m_colorProfiles.clear();
 	ci::Json fixtureDescriptions = ci::loadJson(loadFile(path));
 
 	int smallestID = INT_MAX;
 	for (auto&& desc : fixtureDescriptions["devices"]) {
 		m_fixtureDescriptions.push_back(desc);
+		m_colorProfiles.push_back(DMXColorProfile::create(desc));
 		std::string name = desc["name"];
 		m_fixtureNames.push_back(name);
 		CI_LOG_I("loaded Fixture: " << name);
@@ -262,11 +291,102 @@ int act::room::DMXManager::getFixtureIndexByName(std::string fixtureName)
 void act::room::DMXManager::refreshLists()
 {
 	m_availableDeviceNames.clear();
+	m_movingHeads.clear();
+	m_colorGroups.clear();
 	for (auto&& device : m_nodes) {
 		m_availableDeviceNames.push_back(device->getName());
+
+		auto mh = std::dynamic_pointer_cast<act::room::MovingHeadRoomNode>(device);
+		if (mh)
+			m_movingHeads.push_back(mh);
+
+		auto dmxDevice = std::dynamic_pointer_cast<act::room::DMXRoomNodeBase>(device);
+		if (dmxDevice && dmxDevice->getColorProfile()) {
+			auto profile = dmxDevice->getColorProfile();
+			auto group = std::find_if(m_colorGroups.begin(), m_colorGroups.end(), [&](auto& g) { return g.first == profile; });
+			if (group == m_colorGroups.end()) {
+				m_colorGroups.emplace_back(profile, std::vector<DMXRoomNodeBase*>());
+				group = std::prev(m_colorGroups.end());
+			}
+			group->second.push_back(dmxDevice.get());
+		}
+	}
+
+	m_movingHeadSolver->resize(m_movingHeads.size());
+	m_movingHeadPlanner->resize(m_movingHeads.size());
+	for (size_t i = 0; i < m_movingHeads.size(); i++) {
+		auto calibration = m_movingHeads[i]->syncCalibration();
+		m_movingHeadSolver->setFixture(i, calibration);
+		m_movingHeadPlanner->setFixture(i, calibration);
+		m_movingHeadPlanner->setCurrent(i, m_movingHeads[i]->getPan(), m_movingHeads[i]->getTilt());
 	}
 }
 
+void act::room::DMXManager::updateMovingHeads()
+{
+	bool hasTargets = false;
+	for (size_t i = 0; i < m_movingHeads.size(); i++) {
+		auto& mh = m_movingHeads[i];
+		if (mh->isCalibrationDirty()) {
+			auto calibration = mh->syncCalibration();
+			m_movingHeadSolver->setFixture(i, calibration);
+			m_movingHeadPlanner->setFixture(i, calibration);
+		}
+
+		if (mh->hasPendingLookAt()) {
+			m_movingHeadSolver->setCurrent(i, mh->getPan(), mh->getTilt());
+			m_movingHeadSolver->setTarget(i, mh->getLookAt());
+			hasTargets = true;
+		}
+		else if (!m_movingHeadPlanner->isGoal(i, mh->getPan(), mh->getTilt())) { // set manually, dmx-data is already written
+			m_movingHeadPlanner->setCurrent(i, mh->getPan(), mh->getTilt());
+		}
+	}
+
+	if (!hasTargets)
+		return;
+
+	m_movingHeadSolver->solve();
+
+	for (size_t i = 0; i < m_movingHeads.size(); i++) {
+		if (!m_movingHeadSolver->isSolved(i))
+			continue;
+
+		float pan	= m_movingHeadSolver->getPan(i);
+		float tilt	= m_movingHeadSolver->getTilt(i);
+		m_movingHeadPlanner->setGoal(i, pan, tilt);
+		m_movingHeads[i]->applySolvedPanTilt(pan, tilt);
+	}
+}
+
+void act::room::DMXManager::updateColors()
+{
+	m_colorOutChannels.clear();
+	m_colorOutValues.clear();
+
+	// all dirty devices of one fixture type are converted in one go, the universe is written once
+	for (auto&& [profile, devices] : m_colorGroups) {
+		m_colorIn.clear();
+		m_dimmerIn.clear();
+		m_addressIn.clear();
+
+		for (auto&& device : devices) {
+			if (!device->isColorDirty())
+				continue;
+			device->clearColorDirty();
+
+			m_colorIn.push_back(device->getColorOutput());
+			m_dimmerIn.push_back(device->getDimmerOutput());
+			m_addressIn.push_back(device->getStartAddress());
+		}
+
+		if (!m_colorIn.empty())
+			profile->convert(m_colorIn.data(), m_dimmerIn.data(), m_addressIn.data(), m_colorIn.size(), m_colorOutChannels, m_colorOutValues);
+	}
+
+	if (m_dmxInterface && !m_colorOutChannels.empty())
+		m_dmxInterface->setValues(m_colorOutChannels.data(), m_colorOutValues.data(), m_colorOutChannels.size());
+}
  
 act::room::RoomNodeBaseRef act::room::DMXManager::addDevice(std::string name, int fixtureIndex, int startAddress)
 {
@@ -281,6 +401,10 @@ act::room::RoomNodeBaseRef act::room::DMXManager::addDevice(std::string name, in
 		node = DimmerRoomNode::create(m_dmxInterface, description, name, startAddress);
 	}
 	if (node) {
+		auto dmxDevice = std::dynamic_pointer_cast<act::room::DMXRoomNodeBase>(node);
+		if (dmxDevice)
+			dmxDevice->setColorProfile(m_colorProfiles[fixtureIndex]);
+
 		m_nodes.push_back(node);
 		refreshLists();
 		return node;
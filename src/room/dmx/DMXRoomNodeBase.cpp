@@ -64,3 +64,18 @@ bool act::room::DMXRoomNodeBase::setValue(std::string channel, int value)
 		return false;
 	}
 }
+
+int act::room::DMXRoomNodeBase::getChannelAddress(const std::string& channel)
+{
+	auto it = m_channelMapping.find(channel);
+	if (it == m_channelMapping.end())
+		return -1;
+	return it->second - 1 + m_startAddress;
+}
+
+void act::room::DMXRoomNodeBase::setColorOutput(ci::Color color, float dimmer)
+{
+	m_colorOutput	= color;
+	m_dimmerOutput	= dimmer;
+	m_isColorDirty	= true;
+}
@@ -113,6 +113,6 @@ void act::room::DimmerRoomNode::fromParams(ci::Json json)
 void act::room::DimmerRoomNode::setDimmer(float dim)
 {
 	m_dimmer.setValue(dim);
-	setValue("dimmer", m_dimmer.getValue() * 255);
+	setColorOutput(ci::Color::white(), m_dimmer.getValue());
 }
  
@@ -0,0 +1,289 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "dmx/MovingHeadPlanner.hpp"
+
+#include <chrono>
+
+
+act::room::MovingHeadPlanner::MovingHeadPlanner()
+{
+}
+
+act::room::MovingHeadPlanner::~MovingHeadPlanner()
+{
+	stop();
+}
+
+void act::room::MovingHeadPlanner::start(int rate)
+{
+	if (m_isRunning)
+		return;
+
+	m_isRunning = true;
+	m_thread = std::thread([this, rate]() {
+		auto interval	= std::chrono::microseconds(1000000 / std::max(1, rate));
+		auto next		= std::chrono::steady_clock::now();
+		double last		= now();
+
+		while (m_isRunning) {
+			next += interval;
+
+			double current = now();
+			step((float)(current - last));
+			last = current;
+
+			std::this_thread::sleep_until(next);
+		}
+		});
+}
+
+void act::room::MovingHeadPlanner::stop()
+{
+	m_isRunning = false;
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+void act::room::MovingHeadPlanner::setDMXInterface(DMXProRef dmxInterface)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_dmxInterface = dmxInterface;
+}
+
+void act::room::MovingHeadPlanner::resize(size_t count)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_heads.resize(count);
+	m_outChannels.reserve(count * 4);
+	m_outValues.reserve(count * 4);
+}
+
+void act::room::MovingHeadPlanner::setFixture(size_t index, const MovingHeadCalibration& calibration)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (index >= m_heads.size())
+		return;
+
+	Head& head = m_heads[index];
+	head.pan.max			= calibration.panRange;
+	head.pan.maxVel			= calibration.maxPanSpeed;
+	head.pan.maxAcc			= calibration.maxPanAcceleration;
+	head.tilt.max			= calibration.tiltRange;
+	head.tilt.maxVel		= calibration.maxTiltSpeed;
+	head.tilt.maxAcc		= calibration.maxTiltAcceleration;
+
+	head.tiltOffset			= calibration.tiltOffset;
+	head.isPanFlipped		= calibration.isPanFlipped;
+	head.isTiltFlipped		= calibration.isTiltFlipped;
+
+	head.panChannel			= calibration.panChannel;
+	head.finePanChannel		= calibration.finePanChannel;
+	head.tiltChannel		= calibration.tiltChannel;
+	head.fineTiltChannel	= calibration.fineTiltChannel;
+}
+
+void act::room::MovingHeadPlanner::setGoal(size_t index, float pan, float tilt)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (index >= m_heads.size())
+		return;
+
+	Head& head = m_heads[index];
+
+	double current	= now();
+	float dt		= (float)(current - head.goalTime);
+	head.goalTime	= current;
+	if (dt > m_maxExtrapolation) // the first goal after a pause has no usable velocity
+		dt = 0.0f;
+
+	head.pan.setGoal(pan, dt);
+	head.tilt.setGoal(tilt, dt);
+
+	// slow down the faster axis, so that both arrive at the same time
+	float panTime	= head.pan.minTime(fabsf(head.pan.goal - head.pan.pos));
+	float tiltTime	= head.tilt.minTime(fabsf(head.tilt.goal - head.tilt.pos));
+	float duration	= std::max(panTime, tiltTime);
+
+	head.pan.scale	= duration > 0.0f && panTime > 0.0f		? std::max(0.05f, panTime / duration)	: 1.0f;
+	head.tilt.scale	= duration > 0.0f && tiltTime > 0.0f	? std::max(0.05f, tiltTime / duration)	: 1.0f;
+}
+
+void act::room::MovingHeadPlanner::setCurrent(size_t index, float pan, float tilt)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (index >= m_heads.size())
+		return;
+
+	Head& head = m_heads[index];
+	head.pan.pos		= head.pan.goal		= pan;
+	head.tilt.pos		= head.tilt.goal	= tilt;
+	head.pan.vel		= head.tilt.vel		= 0.0f;
+	head.pan.goalVel	= head.tilt.goalVel	= 0.0f;
+	head.pan.isMoving	= head.tilt.isMoving = false;
+}
+
+bool act::room::MovingHeadPlanner::isGoal(size_t index, float pan, float tilt)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (index >= m_heads.size())
+		return false;
+
+	return fabsf(m_heads[index].pan.goal - pan) < 0.01f && fabsf(m_heads[index].tilt.goal - tilt) < 0.01f;
+}
+
+float act::room::MovingHeadPlanner::getPan(size_t index)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return index < m_heads.size() ? m_heads[index].pan.pos : 0.0f;
+}
+
+float act::room::MovingHeadPlanner::getTilt(size_t index)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return index < m_heads.size() ? m_heads[index].tilt.pos : 0.0f;
+}
+
+void act::room::MovingHeadPlanner::step(float dt)
+{
+	if (dt <= 0.0f)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_outChannels.clear();
+	m_outValues.clear();
+
+	double current = now();
+	float lead = m_lead;
+
+	for (auto&& head : m_heads) {
+		if (!head.pan.isMoving && !head.tilt.isMoving)
+			continue;
+
+		// predict where the goal is by now plus the tracking latency,
+		// without new goals for a while the target is assumed to stand still
+		float sinceGoal = (float)(current - head.goalTime);
+		if (sinceGoal > m_maxExtrapolation) {
+			head.pan.goalVel	= 0.0f;
+			head.tilt.goalVel	= 0.0f;
+		}
+		float ahead = lead + sinceGoal;
+
+		bool changed = head.pan.step(head.pan.goal + head.pan.goalVel * ahead, dt);
+		changed = head.tilt.step(head.tilt.goal + head.tilt.goalVel * ahead, dt) || changed;
+
+		if (changed)
+			emit(head);
+	}
+
+	if (m_dmxInterface && !m_outChannels.empty())
+		m_dmxInterface->setValues(m_outChannels.data(), m_outValues.data(), m_outChannels.size());
+}
+
+double act::room::MovingHeadPlanner::now()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void act::room::MovingHeadPlanner::emit(const Head& head)
+{
+	int coarse, fine;
+
+	MovingHeadSolver::encode16(MovingHeadSolver::panToNormalized(head.pan.pos, head.pan.max, head.isPanFlipped), coarse, fine);
+	emitChannel(head.panChannel, coarse);
+	emitChannel(head.finePanChannel, fine);
+
+	MovingHeadSolver::encode16(MovingHeadSolver::tiltToNormalized(head.tilt.pos, head.tiltOffset, head.tilt.max, head.isTiltFlipped), coarse, fine);
+	emitChannel(head.tiltChannel, coarse);
+	emitChannel(head.fineTiltChannel, fine);
+}
+
+void act::room::MovingHeadPlanner::emitChannel(int channel, int value)
+{
+	if (channel < 0)
+		return;
+
+	m_outChannels.push_back(channel);
+	m_outValues.push_back((unsigned char)value);
+}
+
+void act::room::MovingHeadPlanner::Axis::setGoal(float value, float dt)
+{
+	// a jump of more than half a turn is the solver switching sides, not a moving target
+	if (dt > 0.0001f && fabsf(value - goal) < 180.0f)
+		goalVel = goalVel + 0.5f * ((value - goal) / dt - goalVel);
+	else
+		goalVel = 0.0f;
+
+	goal		= value;
+	isMoving	= true;
+}
+
+float act::room::MovingHeadPlanner::Axis::minTime(float distance)
+{
+	if (maxVel <= 0.0f)
+		return 0.0f;
+	if (maxAcc <= 0.0f)
+		return distance / maxVel;
+
+	// trapezoidal profile from rest to rest, triangular if the distance is too short to reach maxVel
+	if (distance < maxVel * maxVel / maxAcc)
+		return 2.0f * sqrtf(distance / maxAcc);
+	return distance / maxVel + maxVel / maxAcc;
+}
+
+bool act::room::MovingHeadPlanner::Axis::step(float target, float dt)
+{
+	target = std::clamp(target, min, max);
+	float err = target - pos;
+
+	if (maxVel <= 0.0f) { // unlimited, jump
+		bool changed = err != 0.0f;
+		pos			= target;
+		vel			= 0.0f;
+		isMoving	= goalVel != 0.0f;
+		return changed;
+	}
+
+	float vMax = maxVel * scale;
+	float aMax = maxAcc > 0.0f ? maxAcc * scale * scale : FLT_MAX;
+
+	if (fabsf(err) < 0.001f && fabsf(vel) <= aMax * dt) {
+		bool changed = err != 0.0f;
+		pos			= target;
+		vel			= 0.0f;
+		isMoving	= goalVel != 0.0f;
+		return changed;
+	}
+
+	// fastest velocity that still allows to brake in time
+	float vStop	= aMax < FLT_MAX ? sqrtf(2.0f * aMax * fabsf(err)) : vMax;
+	float vDes	= copysignf(std::min(vMax, vStop), err);
+	float dv	= aMax < FLT_MAX ? std::clamp(vDes - vel, -aMax * dt, aMax * dt) : vDes - vel;
+	vel += dv;
+
+	float delta = vel * dt;
+	if (fabsf(delta) >= fabsf(err) && (delta > 0.0f) == (err > 0.0f)) {
+		pos = target;
+		vel = 0.0f;
+	}
+	else {
+		pos = std::clamp(pos + delta, min, max);
+	}
+	return true;
+}
@@ -18,8 +18,6 @@
 #include "roompch.hpp"
 #include "dmx/MovingHeadRoomNode.hpp"
 
-#include "RGBAWHelper.h"
-
 act::room::MovingHeadRoomNode::MovingHeadRoomNode(DMXProRef dmxInterface, ci::Json description, std::string name, int startAddress, ci::vec3 position, ci::vec3 rotation, float radius, act::UID replyUID)
 	: DMXRoomNodeBase(dmxInterface, description, startAddress), RoomNodeBase("movinghead", position, rotation, radius, replyUID)
 {
@@ -29,6 +27,11 @@ act::room::MovingHeadRoomNode::MovingHeadRoomNode(DMXProRef dmxInterface, ci::Js
 	util::setValueFromJson(description, "beamAngle",	m_beamAngle);
 	util::setValueFromJson(description, "strobeSpeed",	m_strobeSpeed);
 
+	util::setValueFromJson(description, "maxPanSpeed",			m_maxPanSpeed);
+	util::setValueFromJson(description, "maxTiltSpeed",			m_maxTiltSpeed);
+	util::setValueFromJson(description, "maxPanAcceleration",	m_maxPanAcceleration);
+	util::setValueFromJson(description, "maxTiltAcceleration",	m_maxTiltAcceleration);
+
 	m_hasFineAdjust = m_channelMapping.find("finePan")	!= m_channelMapping.end() && m_channelMapping.find("fineTilt") != m_channelMapping.end();
 	m_hasWhite		= m_channelMapping.find("W")		!= m_channelMapping.end();
 	m_hasAmber		= m_channelMapping.find("A")		!= m_channelMapping.end();
@@ -72,16 +75,9 @@ act::room::MovingHeadRoomNode::MovingHeadRoomNode(DMXProRef dmxInterface, ci::Js
 		m_goboShake = util::MinMaxValue<float>(0.0f, 1.0f);
 	}
 
-	if (m_hasColorWheel) {
-		createColorWheelLookUp(description["colorMap"]);
-	}
-
 	m_color = ci::Color::white();
 	m_colorPreHighlight = ci::Color::white();
 
-	m_gaze = glm::quat(m_upDir);
-	m_previousGaze = glm::quat(m_upDir);
-
 	m_lookAtFlt = OneEuroFilterV3::create(3.0f, 0.006f, 3.0f, 100.0f);
 
 	//m_triMesh = ci::TriMesh::create(ci::geom::Cone()); // m_triMesh is for intersection
@@ -216,12 +212,14 @@ void act::room::MovingHeadRoomNode::drawSpecificSettings()
 	ImGui::SameLine();
 	if (ImGui::Checkbox("pan is flipped", &m_isPanFlipped)) {
 		//m_upDir.y = -m_upDir.y;
+		m_isCalibrationDirty = true;
 		if (m_isLookingAt) // refresh
 			lookAt(m_lookAt);
 	}
 	ImGui::SameLine();
 	if (ImGui::Checkbox("tilt is flipped", &m_isTiltFlipped)) {
 		//m_upDir.y = -m_upDir.y;
+		m_isCalibrationDirty = true;
 		if (m_isLookingAt) // refresh
 			lookAt(m_lookAt);
 	}
@@ -323,6 +321,7 @@ void act::room::MovingHeadRoomNode::fromParams(ci::Json json)
 	util::setValueFromJson(json, "uv",				m_UV.value);
 	util::setValueFromJson(json, "isPanFlipped",	m_isPanFlipped);
 	util::setValueFromJson(json, "isTiltFlipped",	m_isTiltFlipped);
+	m_isCalibrationDirty = true;
 	
 	int startAdress = 0; 
 	if (util::setValueFromJson(json, "startAddress", startAdress)) {
@@ -330,7 +329,8 @@ void act::room::MovingHeadRoomNode::fromParams(ci::Json json)
 	}
 
 	ci::vec3 lookAtVec;
-	if (util::setValueFromJson(json, "lookAt", lookAtVec)) {
+	bool hasLookAt = util::setValueFromJson(json, "lookAt", lookAtVec);
+	if (hasLookAt) {
 			lookAt(lookAtVec);
 	}
 
@@ -344,7 +344,8 @@ void act::room::MovingHeadRoomNode::fromParams(ci::Json json)
 	setDimmer(m_dimmer.getValue(), false);
 	setZoom(m_zoom.getValue(), false);
 
-	setPanTilt(m_pan.getValue(), m_tilt.getValue());
+	if (!hasLookAt) // otherwise pan/tilt gets solved from lookAt
+		setPanTilt(m_pan.getValue(), m_tilt.getValue());
 
 	setColor(m_color, false);
 
@@ -357,59 +358,15 @@ void act::room::MovingHeadRoomNode::fromParams(ci::Json json)
 void act::room::MovingHeadRoomNode::setColor(ci::Color color, bool publish)
 {
 	m_color = color;
-	RGBAWColor col;
-	if (m_hasAmber) {
-		col = RGBAWHelper::RGBtoRGBAW(color);
-	}
-	else {
-		col = RGBAWHelper::RGBtoRGBW(color);
-	}
-	
-	if (m_hasColorWheel) {
-		vec3 hsv = ci::rgbToHsv(m_color);
-		int wheelValue = 0;
-		if (m_hasWhiteColorWheel && hsv.y <= 0.1f)
-			wheelValue = m_whiteColorWheelValue;
-		else
-			wheelValue = m_colorWheelLookUp[hsv.x * 255];
-
-		setValue("color", wheelValue);
-		m_dimmerMul.setValue(hsv.z);
-		setDimmer(m_dimmer.value);
-	}
-	else {
-		setValue("R", col.r);
-		setValue("G", col.g);
-		setValue("B", col.b);
-	}
-	if (m_hasWhite)
-		setValue("W", col.w);
-	if (m_hasAmber)
-		setValue("A", col.a);
-
-	if(publish)
-		publishParam("color", util::valueToJson(m_color));
-}
-
-glm::vec3 toPitchYawRoll(glm::quat data)
-{
-	glm::vec3 ans;
 
-	double q2sqr = data.y * data.y;
-	double t0 = -2.0 * (q2sqr + data.z * data.z) + 1.0;
-	double t1 = +2.0 * (data.x * data.y + data.w * data.z);
-	double t2 = -2.0 * (data.x * data.z - data.w * data.y);
-	double t3 = +2.0 * (data.y * data.z + data.w * data.x);
-	double t4 = -2.0 * (data.x * data.x + q2sqr) + 1.0;
+	if (m_hasColorWheel) // the wheel only selects the hue, the brightness goes to the dimmer
+		m_dimmerMul.setValue(std::max(color.r, std::max(color.g, color.b)));
 
-	t2 = t2 > 1.0 ? 1.0 : t2;
-	t2 = t2 < -1.0 ? -1.0 : t2;
+	// converted and written together with all other fixtures by the DMXManager
+	setColorOutput(m_color, m_dimmer.getValue() * m_dimmerMul.getValue());
 
-	ans.y = asin(t2);
-	ans.x = atan2(t3, t4);
-	ans.z = atan2(t1, t0);
-
-	return ans;
+	if(publish)
+		publishParam("color", util::valueToJson(m_color));
 }
 
 void act::room::MovingHeadRoomNode::lookAt(ci::vec3 at)
@@ -424,35 +381,8 @@ void act::room::MovingHeadRoomNode::lookAt(ci::vec3 at)
 		m_lookAt = at;
 	}
 
-	// m_position + glm::normalize(m_orientation * m_frontDir))
-
-	vec3 atVec = glm::normalize(m_lookAt - m_position);
-	m_gaze = util::rotationBetween(m_frontDir, atVec);
-	if (isnan(m_gaze.w)) {
-		m_gaze = m_previousGaze;
-	}
-
-	vec3 right = glm::cross(atVec, m_upDir);
-	vec3 up = glm::cross(right, atVec);
-	if (length(up) > 0.0f) { // otherwise rotationBetween will become nan
-		vec3 newUp = m_gaze * m_upDir;
-		quat upCorrection = util::rotationBetween(newUp, up);
-		m_gaze = upCorrection * m_gaze;
-	}
-	m_gaze = glm::inverse(m_orientation) * m_gaze;
-
-	vec3 gazeFront = glm::normalize(m_gaze * m_frontDir);
-	m_phi		= atan2(gazeFront.x, gazeFront.z);
-	m_theta		= acos(gazeFront.y / length(gazeFront));
-	
-	vec3 gaze = glm::eulerAngles(util::rotationBetween(m_frontDir, glm::normalize(m_gaze * m_frontDir)));
-	m_pitch = gaze.x;
-	m_yaw = gaze.y;
-	// float roll	= gaze.z;
- 
-
-	if(!polarToPanTilt()) { // this sets the dmx-data
-	}
+	// pan/tilt are solved for all moving heads at once in DMXManager::update(), the dmx-data is set by its planner
+	m_hasPendingLookAt = true;
 
 	m_cameraPersp.lookAt(m_lookAt);
 	publishChanges("lookAt", util::valueToJson(m_lookAt));
@@ -460,28 +390,30 @@ void act::room::MovingHeadRoomNode::lookAt(ci::vec3 at)
 
 void act::room::MovingHeadRoomNode::setPan(float pan)
 {
+	m_hasPendingLookAt = false;
 	panTo(pan);
-	//panTiltToYawPitch();
+	panTiltToPolar();
 }
 
 void act::room::MovingHeadRoomNode::setTilt(float tilt)
 {
+	m_hasPendingLookAt = false;
 	tiltTo(tilt);
-	//panTiltToYawPitch();
+	panTiltToPolar();
 }
 
 void act::room::MovingHeadRoomNode::setPanTilt(float pan, float tilt)
 {
+	m_hasPendingLookAt = false;
 	panTo(pan);
 	tiltTo(tilt);
-
-	//panTiltToYawPitch();
+	panTiltToPolar();
 }
 
 void act::room::MovingHeadRoomNode::setDimmer(float dim, bool publish)
 {
 	m_dimmer.setValue(dim);
-	setValue("dimmer", (m_dimmer.getValue() * m_dimmerMul.getValue()) * 255);
+	setColorOutput(m_color, m_dimmer.getValue() * m_dimmerMul.getValue());
 }
 
 void act::room::MovingHeadRoomNode::setSpeed(float speed)
@@ -523,83 +455,6 @@ void act::room::MovingHeadRoomNode::home()
 	setZoom(0.0f);
 }
 
-void act::room::MovingHeadRoomNode::createColorWheelLookUp(ci::Json colorMap)
-{
-	//if (!colorMap)
-	//	return;
-
-	std::map<int, int> hueToVal;
-	m_hasWhiteColorWheel = false;
-	m_whiteColorWheelValue = -1;
-
-	for (auto color : colorMap["colors"]) {
-		if (color.find("value") == color.end())
-			continue;
-		int value = color["value"];
-
-		ci::Color rgb = ci::Color(color["R"], color["G"], color["B"]);
-		vec3 hsv = ci::rgbToHsv(rgb);
-
-		if (hsv.y <= 0.05f) {
-			m_hasWhiteColorWheel = true;
-			m_whiteColorWheelValue = value;
-			continue;
-		}
-
-		hueToVal[hsv.x * 255] = value;
-	}
-	int mapHue = 0;
-	for (auto entry = hueToVal.begin(); entry != hueToVal.end(); ++entry) {
-		auto current	= *entry;
-		auto nextEntry	= ++entry;
-		if(nextEntry == hueToVal.end())
-			nextEntry	= hueToVal.begin();
-		auto next		= *nextEntry;
-
-		int currentHue	= current.first;
-		int nextHue		= next.first;
-		int currentVal  = current.second;
-		int nextVal		= next.second;
-		
-		if (nextHue < currentHue) { // assume that next is the first entry again
-			nextHue += 255;
-		}
-
-		int halfHue = (currentHue + nextHue) * 0.5f;
-
-		for (mapHue; mapHue < halfHue && mapHue <= 255; mapHue++) {
-			m_colorWheelLookUp[mapHue] = currentVal;
-		}
-		for (mapHue; mapHue < nextHue && mapHue <= 255; mapHue++) {
-			m_colorWheelLookUp[mapHue] = nextVal;
-		}
-
-		if (entry == hueToVal.end())
-			break;
-	}
-}
-
-bool act::room::MovingHeadRoomNode::polarToPanTilt()
-{
-	float tilt	= toDegrees(m_theta)	+ 90	+ m_tiltCenterOffset;	// shift to middle position and add offset
-	float pan	= toDegrees(m_phi)		+ 180	+ m_panCenterOffset;	// shift to middle position and add offset
-
-	if (pan > (m_panCenterOffset + 360.0f))
-		pan -= (m_panRange - m_panCenterOffset);
-
-	if (tilt >= 360.0f - m_tiltCenterOffset)
-		tilt = m_theta - (360.0f - m_tiltCenterOffset);
-
-	setPanTilt(pan, tilt);
-
-	if (pan >= 0.0f && tilt >= 0.0f && pan <= m_panRange && tilt <= m_tiltRange)
-		return true;
-	else {
-		//panTiltToYawPitch();
-		return false;
-	}
-}
-
 void act::room::MovingHeadRoomNode::panTiltToPolar()
 {
 	m_theta		= toRadians(m_tilt.getValue() - 90	- m_tiltCenterOffset);
@@ -612,17 +467,13 @@ void act::room::MovingHeadRoomNode::panTiltToPolar()
 void act::room::MovingHeadRoomNode::panTo(float pan)
 {
 	m_pan.setValue(fmodf(pan, (float)m_panRange));
-	
-	double panRough = ((double)m_pan.getValue() / (double)m_panRange);
-	if (m_isPanFlipped) {
-		panRough = 1.0f - panRough;
-	}
-	panRough *= 255;
-	setValue("pan", (int)floor(panRough));
+
+	int coarse, fine;
+	MovingHeadSolver::encode16(MovingHeadSolver::panToNormalized(m_pan.getValue(), m_panRange, m_isPanFlipped), coarse, fine);
+	setValue("pan", coarse);
 
 	if (m_hasFineAdjust) {
-		double panFine = (panRough - floor(panRough)) * 255.0;
-		setValue("finePan", (int)floor(panFine));
+		setValue("finePan", fine);
 	}
 }
 
@@ -630,29 +481,73 @@ void act::room::MovingHeadRoomNode::tiltTo(float tilt)
 {
 	m_tilt.setValue(clamp(tilt, 0.0f, (float)(m_tiltRange)));
 
-	double tiltRough = ((double)(m_tilt.getValue() - m_tiltOffset) / (double)m_tiltRange);
-	
-	if (m_isTiltFlipped) {
-		tiltRough = 1.0f - tiltRough;
+	int coarse, fine;
+	MovingHeadSolver::encode16(MovingHeadSolver::tiltToNormalized(m_tilt.getValue(), m_tiltOffset, m_tiltRange, m_isTiltFlipped), coarse, fine);
+	setValue("tilt", coarse);
+
+	if (m_hasFineAdjust) {
+		setValue("fineTilt", fine);
 	}
+}
 
-	tiltRough *= 255;
-	setValue("tilt", (int)floor(tiltRough));
+void act::room::MovingHeadRoomNode::setStartAddress(int address)
+{
+	DMXRoomNodeBase::setStartAddress(address);
+	m_isCalibrationDirty = true;
+}
 
+act::room::MovingHeadCalibration act::room::MovingHeadRoomNode::syncCalibration()
+{
+	MovingHeadCalibration calibration;
+	calibration.position			= m_position;
+	calibration.orientation			= m_orientation;
+	calibration.panRange			= m_panRange;
+	calibration.tiltRange			= m_tiltRange;
+	calibration.tiltOffset			= m_tiltOffset;
+	calibration.panCenterOffset		= m_panCenterOffset;
+	calibration.tiltCenterOffset	= m_tiltCenterOffset;
+	calibration.isPanFlipped		= m_isPanFlipped;
+	calibration.isTiltFlipped		= m_isTiltFlipped;
+	calibration.panChannel			= getChannelAddress("pan");
+	calibration.tiltChannel			= getChannelAddress("tilt");
 	if (m_hasFineAdjust) {
-		double tiltFine = (tiltRough - floor(tiltRough)) * 255.0;
-		setValue("fineTilt", (int)floor(tiltFine));
+		calibration.finePanChannel	= getChannelAddress("finePan");
+		calibration.fineTiltChannel	= getChannelAddress("fineTilt");
 	}
+	calibration.maxPanSpeed			= m_maxPanSpeed;
+	calibration.maxTiltSpeed		= m_maxTiltSpeed;
+	calibration.maxPanAcceleration	= m_maxPanAcceleration;
+	calibration.maxTiltAcceleration	= m_maxTiltAcceleration;
+
+	m_isCalibrationDirty = false;
+	return calibration;
+}
+
+void act::room::MovingHeadRoomNode::applySolvedPanTilt(float pan, float tilt)
+{
+	m_hasPendingLookAt = false;
+
+	// dmx-data is written by the planner, while moving there
+	m_pan.setValue(pan);
+	m_tilt.setValue(tilt);
+	panTiltToPolar();
 }
 
 void act::room::MovingHeadRoomNode::onPosition(act::UID replyUID, bool publish)
 {
+	m_isCalibrationDirty = true;
 	m_cameraPersp.setEyePoint(m_position);
 
 	if (publish)
 		publishChanges("position", util::valueToJson(m_position), net::PT_ROOMNODE_UPDATE, replyUID);
 }
 
+void act::room::MovingHeadRoomNode::onOrientation(act::UID replyUID, bool publish)
+{
+	m_isCalibrationDirty = true;
+	RoomNodeBase::onOrientation(replyUID, publish);
+}
+
 /*highlights the MH 
 	(Dimmer: 100%,
 	Color: white)
@@ -0,0 +1,175 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "dmx/MovingHeadSolver.hpp"
+
+
+act::room::MovingHeadSolver::MovingHeadSolver()
+{
+}
+
+act::room::MovingHeadSolver::~MovingHeadSolver()
+{
+}
+
+void act::room::MovingHeadSolver::resize(size_t count)
+{
+	m_count = count;
+
+	for (auto* v : { &m_posX, &m_posY, &m_posZ,
+					 &m_inv00, &m_inv01, &m_inv02, &m_inv10, &m_inv11, &m_inv12, &m_inv20, &m_inv21, &m_inv22,
+					 &m_panRange, &m_tiltRange, &m_tiltOffset, &m_panCenter, &m_tiltCenter,
+					 &m_tgtX, &m_tgtY, &m_tgtZ, &m_pan, &m_tilt }) {
+		v->resize(count, 0.0f);
+	}
+	for (auto* v : { &m_hasTarget, &m_isSolved, &m_isReachable }) {
+		v->resize(count, 0);
+	}
+}
+
+void act::room::MovingHeadSolver::setFixture(size_t index, const MovingHeadCalibration& calibration)
+{
+	if (index >= m_count)
+		return;
+
+	m_posX[index] = calibration.position.x;
+	m_posY[index] = calibration.position.y;
+	m_posZ[index] = calibration.position.z;
+
+	// rotation matrices are orthonormal, so the inverse is the transpose - stored row major to get local = inv * (target - position)
+	ci::mat3 inv = glm::transpose(glm::toMat3(glm::normalize(calibration.orientation)));
+	m_inv00[index] = inv[0][0];	m_inv01[index] = inv[1][0];	m_inv02[index] = inv[2][0];
+	m_inv10[index] = inv[0][1];	m_inv11[index] = inv[1][1];	m_inv12[index] = inv[2][1];
+	m_inv20[index] = inv[0][2];	m_inv21[index] = inv[1][2];	m_inv22[index] = inv[2][2];
+
+	m_panRange[index]		= calibration.panRange;
+	m_tiltRange[index]		= calibration.tiltRange;
+	m_tiltOffset[index]		= calibration.tiltOffset;
+	m_panCenter[index]		= 180.0f + calibration.panCenterOffset;	// shift to middle position and add offset
+	m_tiltCenter[index]		= 90.0f  + calibration.tiltCenterOffset;	// shift to middle position and add offset
+}
+
+void act::room::MovingHeadSolver::setTarget(size_t index, ci::vec3 target)
+{
+	if (index >= m_count)
+		return;
+
+	m_tgtX[index] = target.x;
+	m_tgtY[index] = target.y;
+	m_tgtZ[index] = target.z;
+	m_hasTarget[index] = 1;
+}
+
+void act::room::MovingHeadSolver::setCurrent(size_t index, float pan, float tilt)
+{
+	if (index >= m_count)
+		return;
+
+	m_pan[index] = pan;
+	m_tilt[index] = tilt;
+}
+
+void act::room::MovingHeadSolver::solve()
+{
+	const float toDeg = 180.0f / glm::pi<float>();
+
+	for (size_t i = 0; i < m_count; i++) {
+		m_isSolved[i] = 0;
+		if (!m_hasTarget[i])
+			continue;
+		m_hasTarget[i] = 0;
+
+		float dx = m_tgtX[i] - m_posX[i];
+		float dy = m_tgtY[i] - m_posY[i];
+		float dz = m_tgtZ[i] - m_posZ[i];
+
+		// target direction in fixture space
+		float lx = m_inv00[i] * dx + m_inv01[i] * dy + m_inv02[i] * dz;
+		float ly = m_inv10[i] * dx + m_inv11[i] * dy + m_inv12[i] * dz;
+		float lz = m_inv20[i] * dx + m_inv21[i] * dy + m_inv22[i] * dz;
+
+		float len = sqrtf(lx * lx + ly * ly + lz * lz);
+		if (len < 0.0001f) // target is inside the fixture, keep the last position
+			continue;
+
+		float phi	= atan2f(lx, lz) * toDeg;								// [-180..180]
+		float theta	= acosf(std::clamp(ly / len, -1.0f, 1.0f)) * toDeg;	// [0..180]
+
+		// a direction is reachable by (pan, center + theta) and by (pan + 180, center - theta),
+		// and on fixtures with more than 360 degree pan every pan repeats every full turn.
+		// pick the reachable candidate that is closest to where the head is now
+		float panRange	= m_panRange[i];
+		float tiltRange	= m_tiltRange[i];
+		float curPan	= m_pan[i];
+		float curTilt	= m_tilt[i];
+
+		float bestPan	= 0.0f;
+		float bestTilt	= 0.0f;
+		float bestCost	= FLT_MAX;
+
+		for (int side = 0; side < 2; side++) {
+			float tilt = side == 0 ? m_tiltCenter[i] + theta : m_tiltCenter[i] - theta;
+			if (tilt < 0.0f || tilt > tiltRange)
+				continue;
+
+			float pan = fmodf(m_panCenter[i] + phi + (side == 0 ? 0.0f : 180.0f), 360.0f);
+			if (pan < 0.0f)
+				pan += 360.0f;
+
+			for (; pan <= panRange; pan += 360.0f) {
+				float cost = fabsf(pan - curPan) + fabsf(tilt - curTilt);
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestPan	 = pan;
+					bestTilt = tilt;
+				}
+			}
+		}
+
+		if (bestCost < FLT_MAX) {
+			m_isReachable[i] = 1;
+		}
+		else { // out of range, clamp like a single setPanTilt would do
+			m_isReachable[i] = 0;
+			bestPan	 = fmodf(m_panCenter[i] + phi, panRange);
+			bestTilt = std::clamp(m_tiltCenter[i] + theta, 0.0f, tiltRange);
+		}
+
+		m_pan[i]		= bestPan;
+		m_tilt[i]		= bestTilt;
+		m_isSolved[i]	= 1;
+	}
+}
+
+void act::room::MovingHeadSolver::encode16(double normalized, int& coarse, int& fine)
+{
+	int value = (int)std::round(std::clamp(normalized, 0.0, 1.0) * 65535.0);
+	coarse	= (value >> 8) & 0xFF;
+	fine	= value & 0xFF;
+}
+
+double act::room::MovingHeadSolver::panToNormalized(float pan, float panRange, bool isFlipped)
+{
+	double normalized = (double)pan / (double)panRange;
+	return isFlipped ? 1.0 - normalized : normalized;
+}
+
+double act::room::MovingHeadSolver::tiltToNormalized(float tilt, float tiltOffset, float tiltRange, bool isFlipped)
+{
+	double normalized = (double)(tilt - tiltOffset) / (double)tiltRange;
+	return isFlipped ? 1.0 - normalized : normalized;
+}
@@ -0,0 +1,358 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "kinect/BodyFusion.hpp"
+
+
+act::room::BodyFusion::BodyFusion()
+{
+}
+
+act::room::BodyFusion::~BodyFusion()
+{
+}
+
+void act::room::BodyFusion::begin(double time)
+{
+	m_time = time;
+
+	m_grid.clear();
+
+	for (uint32_t i = 0; i < (uint32_t)m_tracks.size(); i++) {
+		Track& track = m_tracks[i];
+		track.observations = 0;
+		track.positionSum.fill(ci::vec3(0.0f));
+		track.weightSum.fill(0.0f);
+		track.orientationSum.fill(ci::quat(0.0f, 0.0f, 0.0f, 0.0f));
+		track.confidence.fill(0);
+		track.fallbackSum.fill(ci::vec3(0.0f));
+		insert(i);
+	}
+}
+
+void act::room::BodyFusion::addBodies(size_t sensor, double time, const std::map<uint32_t, k4abt_skeleton_t>& bodies)
+{
+	if (bodies.empty())
+		return;
+
+	// edges to the tracks near each body, the cost is the distance of the chests at the time of the sensor
+	m_candidates.clear();
+	m_edges.clear();
+	m_trackColumn.assign(m_tracks.size(), -1);
+
+	int rows = 0;
+	for (auto&& body : bodies) {
+		ci::vec3 center = getCenter(body.second);
+		ci::ivec2 c = cell(center);
+		auto last = m_associations.find(std::make_pair(sensor, body.first));
+
+		for (int x = c.x - 1; x <= c.x + 1; x++) {
+			for (int z = c.y - 1; z <= c.y + 1; z++) {
+				auto it = m_grid.find(cellKey(x, z));
+				if (it == m_grid.end())
+					continue;
+				for (uint32_t index : it->second) {
+					const Track& track = m_tracks[index];
+					ci::vec3 predicted = track.center + track.velocity * (float)(time - track.time);
+					float distance = glm::distance(predicted, center);
+					if (last != m_associations.end() && last->second == track.id)
+						distance *= 0.5f; // keep what has been associated before
+					if (distance >= m_gateDistance)
+						continue;
+
+					if (m_trackColumn[index] < 0) {
+						m_trackColumn[index] = (int)m_candidates.size();
+						m_candidates.push_back(index);
+					}
+					m_edges.push_back(Edge{ rows, m_trackColumn[index], 0, distance });
+				}
+			}
+		}
+		rows++;
+	}
+
+	// bodies and tracks without a common candidate cannot affect each other's assignment
+	int cols = (int)m_candidates.size();
+	m_parent.resize(rows + cols);
+	for (int i = 0; i < rows + cols; i++)
+		m_parent[i] = i;
+	for (auto&& edge : m_edges) {
+		int a = findComponent(edge.row);
+		int b = findComponent(rows + edge.col);
+		if (a != b)
+			m_parent[b] = a;
+	}
+	for (auto&& edge : m_edges)
+		edge.component = findComponent(edge.row);
+	std::sort(m_edges.begin(), m_edges.end(), [](const Edge& a, const Edge& b) { return a.component < b.component; });
+
+	m_rowColumn.assign(rows, -1);
+	m_localRow.assign(rows, -1);
+	m_localCol.assign(cols, -1);
+	for (size_t begin = 0; begin < m_edges.size(); ) {
+		size_t end = begin + 1;
+		while (end < m_edges.size() && m_edges[end].component == m_edges[begin].component)
+			end++;
+		assignComponent(begin, end);
+		begin = end;
+	}
+
+	int row = 0;
+	for (auto&& body : bodies) {
+		int col = m_rowColumn[row];
+		uint32_t id;
+		if (col >= 0) {
+			Track& track = m_tracks[m_candidates[col]];
+			accumulate(track, time, body.second);
+			id = track.id;
+		}
+		else {
+			id = createTrack(time, body.second);
+		}
+		m_associations[std::make_pair(sensor, body.first)] = id;
+		row++;
+	}
+}
+
+void act::room::BodyFusion::end()
+{
+	m_bodies.clear();
+
+	for (auto&& track : m_tracks) {
+		if (track.observations == 0)
+			continue;
+
+		for (int j = 0; j < kJoints; j++) {
+			k4abt_joint_t& joint = track.skeleton.joints[j];
+
+			ci::vec3 position;
+			if (track.weightSum[j] > 0.0f)
+				position = track.positionSum[j] / track.weightSum[j];
+			else
+				position = track.fallbackSum[j] / (float)track.observations;
+
+			joint.position.xyz.x = position.x;
+			joint.position.xyz.y = position.y;
+			joint.position.xyz.z = position.z;
+
+			ci::quat orientation = track.orientationSum[j];
+			if (glm::dot(orientation, orientation) > 0.0f) {
+				orientation = glm::normalize(orientation);
+				joint.orientation.wxyz.w = orientation.w;
+				joint.orientation.wxyz.x = orientation.x;
+				joint.orientation.wxyz.y = orientation.y;
+				joint.orientation.wxyz.z = orientation.z;
+			}
+
+			joint.confidence_level = (k4abt_joint_confidence_level_t)track.confidence[j];
+		}
+
+		ci::vec3 center = getCenter(track.skeleton);
+		float dt = (float)(m_time - track.time);
+		if (dt > 0.001f)
+			track.velocity = glm::mix(track.velocity, (center - track.center) / dt, 0.5f);
+		track.center	= center;
+		track.time		= m_time;
+
+		m_bodies[track.id] = track.skeleton;
+	}
+
+	// tracks that have not been seen for a while are gone, as are the associations to them
+	m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(), [&](const Track& track) {
+		return m_time - track.time > m_maxMissingTime;
+	}), m_tracks.end());
+
+	for (auto it = m_associations.begin(); it != m_associations.end(); ) {
+		uint32_t id = it->second;
+		bool alive = std::any_of(m_tracks.begin(), m_tracks.end(), [&](const Track& track) { return track.id == id; });
+		if (alive)
+			++it;
+		else
+			it = m_associations.erase(it);
+	}
+}
+
+int act::room::BodyFusion::findComponent(int node)
+{
+	while (m_parent[node] != node) {
+		m_parent[node] = m_parent[m_parent[node]];
+		node = m_parent[node];
+	}
+	return node;
+}
+
+void act::room::BodyFusion::assignComponent(size_t begin, size_t end)
+{
+	// a single edge needs no assignment
+	if (end - begin == 1) {
+		m_rowColumn[m_edges[begin].row] = m_edges[begin].col;
+		return;
+	}
+
+	m_componentRows.clear();
+	m_componentCols.clear();
+	for (size_t e = begin; e < end; e++) {
+		const Edge& edge = m_edges[e];
+		if (m_localRow[edge.row] < 0) {
+			m_localRow[edge.row] = (int)m_componentRows.size();
+			m_componentRows.push_back(edge.row);
+		}
+		if (m_localCol[edge.col] < 0) {
+			m_localCol[edge.col] = (int)m_componentCols.size();
+			m_componentCols.push_back(edge.col);
+		}
+	}
+
+	// not matching costs the gate
+	int n = (int)std::max(m_componentRows.size(), m_componentCols.size());
+	m_cost.assign(n * n, m_gateDistance);
+	for (size_t e = begin; e < end; e++) {
+		const Edge& edge = m_edges[e];
+		m_cost[m_localRow[edge.row] * n + m_localCol[edge.col]] = edge.cost;
+	}
+
+	solveAssignment(m_cost, n, m_assignment);
+
+	for (int r = 0; r < (int)m_componentRows.size(); r++) {
+		int c = m_assignment[r];
+		if (c < (int)m_componentCols.size() && m_cost[r * n + c] < m_gateDistance)
+			m_rowColumn[m_componentRows[r]] = m_componentCols[c];
+	}
+}
+
+void act::room::BodyFusion::insert(uint32_t track)
+{
+	ci::ivec2 c = cell(m_tracks[track].center + m_tracks[track].velocity * (float)(m_time - m_tracks[track].time));
+	m_grid[cellKey(c.x, c.y)].push_back(track);
+}
+
+void act::room::BodyFusion::accumulate(Track& track, double time, const k4abt_skeleton_t& skeleton)
+{
+	// the sensor's frame is moved to the fusion time along the track
+	ci::vec3 shift = track.velocity * (float)(m_time - time);
+
+	for (int j = 0; j < kJoints; j++) {
+		const k4abt_joint_t& joint = skeleton.joints[j];
+		ci::vec3 position = ci::vec3(joint.position.xyz.x, joint.position.xyz.y, joint.position.xyz.z) + shift;
+		float weight = confidenceWeight(joint.confidence_level);
+
+		track.fallbackSum[j] += position;
+		track.confidence[j] = std::max(track.confidence[j], (int)joint.confidence_level);
+		if (weight <= 0.0f)
+			continue;
+
+		track.positionSum[j]	+= position * weight;
+		track.weightSum[j]		+= weight;
+
+		// quaternions are averaged in the hemisphere of the first one
+		ci::quat orientation(joint.orientation.wxyz.w, joint.orientation.wxyz.x, joint.orientation.wxyz.y, joint.orientation.wxyz.z);
+		if (glm::dot(track.orientationSum[j], orientation) < 0.0f)
+			orientation = -orientation;
+		track.orientationSum[j] += orientation * weight;
+	}
+	track.observations++;
+}
+
+uint32_t act::room::BodyFusion::createTrack(double time, const k4abt_skeleton_t& skeleton)
+{
+	Track track;
+	track.id		= m_nextID++;
+	track.center	= getCenter(skeleton);
+	track.time		= time;
+	track.skeleton	= skeleton;
+	track.positionSum.fill(ci::vec3(0.0f));
+	track.weightSum.fill(0.0f);
+	track.orientationSum.fill(ci::quat(0.0f, 0.0f, 0.0f, 0.0f));
+	track.confidence.fill(0);
+	track.fallbackSum.fill(ci::vec3(0.0f));
+	m_tracks.push_back(track);
+
+	accumulate(m_tracks.back(), time, skeleton);
+	insert((uint32_t)m_tracks.size() - 1);
+
+	return track.id;
+}
+
+ci::vec3 act::room::BodyFusion::getCenter(const k4abt_skeleton_t& skeleton)
+{
+	const k4abt_joint_t& chest = skeleton.joints[K4ABT_JOINT_SPINE_CHEST];
+	return ci::vec3(chest.position.xyz.x, chest.position.xyz.y, chest.position.xyz.z);
+}
+
+float act::room::BodyFusion::confidenceWeight(int confidence)
+{
+	switch (confidence) {
+	case K4ABT_JOINT_CONFIDENCE_LOW:	return 0.2f;
+	case K4ABT_JOINT_CONFIDENCE_MEDIUM:	return 1.0f;
+	case K4ABT_JOINT_CONFIDENCE_HIGH:	return 1.0f;
+	default:							return 0.0f;
+	}
+}
+
+void act::room::BodyFusion::solveAssignment(const std::vector<float>& cost, int n, std::vector<int>& rowToCol)
+{
+	// potentials and augmenting paths, indices are 1-based with 0 as virtual start
+	std::vector<float>	u(n + 1, 0.0f), v(n + 1, 0.0f), minv(n + 1);
+	std::vector<int>	p(n + 1, 0), way(n + 1, 0);
+	std::vector<char>	used(n + 1);
+
+	for (int i = 1; i <= n; i++) {
+		p[0] = i;
+		int j0 = 0;
+		std::fill(minv.begin(), minv.end(), FLT_MAX);
+		std::fill(used.begin(), used.end(), 0);
+		do {
+			used[j0] = 1;
+			int i0 = p[j0], j1 = 0;
+			float delta = FLT_MAX;
+			for (int j = 1; j <= n; j++) {
+				if (used[j])
+					continue;
+				float cur = cost[(i0 - 1) * n + (j - 1)] - u[i0] - v[j];
+				if (cur < minv[j]) {
+					minv[j] = cur;
+					way[j] = j0;
+				}
+				if (minv[j] < delta) {
+					delta = minv[j];
+					j1 = j;
+				}
+			}
+			for (int j = 0; j <= n; j++) {
+				if (used[j]) {
+					u[p[j]] += delta;
+					v[j] -= delta;
+				}
+				else {
+					minv[j] -= delta;
+				}
+			}
+			j0 = j1;
+		} while (p[j0] != 0);
+		do {
+			int j1 = way[j0];
+			p[j0] = p[j1];
+			j0 = j1;
+		} while (j0);
+	}
+
+	rowToCol.assign(n, -1);
+	for (int j = 1; j <= n; j++) {
+		if (p[j] != 0)
+			rowToCol[p[j] - 1] = j - 1;
+	}
+}
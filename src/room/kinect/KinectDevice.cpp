@@ -17,6 +17,9 @@
 
 #include "roompch.hpp"
 #include "kinect/KinectDevice.hpp"
+#include "pointcloud/PointcloudFilter.hpp"
+
+#include <chrono>
 
 using namespace cinder::app;
 using namespace act;
@@ -90,113 +93,6 @@ void KinectDevice::openDevice()
 	}
 }
 
-/*
-Pointcloud act::room::KinectDevice::toPointCloud(k4a::image depth, k4a::image color)
-{
-	Pointcloud pointcloud
-
-	bool noColor = color == nullptr;
-
-	int width = k4a_image_get_width_pixels(depth);
-	int height = k4a_image_get_height_pixels(depth);
-
-	if (width == 0 || height == 0) {
-		return pointcloud;
-	}
-
-	k4a::image transformedColor = NULL;
-	if (K4A_RESULT_SUCCEEDED != k4a_image_create(K4A_IMAGE_FORMAT_COLOR_BGRA32,
-		width,
-		height,
-		0,
-		&transformedColor))
-	{
-		CI_LOG_E("Failed to create transformed color image\n");
-		return pointcloud;
-	}
-
-	k4a::image pointcloudImage = NULL;
-	if (K4A_RESULT_SUCCEEDED != k4a_image_create(K4A_IMAGE_FORMAT_CUSTOM,
-		width,
-		height,
-		width * 3 * (int)sizeof(int16_t),
-		&pointcloudImage))
-	{
-		CI_LOG_E("Failed to create point cloud image\n");
-		return pointcloud;
-	}
-
-	if (!noColor && K4A_RESULT_SUCCEEDED != k4a_transformation_color_image_to_depth_camera(m_transformation,
-		depth,
-		color,
-		transformedColor))
-	{
-		CI_LOG_E("Failed to compute transformed color image\n");
-		//return pointcloud; // most the time, if color is given, but cannot transformed, some more data is malicious
-		noColor = true;
-	}
-
-	if (K4A_RESULT_SUCCEEDED != k4a_transformation_depth_image_to_point_cloud(m_transformation,
-		depth,
-		K4A_CALIBRATION_TYPE_DEPTH,
-		pointcloudImage))
-	{
-		CI_LOG_E("Failed to compute point cloud\n");
-		return pointcloud;
-	}
-
-	if (!pointcloudImage)
-		return pointcloud;
-
-	int16_t* pointcloudData = (int16_t*)(void*)k4a_image_get_buffer(pointcloudImage);
-	uint8_t* colorData;
-	if(!noColor && transformedColor != nullptr)
-		colorData = k4a_image_get_buffer(transformedColor);
-
-	if (!pointcloudData)
-		return pointcloud;
-
-	pointcloud->resize(static_cast<size_t>(height) * width);
-	pointcloud->width = width;
-	pointcloud->height = height;
-
-
-
-	long i{ 0 };
-	float min = 10000;
-	float max = 0;
-
-	for (auto& point : *pointcloud)
-	{
-		point.x = pointcloudData[3 * i + 0] * -0.001f;	// Convert to mm to m
-		point.y = pointcloudData[3 * i + 1] * -0.001f;
-		point.z = pointcloudData[3 * i + 2] * 0.001f;
-
-		if (point.z < min)
-			min = point.z;
-		if (point.z > max)
-			max = point.z;
-
-		if (noColor) {
-			point.r = 180.f;// 240.f - (point.z);
-			point.g = 180.f;// 230.f;
-			point.b = 180.f;// 230.f + (point.z);
-		}
-		else {
-			point.b = colorData[4 * i + 0];
-			point.g = colorData[4 * i + 1];
-			point.r = colorData[4 * i + 2];
-			// uint8_t alpha = color_image_data[4 * i + 3];
-		}
-
-		i = i + 1;
-	}
-
-	//TODO 
-
-	return pointcloud;
-}*/
-
 void KinectDevice::startDevice(bool mode)
 {
 #ifdef WITHKINECT
@@ -222,10 +118,13 @@ void KinectDevice::startDevice(bool mode)
 	bodyTrackingInit(mode);
 #endif;
 	m_state = KinectState::KS_STARTUP;
+	startPipeline();
 }
 
 void KinectDevice::stopDevice()
 {
+	stopPipeline();
+
 	if (m_state != KinectState::KS_CLOSED) {
 #ifdef WITHKINECT
 		m_tracker.shutdown();
@@ -240,249 +139,292 @@ void KinectDevice::stopDevice()
 	}
 }
 
+void KinectDevice::startPipeline()
+{
+	if (m_isRunning)
+		return;
+
+	m_trackerQueue.open();
+	m_pointcloudQueue.open();
+
+	m_isRunning = true;
+	m_captureThread		= std::thread([this]() { captureLoop(); });
+	m_trackerThread		= std::thread([this]() { trackerLoop(); });
+	m_pointcloudThread	= std::thread([this]() { pointcloudLoop(); });
+}
+
+void KinectDevice::stopPipeline()
+{
+	m_isRunning = false;
+	m_trackerQueue.close();
+	m_pointcloudQueue.close();
+
+	if (m_captureThread.joinable())
+		m_captureThread.join();
+	if (m_trackerThread.joinable())
+		m_trackerThread.join();
+	if (m_pointcloudThread.joinable())
+		m_pointcloudThread.join();
+}
+
 void KinectDevice::update() 
 {
-	if (m_state == KinectState::KS_CAPTURING)
-	{
-#ifdef WITHKINECT
-		k4a::capture capture;
-		if (m_device.get_capture(&capture, std::chrono::milliseconds(K4A_WAIT_INFINITE)))
-		{
-			k4a::image colorImage = capture.get_color_image();
-			k4a::image depthImage = capture.get_depth_image();
-			if (m_isCapturingImage)
-				updateColor(colorImage);
+	KinectFrameRef frame = m_frame.load();
+	bool isNewFrame = frame && frame != m_currentFrame;
+	if (isNewFrame) {
+		m_currentFrame = frame;
 
-			if (m_isCapturingDepth) {
-				updateDepth(depthImage);
-			}
+		m_colorFrame		= frame->color;
+		m_depthFrame		= frame->depth;
+		m_infraRedFrame		= frame->infraRed;
+		m_isColorFrameAvailable		= !m_colorFrame.empty();
+		m_isDepthFrameAvailable		= !m_depthFrame.empty();
+		m_isInfraRedFrameAvailable	= !m_infraRedFrame.empty();
 
-			if (m_isProvidingPointCloud && depthImage != nullptr) {
-				updatePointCloud(depthImage, colorImage);
-			}
+		m_temperatureSample		= frame->temperature;
+		m_accelerometerSample	= frame->accelerometer;
+		m_gyroscopeSample		= frame->gyroscope;
+	}
 
-			/*
-			if (colorImage != nullptr)
-				colorImage.reset();
-			if (depthImage != nullptr)
-				depthImage.reset();
-			*/
-
-			if (m_isCapturingIR)
-				updateIR(capture);
-
-			if (m_isCapturingIMU)
-				updateIMU();
-
-			if (m_isCapturingBodies)
-			{
-				try {
-					if (m_tracker.enqueue_capture(capture))
-					{
-						updateBodyTracker();
-					}
-				}
-				catch(k4a::error err) {
-					// It should never hit timeout when K4A_WAIT_INFINITE is set.
-					CI_LOG_E("Error! Add capture to tracker process queue timeout!");
-				}
-			}
+	KinectBodiesRef bodies = m_bodies.load();
+	if (bodies && bodies != m_currentBodies) {
+		m_currentBodies = bodies;
+
+		m_numOfBodies		= (int)bodies->bodies.size();
+		m_areBodiesAvailable = true;
+		m_bodyIndexFrame	= bodies->bodyIndex;
+		m_isBodyIndexFrameAvailable = !m_bodyIndexFrame.empty();
+
+		if (m_isDrawing2dJoints) {
+			m_skeletonJoints2d.clear();
+			for (auto&& body : bodies->bodies)
+				generateSkeleton2dCoordinates(body.second, body.first);
 		}
-#endif
 	}
-	else if (m_state == KinectState::KS_STARTUP) {
-#ifdef WITHKINECT
-		k4a::capture capture;
-		try {
-			if (m_device.get_capture(&capture, std::chrono::milliseconds(K4A_WAIT_INFINITE)))
-			{
-				k4a::image colorImage = capture.get_color_image();
-				k4a::image depthImage = capture.get_depth_image();
 
-			}
+	if (m_isDrawing2dJoints && isNewFrame)
+		update2dJoints();
 
-			m_state = KinectState::KS_CAPTURING;
-		}
-		catch (k4a::error err) {
-			CI_LOG_E("Unable to get Capture");
-		}
-#endif
+	KinectPointsRef points = m_points.load();
+	if (points && points != m_currentPoints) {
+		m_currentPoints = points;
+		m_isPointCloudAvailable = true;
 	}
 }
 
-glm::vec2 act::room::KinectDevice::getFOV()
+bool KinectDevice::grab(k4a::capture& capture, double& timestamp)
 {
-	// TODO: add fancy function for getting FOV from kinect m_device
-	return glm::vec2(90.0f, 74.3f); // in degree
+#ifdef WITHKINECT
+	try {
+		if (!m_device.get_capture(&capture, std::chrono::milliseconds(100)))
+			return false;
+	}
+	catch (k4a::error err) {
+		CI_LOG_E("Unable to get Capture");
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		return false;
+	}
+	timestamp = now();
+
+	if (m_state == KinectState::KS_STARTUP) { // the first capture only confirms that the cameras are running
+		m_state = KinectState::KS_CAPTURING;
+		return false;
+	}
+	return true;
+#else
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	return false;
+#endif
 }
 
-void KinectDevice::updateColor(k4a::image colorImage)
+void KinectDevice::captureLoop()
 {
-#ifdef WITHKINECT
-	if (colorImage != nullptr)
-	{
-		m_colorFrame = kh::k4a_get_mat(colorImage).getUMat(cv::ACCESS_FAST);
+	uint64_t sequence = 0;
 
-		if (m_colorFrame.rows != 0 && m_colorFrame.cols != 0) {
-			if (m_isDrawing2dJoints)
-				update2dJoints();
+	while (m_isRunning) {
+		k4a::capture capture;
+		double timestamp = 0.0;
+		if (!grab(capture, timestamp))
+			continue;
 
-			cv::flip(m_colorFrame, m_colorFrame, 1);
+#ifdef WITHKINECT
+		auto frame = std::make_shared<KinectFrame>();
+		frame->timestamp	= timestamp;
+		frame->sequence		= ++sequence;
+
+		k4a::image colorImage = capture.get_color_image();
+		k4a::image depthImage = capture.get_depth_image();
+
+		if (m_isCapturingImage && colorImage.is_valid())
+			frame->color = toFlippedUMat(colorImage);
+		if (m_isCapturingDepth && depthImage.is_valid())
+			frame->depth = toFlippedUMat(depthImage);
+		if (m_isCapturingIR) {
+			k4a::image irImage = capture.get_ir_image();
+			if (irImage.is_valid())
+				frame->infraRed = toFlippedUMat(irImage);
+		}
 
-			m_isColorFrameAvailable = true;
+		if (m_isCapturingIMU && !m_isDummy) {
+			k4a_imu_sample_t imuSample;
+			try {
+				if (m_device.get_imu_sample(&imuSample, std::chrono::milliseconds(0))) {
+					frame->temperature		= imuSample.temperature;
+					frame->accelerometer	= vec3(imuSample.acc_sample.xyz.x, imuSample.acc_sample.xyz.y, imuSample.acc_sample.xyz.z);
+					frame->gyroscope		= vec3(imuSample.gyro_sample.xyz.x, imuSample.gyro_sample.xyz.y, imuSample.gyro_sample.xyz.z);
+				}
+			}
+			catch (k4a::error err) {
+			}
 		}
-	}
+
+		m_frame.store(frame);
+
+		if (m_isCapturingBodies && m_tracker)
+			m_trackerQueue.push({ capture, timestamp, frame->sequence });
+		if (m_isProvidingPointCloud && depthImage.is_valid())
+			m_pointcloudQueue.push({ capture, timestamp, frame->sequence });
 #endif
+	}
 }
 
-void KinectDevice::update2dJoints()
+void KinectDevice::trackerLoop()
 {
-	if (m_skeletonJoints2d[1].size() == 32) {
+	CaptureItem item;
+	while (m_trackerQueue.pop(item)) {
+#ifdef WITHKINECT
+		k4abt::frame bodyFrame;
+		try {
+			if (!m_tracker.enqueue_capture(item.capture))
+				continue;
+			bodyFrame = m_tracker.pop_result();
+		}
+		catch (k4a::error err) {
+			CI_LOG_E("Error! Add capture to tracker process queue failed!");
+			continue;
+		}
+		if (bodyFrame == nullptr)
+			continue;
 
-		cv::UMat overlay;
+		auto bodies = std::make_shared<KinectBodies>();
+		bodies->timestamp	= item.timestamp;
+		bodies->sequence	= item.sequence;
 
-		int circleSize = 20;
-		cv::Scalar color = (255.0f, 0.0f, 0.0f, 255.0f);
-		double alpha = 0.2;
+		uint32_t numOfBodies = bodyFrame.get_num_bodies();
+		for (uint32_t i = 0; i < numOfBodies; i++) {
+			k4abt_body_t body = bodyFrame.get_body(i);
+			bodies->bodies[body.id] = body.skeleton;
+		}
 
-		m_colorFrame.copyTo(overlay);
+		k4a::image bodyIndexMap = bodyFrame.get_body_index_map();
+		if (bodyIndexMap.is_valid())
+			bodies->bodyIndex = toFlippedUMat(bodyIndexMap);
 
-		for (int i = 1; i <= m_skeletonJoints2d.size(); i++) {
-			for (int j = 0; j < 32; j++)
-			{
-				if (m_skeletonJoints2d[i][j].xy.x != -1.0f)
-					cv::circle(overlay, cv::Point(m_skeletonJoints2d[i][j].xy.x, m_skeletonJoints2d[i][j].xy.y), circleSize, color, -1);
-			}
-		}
-		cv::addWeighted(overlay, alpha, m_colorFrame, 1 - alpha, 0, m_colorFrame);
+		m_bodies.store(bodies);
+#endif
 	}
 }
 
-void KinectDevice::updateDepth(k4a::image depthImage)
+void KinectDevice::pointcloudLoop()
 {
+	CaptureItem item;
 #ifdef WITHKINECT
-	if (depthImage != nullptr)
-	{
-		/*
+	k4a::image pointcloudImage;
+#endif
+
+	while (m_pointcloudQueue.pop(item)) {
+#ifdef WITHKINECT
+		k4a::image depthImage = item.capture.get_depth_image();
+		if (!depthImage.is_valid())
+			continue;
+
 		int width	= depthImage.get_width_pixels();
 		int height	= depthImage.get_height_pixels();
-
 		if (width == 0 || height == 0)
-			return;
-
-		k4a::image transformedDepthImage;
+			continue;
 
 		try {
-			transformedDepthImage = k4a::image::create(K4A_IMAGE_FORMAT_DEPTH16, width, height, width * (int)sizeof(uint16_t));
+			if (!pointcloudImage.is_valid() || pointcloudImage.get_width_pixels() != width || pointcloudImage.get_height_pixels() != height)
+				pointcloudImage = k4a::image::create(K4A_IMAGE_FORMAT_CUSTOM, width, height, width * 3 * (int)sizeof(int16_t));
+
+			m_transformation.depth_image_to_point_cloud(depthImage, K4A_CALIBRATION_TYPE_DEPTH, &pointcloudImage);
 		}
-		catch(k4a::error err)
-		{
-			CI_LOG_E("Failed to create transformed depth image");
+		catch (k4a::error err) {
+			CI_LOG_E("Failed to compute point cloud");
+			continue;
 		}
 
-		try {
-			m_transformation.depth_image_to_color_camera(depthImage, &transformedDepthImage);
+		// mm to m, with x and y inverted like the bodies; pixels without depth are skipped
+		const int16_t* data = (const int16_t*)pointcloudImage.get_buffer();
+		auto points = std::make_shared<std::vector<glm::vec3>>();
+		points->reserve((size_t)width * height);
+		for (size_t i = 0; i < (size_t)width * height; i++) {
+			if (data[3 * i + 2] == 0)
+				continue;
+			points->push_back(glm::vec3(data[3 * i + 0] * -0.001f, data[3 * i + 1] * -0.001f, data[3 * i + 2] * 0.001f));
 		}
-		catch(k4a::error err)
-		{
-			transformedDepthImage = depthImage;
-			CI_LOG_E("Failed to compute transformed depth image");
+
+		float voxelSize = m_pointCloudVoxelSize.load();
+		if (voxelSize > 0.0f) {
+			auto downsampled = std::make_shared<std::vector<glm::vec3>>();
+			PointcloudFilter::voxelDownsample(*points, voxelSize, *downsampled);
+			points = downsampled;
 		}
-		m_depthFrame = kh::k4a_get_mat(transformedDepthImage).getUMat(cv::ACCESS_FAST);
-		*/
-		m_depthFrame = kh::k4a_get_mat(depthImage).getUMat(cv::ACCESS_FAST);
-		cv::flip(m_depthFrame, m_depthFrame, 1);
-		m_isDepthFrameAvailable = true;
-		
-	}
-#endif
-}
 
-void act::room::KinectDevice::updatePointCloud(k4a::image depth, k4a::image color)
-{
-	// m_pointcloud = toPointCloud(depth, color);
-	// m_isPointCloudAvailable = true;
+		auto snapshot = std::make_shared<KinectPoints>();
+		snapshot->timestamp	= item.timestamp;
+		snapshot->sequence	= item.sequence;
+		snapshot->points	= points;
+		m_points.store(snapshot);
+#endif
+	}
 }
 
-void KinectDevice::updateIR(k4a::capture capture)
+cv::UMat KinectDevice::toFlippedUMat(k4a::image image)
 {
+	cv::UMat result;
 #ifdef WITHKINECT
-	k4a::image irImage = capture.get_ir_image();
-	if (irImage.is_valid())
-	{
-		auto handle = irImage.handle();
-		m_infraRedFrame = kh::k4a_get_mat(handle).getUMat(cv::ACCESS_FAST);
-		cv::flip(m_infraRedFrame, m_infraRedFrame, 1);
-		m_isInfraRedFrameAvailable = true;
-	}
+	cv::flip(kh::k4a_get_mat(image), result, 1);
 #endif
+	return result;
 }
 
-void KinectDevice::updateIMU()
+double KinectDevice::now()
 {
-#ifdef WITHKINECT
-	k4a_imu_sample_t imuSample;
-
-	if (m_device.get_imu_sample(&imuSample))
-	{
-		m_temperatureSample = imuSample.temperature;
-		m_accelerometerSample = vec3(imuSample.acc_sample.xyz.x, imuSample.acc_sample.xyz.y, imuSample.acc_sample.xyz.z);
-		m_gyroscopeSample = vec3(imuSample.gyro_sample.xyz.x, imuSample.gyro_sample.xyz.y, imuSample.gyro_sample.xyz.z);
-	}
-#endif
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void KinectDevice::updateBodyTracker()
+glm::vec2 act::room::KinectDevice::getFOV()
 {
-#ifdef WITHKINECT
-	k4abt::frame bodyFrame = m_tracker.pop_result();
-
-	if (bodyFrame != nullptr)
-	{
-		m_numOfBodies = bodyFrame.get_num_bodies();
-		updateSkeletons(bodyFrame);
-		updateBodyIndexMap(bodyFrame);
-	}
-	else
-	{
-		// CI_LOG_D("Pop body frame result failed!");
-		return;
-	}
-#endif
+	// TODO: add fancy function for getting FOV from kinect m_device
+	return glm::vec2(90.0f, 74.3f); // in degree
 }
 
-void KinectDevice::updateSkeletons(k4abt::frame bodyFrame)
+void KinectDevice::update2dJoints()
 {
-#ifdef WITHKINECT
-	m_bodyMap.clear();
+	if (m_skeletonJoints2d.empty() || m_colorFrame.empty())
+		return;
 
-	for (size_t i = 0; i < m_numOfBodies; i++)
-	{
-		k4abt_body_t body = bodyFrame.get_body(i);
+	cv::UMat overlay;
 
-		k4abt_skeleton_t skeleton = body.skeleton;
+	int circleSize = 20;
+	cv::Scalar color = (255.0f, 0.0f, 0.0f, 255.0f);
+	double alpha = 0.2;
 
-		uint32_t id = body.id;
-		m_bodyMap[id] = skeleton;
-		m_areBodiesAvailable = true;
+	m_colorFrame.copyTo(overlay);
 
-		if (m_isDrawing2dJoints)
-			generateSkeleton2dCoordinates(skeleton, id);
+	for (auto&& joints : m_skeletonJoints2d) {
+		for (auto&& joint : joints.second)
+		{
+			if (joint.second.xy.x != -1.0f) // the frame is already mirrored
+				cv::circle(overlay, cv::Point(m_colorFrame.cols - 1 - joint.second.xy.x, joint.second.xy.y), circleSize, color, -1);
+		}
 	}
-#endif
-}
 
-void KinectDevice::updateBodyIndexMap(k4abt::frame bodyFrame)
-{
-#ifdef WITHKINECT
-	k4a::image bodyIndexMap = bodyFrame.get_body_index_map();
-	if (bodyIndexMap.is_valid())
-	{
-		m_bodyIndexFrame = kh::k4a_get_mat(bodyIndexMap).getUMat(cv::ACCESS_FAST); // .mul(32); // expand space
-		cv::flip(m_bodyIndexFrame, m_bodyIndexFrame, 1);
-		m_isBodyIndexFrameAvailable = true;
-	}
-#endif
+	// the frame belongs to the snapshot, so the result goes into a new image
+	cv::UMat blended;
+	cv::addWeighted(overlay, alpha, m_colorFrame, 1 - alpha, 0, blended);
+	m_colorFrame = blended;
 }
 
 // xcopy "$(SolutionDir)..\blocks\onnxruntime\lib\onnxruntime.dll" "$(SolutionDir)bin\$(Configuration)\onnxruntime.dll" /Y /I
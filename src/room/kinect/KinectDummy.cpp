@@ -18,6 +18,8 @@
 #include "roompch.hpp"
 #include "kinect/KinectDummy.hpp"
 
+#include <chrono>
+
 using namespace cinder::app;
 using namespace act;
 using namespace room;
@@ -34,40 +36,14 @@ KinectDummy::KinectDummy(std::uint32_t deviceIndex, std::string name, std::strin
 }
 
 
-void KinectDummy::update()
-{	
-	if (m_state == KinectState::KS_CAPTURING)
-	{
-#ifdef WITHKINECT
-		k4a::capture capture;
-		if (m_device.get_capture(&capture, std::chrono::milliseconds(K4A_WAIT_INFINITE)))
-		{
-			k4a::image colorImage = capture.get_color_image();
-			k4a::image depthImage = capture.get_depth_image();
-			if (m_isCapturingImage)
-				updateColor(colorImage);
-
-			if (m_isCapturingDepth) {
-				updateDepth(depthImage);
-			}
-
-			if (m_isProvidingPointCloud && depthImage != nullptr) {
-				updatePointCloud(depthImage, colorImage);
-			}
-
-
-			if (m_isCapturingIR)
-				updateIR(capture);
-
-
-		}
-#endif
-	}
-	 
-}
-
 KinectDummy::~KinectDummy()
 {
+	stopDevice();
+#ifdef WITHKINECT
+	if (m_playback)
+		k4a_playback_close(m_playback);
+#endif
+	m_state = KinectState::KS_CLOSED;
 }
 
 void KinectDummy::openDevice()
@@ -83,7 +59,8 @@ void KinectDummy::openDevice()
 	}
 	else {
 		CI_LOG_E("Failed to open playback");
-
+		m_playback = NULL;
+		return;
 	}
 
 	k4a_playback_get_calibration(m_playback, &m_sensorCalibration);
@@ -95,10 +72,64 @@ void KinectDummy::openDevice()
 
 void KinectDummy::startDevice(bool mode)
 {
+	if (!m_playback)
+		return;
+
+	bodyTrackingInit(mode);
+	m_playbackStart = -1.0;
 	m_state = KS_CAPTURING;
+	startPipeline();
 }
 
 void KinectDummy::stopDevice()
 {
-	m_state = KS_OPENED;
-}
\ No newline at end of file
+	stopPipeline();
+
+#ifdef WITHKINECT
+	if (m_tracker) {
+		m_tracker.shutdown();
+		m_tracker.destroy();
+	}
+#endif
+	if (m_state == KS_CAPTURING)
+		m_state = KS_OPENED;
+}
+
+bool KinectDummy::grab(k4a::capture& capture, double& timestamp)
+{
+#ifdef WITHKINECT
+	k4a_capture_t handle = NULL;
+	k4a_stream_result_t result = k4a_playback_get_next_capture(m_playback, &handle);
+
+	if (result == K4A_STREAM_RESULT_EOF) {
+		k4a_playback_seek_timestamp(m_playback, 0, K4A_PLAYBACK_SEEK_BEGIN);
+		m_playbackStart = -1.0;
+		return false;
+	}
+	if (result != K4A_STREAM_RESULT_SUCCEEDED) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		return false;
+	}
+	capture = k4a::capture(handle);
+
+	k4a::image image = capture.get_depth_image();
+	if (!image.is_valid())
+		image = capture.get_color_image();
+	if (!image.is_valid())
+		return false;
+
+	double recordingTime = image.get_device_timestamp().count() * 0.000001;
+	if (m_playbackStart < 0.0)
+		m_playbackStart = now() - recordingTime;
+
+	timestamp = m_playbackStart + recordingTime;
+	double wait = timestamp - now();
+	if (wait > 0.0)
+		std::this_thread::sleep_for(std::chrono::duration<double>(std::min(wait, 1.0)));
+
+	return true;
+#else
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	return false;
+#endif
+}
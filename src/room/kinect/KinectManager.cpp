@@ -21,17 +21,16 @@
 #include "kinect/KinectRoomNode.hpp"
 #include "kinect/KinectDummy.hpp"
 
+#include <chrono>
+
 act::room::KinectManager::KinectManager() : RoomNodeManagerBase("kinectManager")
 {
 	m_selectedDevice = 0;
 	refreshLists();
-
-	//m_updateThread = std::thread([&]() { while (1) { updateKinects(); }; });
 }
 
 act::room::KinectManager::~KinectManager()
 {
-	//m_updateThread.join();
 	stopDevices();
 }
 
@@ -59,6 +58,22 @@ void act::room::KinectManager::update() {
 		addDummyDevice(path);
 	}	
 
+	if (m_isRecordDialog) {
+		m_isRecordDialog = false;
+		std::vector<std::string> exts;
+		exts.push_back("iarec");
+		std::string path = ci::app::getSaveFilePath(app::getAssetPath("./../recordings/"), exts).string();
+		startRecording(path);
+	}
+
+	if (m_isPlaybackDialog) {
+		m_isPlaybackDialog = false;
+		std::vector<std::string> exts;
+		exts.push_back("iarec");
+		std::string path = ci::app::getOpenFilePath(app::getAssetPath("./../recordings/"), exts).string();
+		startPlayback(path);
+	}
+
 	updateKinects();
 }
 void act::room::KinectManager::updateKinects()
@@ -67,21 +82,81 @@ void act::room::KinectManager::updateKinects()
 		node->update();
 	}
 
-	if (m_devices.size() > 0)
+	if (m_player.isPlaying())
 	{
-		m_bodiesMerged.clear();
-		m_bodiesWithDuplicates.clear();
+		if (m_player.update()) {
+			m_bodiesMerged = m_player.getBodies();
+			if (m_playbackPointcloud && m_player.hasPoints()) {
+				m_playbackPointcloud->setPointcloud(m_player.getPoints());
+				m_playbackPointcloud->update();
+			}
+		}
+	}
+	else if (m_devices.size() > 0)
+	{
+		m_fusion.begin(std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+		size_t sensor = 0;
+		for (auto&& node : m_nodes) {
+			auto kinectNode = std::dynamic_pointer_cast<KinectRoomNode>(node);
+			if (!kinectNode)
+				continue;
+			m_fusion.addBodies(sensor++, kinectNode->getBodyTime(), kinectNode->getRepositionedBodies());
+		}
 
-		for (auto&& device : m_devices) {
-			checkRedundantBodies(device->getRepositionedBodies());
+		m_fusion.end();
+		m_bodiesMerged = m_fusion.getBodies();
+	}
+
+	if (m_recorder.isOpen())
+		record();
+}
+
+void act::room::KinectManager::startRecording(std::string path)
+{
+	if (path.empty())
+		return;
+
+	m_recordedFrames.clear();
+	m_recordedPoints.clear();
+	m_recorder.open(path);
+}
+
+void act::room::KinectManager::startPlayback(std::string path)
+{
+	if (path.empty() || !m_player.open(path))
+		return;
+
+	m_player.play();
+	if (m_player.hasPoints() && !m_playbackPointcloud) {
+		m_playbackPointcloud = createPointcloudRoomNode();
+		m_isPlaybackPointcloudNew = true;
+	}
+}
+
+void act::room::KinectManager::record()
+{
+	m_recorder.addBodies(std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(), m_bodiesMerged);
+
+	m_recordedFrames.resize(m_devices.size(), 0);
+	m_recordedPoints.resize(m_devices.size(), 0);
+	for (size_t i = 0; i < m_devices.size(); i++) {
+		KinectFrameRef frame = m_devices[i]->getLatestFrame();
+		if (frame && frame->sequence != m_recordedFrames[i] && !frame->depth.empty()) {
+			m_recordedFrames[i] = frame->sequence;
+			m_recorder.addDepth(frame->timestamp, frame->depth.getMat(cv::ACCESS_READ), (uint32_t)i);
+		}
+
+		KinectPointsRef points = m_devices[i]->getLatestPoints();
+		if (points && points->sequence != m_recordedPoints[i] && points->points) {
+			m_recordedPoints[i] = points->sequence;
+			m_recorder.addPoints(points->timestamp, *points->points, (uint32_t)i);
 		}
 	}
 }
 
 void act::room::KinectManager::draw()
 {
-	//drawBodySkeletons(m_bodiesWithDuplicates);
-
 	int k_body = 1;
 
 	if (m_colorMapping.size() > 0)
@@ -191,11 +266,61 @@ act::room::RoomNodeBaseRef act::room::KinectManager::drawMenu()
 
 	ImGui::Text("Body Merging");
 
-	ImGui::SliderFloat("Body Merge Threshold (Meter)", &m_bodyClippingThreshold, 0.0f, 2.0f);
+	float gate = m_fusion.getGateDistance();
+	if (ImGui::SliderFloat("Body Merge Threshold (Meter)", &gate, 0.05f, 2.0f))
+		m_fusion.setGateDistance(gate);
 
-	ImGui::Checkbox("Simple Merge Mode", &simpleMergeMode);
+	float missing = m_fusion.getMaxMissingTime();
+	if (ImGui::SliderFloat("Keep Lost Bodies (Seconds)", &missing, 0.0f, 5.0f))
+		m_fusion.setMaxMissingTime(missing);
 
 
+	ImGui::NewLine();
+
+	ImGui::Separator();
+
+	ImGui::Text("Recording");
+
+	if (m_recorder.isOpen()) {
+		ImGui::Text("recording %.1f s", m_recorder.getDuration());
+		if (ImGui::Button("stop recording"))
+			m_recorder.close();
+	}
+	else if (ImGui::Button("record")) {
+		m_isRecordDialog = true;
+	}
+
+	if (m_player.isOpen()) {
+		ImGui::Text("playing %.1f / %.1f s", m_player.getTime(), m_player.getDuration());
+		if (ImGui::Button(m_player.isPlaying() ? "pause" : "play")) {
+			if (m_player.isPlaying())
+				m_player.pause();
+			else
+				m_player.play();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("close recording"))
+			m_player.close();
+
+		bool isRealtime = m_player.isRealtime();
+		if (ImGui::Checkbox("in time (else as fast as possible)", &isRealtime))
+			m_player.setIsRealtime(isRealtime);
+		bool isLooping = m_player.isLooping();
+		if (ImGui::Checkbox("loop", &isLooping))
+			m_player.setIsLooping(isLooping);
+		float speed = m_player.getSpeed();
+		if (ImGui::SliderFloat("speed", &speed, 0.1f, 4.0f))
+			m_player.setSpeed(speed);
+	}
+	else if (ImGui::Button("play recording")) {
+		m_isPlaybackDialog = true;
+	}
+
+	if (m_isPlaybackPointcloudNew) { // collect playback pointcloud
+		m_isPlaybackPointcloudNew = false;
+		return m_playbackPointcloud;
+	}
+
 	ImGui::NewLine();
 
 	ImGui::Separator();
@@ -577,70 +702,9 @@ act::room::BodyRefList act::room::KinectManager::getBodies()
 	return bodies;
 }
 
-void act::room::KinectManager::checkRedundantBodies(std::map<uint32_t, k4abt_skeleton_t> currBodies)
+void act::room::KinectManager::getBodies(room::BodyStore& store)
 {
-	if (m_bodiesMerged.size() == 0) {
-		for (auto&& currBody : currBodies) {
-			m_bodiesMerged.insert(std::make_pair(uint32_t(m_bodiesMerged.size() + 1), currBody.second));
-			m_bodiesWithDuplicates.insert(std::make_pair((m_bodiesWithDuplicates.size() + 1), std::make_pair(currBody.second, 0)));
-		}
-	}
-	else {
-		for (auto&& currBody : currBodies)
-		{
-			k4abt_skeleton_t currSkeleton = currBody.second;
-			k4abt_skeleton_t s_currSkeleton;
-			uint32_t s_currBodyID;
-
-			int duplicateRef = 0;
-
-			for (auto&& s_currBody : m_bodiesMerged)
-			{
-				s_currSkeleton = s_currBody.second;
-				s_currBodyID = s_currBody.first;
-
-				//check for specific joint position
-				int joint = K4ABT_JOINT_SPINE_CHEST;
-
-				float min_distance = 1000.0f;
-
-				for (int i = 0; i < 32; i++) {
-					if (simpleMergeMode) {
-						i = K4ABT_JOINT_SPINE_CHEST;
-					}
-					if (s_currSkeleton.joints[i].confidence_level == k4abt_joint_confidence_level_t::K4ABT_JOINT_CONFIDENCE_MEDIUM)
-						if (s_currSkeleton.joints[i].confidence_level == currSkeleton.joints[i].confidence_level) {
-
-							k4a_float3_t::_xyz s_pos = s_currSkeleton.joints[i].position.xyz;
-							k4a_float3_t::_xyz pos = currSkeleton.joints[i].position.xyz;
-
-							vec3 center = vec3(s_pos.x, s_pos.y, s_pos.z);
-							vec3 point = vec3(pos.x, pos.y, pos.z);
-
-							float distance = hypot(hypot(center.x - point.x, center.y - point.y), center.z - point.z);
-
-							if (distance < min_distance)
-								min_distance = distance;
-						}
-
-					if (simpleMergeMode) {
-						break;
-					}
-				}
-
-				if (min_distance < m_bodyClippingThreshold) {
-					duplicateRef = (int)s_currBodyID;
-				}
-			}
-
-			if (duplicateRef == 0)
-			{
-				m_bodiesMerged.insert(std::make_pair(uint32_t(m_bodiesMerged.size() + 1), currSkeleton));
-			}
-
-			m_bodiesWithDuplicates.insert(std::make_pair(uint32_t(m_bodiesWithDuplicates.size() + 1), std::make_pair(currSkeleton, duplicateRef)));
-		}
-	}
+	kh::toBodyStore(m_bodiesMerged, store);
 }
 
 bool act::room::KinectManager::checkConnectionState(std::string kinectName) {
@@ -0,0 +1,481 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "kinect/KinectRecording.hpp"
+
+#include <chrono>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace act::room::recording;
+
+namespace {
+	const size_t kJointSize = 7 * sizeof(float) + sizeof(int32_t);
+	const size_t kBodySize	= sizeof(uint32_t) + 32 * kJointSize;
+
+	double now()
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+
+act::room::KinectRecorder::KinectRecorder()
+{
+}
+
+act::room::KinectRecorder::~KinectRecorder()
+{
+	close();
+}
+
+bool act::room::KinectRecorder::open(const fs::path& path)
+{
+	close();
+
+	m_file.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open()) {
+		CI_LOG_E("Failed to open recording " << path);
+		return false;
+	}
+
+	uint32_t reserved = 0;
+	m_file.write(kMagic, sizeof(kMagic));
+	m_file.write((const char*)&kVersion, sizeof(kVersion));
+	m_file.write((const char*)&reserved, sizeof(reserved));
+
+	m_offset	= sizeof(kMagic) + 2 * sizeof(uint32_t);
+	m_start		= -1.0;
+	m_duration	= 0.0;
+	m_index.clear();
+	return true;
+}
+
+void act::room::KinectRecorder::close()
+{
+	if (!m_file.is_open())
+		return;
+
+	uint64_t indexOffset	= m_offset;
+	uint64_t indexCount		= m_index.size();
+	m_file.write((const char*)m_index.data(), m_index.size() * sizeof(IndexEntry));
+	m_file.write((const char*)&indexOffset, sizeof(indexOffset));
+	m_file.write((const char*)&indexCount, sizeof(indexCount));
+	m_file.write(kIndexMagic, sizeof(kIndexMagic));
+	m_file.close();
+}
+
+void act::room::KinectRecorder::addBodies(double time, const std::map<uint32_t, k4abt_skeleton_t>& bodies, uint32_t stream)
+{
+	if (!isOpen())
+		return;
+
+	m_buffer.clear();
+	append((uint32_t)bodies.size());
+	for (auto&& body : bodies) {
+		append(body.first);
+		for (int j = 0; j < 32; j++) {
+			const k4abt_joint_t& joint = body.second.joints[j];
+			append((float)joint.position.xyz.x);
+			append((float)joint.position.xyz.y);
+			append((float)joint.position.xyz.z);
+			append((float)joint.orientation.wxyz.w);
+			append((float)joint.orientation.wxyz.x);
+			append((float)joint.orientation.wxyz.y);
+			append((float)joint.orientation.wxyz.z);
+			append((int32_t)joint.confidence_level);
+		}
+	}
+	writeChunk(CT_BODIES, stream, time);
+}
+
+void act::room::KinectRecorder::addDepth(double time, const cv::Mat& depth, uint32_t stream)
+{
+	if (!isOpen() || depth.empty() || depth.type() != CV_16UC1)
+		return;
+
+	m_buffer.clear();
+	append((int32_t)depth.cols);
+	append((int32_t)depth.rows);
+	for (int y = 0; y < depth.rows; y++) {
+		const char* row = (const char*)depth.ptr(y);
+		m_buffer.insert(m_buffer.end(), row, row + depth.cols * sizeof(uint16_t));
+	}
+	writeChunk(CT_DEPTH, stream, time);
+}
+
+void act::room::KinectRecorder::addPoints(double time, const std::vector<glm::vec3>& points, uint32_t stream)
+{
+	if (!isOpen())
+		return;
+
+	m_buffer.clear();
+	append((uint32_t)points.size());
+	const char* data = (const char*)points.data();
+	m_buffer.insert(m_buffer.end(), data, data + points.size() * sizeof(glm::vec3));
+	writeChunk(CT_POINTS, stream, time);
+}
+
+void act::room::KinectRecorder::writeChunk(ChunkType type, uint32_t stream, double time)
+{
+	if (m_start < 0.0)
+		m_start = time;
+	double timestamp = std::max(time - m_start, m_duration); // keeps the chunks in order
+
+	ChunkHeader header	= { type, stream, timestamp, m_buffer.size() };
+	m_index.push_back({ type, stream, timestamp, m_offset });
+
+	size_t padding = (8 - m_buffer.size() % 8) % 8;
+	m_buffer.insert(m_buffer.end(), padding, 0);
+
+	m_file.write((const char*)&header, sizeof(header));
+	m_file.write(m_buffer.data(), m_buffer.size());
+
+	m_offset	+= sizeof(header) + m_buffer.size();
+	m_duration	= timestamp;
+}
+
+
+act::room::KinectRecordingPlayer::KinectRecordingPlayer()
+{
+}
+
+act::room::KinectRecordingPlayer::~KinectRecordingPlayer()
+{
+	close();
+}
+
+bool act::room::KinectRecordingPlayer::open(const fs::path& path)
+{
+	close();
+
+	if (!map(path)) {
+		CI_LOG_E("Failed to open recording " << path);
+		return false;
+	}
+
+	size_t headerSize = sizeof(kMagic) + 2 * sizeof(uint32_t);
+	if (m_size < headerSize || memcmp(m_data, kMagic, sizeof(kMagic)) != 0 || read<uint32_t>(sizeof(kMagic)) > kVersion) {
+		CI_LOG_E("Not a supported recording " << path);
+		close();
+		return false;
+	}
+
+	// the chunks are checked once here, so reading them later needs no checks
+	if (!readIndex() || !std::all_of(m_index.begin(), m_index.end(), [this](const IndexEntry& entry) { return isValidChunk(entry); }))
+		scanIndex();
+
+	std::stable_sort(m_index.begin(), m_index.end(), [](const IndexEntry& a, const IndexEntry& b) { return a.timestamp < b.timestamp; });
+
+	m_duration	= m_index.empty() ? 0.0 : m_index.back().timestamp;
+	m_hasPoints	= std::any_of(m_index.begin(), m_index.end(), [](const IndexEntry& entry) { return entry.type == CT_POINTS; });
+
+	seek(0.0);
+	return true;
+}
+
+void act::room::KinectRecordingPlayer::close()
+{
+	m_isPlaying = false;
+	m_index.clear();
+	m_bodies.clear();
+	m_depthChunks.clear();
+	m_pointChunks.clear();
+	m_pointCache.clear();
+	unmap();
+}
+
+void act::room::KinectRecordingPlayer::play()
+{
+	if (!isOpen())
+		return;
+
+	m_isPlaying = true;
+	m_playStart = -1.0;
+}
+
+void act::room::KinectRecordingPlayer::seek(double time)
+{
+	m_bodies.clear();
+	m_depthChunks.clear();
+	m_pointChunks.clear();
+	m_cursor	= 0;
+	m_time		= 0.0;
+	m_playStart	= -1.0;
+
+	readUntil(std::clamp(time, 0.0, m_duration));
+}
+
+bool act::room::KinectRecordingPlayer::update()
+{
+	if (!m_isPlaying || m_index.empty())
+		return false;
+
+	if (m_cursor >= m_index.size()) {
+		if (!m_isLooping) {
+			m_isPlaying = false;
+			return false;
+		}
+		seek(0.0);
+	}
+
+	size_t cursor = m_cursor;
+	if (m_isRealtime) {
+		if (m_playStart < 0.0)
+			m_playStart = now() - m_time / m_speed;
+		readUntil((now() - m_playStart) * m_speed);
+	}
+	else {
+		// up to and including the next bodies, or the next chunk if there are no more bodies
+		size_t next = m_cursor;
+		while (next < m_index.size() && m_index[next].type != CT_BODIES)
+			next++;
+		readUntil(m_index[std::min(next, m_index.size() - 1)].timestamp);
+	}
+	return m_cursor != cursor;
+}
+
+void act::room::KinectRecordingPlayer::readUntil(double time)
+{
+	while (m_cursor < m_index.size() && m_index[m_cursor].timestamp <= time) {
+		readChunk(m_index[m_cursor]);
+		m_cursor++;
+	}
+	m_time = std::max(m_time, std::min(time, m_duration));
+}
+
+void act::room::KinectRecordingPlayer::readChunk(const IndexEntry& entry)
+{
+	switch (entry.type) {
+	case CT_BODIES:
+		if (entry.stream == 0) {
+			readBodies(entry.offset);
+			m_bodyTime = entry.timestamp;
+		}
+		break;
+	case CT_DEPTH:
+		m_depthChunks[entry.stream] = entry.offset;
+		break;
+	case CT_POINTS:
+		m_pointChunks[entry.stream] = entry.offset;
+		break;
+	}
+}
+
+void act::room::KinectRecordingPlayer::readBodies(uint64_t offset)
+{
+	ChunkHeader header	= read<ChunkHeader>(offset);
+	uint64_t payload	= offset + sizeof(ChunkHeader);
+	uint32_t count		= read<uint32_t>(payload);
+	if (sizeof(uint32_t) + (uint64_t)count * kBodySize > header.size) // checked in open()
+		return;
+
+	m_bodies.clear();
+	uint64_t position = payload + sizeof(uint32_t);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t id = read<uint32_t>(position);
+		position += sizeof(uint32_t);
+
+		k4abt_skeleton_t& skeleton = m_bodies[id];
+		for (int j = 0; j < 32; j++) {
+			float values[7];
+			memcpy(values, m_data + position, sizeof(values));
+			k4abt_joint_t& joint = skeleton.joints[j];
+			joint.position.xyz.x		= values[0];
+			joint.position.xyz.y		= values[1];
+			joint.position.xyz.z		= values[2];
+			joint.orientation.wxyz.w	= values[3];
+			joint.orientation.wxyz.x	= values[4];
+			joint.orientation.wxyz.y	= values[5];
+			joint.orientation.wxyz.z	= values[6];
+			joint.confidence_level		= (k4abt_joint_confidence_level_t)read<int32_t>(position + sizeof(values));
+			position += kJointSize;
+		}
+	}
+}
+
+cv::Mat act::room::KinectRecordingPlayer::getDepth(uint32_t stream)
+{
+	auto chunk = m_depthChunks.find(stream);
+	if (chunk == m_depthChunks.end())
+		return cv::Mat();
+
+	uint64_t payload	= chunk->second + sizeof(ChunkHeader);
+	int width			= read<int32_t>(payload);
+	int height			= read<int32_t>(payload + sizeof(int32_t));
+
+	// chunks are 8-byte aligned, so are the pixels behind width and height
+	return cv::Mat(height, width, CV_16UC1, (void*)(m_data + payload + 2 * sizeof(int32_t)));
+}
+
+std::shared_ptr<std::vector<glm::vec3>> act::room::KinectRecordingPlayer::getPoints(uint32_t stream)
+{
+	auto chunk = m_pointChunks.find(stream);
+	if (chunk == m_pointChunks.end())
+		return nullptr;
+
+	auto& cached = m_pointCache[stream];
+	if (cached.second && cached.first == chunk->second)
+		return cached.second;
+
+	uint64_t payload	= chunk->second + sizeof(ChunkHeader);
+	uint32_t count		= read<uint32_t>(payload);
+
+	auto points = std::make_shared<std::vector<glm::vec3>>(count);
+	memcpy(points->data(), m_data + payload + sizeof(uint32_t), count * sizeof(glm::vec3));
+
+	cached = std::make_pair(chunk->second, points);
+	return points;
+}
+
+bool act::room::KinectRecordingPlayer::readIndex()
+{
+	size_t footerSize = 2 * sizeof(uint64_t) + sizeof(kIndexMagic);
+	if (m_size < footerSize || memcmp(m_data + m_size - sizeof(kIndexMagic), kIndexMagic, sizeof(kIndexMagic)) != 0)
+		return false;
+
+	uint64_t indexOffset	= read<uint64_t>(m_size - footerSize);
+	uint64_t indexCount		= read<uint64_t>(m_size - footerSize + sizeof(uint64_t));
+	if (indexCount > m_size / sizeof(IndexEntry) || indexOffset > m_size || indexOffset + indexCount * sizeof(IndexEntry) + footerSize != m_size)
+		return false;
+
+	m_index.resize(indexCount);
+	memcpy(m_index.data(), m_data + indexOffset, indexCount * sizeof(IndexEntry));
+	return true;
+}
+
+void act::room::KinectRecordingPlayer::scanIndex()
+{
+	CI_LOG_W("Recording has no index, scanning its chunks");
+
+	m_index.clear();
+	uint64_t offset = sizeof(kMagic) + 2 * sizeof(uint32_t);
+	while (offset + sizeof(ChunkHeader) <= m_size) {
+		ChunkHeader header = read<ChunkHeader>(offset);
+		uint64_t size = header.size + (8 - header.size % 8) % 8;
+		if (header.type < CT_BODIES || header.type > CT_POINTS || header.size > m_size || offset + sizeof(ChunkHeader) + size > m_size)
+			break; // truncated
+
+		IndexEntry entry = { header.type, header.stream, header.timestamp, offset };
+		if (isValidChunk(entry))
+			m_index.push_back(entry);
+		else
+			CI_LOG_W("Skipping corrupt chunk at " << offset);
+		offset += sizeof(ChunkHeader) + size;
+	}
+}
+
+bool act::room::KinectRecordingPlayer::isValidChunk(const IndexEntry& entry)
+{
+	if (entry.offset > m_size || m_size - entry.offset < sizeof(ChunkHeader))
+		return false;
+
+	ChunkHeader header	= read<ChunkHeader>(entry.offset);
+	uint64_t payload	= entry.offset + sizeof(ChunkHeader);
+	if (header.type != entry.type || header.size > m_size - payload)
+		return false;
+
+	switch (header.type) {
+	case CT_BODIES: {
+		if (header.size < sizeof(uint32_t))
+			return false;
+		uint64_t count = read<uint32_t>(payload);
+		return sizeof(uint32_t) + count * kBodySize <= header.size;
+	}
+	case CT_DEPTH: {
+		if (header.size < 2 * sizeof(int32_t))
+			return false;
+		int64_t width	= read<int32_t>(payload);
+		int64_t height	= read<int32_t>(payload + sizeof(int32_t));
+		return width >= 0 && height >= 0 && 2 * sizeof(int32_t) + (uint64_t)(width * height) * sizeof(uint16_t) <= header.size;
+	}
+	case CT_POINTS: {
+		if (header.size < sizeof(uint32_t))
+			return false;
+		uint64_t count = read<uint32_t>(payload);
+		return sizeof(uint32_t) + count * sizeof(glm::vec3) <= header.size;
+	}
+	}
+	return false;
+}
+
+bool act::room::KinectRecordingPlayer::map(const fs::path& path)
+{
+#ifdef _WIN32
+	m_fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_fileHandle, &size) || size.QuadPart == 0) {
+		unmap();
+		return false;
+	}
+
+	m_mapping = CreateFileMappingW(m_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!m_mapping) {
+		unmap();
+		return false;
+	}
+
+	m_data = (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+	m_size = (size_t)size.QuadPart;
+#else
+	int file = ::open(path.string().c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0) {
+		::close(file);
+		return false;
+	}
+
+	void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (data == MAP_FAILED)
+		return false;
+
+	m_data = (const uint8_t*)data;
+	m_size = (size_t)info.st_size;
+#endif
+	return m_data != nullptr;
+}
+
+void act::room::KinectRecordingPlayer::unmap()
+{
+#ifdef _WIN32
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(m_fileHandle);
+	m_mapping		= NULL;
+	m_fileHandle	= INVALID_HANDLE_VALUE;
+#else
+	if (m_data)
+		munmap((void*)m_data, m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
@@ -24,12 +24,28 @@ act::room::KinectRoomNode::KinectRoomNode(KinectDeviceRef kinect, std::string de
 {
 	m_isProvidingPointCloud = true;
 	m_kinect = kinect;
+
+	// fromParams only applies values that differ from these, so the device starts with them
+	if (m_kinect) {
+		m_kinect->setIsProvidingPointCloud(m_isProvidingPointCloud);
+		m_kinect->setPointCloudVoxelSize(m_pointCloudVoxelSize);
+	}
 	setPosition(position);
 	setRotation(rotation);
 
 	m_deviceName = deviceName;
 	setCaption("Kinect - " + name);
 
+	m_params.add("isProvidingPointCloud", m_isProvidingPointCloud, [&]() {
+		if (m_kinect)
+			m_kinect->setIsProvidingPointCloud(m_isProvidingPointCloud);
+	});
+	m_params.add("latency", m_latency, 0.0f, 0.5f, 0.001f, nullptr, "%.3f s");
+	m_params.add("pointCloudVoxelSize", m_pointCloudVoxelSize, 0.0f, 0.2f, 0.001f, [&]() {
+		if (m_kinect)
+			m_kinect->setPointCloudVoxelSize(m_pointCloudVoxelSize);
+	}, "%.3f m");
+
 	if (m_kinect)
 	{
 		m_kinect->setNodeUID(getUID());
@@ -70,8 +86,6 @@ void act::room::KinectRoomNode::update()
 
 	if (m_kinect != nullptr) {
 
-		m_captureBodies.clear();
-
 		m_kinect->update();
 
 		if (m_kinect) {
@@ -91,12 +105,12 @@ void act::room::KinectRoomNode::update()
 				m_captureBIM = m_kinect->getBIMFrame();
 				m_kinect->m_isBodyIndexFrameAvailable = false;
 			}
-			//if (m_kinect->m_areBodiesAvailable) {
+			if (m_kinect->m_areBodiesAvailable) {
 				m_captureBodies = m_kinect->getBodyMap();
 				m_kinect->m_areBodiesAvailable = false;
-			//}
+			}
 			if (m_kinect->m_isPointCloudAvailable) {
-				//m_pointcloud = m_kinect->getPointCloud();
+				m_pointcloud = m_kinect->getPointCloud();
 				m_kinect->m_isPointCloudAvailable = false;
 				m_pointcloudRoomNode->setPointcloud(m_pointcloud);
 				m_pointcloudRoomNode->update();
@@ -150,32 +164,6 @@ void act::room::KinectRoomNode::draw()
 	gl::popMatrices();
 }
 
-void act::room::KinectRoomNode::drawSpecificSettings()
-{
-	if (!m_kinect)
-		return;
-
-	if (ImGui::Checkbox("provide PointCloud", &m_isProvidingPointCloud))
-		m_kinect->setIsProvidingPointCloud(m_isProvidingPointCloud);
-
-}
-
-ci::Json act::room::KinectRoomNode::toParams()
-{
-	ci::Json json = ci::Json::object();
-
-	json["isProvidingPointCloud"] = m_isProvidingPointCloud;
-
-	return json;
-}
-
-void act::room::KinectRoomNode::fromParams(ci::Json json)
-{
-	util::setValueFromJson(json, "isProvidingPointCloud", m_isProvidingPointCloud);
-	if (m_kinect)
-		m_kinect->setIsProvidingPointCloud(m_isProvidingPointCloud);
-}
-
 void act::room::KinectRoomNode::initCameraPersp(int width, int height)
 {
 	m_captureSize = ivec2(width, height);
@@ -186,12 +174,13 @@ std::map<uint32_t, k4abt_skeleton_t> act::room::KinectRoomNode::repositionBodies
 {
 	std::map<uint32_t, k4abt_skeleton_t> retMap;
 #ifdef WITHKINECT
+	ci::mat4 extrinsics = getExtrinsics();
 	for (auto&& body : bodyMap)
 	{
 		for (int i = 0; i < 32; i++)
 		{
 			k4a_float3_t::_xyz kinPos = body.second.joints[i].position.xyz;
-			vec3 newPos = calcRoomPos(vec3(kinPos.x, kinPos.y, kinPos.z));
+			vec3 newPos = calcRoomPos(vec3(kinPos.x, kinPos.y, kinPos.z), extrinsics);
 
 			body.second.joints[i].position.xyz.x = newPos.x;
 			body.second.joints[i].position.xyz.y = newPos.y;
@@ -204,7 +193,12 @@ std::map<uint32_t, k4abt_skeleton_t> act::room::KinectRoomNode::repositionBodies
 	return retMap;
 }
 
-vec3 act::room::KinectRoomNode::calcRoomPos(vec3 pos)
+ci::mat4 act::room::KinectRoomNode::getExtrinsics()
+{
+	return ci::translate(m_position - m_offsetPosition) * glm::toMat4(ci::quat(m_rotation - m_offsetRotation));
+}
+
+vec3 act::room::KinectRoomNode::calcRoomPos(vec3 pos, const ci::mat4& extrinsics)
 {
 	//TODO: tilt 1.3 degrees if using WFOV depth mode
 	//https://docs.microsoft.com/en-us/azure/kinect-dk/coordinate-systems
@@ -218,10 +212,7 @@ vec3 act::room::KinectRoomNode::calcRoomPos(vec3 pos)
 		pos *= (0.001f); //mm to m
 	}
 
-	pos = glm::rotateY(pos, m_rotation.y - m_offsetRotation.y);
-	pos += (m_position - m_offsetPosition);
-
-	return pos;
+	return ci::vec3(extrinsics * ci::vec4(pos, 1.0f));
 }
 
 act::room::Pointcloud act::room::KinectRoomNode::getWorldSpacePointCloud() {
@@ -0,0 +1,145 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "pointcloud/PointcloudFilter.hpp"
+
+#include <unordered_map>
+
+
+void act::room::PointcloudFilter::sortByCell(const std::vector<glm::vec3>& points, float cellSize, std::vector<std::pair<uint64_t, uint32_t>>& sorted)
+{
+	float inverse = 1.0f / cellSize;
+
+	sorted.resize(points.size());
+	parallelFor(points.size(), [&](size_t i) {
+		sorted[i] = std::make_pair(cellKey(glm::ivec3(glm::floor(points[i] * inverse))), (uint32_t)i);
+	});
+
+	// ties are ordered by index, so the result does not depend on the sort
+#ifdef _WIN32
+	concurrency::parallel_sort(sorted.begin(), sorted.end());
+#else
+	std::sort(sorted.begin(), sorted.end());
+#endif
+}
+
+void act::room::PointcloudFilter::voxelDownsample(const std::vector<glm::vec3>& points, float voxelSize, std::vector<glm::vec3>& result)
+{
+	result.clear();
+	if (voxelSize <= 0.0f) {
+		result = points;
+		return;
+	}
+
+	std::vector<std::pair<uint64_t, uint32_t>> sorted;
+	sortByCell(points, voxelSize, sorted);
+
+	for (size_t begin = 0; begin < sorted.size(); ) {
+		size_t end = begin;
+		glm::vec3 sum(0.0f);
+		while (end < sorted.size() && sorted[end].first == sorted[begin].first)
+			sum += points[sorted[end++].second];
+
+		result.push_back(sum / (float)(end - begin));
+		begin = end;
+	}
+}
+
+void act::room::PointcloudFilter::removeOutliers(const std::vector<glm::vec3>& points, int neighbors, float stddevMultiplier, float searchRadius, std::vector<glm::vec3>& result)
+{
+	static const int kMaxNeighbors = 64;
+
+	result.clear();
+	if (points.empty() || neighbors <= 0 || searchRadius <= 0.0f) {
+		result = points;
+		return;
+	}
+	neighbors = std::min(neighbors, kMaxNeighbors);
+
+	// uniform grid with cells as large as the search radius, the 27 cells around a point cover it
+	std::vector<std::pair<uint64_t, uint32_t>> sorted;
+	sortByCell(points, searchRadius, sorted);
+
+	std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> cells;
+	cells.reserve(sorted.size() / 4 + 1);
+	for (uint32_t begin = 0; begin < (uint32_t)sorted.size(); ) {
+		uint32_t end = begin;
+		while (end < sorted.size() && sorted[end].first == sorted[begin].first)
+			end++;
+		cells[sorted[begin].first] = std::make_pair(begin, end);
+		begin = end;
+	}
+
+	float inverse		= 1.0f / searchRadius;
+	float radiusSq		= searchRadius * searchRadius;
+	std::vector<float> meanDistances(points.size());
+
+	parallelFor(points.size(), [&](size_t i) {
+		const glm::vec3& point = points[i];
+		glm::ivec3 cell = glm::ivec3(glm::floor(point * inverse));
+
+		// the k smallest squared distances, sorted ascending
+		float nearest[kMaxNeighbors];
+		int found = 0;
+
+		for (int z = -1; z <= 1; z++) {
+			for (int y = -1; y <= 1; y++) {
+				for (int x = -1; x <= 1; x++) {
+					auto it = cells.find(cellKey(cell + glm::ivec3(x, y, z)));
+					if (it == cells.end())
+						continue;
+
+					for (uint32_t n = it->second.first; n < it->second.second; n++) {
+						uint32_t other = sorted[n].second;
+						if (other == i)
+							continue;
+						float distanceSq = glm::distance2(point, points[other]);
+						if (distanceSq > radiusSq || (found == neighbors && distanceSq >= nearest[found - 1]))
+							continue;
+
+						int slot = found < neighbors ? found++ : found - 1;
+						while (slot > 0 && nearest[slot - 1] > distanceSq) {
+							nearest[slot] = nearest[slot - 1];
+							slot--;
+						}
+						nearest[slot] = distanceSq;
+					}
+				}
+			}
+		}
+
+		float sum = (neighbors - found) * searchRadius;
+		for (int n = 0; n < found; n++)
+			sum += sqrtf(nearest[n]);
+		meanDistances[i] = sum / neighbors;
+	});
+
+	double mean = 0.0, meanSq = 0.0;
+	for (float distance : meanDistances) {
+		mean	+= distance;
+		meanSq	+= (double)distance * distance;
+	}
+	mean	/= points.size();
+	meanSq	/= points.size();
+	float threshold = (float)(mean + stddevMultiplier * sqrt(std::max(0.0, meanSq - mean * mean)));
+
+	result.reserve(points.size());
+	for (size_t i = 0; i < points.size(); i++) {
+		if (meanDistances[i] <= threshold)
+			result.push_back(points[i]);
+	}
+}
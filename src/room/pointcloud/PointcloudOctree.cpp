@@ -0,0 +1,329 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "pointcloud/PointcloudOctree.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define OCTREE_SSE
+#endif
+
+
+act::room::PointcloudOctree::PointcloudOctree(ci::vec3 center, float halfSize, float minCellSize, uint32_t leafCapacity)
+{
+	m_initialCenter		= center;
+	m_initialHalfSize	= std::max(minCellSize, halfSize);
+	m_minCellSize		= std::max(0.001f, minCellSize);
+	m_leafCapacity		= std::max(1u, leafCapacity);
+	clear();
+}
+
+act::room::PointcloudOctree::~PointcloudOctree()
+{
+}
+
+void act::room::PointcloudOctree::clear()
+{
+	m_nodes.resize(1);
+	m_nodes[0] = Node();
+	m_nodes[0].center	= m_initialCenter;
+	m_nodes[0].halfSize	= m_initialHalfSize;
+}
+
+ci::AxisAlignedBox act::room::PointcloudOctree::getBounds()
+{
+	const Node& root = m_nodes[0];
+	return ci::AxisAlignedBox(root.center - ci::vec3(root.halfSize), root.center + ci::vec3(root.halfSize));
+}
+
+void act::room::PointcloudOctree::insert(const std::vector<ci::vec3>& points)
+{
+	for (auto&& point : points)
+		insert(point);
+}
+
+void act::room::PointcloudOctree::insert(const ci::vec3& point)
+{
+	if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z))
+		return;
+
+	while (glm::any(glm::greaterThan(glm::abs(point - m_nodes[0].center), ci::vec3(m_nodes[0].halfSize))))
+		grow(point);
+
+	int32_t index = 0;
+	while (true) {
+		m_nodes[index].count++;
+		if (m_nodes[index].children < 0)
+			break;
+		index = m_nodes[index].children + octant(m_nodes[index], point);
+	}
+
+	Node& leaf = m_nodes[index];
+	leaf.x.push_back(point.x);
+	leaf.y.push_back(point.y);
+	leaf.z.push_back(point.z);
+
+	if (leaf.x.size() > m_leafCapacity && leaf.halfSize * 0.5f >= m_minCellSize)
+		split(index);
+}
+
+void act::room::PointcloudOctree::grow(const ci::vec3& towards)
+{
+	// the old root becomes a child of a root twice its size, extended towards the point
+	Node old = std::move(m_nodes[0]);
+	ci::vec3 direction(towards.x >= old.center.x ? 1.0f : -1.0f, towards.y >= old.center.y ? 1.0f : -1.0f, towards.z >= old.center.z ? 1.0f : -1.0f);
+
+	Node root;
+	root.center		= old.center + direction * old.halfSize;
+	root.halfSize	= old.halfSize * 2.0f;
+	root.count		= old.count;
+
+	int32_t first = allocateChildren(root);
+	m_nodes[first + octant(root, old.center)] = std::move(old);
+
+	root.children = first;
+	m_nodes[0] = std::move(root);
+}
+
+void act::room::PointcloudOctree::split(int32_t index)
+{
+	int32_t first = allocateChildren(m_nodes[index]);
+
+	Node& node = m_nodes[index];
+	node.children = first;
+	for (size_t i = 0; i < node.x.size(); i++) {
+		ci::vec3 point(node.x[i], node.y[i], node.z[i]);
+		Node& child = m_nodes[first + octant(node, point)];
+		child.x.push_back(point.x);
+		child.y.push_back(point.y);
+		child.z.push_back(point.z);
+		child.count++;
+	}
+	node.x = std::vector<float>();
+	node.y = std::vector<float>();
+	node.z = std::vector<float>();
+
+	// all points may have ended up in one child
+	for (int i = 0; i < 8; i++) {
+		Node& child = m_nodes[first + i];
+		if (child.x.size() > m_leafCapacity && child.halfSize * 0.5f >= m_minCellSize)
+			split(first + i);
+	}
+}
+
+int32_t act::room::PointcloudOctree::allocateChildren(const Node& parent)
+{
+	// parent may be an element of m_nodes, so it is copied before resizing
+	ci::vec3 center		= parent.center;
+	float quarter		= parent.halfSize * 0.5f;
+
+	int32_t first = (int32_t)m_nodes.size();
+	m_nodes.resize(m_nodes.size() + 8);
+	for (int i = 0; i < 8; i++) {
+		Node& child		= m_nodes[first + i];
+		child.center	= center + ci::vec3(i & 1 ? quarter : -quarter, i & 2 ? quarter : -quarter, i & 4 ? quarter : -quarter);
+		child.halfSize	= quarter;
+	}
+	return first;
+}
+
+int act::room::PointcloudOctree::octant(const Node& node, const ci::vec3& point)
+{
+	return (point.x >= node.center.x ? 1 : 0) | (point.y >= node.center.y ? 2 : 0) | (point.z >= node.center.z ? 4 : 0);
+}
+
+int act::room::PointcloudOctree::classify(const Node& node, const ci::vec3& min, const ci::vec3& max)
+{
+	ci::vec3 nodeMin = node.center - ci::vec3(node.halfSize);
+	ci::vec3 nodeMax = node.center + ci::vec3(node.halfSize);
+
+	if (glm::any(glm::greaterThan(nodeMin, max)) || glm::any(glm::lessThan(nodeMax, min)))
+		return 0;
+	if (glm::all(glm::greaterThanEqual(nodeMin, min)) && glm::all(glm::lessThanEqual(nodeMax, max)))
+		return 2;
+	return 1;
+}
+
+size_t act::room::PointcloudOctree::countLeafInBox(const Node& node, const ci::vec3& min, const ci::vec3& max)
+{
+	size_t count	= 0;
+	size_t n		= node.x.size();
+	size_t i		= 0;
+	const float* x	= node.x.data();
+	const float* y	= node.y.data();
+	const float* z	= node.z.data();
+
+#ifdef OCTREE_SSE
+	static const int bits[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+	__m128 minX = _mm_set1_ps(min.x), minY = _mm_set1_ps(min.y), minZ = _mm_set1_ps(min.z);
+	__m128 maxX = _mm_set1_ps(max.x), maxY = _mm_set1_ps(max.y), maxZ = _mm_set1_ps(max.z);
+	for (; i + 4 <= n; i += 4) {
+		__m128 px = _mm_loadu_ps(x + i);
+		__m128 py = _mm_loadu_ps(y + i);
+		__m128 pz = _mm_loadu_ps(z + i);
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(px, minX), _mm_cmple_ps(px, maxX));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(py, minY), _mm_cmple_ps(py, maxY)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(pz, minZ), _mm_cmple_ps(pz, maxZ)));
+		count += bits[_mm_movemask_ps(inside)];
+	}
+#endif
+	for (; i < n; i++) {
+		if (x[i] >= min.x && x[i] <= max.x && y[i] >= min.y && y[i] <= max.y && z[i] >= min.z && z[i] <= max.z)
+			count++;
+	}
+	return count;
+}
+
+template<typename F>
+bool act::room::PointcloudOctree::visit(const ci::vec3& min, const ci::vec3& max, F&& fn)
+{
+	// fn(node, classification) returns false to stop, nodes inside are not descended
+	m_stack.clear();
+	m_stack.push_back(0);
+	while (!m_stack.empty()) {
+		int32_t index = m_stack.back();
+		m_stack.pop_back();
+
+		const Node& node = m_nodes[index];
+		if (node.count == 0)
+			continue;
+
+		int classification = classify(node, min, max);
+		if (classification == 0)
+			continue;
+
+		if (classification == 1 && node.children >= 0) {
+			for (int i = 0; i < 8; i++)
+				m_stack.push_back(node.children + i);
+			continue;
+		}
+		if (!fn(index, classification))
+			return false;
+	}
+	return true;
+}
+
+void act::room::PointcloudOctree::collect(int32_t index, std::vector<ci::vec3>& result)
+{
+	m_subtree.assign(1, index);
+	while (!m_subtree.empty()) {
+		const Node& node = m_nodes[m_subtree.back()];
+		m_subtree.pop_back();
+		if (node.children >= 0) {
+			for (int i = 0; i < 8; i++)
+				m_subtree.push_back(node.children + i);
+			continue;
+		}
+		for (size_t i = 0; i < node.x.size(); i++)
+			result.push_back(ci::vec3(node.x[i], node.y[i], node.z[i]));
+	}
+}
+
+size_t act::room::PointcloudOctree::countInBox(const ci::AxisAlignedBox& box)
+{
+	size_t count = 0;
+	ci::vec3 min = box.getMin(), max = box.getMax();
+	visit(min, max, [&](int32_t index, int classification) {
+		count += classification == 2 ? m_nodes[index].count : countLeafInBox(m_nodes[index], min, max);
+		return true;
+	});
+	return count;
+}
+
+void act::room::PointcloudOctree::getPointsInBox(const ci::AxisAlignedBox& box, std::vector<ci::vec3>& result)
+{
+	result.clear();
+	ci::vec3 min = box.getMin(), max = box.getMax();
+
+	visit(min, max, [&](int32_t index, int classification) {
+		if (classification == 2) {
+			collect(index, result);
+			return true;
+		}
+
+		const Node& leaf = m_nodes[index];
+		for (size_t i = 0; i < leaf.x.size(); i++) {
+			ci::vec3 point(leaf.x[i], leaf.y[i], leaf.z[i]);
+			if (glm::all(glm::greaterThanEqual(point, min)) && glm::all(glm::lessThanEqual(point, max)))
+				result.push_back(point);
+		}
+		return true;
+	});
+}
+
+size_t act::room::PointcloudOctree::countInSphere(ci::vec3 center, float radius)
+{
+	size_t count	= 0;
+	float radiusSq	= radius * radius;
+	ci::vec3 min	= center - ci::vec3(radius), max = center + ci::vec3(radius);
+
+	visit(min, max, [&](int32_t index, int classification) {
+		// a node is only inside the sphere if its farthest corner is
+		const Node& node = m_nodes[index];
+		ci::vec3 farthest = glm::abs(node.center - center) + ci::vec3(node.halfSize);
+		if (glm::dot(farthest, farthest) <= radiusSq) {
+			count += node.count;
+			return true;
+		}
+
+		m_batch.clear();
+		collect(index, m_batch);
+		for (auto&& point : m_batch) {
+			if (glm::distance2(point, center) <= radiusSq)
+				count++;
+		}
+		return true;
+	});
+	return count;
+}
+
+size_t act::room::PointcloudOctree::countInVolume(BoundingBase& volume)
+{
+	ci::AxisAlignedBox bounds = volume.getWorldBounds();
+	size_t count = 0;
+
+	m_batch.clear();
+	auto flush = [&]() {
+		m_batchResult.resize(m_batch.size());
+		volume.containsPoints(m_batch.data(), m_batch.size(), m_batchResult.data());
+		for (uint8_t inside : m_batchResult)
+			count += inside;
+		m_batch.clear();
+	};
+
+	visit(bounds.getMin(), bounds.getMax(), [&](int32_t index, int classification) {
+		collect(index, m_batch);
+		if (m_batch.size() >= 1024)
+			flush();
+		return true;
+	});
+	flush();
+
+	return count;
+}
+
+bool act::room::PointcloudOctree::isOccupied(const ci::AxisAlignedBox& box, size_t minPoints)
+{
+	size_t count = 0;
+	ci::vec3 min = box.getMin(), max = box.getMax();
+	visit(min, max, [&](int32_t index, int classification) {
+		count += classification == 2 ? m_nodes[index].count : countLeafInBox(m_nodes[index], min, max);
+		return count < minPoints;
+	});
+	return count >= minPoints;
+}
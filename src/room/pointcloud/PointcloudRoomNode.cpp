@@ -98,8 +98,8 @@ void act::room::PointcloudRoomNode::draw()
 
 		//m_mesh->draw();
 
-        if(m_geometry)
-            m_geometry->draw();
+        if(m_geometry && m_numPoints > 0)
+            m_geometry->draw(0, m_numPoints);
 
 		/*for (int i = 0; i < m_pointcloud->size(); i += 10) { // skipping a lot of points for debug/performance reasons
 			auto pt = m_pointcloud->at(i);
@@ -126,55 +126,65 @@ void act::room::PointcloudRoomNode::setPointcloud(act::room::Pointcloud pointclo
 
     m_pointcloud = pointcloud;
 
-    if (m_numPoints != m_pointcloud->size())
-        createPointCloud();
-    else
-        updatePointCloud();
+    const std::vector<vec3>* positions = m_pointcloud.get();
+    if (m_voxelSize > 0.0f) {
+        PointcloudFilter::voxelDownsample(*m_pointcloud, m_voxelSize, m_downsampled);
+        positions = &m_downsampled;
+    }
+
+    if (positions->empty()) {
+        m_numPoints = 0;
+        return;
+    }
+
+    // grows by half, so a slightly changing number of points does not reallocate every frame
+    if ((int)positions->size() > m_capacity || !m_geometry)
+        createPointCloud((int)positions->size() + (int)positions->size() / 2);
+
+    updatePointCloud(*positions);
 }
 
-void act::room::PointcloudRoomNode::createPointCloud()
+void act::room::PointcloudRoomNode::createPointCloud(int capacity)
 {
-    m_numPoints = m_pointcloud->size();
-    m_positions.resize(m_numPoints);
-    m_colors.resize(m_numPoints);
-    m_sizes.resize(m_numPoints);
-
-    for (int i = 0; i < m_numPoints; i++)
-    {
-        auto&& pt = m_pointcloud->at(i);
-        m_positions[i] = vec3(pt.x, pt.y, pt.z);
-
-        m_sizes[i] = 0.5f; //pt.z * 0.5f;
-        m_colors[i] = ci::Colorf(pt.r, pt.g, pt.b);
-    }
+    m_capacity = std::max(capacity, 1);
+
+    // color and size are the same for all points and never change
+    std::vector<ci::Colorf> colors(m_capacity, ci::Colorf::gray(0.6f));
+    std::vector<float>      sizes(m_capacity, 0.5f);
 
     auto posLayout = gl::VboMesh::Layout().attrib(geom::POSITION, 3).usage(GL_DYNAMIC_DRAW); // Because these update every frame
-    auto colorAndSizeLayout = gl::VboMesh::Layout().attrib(geom::COLOR, 3).attrib(geom::CUSTOM_0, 1).usage(GL_DYNAMIC_DRAW); // GL_STATIC_DRAW if dont
+    auto colorAndSizeLayout = gl::VboMesh::Layout().attrib(geom::COLOR, 3).attrib(geom::CUSTOM_0, 1).usage(GL_STATIC_DRAW);
 
-    auto mesh = gl::VboMesh::create(m_numPoints, GL_POINTS, { posLayout, colorAndSizeLayout });
-    mesh->bufferAttrib(geom::POSITION, m_positions);
-    mesh->bufferAttrib(geom::COLOR, m_colors);
-    mesh->bufferAttrib(geom::CUSTOM_0, m_sizes);
+    auto mesh = gl::VboMesh::create(m_capacity, GL_POINTS, { posLayout, colorAndSizeLayout });
+    mesh->bufferAttrib(geom::COLOR, colors);
+    mesh->bufferAttrib(geom::CUSTOM_0, sizes);
 
     m_geometry = gl::Batch::create(mesh, m_shader, { { geom::Attrib::CUSTOM_0, "vSize" } });
 }
 
-void act::room::PointcloudRoomNode::updatePointCloud()
+void act::room::PointcloudRoomNode::updatePointCloud(const std::vector<vec3>& positions)
 {
-    for (int i = 0; i < m_numPoints; i++)
-    {
-        auto&& pt = m_pointcloud->at(i);
-        m_positions[i] = vec3(pt.x, pt.y, pt.z);
+    // uploaded straight from the pointcloud, only the used part of the vbo is drawn
+    m_numPoints = (int)positions.size();
+    m_geometry->getVboMesh()->bufferAttrib(geom::POSITION, m_numPoints * sizeof(vec3), positions.data());
+}
 
-        //m_sizes[i] = pt.z * 0.5f;
-        m_colors[i] = ci::Colorf(pt.r / 255.0f, pt.g / 255.0f, pt.b / 255.0f);
-    }
+void act::room::PointcloudRoomNode::drawSpecificSettings() 
+{
+    if (ImGui::DragFloat("voxel size", &m_voxelSize, 0.001f, 0.0f, 0.5f, "%.3f m"))
+        setVoxelSize(m_voxelSize);
+    ImGui::Text("%d points", m_numPoints);
+}
 
-    m_geometry->getVboMesh()->bufferAttrib(geom::POSITION, m_positions);
-    m_geometry->getVboMesh()->bufferAttrib(geom::COLOR, m_colors);
-    //m_geometry->getVboMesh()->bufferAttrib(geom::CUSTOM_0, m_sizes);
+ci::Json act::room::PointcloudRoomNode::toParams()
+{
+    ci::Json params = ci::Json();
+    params["voxelSize"] = m_voxelSize;
+    return params;
 }
 
-void act::room::PointcloudRoomNode::drawSpecificSettings() 
+void act::room::PointcloudRoomNode::fromParams(ci::Json params)
 {
+    util::setValueFromJson(params, "voxelSize", m_voxelSize);
+    setVoxelSize(m_voxelSize);
 }
\ No newline at end of file
@@ -0,0 +1,223 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "roompch.hpp"
+#include "position/PathSpline.hpp"
+
+
+act::room::PathSpline::PathSpline()
+{
+}
+
+act::room::PathSpline::~PathSpline()
+{
+}
+
+void act::room::PathSpline::set(const std::vector<ci::vec3>& points, PathType type, bool isLooping, int degree)
+{
+	m_points	= points;
+	m_type		= type;
+	m_isLooping	= isLooping;
+
+	int count = (int)m_points.size();
+	switch (m_type) {
+	case PT_BSPLINE:
+		m_segments = count >= 2 ? count - 1 : 0;
+		if (m_segments > 0)
+			m_bSpline = ci::BSpline3f(m_points, std::clamp(degree, 1, count - 1), m_isLooping, !m_isLooping);
+		break;
+	case PT_CATMULLROM:
+		m_segments = count >= 2 ? (m_isLooping ? count : count - 1) : 0;
+		break;
+	case PT_BEZIER:
+		m_segments = m_isLooping ? count / 3 : (count - 1) / 3;
+		break;
+	}
+
+	createTable();
+}
+
+ci::vec3 act::room::PathSpline::evaluate(float u) const
+{
+	if (m_segments <= 0)
+		return m_points.empty() ? ci::vec3(0.0f) : m_points[0];
+
+	if (m_isLooping)
+		u -= floorf(u);
+	else
+		u = std::clamp(u, 0.0f, 1.0f);
+
+	if (m_type == PT_BSPLINE)
+		return m_bSpline.getPosition(u);
+
+	float x		= u * m_segments;
+	int segment	= std::min((int)x, m_segments - 1);
+	return evaluateSegment(segment, x - segment);
+}
+
+float act::room::PathSpline::getParameterAtDistance(float distance) const
+{
+	if (m_lengths.empty())
+		return 0.0f;
+
+	distance = wrapDistance(distance);
+
+	auto it = std::upper_bound(m_lengths.begin(), m_lengths.end(), distance);
+	if (it == m_lengths.begin())
+		return m_params.front();
+	if (it == m_lengths.end())
+		return m_params.back();
+
+	size_t i	= it - m_lengths.begin();
+	float span	= m_lengths[i] - m_lengths[i - 1];
+	float f		= span > 0.0f ? (distance - m_lengths[i - 1]) / span : 0.0f;
+	return m_params[i - 1] + f * (m_params[i] - m_params[i - 1]);
+}
+
+ci::vec3 act::room::PathSpline::evaluateAtDistance(float distance) const
+{
+	return evaluate(getParameterAtDistance(distance));
+}
+
+void act::room::PathSpline::evaluateAtDistances(const float* distances, size_t count, ci::vec3* positions) const
+{
+	for (size_t i = 0; i < count; i++) {
+		positions[i] = evaluate(getParameterAtDistance(distances[i]));
+	}
+}
+
+ci::vec3 act::room::PathSpline::getClosestPosition(const ci::vec3& position, float* distance) const
+{
+	if (m_samples.size() < 2) {
+		if (distance)
+			*distance = 0.0f;
+		return m_points.empty() ? ci::vec3(0.0f) : m_points[0];
+	}
+
+	// nearest point on the sampled polyline, then back onto the curve by its arc length
+	float bestDist2		= FLT_MAX;
+	float bestLength	= 0.0f;
+	for (size_t i = 1; i < m_samples.size(); i++) {
+		ci::vec3 a		= m_samples[i - 1];
+		ci::vec3 ab		= m_samples[i] - a;
+		float len2		= glm::dot(ab, ab);
+		float f			= len2 > 0.0f ? std::clamp(glm::dot(position - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+		float dist2		= glm::distance2(position, a + f * ab);
+		if (dist2 < bestDist2) {
+			bestDist2	= dist2;
+			bestLength	= m_lengths[i - 1] + f * (m_lengths[i] - m_lengths[i - 1]);
+		}
+	}
+
+	if (distance)
+		*distance = bestLength;
+	return evaluateAtDistance(bestLength);
+}
+
+std::string act::room::PathSpline::typeToString(PathType type)
+{
+	switch (type) {
+	case PT_BSPLINE:	return "bspline";
+	case PT_CATMULLROM:	return "catmullrom";
+	case PT_BEZIER:		return "bezier";
+	}
+	return "catmullrom";
+}
+
+act::room::PathSpline::PathType act::room::PathSpline::stringToType(std::string type)
+{
+	if (type == "bspline")
+		return PT_BSPLINE;
+	if (type == "bezier")
+		return PT_BEZIER;
+	return PT_CATMULLROM;
+}
+
+ci::vec3 act::room::PathSpline::evaluateSegment(int segment, float u) const
+{
+	float u2 = u * u;
+	float u3 = u2 * u;
+
+	if (m_type == PT_BEZIER) {
+		int i = segment * 3;
+		const ci::vec3& p0 = point(i);
+		const ci::vec3& p1 = point(i + 1);
+		const ci::vec3& p2 = point(i + 2);
+		const ci::vec3& p3 = point(i + 3);
+
+		float v = 1.0f - u;
+		return (v * v * v) * p0 + (3.0f * v * v * u) * p1 + (3.0f * v * u2) * p2 + u3 * p3;
+	}
+
+	// uniform Catmull-Rom, open ends are extended by mirroring the neighbour
+	int last = (int)m_points.size() - 1;
+	const ci::vec3& p1 = point(segment);
+	const ci::vec3& p2 = point(segment + 1);
+	ci::vec3 p0 = (m_isLooping || segment > 0)			? point(segment - 1) : 2.0f * p1 - p2;
+	ci::vec3 p3 = (m_isLooping || segment + 1 < last)	? point(segment + 2) : 2.0f * p2 - p1;
+
+	return 0.5f * ((2.0f * p1)
+		+ (p2 - p0) * u
+		+ (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2
+		+ (3.0f * p1 - p0 - 3.0f * p2 + p3) * u3);
+}
+
+const ci::vec3& act::room::PathSpline::point(int index) const
+{
+	int count = (int)m_points.size();
+	if (m_isLooping)
+		return m_points[((index % count) + count) % count];
+	return m_points[std::clamp(index, 0, count - 1)];
+}
+
+float act::room::PathSpline::wrapDistance(float distance) const
+{
+	float length = m_lengths.back();
+	if (!m_isLooping || length <= 0.0f)
+		return std::clamp(distance, 0.0f, length);
+
+	distance = fmodf(distance, length);
+	if (distance < 0.0f)
+		distance += length;
+	return distance;
+}
+
+void act::room::PathSpline::createTable()
+{
+	m_params.clear();
+	m_lengths.clear();
+	m_samples.clear();
+
+	if (m_segments <= 0)
+		return;
+
+	int count = m_segments * kSamplesPerSegment;
+	m_params.reserve(count + 1);
+	m_lengths.reserve(count + 1);
+	m_samples.reserve(count + 1);
+
+	float length = 0.0f;
+	for (int i = 0; i <= count; i++) {
+		float u		= i / (float)count;
+		ci::vec3 pt	= evaluate(u);
+		if (i > 0)
+			length += glm::distance(m_samples.back(), pt);
+
+		m_params.push_back(u);
+		m_lengths.push_back(length);
+		m_samples.push_back(pt);
+	}
+}
@@ -102,6 +102,11 @@ void act::room::PositionRoomNode::drawSpecificSettings()
 	if (ImGui::Checkbox("loop", &loop)) {
 		setIsLooping(loop);
 	}
+
+	int type = m_pathType;
+	if (ImGui::Combo("type", &type, "B-spline\0Catmull-Rom\0Bezier\0")) {
+		setPathType((PathSpline::PathType)type);
+	}
 }
 
 ci::Json act::room::PositionRoomNode::toParams()
@@ -109,6 +114,7 @@ ci::Json act::room::PositionRoomNode::toParams()
 	ci::Json json	= ci::Json::object();
 	json["degree"]	= m_degree;
 	json["loop"]	= m_isLooping;
+	json["type"]	= PathSpline::typeToString(m_pathType);
 
 	ci::Json points = ci::Json::array();
 	for (auto&& pt : m_controlPoints) {
@@ -128,6 +134,8 @@ void act::room::PositionRoomNode::fromParams(ci::Json json)
 
 	util::setValueFromJson(json, "degree", m_degree);
 	util::setValueFromJson(json, "loop", m_isLooping);
+	if (json.contains("type"))
+		m_pathType = PathSpline::stringToType(json["type"]);
 	setDegree(getDegree());
 	updateSpline();
 }
@@ -218,20 +226,46 @@ ci::vec3 act::room::PositionRoomNode::evaluatePosition(float t)
 	if (abs(t) == NAN)
 		return m_position;
 
-	m_evaluatedPosition = m_spline.getPosition(t);
+	m_evaluatedPosition = m_path.evaluate(t);
 	return m_evaluatedPosition + m_position;
 }
 
-void act::room::PositionRoomNode::updateSpline()
+void act::room::PositionRoomNode::setPathType(PathSpline::PathType type)
 {
-	if (m_controlPoints.size() < 2)
+	m_pathType = type;
+	updateSpline();
+}
+
+ci::vec3 act::room::PositionRoomNode::evaluatePositionAtDistance(float distance)
+{
+	if (m_controlPoints.size() <= 1)
+		return m_position;
+
+	m_evaluatedPosition = m_path.evaluateAtDistance(distance);
+	return m_evaluatedPosition + m_position;
+}
+
+void act::room::PositionRoomNode::evaluatePositionsAtDistances(const std::vector<float>& distances, std::vector<ci::vec3>& positions)
+{
+	positions.resize(distances.size());
+	if (distances.empty())
 		return;
 
-	m_spline = ci::BSpline3f(m_controlPoints, m_degree, m_isLooping, !m_isLooping);
-	m_points.resize(0);
-	for (float t = 0.00f; t < 1.0f; t += 0.01f) {
-		m_points.push_back(m_spline.getPosition(t));
+	m_path.evaluateAtDistances(distances.data(), distances.size(), positions.data());
+	for (auto&& pos : positions) {
+		pos += m_position;
 	}
+}
+
+ci::vec3 act::room::PositionRoomNode::getClosestPosition(ci::vec3 position, float* distance)
+{
+	return m_path.getClosestPosition(position - m_position, distance) + m_position;
+}
+
+void act::room::PositionRoomNode::updateSpline()
+{
+	m_path.set(m_controlPoints, m_pathType, m_isLooping, m_degree);
+	m_points = m_path.getSamples();
 
 	evaluatePosition(m_t);
 }
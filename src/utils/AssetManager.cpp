@@ -0,0 +1,124 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "AssetManager.hpp"
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+
+act::util::AssetManager::AssetManager(unsigned int numThreads)
+{
+	// loading is mostly disk and decoding, a few threads are enough and leave the cores to the running show
+	if (numThreads == 0)
+		numThreads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+
+	for (unsigned int i = 0; i < numThreads; i++)
+		m_threads.push_back(std::thread([&]() { loop(); }));
+}
+
+act::util::AssetManager::~AssetManager()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_jobMutex);
+		m_isRunning = false;
+		m_jobs.clear();	// their futures report nullptr
+	}
+	m_condition.notify_all();
+
+	for (auto&& thread : m_threads) {
+		if (thread.joinable())
+			thread.join();
+	}
+}
+
+act::util::AssetManager& act::util::AssetManager::get()
+{
+	static AssetManager manager;
+	return manager;
+}
+
+void act::util::AssetManager::clear()
+{
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	m_cache.clear();
+}
+
+void act::util::AssetManager::evict(const std::string& key, uint64_t generation)
+{
+	std::lock_guard<std::mutex> lock(m_cacheMutex);
+	auto it = m_cache.find(key);
+	if (it != m_cache.end() && it->second.generation == generation)
+		m_cache.erase(it);
+}
+
+void act::util::AssetManager::enqueue(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_jobMutex);
+		m_jobs.push_back(job);
+		m_numPending++;
+	}
+	m_condition.notify_one();
+}
+
+void act::util::AssetManager::loop()
+{
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_jobMutex);
+			m_condition.wait(lock, [&]() { return !m_isRunning || !m_jobs.empty(); });
+			if (!m_isRunning)
+				return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		job();
+		m_numPending--;
+	}
+}
+
+uint64_t act::util::AssetManager::fingerprint(const std::filesystem::path& path)
+{
+	std::error_code error;
+	uint64_t size = std::filesystem::file_size(path, error);
+	if (error)
+		return 0;
+	uint64_t time = (uint64_t)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+	// FNV-1a over path, size and modification time
+	uint64_t hash = 14695981039346656037ull;
+	auto add = [&](const void* data, size_t length) {
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < length; i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	std::string name = path.string();
+	add(name.data(), name.size());
+	add(&size, sizeof(size));
+	add(&time, sizeof(time));
+	return hash;
+}
+
+void act::util::AssetManager::reportFailure(const std::string& what)
+{
+	CI_LOG_E("[AssetManager] loading failed: " << what);
+}
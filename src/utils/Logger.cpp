@@ -19,8 +19,236 @@
 #include "cinder/app/App.h"
 #include "cinder/Utilities.h"
 
+#include <array>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <sstream>
+
 bool act::util::Logger::m_isInitialized = false;
 
+namespace {
+
+	constexpr size_t MaxFields		= 8;
+	constexpr size_t RingCapacity	= 1024;
+
+	struct Record {
+		uint64_t				sequence	= 0;
+		ci::log::Metadata		meta;				// as given by Cinder
+		const char*				function	= nullptr;	// given instead of meta by ACT_LOG
+		const char*				file		= nullptr;
+		int						line		= 0;
+		std::string				text;
+		std::array<act::util::LogField, MaxFields>	fields;
+		size_t					numFields	= 0;
+	};
+
+	/** @brief single producer (the logging thread), single consumer (the log thread) */
+	struct Ring {
+		std::unique_ptr<Record[]>	records = std::make_unique<Record[]>(RingCapacity);
+		std::atomic<size_t>			head	= 0;	// next to read
+		std::atomic<size_t>			tail	= 0;	// next to write
+
+		bool push(Record&& record) {
+			size_t t = tail.load(std::memory_order_relaxed);
+			if (t - head.load(std::memory_order_acquire) == RingCapacity)
+				return false;
+			records[t % RingCapacity] = std::move(record);
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(Record& record) {
+			size_t h = head.load(std::memory_order_relaxed);
+			if (h == tail.load(std::memory_order_acquire))
+				return false;
+			record = std::move(records[h % RingCapacity]);
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+	};
+
+	class LogBackend
+	{
+	public:
+		static LogBackend& get() {
+			static LogBackend backend;
+			return backend;
+		}
+
+		~LogBackend() {
+			stop();
+		}
+
+		void push(Record&& record) {
+			// once the log thread is stopped (at shutdown, while the rest is torn down) records are written right away.
+			// the writer is counted before m_isRunning is checked, so stop() waits for a push that saw the thread running
+			m_writers.fetch_add(1);
+			if (!m_isRunning.load()) {
+				m_writers.fetch_sub(1);
+				std::lock_guard<std::mutex> lock(m_sinkMutex);
+				write(record);
+				return;
+			}
+
+			thread_local std::shared_ptr<Ring> ring = addRing();
+
+			record.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+			bool isUrgent = record.meta.mLevel >= ci::log::LEVEL_ERROR;
+			if (!ring->push(std::move(record)))
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+			else if (isUrgent)
+				m_condition.notify_one();
+			m_writers.fetch_sub(1, std::memory_order_release);
+		}
+
+		void addSink(std::unique_ptr<ci::log::Logger> sink) {
+			std::lock_guard<std::mutex> lock(m_sinkMutex);
+			m_sinks.push_back(std::move(sink));
+		}
+
+		void stop() {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_isRunning = false;
+			}
+			m_condition.notify_all();
+			if (m_thread.joinable())
+				m_thread.join();
+
+			// pushes that still saw the thread running end in a ring
+			while (m_writers.load(std::memory_order_acquire) > 0)
+				std::this_thread::yield();
+
+			// what was pushed while the thread was stopping
+			std::lock_guard<std::mutex> lock(m_mutex);
+			collect();
+			flush();
+		}
+
+		size_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+	private:
+		std::mutex							m_mutex;		// guards the rings, taken once per logging thread
+		std::condition_variable				m_condition;
+		std::vector<std::shared_ptr<Ring>>	m_rings;
+		std::atomic<bool>					m_isRunning = true;
+		std::atomic<int>					m_writers	= 0;	// pushes into a ring in progress
+		std::thread							m_thread;
+
+		std::mutex								m_sinkMutex;
+		std::vector<std::unique_ptr<ci::log::Logger>>	m_sinks;
+
+		std::atomic<uint64_t>	m_sequence	= 0;
+		std::atomic<size_t>		m_dropped	= 0;
+		size_t					m_reportedDropped = 0;
+		std::vector<Record>		m_batch;
+
+		LogBackend() {
+			m_sinks.push_back(std::make_unique<ci::log::LoggerConsole>());
+			m_thread = std::thread([this]() { loop(); });
+		}
+
+		std::shared_ptr<Ring> addRing() {
+			auto ring = std::make_shared<Ring>();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_rings.push_back(ring);
+			return ring;
+		}
+
+		void loop() {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (true) {
+				bool isRunning = m_isRunning;
+				collect();
+
+				lock.unlock();
+				flush();
+				lock.lock();
+
+				if (!isRunning)
+					return; // stopped and everything is written
+				m_condition.wait_for(lock, std::chrono::milliseconds(20));
+			}
+		}
+
+		/** @brief moves the records of all rings into the batch, the rings of ended threads are removed once empty */
+		void collect() {
+			for (auto it = m_rings.begin(); it != m_rings.end();) {
+				Record record;
+				while ((*it)->pop(record))
+					m_batch.push_back(std::move(record));
+
+				if (it->use_count() == 1 && (*it)->head == (*it)->tail)
+					it = m_rings.erase(it);
+				else
+					++it;
+			}
+		}
+
+		void flush() {
+			std::sort(m_batch.begin(), m_batch.end(), [](const Record& a, const Record& b) { return a.sequence < b.sequence; });
+
+			std::lock_guard<std::mutex> lock(m_sinkMutex);
+			for (auto&& record : m_batch)
+				write(record);
+			m_batch.clear();
+
+			size_t dropped = m_dropped.load(std::memory_order_relaxed);
+			if (dropped != m_reportedDropped) {
+				Record record;
+				record.meta.mLevel	= ci::log::LEVEL_WARNING;
+				record.text			= std::to_string(dropped - m_reportedDropped) + " log records dropped, the log ring was full";
+				write(record);
+				m_reportedDropped = dropped;
+			}
+		}
+
+		void write(Record& record) {
+			if (record.function)
+				record.meta.mLocation = ci::log::Location(record.function, record.file, record.line);
+
+			if (record.numFields > 0) {
+				std::stringstream strstr;
+				strstr << record.text;
+				for (size_t i = 0; i < record.numFields; i++) {
+					auto&& field = record.fields[i];
+					strstr << " " << field.key << "=";
+					std::visit([&](auto&& value) {
+						using T = std::decay_t<decltype(value)>;
+						if constexpr (std::is_same_v<T, std::string>)
+							strstr << "\"" << value << "\"";
+						else if constexpr (std::is_same_v<T, bool>)
+							strstr << (value ? "true" : "false");
+						else
+							strstr << value;
+					}, field.value);
+				}
+				record.text = strstr.str();
+			}
+
+			for (auto&& sink : m_sinks)
+				sink->write(record.meta, record.text);
+		}
+	};
+
+	/** @brief registered at Cinder's LogManager, so CI_LOG_* only pushes into the ring */
+	class AsyncLogger : public ci::log::Logger
+	{
+	public:
+		void write(const ci::log::Metadata& meta, const std::string& text) override {
+			Record record;
+			record.meta = meta;
+			record.text = text;
+			LogBackend::get().push(std::move(record));
+		}
+	};
+
+}
+
 void act::util::Logger::initialize()
 {
 	if (m_isInitialized)
@@ -28,9 +256,47 @@ void act::util::Logger::initialize()
 
 	m_isInitialized = true;
 
-	ci::log::makeLogger<ci::log::LoggerSystem>()->setLevel(ci::log::LEVEL_WARNING);
+	auto&& backend = LogBackend::get();
+
+	auto systemLogger = std::make_unique<ci::log::LoggerSystem>();
+	systemLogger->setLevel(ci::log::LEVEL_WARNING);
+	backend.addSink(std::move(systemLogger));
 
-	ci::log::makeLogger<ci::log::LoggerFileRotating>(ci::app::getAppPath() / "logs", "InActually_%Y-%m-%d.log", true, [](const std::filesystem::path& path) {
+	backend.addSink(std::make_unique<ci::log::LoggerFileRotating>(ci::app::getAppPath() / "logs", "InActually_%Y-%m-%d.log", true, [](const std::filesystem::path& path) {
 		ci::limitDirectoryFileCount(path.parent_path(), 10); // logs from the last 10 days
-	});
+	}));
+
+	// the console is written by the log thread as well
+	ci::log::LogManager::instance()->clearLoggers();
+	ci::log::makeLogger<AsyncLogger>();
+}
+
+void act::util::Logger::shutdown()
+{
+	LogBackend::get().stop();
+}
+
+void act::util::Logger::write(ci::log::Level level, const char* function, const char* file, int line, std::string text, std::initializer_list<LogField> fields, size_t suppressed)
+{
+	Record record;
+	record.meta.mLevel	= level;
+	record.function		= function;
+	record.file			= file;
+	record.line			= line;
+	record.text			= std::move(text);
+
+	for (auto&& field : fields) {
+		if (record.numFields == MaxFields)
+			break;
+		record.fields[record.numFields++] = field;
+	}
+	if (suppressed > 0 && record.numFields < MaxFields)
+		record.fields[record.numFields++] = LogField("suppressed", suppressed);
+
+	LogBackend::get().push(std::move(record));
+}
+
+size_t act::util::Logger::getDroppedCount()
+{
+	return LogBackend::get().getDroppedCount();
 }
@@ -0,0 +1,211 @@
+/*
+	InACTually
+	> interactive theater for actual acts
+	> this file is part of the "InACTually Engine", a MediaServer for driving all technology
+
+	Copyright (c) 20212025 Lars Engeln, Fabian Tpfer
+	Copyright (c) 2025 InACTually Community
+	Licensed under the MIT License.
+	See LICENSE file in the project root for full license information.
+
+	This file is created and substantially modified: 2025
+
+	contributors:
+	Lars Engeln - mail@lars-engeln.de
+*/
+
+#include "Snapshot.hpp"
+
+#include "cinder/Log.h"
+
+#include <fstream>
+
+static const char kMagic[6] = { 'I', 'A', 'S', 'N', 'A', 'P' };
+
+
+void act::util::SnapshotWriter::writeBlob(const std::vector<uint8_t>& blob)
+{
+	write((uint32_t)blob.size());
+	m_body.insert(m_body.end(), blob.begin(), blob.end());
+}
+
+std::vector<uint8_t> act::util::SnapshotWriter::finish()
+{
+	std::vector<uint8_t> result;
+	auto append = [&](const void* data, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		result.insert(result.end(), bytes, bytes + size);
+	};
+
+	size_t tableSize = 0;
+	if (m_strings) {
+		for (auto&& string : *m_strings)
+			tableSize += 4 + string.size();
+	}
+	result.reserve(sizeof(kMagic) + 2 + 4 + 4 + tableSize + m_body.size());
+
+	uint16_t version	= kVersion;
+	uint32_t kind		= m_kind;
+	uint32_t count		= m_strings ? (uint32_t)m_strings->size() : 0;
+	append(kMagic, sizeof(kMagic));
+	append(&version, sizeof(version));
+	append(&kind, sizeof(kind));
+	append(&count, sizeof(count));
+
+	if (m_strings) {
+		for (auto&& string : *m_strings) {
+			uint32_t size = (uint32_t)string.size();
+			append(&size, sizeof(size));
+			append(string.data(), string.size());
+		}
+	}
+
+	result.insert(result.end(), m_body.begin(), m_body.end());
+	return result;
+}
+
+bool act::util::SnapshotReader::open(const std::vector<uint8_t>& data, SnapshotKind kind)
+{
+	m_data		= &data;
+	m_position	= 0;
+	m_isValid	= true;
+	m_strings.clear();
+
+	char magic[sizeof(kMagic)];
+	for (auto& c : magic)
+		read(c);
+	uint32_t fileKind = 0, count = 0;
+	read(m_version);
+	read(fileKind);
+	read(count);
+
+	if (!m_isValid || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || fileKind != kind) {
+		m_isValid = false;
+		return false;
+	}
+	if (m_version > SnapshotWriter::kVersion) {
+		CI_LOG_E("snapshot version " << m_version << " is newer than this build");
+		m_isValid = false;
+		return false;
+	}
+
+	m_strings.resize(count);
+	for (auto& string : m_strings) {
+		uint32_t size = 0;
+		if (!read(size) || m_position + size > m_data->size()) {
+			m_isValid = false;
+			return false;
+		}
+		string.assign(reinterpret_cast<const char*>(m_data->data() + m_position), size);
+		m_position += size;
+	}
+	return true;
+}
+
+bool act::util::SnapshotReader::readBlob(std::vector<uint8_t>& blob)
+{
+	uint32_t size = 0;
+	if (!read(size) || m_position + size > m_data->size()) {
+		m_isValid = false;
+		return false;
+	}
+	blob.assign(m_data->begin() + m_position, m_data->begin() + m_position + size);
+	m_position += size;
+	return true;
+}
+
+bool act::util::isSnapshotFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	char magic[sizeof(kMagic)] = {};
+	return file.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool act::util::readSnapshotFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+
+	data.resize((size_t)file.tellg());
+	file.seekg(0);
+	return !!file.read(reinterpret_cast<char*>(data.data()), data.size());
+}
+
+bool act::util::writeSnapshotFile(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+{
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(reinterpret_cast<const char*>(data.data()), data.size()))
+			return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	if (error) {
+		CI_LOG_E("cannot replace " << path << ": " << error.message());
+		return false;
+	}
+	return true;
+}
+
+act::util::SnapshotSaver::SnapshotSaver()
+{
+	m_thread = std::thread([this]() { loop(); });
+}
+
+act::util::SnapshotSaver::~SnapshotSaver()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isRunning = false;
+	}
+	m_condition.notify_all();
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+void act::util::SnapshotSaver::save(const std::filesystem::path& path, std::function<std::vector<uint8_t>()> encode)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending[path] = encode;
+		m_isSaving = true;
+	}
+	m_condition.notify_all();
+}
+
+void act::util::SnapshotSaver::flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]() { return m_pending.empty() && !m_isSaving; });
+}
+
+void act::util::SnapshotSaver::loop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_condition.wait(lock, [this]() { return !m_pending.empty() || !m_isRunning; });
+		if (m_pending.empty())
+			return;	// stopped, everything is written
+
+		auto job = *m_pending.begin();
+		m_pending.erase(m_pending.begin());
+
+		lock.unlock();
+		try {
+			std::vector<uint8_t> data = job.second();
+			if (!writeSnapshotFile(job.first, data))
+				CI_LOG_E("cannot save " << job.first);
+		}
+		catch (const std::exception& exc) {
+			CI_LOG_E("cannot save " << job.first << ": " << exc.what());
+		}
+		lock.lock();
+
+		m_isSaving = !m_pending.empty();
+		m_condition.notify_all();
+	}
+}